@@ -0,0 +1,8 @@
+#! /usr/bin/env python3
+
+# Programs that are runnable.
+ns3_runnable_programs = ['src/applications/examples/ns3-dev-three-gpp-http-example-debug', 'src/bridge/examples/ns3-dev-csma-bridge-debug', 'src/bridge/examples/ns3-dev-csma-bridge-one-hop-debug', 'src/buildings/examples/ns3-dev-buildings-pathloss-profiler-debug', 'src/buildings/examples/ns3-dev-outdoor-random-walk-example-debug', 'src/config-store/examples/ns3-dev-config-store-save-debug', 'src/core/examples/ns3-dev-main-callback-debug', 'src/core/examples/ns3-dev-sample-simulator-debug', 'src/core/examples/ns3-dev-main-ptr-debug', 'src/core/examples/ns3-dev-main-random-variable-stream-debug', 'src/core/examples/ns3-dev-sample-random-variable-debug', 'src/core/examples/ns3-dev-sample-random-variable-stream-debug', 'src/core/examples/ns3-dev-command-line-example-debug', 'src/core/examples/ns3-dev-hash-example-debug', 'src/core/examples/ns3-dev-sample-log-time-format-debug', 'src/core/examples/ns3-dev-test-string-value-formatting-debug', 'src/core/examples/ns3-dev-sample-show-progress-debug', 'src/core/examples/ns3-dev-system-path-examples-debug', 'src/core/examples/ns3-dev-main-test-sync-debug', 'src/csma/examples/ns3-dev-csma-one-subnet-debug', 'src/csma/examples/ns3-dev-csma-broadcast-debug', 'src/csma/examples/ns3-dev-csma-packet-socket-debug', 'src/csma/examples/ns3-dev-csma-multicast-debug', 'src/fd-net-device/examples/ns3-dev-fd2fd-onoff-debug', 'src/fd-net-device/examples/ns3-dev-realtime-fd2fd-onoff-debug', 'src/fd-net-device/examples/ns3-dev-fd-emu-udp-echo-debug', 'src/fd-net-device/examples/ns3-dev-fd-emu-onoff-debug', 'src/internet/examples/ns3-dev-main-simple-debug', 'src/lte/examples/ns3-dev-lena-cqi-threshold-debug', 'src/lte/examples/ns3-dev-lena-dual-stripe-debug', 'src/lte/examples/ns3-dev-lena-fading-debug', 'src/lte/examples/ns3-dev-lena-intercell-interference-debug', 'src/lte/examples/ns3-dev-lena-ipv6-addr-conf-debug', 'src/lte/examples/ns3-dev-lena-ipv6-ue-rh-debug', 'src/lte/examples/ns3-dev-lena-ipv6-ue-ue-debug', 'src/lte/examples/ns3-dev-lena-pathloss-traces-debug', 'src/lte/examples/ns3-dev-lena-profiling-debug', 'src/lte/examples/ns3-dev-lena-rem-debug', 'src/lte/examples/ns3-dev-lena-rem-sector-antenna-debug', 'src/lte/examples/ns3-dev-lena-rlc-traces-debug', 'src/lte/examples/ns3-dev-lena-simple-debug', 'src/lte/examples/ns3-dev-lena-simple-epc-debug', 'src/lte/examples/ns3-dev-lena-deactivate-bearer-debug', 'src/lte/examples/ns3-dev-lena-x2-handover-debug', 'src/lte/examples/ns3-dev-lena-x2-handover-measures-debug', 'src/lte/examples/ns3-dev-lena-frequency-reuse-debug', 'src/lte/examples/ns3-dev-lena-distributed-ffr-debug', 'src/lte/examples/ns3-dev-lena-uplink-power-control-debug', 'src/lte/examples/ns3-dev-lena-simple-epc-emu-debug', 'src/millicar/examples/ns3-dev-vehicular-simple-one-debug', 'src/millicar/examples/ns3-dev-vehicular-simple-two-debug', 'src/millicar/examples/ns3-dev-vehicular-simple-three-debug', 'src/millicar/examples/ns3-dev-vehicular-simple-four-debug', 'src/millicar/examples/ns3-dev-mmwave-vehicular-link-adaptation-example-debug', 'src/millicar/examples/ns3-dev-vehicular-large-group-debug', 'src/millicar/examples/ns3-dev-vehicular-benchmark-debug', 'src/mmwave/examples/ns3-dev-mmwave-example-debug', 'src/mmwave/examples/ns3-dev-mmwave-tcp-example-debug', 'src/mmwave/examples/ns3-dev-mmwave-simple-epc-debug', 'src/mmwave/examples/ns3-dev-mmwave-simple-epc-ipv6-debug', 'src/mmwave/examples/ns3-dev-mmwave-epc-tdma-debug', 'src/mmwave/examples/ns3-dev-mmwave-tdma-debug', 'src/mmwave/examples/ns3-dev-mmwave-simple-building-obstacle-debug', 'src/mmwave/examples/ns3-dev-mmwave-tcp-building-example-debug', 'src/mmwave/examples/ns3-dev-mmwave-amc-test-debug', 'src/mmwave/examples/ns3-dev-mmwave-amc-test2-debug', 'src/mmwave/examples/ns3-dev-mmwave-epc-amc-test-debug', 'src/mmwave/examples/ns3-dev-mc-twoenbs-debug', 'src/mmwave/examples/ns3-dev-mc-twoenbs-ipv6-debug', 'src/mmwave/examples/ns3-dev-mmwave-ca-diff-bandwidth-debug', 'src/mmwave/examples/ns3-dev-mmwave-ca-same-bandwidth-debug', 'src/mobility/examples/ns3-dev-main-grid-topology-debug', 'src/mobility/examples/ns3-dev-main-random-topology-debug', 'src/mobility/examples/ns3-dev-main-random-walk-debug', 'src/mobility/examples/ns3-dev-mobility-trace-example-debug', 'src/mobility/examples/ns3-dev-ns2-mobility-trace-debug', 'src/mobility/examples/ns3-dev-bonnmotion-ns2-example-debug', 'src/network/examples/ns3-dev-main-packet-header-debug', 'src/network/examples/ns3-dev-main-packet-tag-debug', 'src/network/examples/ns3-dev-packet-socket-apps-debug', 'src/point-to-point/examples/ns3-dev-main-attribute-value-debug', 'src/propagation/examples/ns3-dev-main-propagation-loss-debug', 'src/propagation/examples/ns3-dev-jakes-propagation-model-example-debug', 'src/spectrum/examples/ns3-dev-adhoc-aloha-ideal-phy-debug', 'src/spectrum/examples/ns3-dev-adhoc-aloha-ideal-phy-matrix-propagation-loss-model-debug', 'src/spectrum/examples/ns3-dev-adhoc-aloha-ideal-phy-with-microwave-oven-debug', 'src/spectrum/examples/ns3-dev-tv-trans-example-debug', 'src/spectrum/examples/ns3-dev-tv-trans-regional-example-debug', 'src/spectrum/examples/ns3-dev-three-gpp-channel-example-debug', 'src/stats/examples/ns3-dev-gnuplot-example-debug', 'src/stats/examples/ns3-dev-double-probe-example-debug', 'src/stats/examples/ns3-dev-time-probe-example-debug', 'src/stats/examples/ns3-dev-gnuplot-aggregator-example-debug', 'src/stats/examples/ns3-dev-gnuplot-helper-example-debug', 'src/stats/examples/ns3-dev-file-aggregator-example-debug', 'src/stats/examples/ns3-dev-file-helper-example-debug', 'src/traffic-control/examples/ns3-dev-codel-vs-pfifo-basic-test-debug', 'src/traffic-control/examples/ns3-dev-codel-vs-pfifo-asymmetric-debug', 'src/virtual-net-device/examples/ns3-dev-virtual-net-device-debug', 'examples/tcp/ns3-dev-tcp-large-transfer-debug', 'examples/tcp/ns3-dev-tcp-nsc-lfn-debug', 'examples/tcp/ns3-dev-tcp-nsc-zoo-debug', 'examples/tcp/ns3-dev-tcp-star-server-debug', 'examples/tcp/ns3-dev-tcp-bulk-send-debug', 'examples/tcp/ns3-dev-tcp-pcap-nanosec-example-debug', 'examples/tcp/ns3-dev-dctcp-example-debug', 'examples/routing/ns3-dev-dynamic-global-routing-debug', 'examples/routing/ns3-dev-static-routing-slash32-debug', 'examples/routing/ns3-dev-global-routing-slash32-debug', 'examples/routing/ns3-dev-global-injection-slash32-debug', 'examples/routing/ns3-dev-simple-alternate-routing-debug', 'examples/routing/ns3-dev-mixed-global-routing-debug', 'examples/routing/ns3-dev-global-routing-multi-switch-plus-router-debug', 'examples/routing/ns3-dev-simple-multicast-flooding-debug', 'examples/udp-client-server/ns3-dev-udp-client-server-debug', 'examples/udp-client-server/ns3-dev-udp-trace-client-server-debug', 'examples/error-model/ns3-dev-simple-error-model-debug', 'examples/tutorial/ns3-dev-hello-simulator-debug', 'examples/tutorial/ns3-dev-first-debug', 'examples/tutorial/ns3-dev-second-debug', 'examples/tutorial/ns3-dev-fourth-debug', 'examples/tutorial/ns3-dev-fifth-debug', 'examples/tutorial/ns3-dev-sixth-debug', 'examples/tutorial/ns3-dev-seventh-debug', 'examples/udp/ns3-dev-udp-echo-debug', 'examples/socket/ns3-dev-socket-bound-static-routing-debug', 'examples/socket/ns3-dev-socket-bound-tcp-static-routing-debug', 'examples/socket/ns3-dev-socket-options-ipv4-debug', 'examples/socket/ns3-dev-socket-options-ipv6-debug', 'examples/realtime/ns3-dev-realtime-udp-echo-debug', 'examples/naming/ns3-dev-object-names-debug', 'examples/ipv6/ns3-dev-test-ipv6-debug', 'examples/traffic-control/ns3-dev-tbf-example-debug', 'examples/traffic-control/ns3-dev-cobalt-vs-codel-debug', 'scratch/sumo_ns3_paderborn/ns3-dev-sumo_ns3_paderborn-debug', 'scratch/simple_example/ns3-dev-simple_example-debug', 'scratch/subdir/ns3-dev-subdir-debug']
+
+# Scripts that are runnable.
+ns3_runnable_scripts = ['csma-bridge.py', 'sample-simulator.py', 'first.py', 'second.py', 'realtime-udp-echo.py']
+
@@ -0,0 +1,30 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_MILLICAR
+    
+
+// Module headers:
+#include "mmwave-sidelink-edf-scheduler.h"
+#include "mmwave-sidelink-mac.h"
+#include "mmwave-sidelink-pf-scheduler.h"
+#include "mmwave-sidelink-phy.h"
+#include "mmwave-sidelink-rr-scheduler.h"
+#include "mmwave-sidelink-sap.h"
+#include "mmwave-sidelink-scheduler.h"
+#include "mmwave-sidelink-spectrum-channel.h"
+#include "mmwave-sidelink-spectrum-phy.h"
+#include "mmwave-sidelink-spectrum-signal-parameters.h"
+#include "mmwave-vehicular-antenna-array-model.h"
+#include "mmwave-vehicular-helper.h"
+#include "mmwave-vehicular-net-device.h"
+#include "mmwave-vehicular-profiler.h"
+#include "mmwave-vehicular-propagation-loss-model.h"
+#include "mmwave-vehicular-spectrum-propagation-loss-model.h"
+#include "mmwave-vehicular-traces-helper.h"
+#include "mmwave-vehicular.h"
+#include "rain-attenuation.h"
+#include "rain-snow-attenuation.h"
+#endif
@@ -0,0 +1,194 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef SRC_MMWAVE_HELPER_MMWAVE_ASYNC_TRACE_WRITER_H_
+#define SRC_MMWAVE_HELPER_MMWAVE_ASYNC_TRACE_WRITER_H_
+
+#include <ns3/object.h>
+#include <atomic>
+#include <new>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+namespace ns3 {
+
+class SystemThread;
+
+namespace mmwave {
+
+/**
+ * \ingroup mmwave
+ *
+ * \brief Trace sink shared by the trace helpers, which formats and writes
+ * the trace records on a background thread
+ *
+ * A trace record is a trivially copyable struct T with a static method
+ * void T::Format (std::ostream& os, const T& record), which writes the
+ * record, including the end of line, to the stream. When Async is false,
+ * or if threads are not supported, Write formats the record immediately and
+ * flushes the stream, as the trace helpers used to do. Otherwise the record
+ * is copied to a lock-free single-producer single-consumer ring and a
+ * background thread formats it, so that the files are identical once the
+ * ring is drained. The ring is drained when the simulation is destroyed and
+ * by Drain, which must be called before closing a stream written through
+ * the writer.
+ */
+class MmWaveAsyncTraceWriter : public Object
+{
+public:
+  /// the policy applied when the ring is full
+  enum BackPressurePolicy
+  {
+    BLOCK, //!< wait until the background thread frees a slot
+    DROP //!< drop the record and increase the counter of dropped records
+  };
+
+  MmWaveAsyncTraceWriter ();
+  virtual ~MmWaveAsyncTraceWriter ();
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * Returns the writer shared by the trace helpers, created the first time
+   * this method is called
+   * \return the shared writer
+   */
+  static Ptr<MmWaveAsyncTraceWriter> Get ();
+
+  /**
+   * Writes a record to a stream
+   * \param os the stream, which must stay open until the record is written
+   * \param record the record
+   */
+  template <typename T>
+  void Write (std::ostream& os, const T& record);
+
+  /**
+   * Waits until all the queued records are written and flushes the streams
+   */
+  void Drain ();
+
+  /**
+   * Returns the number of records dropped because the ring was full
+   * \return the number of dropped records
+   */
+  uint64_t GetDroppedRecords () const;
+
+  /// the maximum size of a record, in bytes
+  static const std::size_t MAX_RECORD_SIZE = 96;
+
+protected:
+  // inherited from Object
+  virtual void DoDispose ();
+
+private:
+  /// a function which formats a record
+  typedef void (*FormatFunction) (std::ostream& os, const void* record);
+
+  /// a slot of the ring
+  struct Slot
+  {
+    FormatFunction m_format; //!< the function which formats the record
+    std::ostream* m_stream; //!< the destination stream
+    union
+    {
+      uint8_t m_data[MAX_RECORD_SIZE]; //!< the record
+      double m_align; //!< forces the alignment of the record
+    };
+  };
+
+  /**
+   * Formats a record of type T
+   * \param os the stream
+   * \param record the record
+   */
+  template <typename T>
+  static void Format (std::ostream& os, const void* record)
+  {
+    T::Format (os, *static_cast<const T*> (record));
+  }
+
+  /**
+   * Returns true if the records are written by the background thread
+   * \return true if the writer is asynchronous
+   */
+  bool IsAsync () const;
+
+  /**
+   * Reserves the next slot of the ring, starting the background thread if
+   * needed and applying the back-pressure policy if the ring is full
+   * \return the slot, or 0 if the record must be dropped
+   */
+  Slot* Reserve ();
+
+  /**
+   * Makes the last reserved slot visible to the background thread
+   */
+  void Commit ();
+
+  /**
+   * The body of the background thread
+   */
+  void Run ();
+
+  bool m_async; //!< true if the records are written by the background thread
+  BackPressurePolicy m_policy; //!< the back-pressure policy
+  uint32_t m_ringSize; //!< the number of slots of the ring
+  std::vector<Slot> m_ring; //!< the ring
+  std::atomic<uint64_t> m_head; //!< the number of records queued, written by the simulation thread
+  std::atomic<uint64_t> m_tail; //!< the number of records written, written by the background thread
+  std::atomic<bool> m_stop; //!< true if the background thread must exit once the ring is empty
+  uint64_t m_dropped; //!< the number of dropped records
+  Ptr<SystemThread> m_thread; //!< the background thread
+};
+
+template <typename T>
+void
+MmWaveAsyncTraceWriter::Write (std::ostream& os, const T& record)
+{
+  static_assert (sizeof (T) <= MAX_RECORD_SIZE, "the trace record is too large");
+  static_assert (std::is_trivially_copyable<T>::value, "the trace record must be trivially copyable");
+
+  if (!IsAsync ())
+    {
+      T::Format (os, record);
+      os.flush ();
+      return;
+    }
+
+  Slot* slot = Reserve ();
+  if (slot == 0)
+    {
+      return;
+    }
+  slot->m_format = &MmWaveAsyncTraceWriter::Format<T>;
+  slot->m_stream = &os;
+  new (slot->m_data) T (record);
+  Commit ();
+}
+
+} // namespace mmwave
+
+} // namespace ns3
+
+#endif /* SRC_MMWAVE_HELPER_MMWAVE_ASYNC_TRACE_WRITER_H_ */
@@ -0,0 +1,442 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef SRC_MMWAVE_MODEL_MMWAVE_SIDELINK_MAC_H_
+#define SRC_MMWAVE_MODEL_MMWAVE_SIDELINK_MAC_H_
+
+#include "mmwave-sidelink-sap.h"
+#include "mmwave-sidelink-scheduler.h"
+#include "ns3/mmwave-amc.h"
+#include "ns3/mmwave-phy-mac-common.h"
+#include "ns3/eps-bearer.h"
+#include "ns3/traced-callback.h"
+#include "ns3/nstime.h"
+#include "ns3/random-variable-stream.h"
+
+namespace ns3 {
+
+namespace millicar {
+
+/// structure used for the scheduling info callback
+struct SlSchedulingCallback
+{
+  uint16_t frame; //!< frame number
+  uint8_t subframe; //!< subframe number
+  uint8_t slotNum; //!< slot number
+  uint8_t symStart; //!< index of the starting symbol
+  uint8_t numSym; //!< nummber of allocated symbols
+  uint8_t mcs; //!< the MCS for transport block
+  uint16_t tbSize; //!< the TB size in bytes
+  uint16_t txRnti; //!< the RNTI which identifies the sender
+  uint16_t rxRnti; //!< the RNTI which identifies the destination
+};
+
+/**
+ * \brief Fixed-size history of the CQI reports received from a peer device.
+ *        The reports are stored in a ring buffer, hence the newest report
+ *        overwrites the oldest one once the history is full and the memory
+ *        footprint does not grow with the simulation duration.
+ */
+class SlCqiHistory
+{
+public:
+  /// structure representing a single CQI report
+  struct CqiReport
+  {
+    int cqi; //!< the reported CQI
+    Time timestamp; //!< the time at which the report was generated
+  };
+
+  /**
+   * \brief Class constructor
+   * \param size maximum number of reports stored in the history
+   */
+  SlCqiHistory (uint32_t size);
+
+  /**
+   * \brief Add a new report, overwriting the oldest one if the history is full
+   * \param cqi the reported CQI
+   * \param timestamp the time at which the report was generated
+   */
+  void Add (int cqi, Time timestamp);
+
+  /**
+   * \brief Remove the reports generated before the specified time
+   * \param oldest the generation time of the oldest report to keep
+   */
+  void RemoveOlderThan (Time oldest);
+
+  /**
+   * \brief Return the number of reports currently stored
+   * \return the number of reports
+   */
+  uint32_t GetSize () const;
+
+  /**
+   * \brief Return the i-th report, where 0 is the oldest one
+   * \param i the index of the report
+   * \return the report
+   */
+  const CqiReport& Get (uint32_t i) const;
+
+  /**
+   * \brief Return the CQI of the most recent report
+   * \return the CQI
+   */
+  int GetLast () const;
+
+  /**
+   * \brief Return the exponentially weighted moving average of the reports,
+   *        computed from the oldest to the newest one
+   * \param alpha the weight of the newer report
+   * \return the average CQI, rounded down
+   */
+  int GetEwma (double alpha) const;
+
+  /**
+   * \brief Return the minimum CQI of the reports
+   * \return the CQI
+   */
+  int GetMin () const;
+
+private:
+  std::vector<CqiReport> m_reports; //!< ring buffer containing the reports
+  uint32_t m_head; //!< index of the oldest report
+  uint32_t m_count; //!< number of reports currently stored
+};
+
+class MmWaveSidelinkMac : public Object
+{
+
+  friend class MacSidelinkMemberPhySapUser;
+  friend class RlcSidelinkMemberMacSapProvider;
+
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  /// the method used to aggregate the CQI history into a single value
+  enum CqiAggregationType
+  {
+    LAST_CQI, //!< use the most recent report
+    EWMA_CQI, //!< exponentially weighted moving average of the reports
+    MIN_CQI //!< minimum CQI in the history window
+  };
+
+  /**
+   * \brief Delete default constructor to avoid misuse
+   */
+  MmWaveSidelinkMac (void) = delete;
+
+  /**
+   * \brief Class constructor
+   * \param pmc pointer to the mmwave::MmWavePhyMacCommon instance which specifies the
+   *        PHY/MAC parameters
+   */
+  MmWaveSidelinkMac (Ptr<mmwave::MmWavePhyMacCommon> pmc);
+
+  /**
+   * \brief Class destructor
+   */
+  ~MmWaveSidelinkMac (void);
+
+  /**
+   * \brief Destructor implementation
+   */
+  virtual void DoDispose (void);
+
+  /**
+  * \brief trigger the start of a new slot with all the necessary information
+  * \param timingInfo the structure containing the timing information
+  */
+  void DoSlotIndication (mmwave::SfnSf timingInfo);
+
+  /**
+  * \brief Get the PHY SAP user
+  * \return a pointer to the SAP user
+  */
+  MmWaveSidelinkPhySapUser* GetPhySapUser () const;
+
+  /**
+  * \brief Set the PHY SAP provider
+  * \param sap the PHY SAP provider
+  */
+  void SetPhySapProvider (MmWaveSidelinkPhySapProvider* sap);
+
+  /**
+  * \brief return the MAC SAP provider
+  * \return the MacSapProvider
+  */
+  LteMacSapProvider* GetMacSapProvider () const;
+
+  /**
+  * \brief assign a proper value to the RNTI associated to a specific user
+  * \param rnti value of the rnti
+  */
+  void SetRnti (uint16_t rnti);
+
+  /**
+  * \brief return the RNTI associated to a specific user
+  * \return the RNTI
+  */
+  uint16_t GetRnti () const;
+
+  /**
+  * \brief set the subframe allocation pattern
+  * \param pattern the allocation pattern. The number of elements must be a
+  *        multiple of the number of slots per subframe, the pattern is repeated
+  *        every pattern.size () slots. Each element represents the RNTI of the
+  *        device scheduled in the corresponding slot.
+  */
+  void SetSfAllocationInfo (std::vector<uint16_t> pattern);
+
+  /**
+  * \brief Transmit PDU function
+  */
+  void DoTransmitPdu (LteMacSapProvider::TransmitPduParameters params);
+
+  /**
+   * \brief set the callback used to forward data packets up to the NetDevice
+   * \param cb the callback
+   */
+  void SetForwardUpCallback (Callback <void, Ptr<Packet> > cb);
+
+  /**
+   * TracedCallback signature for SL scheduling
+   *
+   * \param params the struct SlSchedulingCallback containing the scheduling info
+   */
+  typedef void (* SlSchedulingTracedCallback) (SlSchedulingCallback params);
+
+  /**
+   * \brief Set the scheduler used to allocate the resources among the active
+   *        logical channels
+   * \param scheduler the scheduler
+   */
+  void SetScheduler (Ptr<MmWaveSidelinkScheduler> scheduler);
+
+  /**
+   * \brief Get the scheduler used to allocate the resources among the active
+   *        logical channels
+   * \return the scheduler
+   */
+  Ptr<MmWaveSidelinkScheduler> GetScheduler () const;
+
+  /**
+   * Associate a MAC SAP user instance to the LCID and add it in the map
+   * \param lcid Logical Channel ID
+   * \param macSapUser LteMacSapUser to be associated to a single LCID and added to the respective map
+   * \param bearer the QoS of the bearer of the logical channel, whose packet
+   *        delay budget is passed to the scheduler
+   */
+  void AddMacSapUser (uint8_t lcid, LteMacSapUser* macSapUser, const EpsBearer& bearer);
+
+  /**
+   * Remove the MAC SAP user associated to the LCID, together with the
+   * pending buffer status report, the queued PDUs and the scheduler state
+   * of the logical channel
+   * \param lcid Logical Channel ID
+   */
+  void RemoveMacSapUser (uint8_t lcid);
+
+  /**
+   * Remove the state kept for another device, i.e., the PDUs queued for
+   * it and the history of the CQIs it reported, e.g., when the device
+   * leaves the group. Nothing is done if the rnti is unknown.
+   * \param rnti the RNTI of the other device
+   */
+  void RemoveDevice (uint16_t rnti);
+
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by this model, i.e., the one selecting the reserved slot of the
+   * sensing-based reservation. Return the number of streams (possibly zero)
+   * that have been assigned.
+   *
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned by this model
+   */
+  int64_t AssignStreams (int64_t stream);
+
+private:
+  // forwarded from PHY SAP
+ /**
+  * Receive PHY PDU function
+  * \param p the packet
+  */
+  void DoReceivePhyPdu (Ptr<Packet> p);
+
+  /**
+  * \brief Based on the SINR reported, the CQI is evaluated and pushed to the
+           CQIs history with the latest SINR information
+  * \params sinr SpectrumValue instance representing the SINR measured on all
+            the spectrum chunks
+  * \params rnti RNTI of the transmitting device
+  * \params numSym size of the transport block that generated the report in
+            number of OFDM symbols
+  * \params tbSize size of the transport block that generated the report in bytes
+  */
+  void DoSlSinrReport (const SpectrumValue& sinr, uint16_t rnti, uint8_t numSym, uint32_t tbSize);
+
+  /**
+  * \brief Stores the information about a sidelink transmission sensed in the
+  *        current slot, used by the sensing based resource allocation
+  * \params rnti RNTI of the transmitting device, 0 if the device is unknown
+  * \params rxPower the received power in dBm
+  */
+  void DoSlSensingReport (uint16_t rnti, double rxPower);
+
+  /**
+  * \brief Updates the slot reservation based on the sensing information
+  *        collected in the last reservation period and configures the
+  *        reception in the slots reserved by the other devices
+  */
+  void UpdateReservation ();
+
+  /**
+  * \brief Implements RlcSidelinkMemberMacSapProvider::ReportBufferStatus,
+  *        reports the RLC buffer status to the MAC
+  * \param params the buffer status report
+  */
+  void DoReportBufferStatus (LteMacSapProvider::ReportBufferStatusParameters params);
+
+  /////////////////////////////////////////////////////////////////////////////
+
+  /**
+  * \brief Evaluate the MCS of the link towards a specific device
+  * \params rnti the RNTI that identifies the device we want to communicate with
+  */
+  uint8_t GetMcs (uint16_t rnti);
+
+  /**
+  * \brief Aggregate the CQI history of the link towards a specific device,
+  *        discarding the reports older than m_cqiMaxAge
+  * \params rnti the RNTI that identifies the device we want to communicate with
+  * \params cqi the aggregated CQI will be stored in this variable
+  * \returns false if no valid report is available, true otherwise
+  */
+  bool GetAggregatedCqi (uint16_t rnti, int& cqi);
+
+  /**
+  * \brief Decides how to allocate the available resources to the active
+  *        logical channels
+  * \params timingInfo the SfnSf object containing the frame, subframe and slot
+  *         index
+  * \returns SlotAllocInfo object containing the scheduling information
+  */
+  mmwave::SlotAllocInfo ScheduleResources (mmwave::SfnSf timingInfo);
+
+  /**
+  * \brief Updates the BSR corresponding to the specified LC by subtracting the
+  *        assigned grant
+  * \params lcid the logical channel ID
+  * \params assignedBytes the assigned grant in bytes
+  * \returns updated iterator to the Buffer Status Report map
+  */
+  std::map<uint8_t, LteMacSapProvider::ReportBufferStatusParameters>::iterator UpdateBufferStatusReport (uint8_t lcid, uint32_t assignedBytes);
+
+  MmWaveSidelinkPhySapUser* m_phySapUser; //!< Sidelink PHY SAP user
+  MmWaveSidelinkPhySapProvider* m_phySapProvider; //!< Sidelink PHY SAP provider
+  LteMacSapProvider* m_macSapProvider; //!< Sidelink MAC SAP provider
+  std::map<uint8_t, LteMacSapUser*> m_lcidToMacSap; //!< map that associates to an LCID the respective MAC SAP
+  Ptr<mmwave::MmWavePhyMacCommon> m_phyMacConfig; //!< PHY and MAC configuration pointer
+  Ptr<mmwave::MmWaveAmc> m_amc; //!< pointer to AMC instance
+  Ptr<MmWaveSidelinkScheduler> m_scheduler; //!< pointer to the scheduler instance
+  uint64_t m_slotCounter; //!< number of slots since the start of the device
+  bool m_useAmc; //!< set to true to use adaptive modulation and coding
+  uint8_t m_mcs; //!< the MCS used to transmit the packets if AMC is not used
+  uint16_t m_rnti; //!< radio network temporary identifier
+  std::vector<uint16_t> m_sfAllocInfo; //!< defines the subframe allocation, m_sfAllocInfo[i] = RNTI of the device scheduled for slot i
+  std::map<uint16_t, std::list<LteMacSapProvider::TransmitPduParameters>> m_txBufferMap; //!< map containing the <RNTI, tx buffer> pairs
+  std::map<uint16_t, SlCqiHistory> m_slCqiReported; //!< map containing the <RNTI, CQI history> pairs
+  uint32_t m_cqiHistorySize; //!< maximum number of CQI reports stored for each device
+  CqiAggregationType m_cqiAggregation; //!< the method used to aggregate the CQI history
+  double m_cqiEwmaAlpha; //!< weight of the newest report in the EWMA
+  Time m_cqiMaxAge; //!< reports older than this are discarded, zero means never
+
+  /// structure containing the strongest transmission sensed in a slot
+  struct SlSensingInfo
+  {
+    uint16_t rnti; //!< the RNTI of the transmitting device
+    double rxPower; //!< the received power in dBm
+    Time timestamp; //!< the time at which the transmission was sensed
+  };
+
+  bool m_sensingBasedAllocation; //!< set to true to select the slots using the sensing based allocation
+  uint32_t m_reservationPeriod; //!< the reservation period in number of subframes
+  uint32_t m_reservationDuration; //!< the number of reservation periods before the reselection
+  double m_sensingThreshold; //!< slots sensed with a received power above this threshold (in dBm) are considered busy
+  uint32_t m_reservationCounter; //!< number of reservation periods before the next reselection
+  uint32_t m_reservedSlot; //!< index of the reserved slot in the reservation period
+  std::vector<SlSensingInfo> m_sensingInfo; //!< sensing information for each slot of the reservation period
+  Ptr<UniformRandomVariable> m_uniformRv; //!< random variable used to select the reserved slot
+  Callback<void, Ptr<Packet> > m_forwardUpCallback; //!< upward callback to the NetDevice
+  std::map<uint8_t, LteMacSapProvider::ReportBufferStatusParameters> m_bufferStatusReportMap; //!< map containing the <LCID, buffer status in bits> pairs
+  std::map<uint8_t, Time> m_bufferStatusReportTime; //!< map containing the <LCID, time of the last buffer status report> pairs
+  std::map<uint8_t, Time> m_lcidToDelayBudget; //!< map containing the <LCID, packet delay budget of the bearer> pairs
+
+  // trace sources
+  TracedCallback<SlSchedulingCallback> m_schedulingTrace; //!< trace source returning information regarding the scheduling
+};
+
+class MacSidelinkMemberPhySapUser : public MmWaveSidelinkPhySapUser
+{
+
+public:
+  MacSidelinkMemberPhySapUser (Ptr<MmWaveSidelinkMac> mac);
+
+  void ReceivePhyPdu (Ptr<Packet> p) override;
+
+  void SlotIndication (mmwave::SfnSf timingInfo) override;
+
+  void SlSinrReport (const SpectrumValue& sinr, uint16_t rnti, uint8_t numSym, uint32_t tbSize) override;
+
+  void SlSensingReport (uint16_t rnti, double rxPower) override;
+
+private:
+  Ptr<MmWaveSidelinkMac> m_mac;
+
+};
+
+class RlcSidelinkMemberMacSapProvider : public LteMacSapProvider
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param mac the MAC class
+   */
+  RlcSidelinkMemberMacSapProvider (Ptr<MmWaveSidelinkMac> mac);
+
+  // inherited from LteMacSapProvider
+  virtual void TransmitPdu (TransmitPduParameters params);
+  virtual void ReportBufferStatus (ReportBufferStatusParameters params);
+
+private:
+  Ptr<MmWaveSidelinkMac> m_mac; ///< the MAC class
+};
+
+} // mmwave namespace
+
+} // ns3 namespace
+
+#endif /* SRC_MMWAVE_MODEL_MMWAVE_SIDELINK_MAC_H_ */
@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef SRC_MILLICAR_MODEL_MMWAVE_SIDELINK_SPECTRUM_CHANNEL_H_
+#define SRC_MILLICAR_MODEL_MMWAVE_SIDELINK_SPECTRUM_CHANNEL_H_
+
+#include "ns3/spectrum-channel.h"
+#include "ns3/spectrum-model.h"
+#include <vector>
+
+namespace ns3 {
+
+namespace millicar {
+
+/**
+ * \ingroup millicar
+ *
+ * \brief SpectrumChannel used by the sidelink devices
+ *
+ * Like the SingleModelSpectrumChannel, all the attached SpectrumPhy instances
+ * must use the same SpectrumModel. Differently from it, the receivers of a
+ * transmission are processed as a batch: the propagation and antenna gains
+ * are computed for all of them before the frequency-selective loss is applied
+ * to the ones that are in range. A single event per propagation delay value
+ * and receiving node delivers the signal to the receivers of that node, in
+ * its context.
+ */
+class MmWaveSidelinkSpectrumChannel : public SpectrumChannel
+{
+public:
+  MmWaveSidelinkSpectrumChannel ();
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  // inherited from SpectrumChannel
+  virtual void AddRx (Ptr<SpectrumPhy> phy);
+  virtual void StartTx (Ptr<SpectrumSignalParameters> params);
+
+  // inherited from Channel
+  virtual std::size_t GetNDevices (void) const;
+  virtual Ptr<NetDevice> GetDevice (std::size_t i) const;
+
+  /// Container: SpectrumPhy objects
+  typedef std::vector<Ptr<SpectrumPhy> > PhyList;
+
+  /// a reception, i.e., the signal received by a SpectrumPhy
+  struct Reception
+  {
+    Ptr<SpectrumSignalParameters> m_params; //!< the received signal
+    Ptr<SpectrumPhy> m_receiver; //!< the receiving SpectrumPhy
+    uint32_t m_node; //!< the context of the receiving node
+  };
+
+  /// Container: receptions delivered by the same event
+  typedef std::vector<Reception> ReceptionList;
+
+private:
+  virtual void DoDispose ();
+
+  /// a reception waiting to be scheduled
+  struct PendingReception
+  {
+    Time m_delay; //!< the propagation delay
+    Reception m_reception; //!< the reception
+  };
+
+  /**
+   * Orders the receptions by propagation delay and receiving node
+   * \param a the first reception
+   * \param b the second reception
+   * \return true if a is delivered before b, or by the same event of a
+   *         lower node
+   */
+  static bool CompareDelayAndNode (const PendingReception &a, const PendingReception &b);
+
+  /**
+   * Delivers the signal to all the receivers of a node which share the same
+   * propagation delay
+   * \param receptions the list of receptions, in the order in which the
+   *        receivers were attached to the channel
+   */
+  void StartRx (ReceptionList receptions);
+
+  PhyList m_phyList; //!< list of SpectrumPhy instances attached to the channel
+  Ptr<const SpectrumModel> m_spectrumModel; //!< SpectrumModel that this channel instance is supporting
+
+  std::vector<Ptr<SpectrumPhy> > m_rxPhys; //!< receivers in range of the current transmission, reused across transmissions
+  std::vector<double> m_pathLossDb; //!< pathloss of the receivers of the current transmission, reused across transmissions
+  std::vector<PendingReception> m_pending; //!< receptions of the current transmission, reused across transmissions
+};
+
+} // namespace millicar
+
+} // namespace ns3
+
+#endif /* SRC_MILLICAR_MODEL_MMWAVE_SIDELINK_SPECTRUM_CHANNEL_H_ */
@@ -0,0 +1,181 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2015, NYU WIRELESS, Tandon School of Engineering, New York
+*   University
+*   Copyright (c) 2020, University of Padova, Dep. of Information Engineering,
+*   SIGNET lab
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#ifndef MMWAVE_VEHICULAR_ANTENNA_ARRAY_MODEL_H_
+#define MMWAVE_VEHICULAR_ANTENNA_ARRAY_MODEL_H_
+#include <ns3/antenna-model.h>
+#include <complex>
+#include <ns3/net-device.h>
+#include <map>
+#include <vector>
+#include <ns3/nstime.h>
+#include <ns3/node.h>
+#include <ns3/mobility-model.h>
+
+namespace ns3 {
+
+namespace millicar {
+
+typedef std::vector< std::complex<double> > complexVector_t;
+
+class MmWaveVehicularAntennaArrayModel : public AntennaModel
+{
+public:
+  MmWaveVehicularAntennaArrayModel ();
+  virtual ~MmWaveVehicularAntennaArrayModel ();
+  static TypeId GetTypeId ();
+  virtual double GetGainDb (Angles a);
+
+  // to store dummy info
+  void SetBeamformingVectorPanel (complexVector_t antennaWeights, Ptr<NetDevice> device = 0);
+  void SetBeamformingVectorWithDelay (complexVector_t antennaWeights, Ptr<NetDevice> device = 0);
+
+  void SetBeamformingVectorPanelDevices (Ptr<NetDevice> thisDevice = 0, Ptr<NetDevice> otherDevice = 0);
+  void ChangeBeamformingVectorPanel (Ptr<NetDevice> device);
+  complexVector_t GetBeamformingVectorPanel ();
+  complexVector_t GetBeamformingVectorPanel (Ptr<NetDevice> device);
+
+  void ChangeToOmniTx ();
+  bool IsOmniTx ();
+  /**
+   * Returns the field pattern of an antenna element in the given direction.
+   * The conversion of the attenuation from dB to linear scale is
+   * interpolated from a lookup table, with a relative error bounded by
+   * GetRadiationPatternMaxError
+   * \param vangle the vertical angle in radians, in [0, pi]
+   * \param hangle the horizontal angle in radians
+   * \return the field pattern in linear scale
+   */
+  double GetRadiationPattern (double vangle, double hangle = 0);
+
+  /**
+   * Returns the field pattern of an antenna element in the given direction,
+   * computed without the lookup table
+   * \param vangle the vertical angle in radians, in [0, pi]
+   * \param hangle the horizontal angle in radians
+   * \return the field pattern in linear scale
+   */
+  double ComputeRadiationPattern (double vangle, double hangle = 0);
+
+  /**
+   * Returns the maximum relative error of GetRadiationPattern with respect
+   * to ComputeRadiationPattern
+   * \return the maximum relative error
+   */
+  static double GetRadiationPatternMaxError ();
+
+  Vector GetAntennaLocation (uint16_t index, uint16_t* antennaNum);
+
+  /**
+   * Returns the location of all the antenna elements, computed once for
+   * each geometry of the array
+   * \return the vector of the locations, indexed by element
+   */
+  const std::vector<Vector>& GetAntennaLocations ();
+
+  /**
+   * Returns the number of antenna elements in each row, i.e., along the
+   * horizontal direction
+   * \return the number of columns of the array
+   */
+  uint16_t GetAntennaColumns () const;
+
+  /**
+   * Returns the number of rows of antenna elements, i.e., the number of
+   * elements along the vertical direction
+   * \return the number of rows of the array
+   */
+  uint16_t GetAntennaRows () const;
+  void SetSector (uint8_t sector, uint16_t *antennaNum, double elevation = 90);
+
+  void SetPlanesNumber (uint8_t planesNumber);
+  double GetPlanesId (void);
+  void SetDeviceType (bool isUe);
+  void SetTotNoArrayElements (uint64_t arrayElements);
+  uint64_t GetTotNoArrayElements () const;
+  double GetOffset ();
+
+  Ptr<NetDevice> GetCurrentDevice ();
+  Time GetLastUpdate (Ptr<NetDevice> device);
+
+private:
+  /**
+   * Returns the attenuation of an antenna element with respect to its
+   * maximum directivity
+   * \param vAngleRadian the vertical angle in radians
+   * \param hAngleRadian the horizontal angle in radians
+   * \return the attenuation in dB, in [0, front-back ratio]
+   */
+  double GetElementAttenuationDb (double vAngleRadian, double hAngleRadian);
+
+  /**
+   * Sets the front-back ratio and the side-lobe level of the element
+   * pattern and fills the table of the field pattern, for the current
+   * element pattern and maximum directivity
+   */
+  void InitRadiationPattern ();
+
+  bool m_omniTx;
+  // double m_minAngle;
+  // double m_maxAngle;
+  complexVector_t m_beamformingVector;
+  int m_currentPanelId;
+  // std::map<Ptr<NetDevice>, complexVector_t> m_beamformingVectorMap;
+  std::map<Ptr<NetDevice>, std::pair<complexVector_t,int> > m_beamformingVectorPanelMap;
+
+  double m_disV;       //antenna spacing in the vertical direction in terms of wave length.
+  double m_disH;       //antenna spacing in the horizontal direction in terms of wave length.
+
+  uint8_t m_noPlane;
+  bool m_isUe;
+  uint64_t m_totNoArrayElements;
+  double m_hpbw;
+  double m_gMax;
+
+  Ptr<NetDevice> m_currentDev;
+
+  std::map<Ptr<NetDevice>, Time> m_lastUpdateMap;
+  std::map<Ptr<NetDevice>, Time> m_lastUpdatePairMap;
+
+  bool m_isotropicElement;
+
+  std::string m_antennaElementPattern; // configuration of antenna parameters based on different 3GPP technical reports (38.901, 37.885)
+
+  uint16_t m_antennaColumns; //!< the number of elements in each row, 0 for a square array
+  double m_frontBackRatio; //!< the front-back ratio of the element pattern in dB
+  double m_sideLobeLevel; //!< the side-lobe level limit of the element pattern in dB
+  std::vector<double> m_patternTable; //!< the field pattern sampled with a fixed step of attenuation
+  std::string m_patternTablePattern; //!< the element pattern m_patternTable was computed for
+  double m_patternTableGMax; //!< the maximum directivity m_patternTable was computed for
+
+  std::vector<Vector> m_locations; //!< the location of each element
+  uint64_t m_locationsElements; //!< the number of elements m_locations was computed for
+  uint16_t m_locationsColumns; //!< the number of columns m_locations was computed for
+  double m_locationsDisH; //!< the horizontal spacing m_locations was computed for
+  double m_locationsDisV; //!< the vertical spacing m_locations was computed for
+};
+
+} /* namespace millicar */
+
+} /* namespace ns3 */
+
+#endif /* MMWAVE_VEHICULAR_ANTENNA_ARRAY_MODEL_H_ */
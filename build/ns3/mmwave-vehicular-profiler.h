@@ -0,0 +1,170 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef SRC_MILLICAR_MODEL_MMWAVE_VEHICULAR_PROFILER_H_
+#define SRC_MILLICAR_MODEL_MMWAVE_VEHICULAR_PROFILER_H_
+
+#include <stdint.h>
+#include <chrono>
+#include <ostream>
+#include <string>
+
+namespace ns3 {
+
+namespace millicar {
+
+/**
+ * \ingroup millicar
+ *
+ * \brief Collects the number of calls and the wall clock time spent in the
+ * hot paths of the channel, PHY, MAC and RLC models
+ *
+ * The sections are timed by the MILLICAR_PROFILE_SCOPE macro, which expands
+ * to nothing unless ns-3 is configured with --enable-millicar-profiling.
+ * The statistics can be queried at any time during the simulation; when the
+ * simulation is destroyed a summary table is printed to std::clog and the
+ * statistics are reset.
+ */
+class MmWaveVehicularProfiler
+{
+public:
+  /// the profiled sections
+  enum Section
+  {
+    CALC_RX_PSD = 0, //!< MmWaveVehicularSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity
+    GET_NEW_CHANNEL, //!< MmWaveVehicularSpectrumPropagationLossModel::GetNewChannel
+    UPDATE_CHANNEL, //!< MmWaveVehicularSpectrumPropagationLossModel::UpdateChannel
+    CAL_LONG_TERM, //!< MmWaveVehicularSpectrumPropagationLossModel::CalLongTerm
+    CAL_BEAMFORMING_GAIN, //!< MmWaveVehicularSpectrumPropagationLossModel::CalBeamformingGain
+    GET_LOSS, //!< MmWaveVehicularPropagationLossModel::GetLoss
+    START_RX_DATA, //!< MmWaveSidelinkSpectrumPhy::StartRxData
+    END_RX_DATA, //!< MmWaveSidelinkSpectrumPhy::EndRxData
+    MAC_SCHEDULER, //!< MmWaveSidelinkMac::ScheduleResources
+    RLC_TX_SDU, //!< PDCP and RLC processing of a packet sent by MmWaveVehicularNetDevice::Send
+    RLC_TX_OPPORTUNITY, //!< RLC processing of a transmission opportunity, nested in MAC_SCHEDULER
+    NUM_SECTIONS //!< the number of sections, not a section
+  };
+
+  /// the statistics collected for a section
+  struct Stats
+  {
+    uint64_t m_calls; //!< the number of calls
+    uint64_t m_totalNs; //!< the total time spent in the section, in ns
+    uint64_t m_maxNs; //!< the longest call, in ns
+  };
+
+  /**
+   * Returns true if the sections are instrumented, i.e., if ns-3 was
+   * configured with --enable-millicar-profiling
+   * \return true if the profiling is enabled
+   */
+  static bool IsEnabled ();
+
+  /**
+   * Records a call of a section
+   * \param section the section
+   * \param durationNs the duration of the call in ns
+   */
+  static void Record (Section section, uint64_t durationNs);
+
+  /**
+   * Returns the statistics collected for a section since the beginning of
+   * the simulation
+   * \param section the section
+   * \return the statistics
+   */
+  static Stats GetStats (Section section);
+
+  /**
+   * Returns the name of a section
+   * \param section the section
+   * \return the name
+   */
+  static std::string GetSectionName (Section section);
+
+  /**
+   * Resets the statistics of all the sections
+   */
+  static void Reset ();
+
+  /**
+   * Prints a table with the statistics of all the sections
+   * \param os the output stream
+   */
+  static void Print (std::ostream& os);
+
+private:
+  /**
+   * Prints the summary table and resets the statistics, called when the
+   * simulation is destroyed
+   */
+  static void DoDestroy ();
+};
+
+/**
+ * \ingroup millicar
+ *
+ * \brief Records the time between its construction and its destruction as a
+ * call of a section
+ */
+class MmWaveVehicularScopedTimer
+{
+public:
+  /**
+   * Starts the timer
+   * \param section the timed section
+   */
+  MmWaveVehicularScopedTimer (MmWaveVehicularProfiler::Section section)
+    : m_section (section),
+      m_start (std::chrono::steady_clock::now ())
+  {
+  }
+
+  /**
+   * Stops the timer and records the call
+   */
+  ~MmWaveVehicularScopedTimer ()
+  {
+    std::chrono::steady_clock::duration duration = std::chrono::steady_clock::now () - m_start;
+    MmWaveVehicularProfiler::Record (m_section, std::chrono::duration_cast<std::chrono::nanoseconds> (duration).count ());
+  }
+
+private:
+  MmWaveVehicularProfiler::Section m_section; //!< the timed section
+  std::chrono::steady_clock::time_point m_start; //!< the time the timer was started
+};
+
+} // namespace millicar
+
+} // namespace ns3
+
+/**
+ * \ingroup millicar
+ * Times the enclosing scope as a call of the given MmWaveVehicularProfiler
+ * section, if ns-3 was configured with --enable-millicar-profiling
+ * \param section the name of the section, e.g., GET_LOSS
+ */
+#ifdef NS3_MILLICAR_PROFILING
+#define MILLICAR_PROFILE_SCOPE(section) \
+  ns3::millicar::MmWaveVehicularScopedTimer millicarProfileScope (ns3::millicar::MmWaveVehicularProfiler::section)
+#else
+#define MILLICAR_PROFILE_SCOPE(section)
+#endif
+
+#endif /* SRC_MILLICAR_MODEL_MMWAVE_VEHICULAR_PROFILER_H_ */
@@ -0,0 +1,205 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2011 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+*   Copyright (c) 2015, NYU WIRELESS, Tandon School of Engineering, New York
+*   University
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+    Copyright (c) 2021 Telecommunication Networks (TKN), TU Berlin
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+*/
+
+#ifndef MMWAVE_VEHICULAR_PROPAGATION_LOSS_MODEL_H_
+#define MMWAVE_VEHICULAR_PROPAGATION_LOSS_MODEL_H_
+
+#include "ns3/propagation-loss-model.h"
+#include "ns3/object.h"
+#include "ns3/random-variable-stream.h"
+#include <ns3/vector.h>
+#include <ns3/mmwave-phy-mac-common.h>
+#include <ns3/rain-snow-attenuation.h>
+#include <ns3/rain-attenuation.h>
+#include <ns3/nstime.h>
+#include <map>
+#include <unordered_map>
+
+/*
+ * This propagation loss model for vehicular communications has been implemented based on the 3GPP TR 37.885 v15.2.0 (2019-01).
+ *
+ * 3rd Generation Partnership Project;
+ * Technical Specification Group Radio Access Network;
+ * (Release 14)
+ *
+ * */
+
+namespace ns3 {
+
+namespace millicar {
+
+class RainAttenuation;
+class RainSnowAttenuation;
+
+struct channelCondition
+{
+  char m_channelCondition;
+  double m_shadowing;
+  Vector m_position;
+};
+
+// map store the path loss scenario(LOS,NLOS,OUTAGE) of each propagation channel
+typedef std::map< std::pair< Ptr<MobilityModel>, Ptr<MobilityModel> >, channelCondition> channelConditionMap_t;
+
+class MmWaveVehicularPropagationLossModel : public PropagationLossModel
+{
+  public:
+
+    static TypeId GetTypeId (void);
+    MmWaveVehicularPropagationLossModel ();
+
+    /**
+     * \param minLoss the minimum loss (dB)
+     *
+     * no matter how short the distance, the total propagation loss (in
+     * dB) will always be greater or equal than this value
+     */
+    void SetMinLoss (double minLoss);
+
+    /**
+     * \return the minimum loss.
+     */
+    double GetMinLoss (void) const;
+
+    /**
+     * \param freq the operating frequency (Hz)
+     */
+    void SetFrequency (double freq);
+
+    /**
+     * \returns the current frequency (Hz)
+     */
+    double GetFrequency (void) const;
+
+    /**
+     * \returns the attenuation from the weather conditions
+     */
+    double GetWeatherAttenuation (double distance3D, double hA, double hB) const;
+
+    /**
+     * Drops the weather attenuation models and the cached losses, so that
+     * the models are created again with the current default attribute
+     * values, e.g., after changing the weather in a branch of a
+     * SimulationFork
+     */
+    void ResetWeatherAttenuation (void);
+
+    char GetChannelCondition (Ptr<MobilityModel> a, Ptr<MobilityModel> b);
+
+    std::string GetScenario ();
+
+    double GetLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+
+  private:
+
+    MmWaveVehicularPropagationLossModel (const MmWaveVehicularPropagationLossModel &o);
+    MmWaveVehicularPropagationLossModel & operator = (const MmWaveVehicularPropagationLossModel &o);
+
+    virtual double DoCalcRxPower (double txPowerDbm,
+                                  Ptr<MobilityModel> a,
+                                  Ptr<MobilityModel> b) const;
+    virtual int64_t DoAssignStreams (int64_t stream);
+    void UpdateConditionMap (Ptr<MobilityModel> a, Ptr<MobilityModel> b, channelCondition cond) const;
+
+    /**
+     * \param distance3D: the 3D distance between tx and rx
+     * \param hA: the height of device A
+     * \param hB: the height of device B
+     *
+     * \returns the additional NLOSv loss
+     */
+    double GetAdditionalNlosVLoss (double distance3D, double hA, double hB) const;
+
+    /**
+     * \param a the mobility model of device A
+     * \param b the mobility model of device B
+     *
+     * \returns the loss between the two devices, without using the cache
+     */
+    double ComputeLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+
+    /**
+     * Remove the entries of the loss cache older than the maximum age,
+     * e.g., the ones of the devices which were removed
+     */
+    void PurgeLossCache (void) const;
+
+    /**
+     * Loss of a link, computed with the devices in the stored positions
+     */
+    struct LossCacheEntry
+    {
+      Vector m_firstPosition; //!< position of the first device of the link
+      Vector m_secondPosition; //!< position of the second device of the link
+      double m_lossDb; //!< the loss in dB
+      Time m_time; //!< the time of the computation of the loss
+    };
+
+    /**
+     * The mobility models of the devices of a link, without holding a
+     * reference to them
+     */
+    typedef std::pair<const MobilityModel *, const MobilityModel *> LossCacheKey;
+
+    /**
+     * Hash function of a LossCacheKey
+     */
+    struct LossCacheKeyHash
+    {
+      /**
+       * \param key the key
+       * \returns the hash of the key
+       */
+      std::size_t operator () (const LossCacheKey &key) const
+      {
+        return std::hash<const MobilityModel *> () (key.first) * 31 + std::hash<const MobilityModel *> () (key.second);
+      }
+    };
+
+    double m_frequency;
+    double m_lambda;
+    double m_minLoss;
+    mutable channelConditionMap_t m_channelConditionMap;
+    std::string m_channelConditions;
+    std::string m_scenario;;
+    bool m_optionNlosEnabled;
+    Ptr<NormalRandomVariable> m_norVar;
+    Ptr<LogNormalRandomVariable> m_logNorVar;
+    Ptr<UniformRandomVariable> m_uniformVar;
+    bool m_shadowingEnabled = true;
+    double m_percType3Vehicles = 30;
+    bool m_snowEnabled = false;
+    mutable Ptr<RainAttenuation> m_rainAttenuation; //!< the rain attenuation model
+    mutable Ptr<RainSnowAttenuation> m_snowAttenuation; //!< the combined rain and wet snow attenuation model
+    double m_cacheThreshold; //!< movement (m) after which the cached loss of a link is recomputed, negative to disable the cache
+    Time m_cacheMaxAge; //!< age after which the cached loss of a link is recomputed and eventually removed
+    mutable Time m_lastCachePurge; //!< the time of the last removal of the old entries of the cache
+    mutable std::unordered_map<LossCacheKey, LossCacheEntry, LossCacheKeyHash> m_lossCache; //!< the cached loss of each link
+};
+
+} // namespace millicar
+
+} // namespace ns3
+
+#endif
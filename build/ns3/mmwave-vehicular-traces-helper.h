@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef MMWAVE_VEHICULAR_TRACES_HELPER_H
+#define MMWAVE_VEHICULAR_TRACES_HELPER_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <ns3/object.h>
+#include <ns3/spectrum-value.h>
+
+namespace ns3 {
+
+namespace millicar {
+
+/**
+ * Class that manages the connection to a trace
+ * in MmWaveSidelinkSpectrumPhy and prints to a file
+ *
+ * The trace can be written as text, with one tab separated line per report,
+ * or in a binary format, which starts with a header and continues with
+ * fixed-size records:
+ * - header: the magic string "MCTR", the format version (uint16), the size
+ *   of a record in bytes (uint16), the RNG seed (uint32) and run (uint64)
+ *   of the simulation, the length of the schema (uint32) and the schema, a
+ *   comma separated list of name:type pairs describing the record fields
+ * - record: the time in ns (int64), the linear SINR averaged over the
+ *   spectrum chunks (float64), the TB size in bytes (uint32), the RNTI of the
+ *   transmitting device (uint16), the number of OFDM symbols (uint8) and
+ *   the MCS (uint8)
+ * All the values are little endian. The records are buffered in memory and
+ * written in blocks. The script vehicular-traces-to-csv.py in the examples
+ * converts a binary trace to CSV.
+ */
+class MmWaveVehicularTracesHelper : public Object
+{
+public:
+  /// the format of the trace file
+  enum TraceFormat
+  {
+    TEXT,
+    BINARY
+  };
+
+  /**
+   * Constructor for this class
+   * \param filename the name of the file
+   * \param format the format of the file
+   */
+  MmWaveVehicularTracesHelper(std::string filename, TraceFormat format = TEXT);
+
+  /**
+   * Destructor for this class
+   */
+  virtual ~MmWaveVehicularTracesHelper();
+
+  /**
+   * Method to be attached to the callback in the MmWaveSidelinkSpectrumPhy
+   * \param sinr pointer to the SpectrumValue instance representing the SINR
+            measured on all the spectrum chunks
+   * \param rnti the RNTI of the tranmitting device
+   * \param numSym size of the transport block that generated the report in
+            number of OFDM symbols
+   * \param tbSize size of the transport block that generated the report in bytes
+   * \param mcs the MCS of the transmission
+   */
+  void McsSinrCallback(const SpectrumValue& sinr, uint16_t rnti, uint8_t numSym, uint32_t tbSize, uint8_t mcs);
+
+  /**
+   * Writes the buffered records to the file
+   */
+  void Flush ();
+
+  /**
+   * Continues the trace in another file, e.g., in a branch of a
+   * SimulationFork. The buffered records are written to the current file,
+   * which is then closed. A binary file starts with a new header.
+   * \param filename the name of the new file
+   */
+  void SetFileName (std::string filename);
+
+protected:
+  // inherited from Object
+  virtual void DoDispose ();
+
+private:
+  /**
+   * Opens the file and writes the header of the binary format
+   */
+  void Open ();
+
+  /**
+   * Writes the header of the binary format
+   */
+  void WriteBinaryHeader ();
+
+  /**
+   * Appends an unsigned integer to the buffer of the binary records,
+   * in little endian byte order
+   * \param value the value
+   * \param size the number of bytes to append
+   */
+  void Append (uint64_t value, uint8_t size);
+
+  std::string m_filename; //!< filename for the output
+  std::ofstream m_outputFile; //!< output file
+  TraceFormat m_format; //!< the format of the output file
+  std::vector<uint8_t> m_buffer; //!< the binary records waiting to be written
+  bool m_flushScheduled; //!< true if the buffer will be flushed when the simulation is destroyed
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,276 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+#include "system-thread.h"
+#include "system-mutex.h"
+#include "nstime.h"
+
+#include "ptr.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <mutex>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * A shared-memory parallel simulator implementation.
+ *
+ * The events are partitioned by their execution context, i.e., the node
+ * given to Simulator::ScheduleWithContext, and each context has its own
+ * event queue, clock and event uids. The events without a context, e.g.,
+ * the ones scheduled before the simulation starts or Simulator::Stop,
+ * form a global partition which is executed serially.
+ *
+ * The simulation advances in conservative time windows: starting from the
+ * timestamp T of the earliest pending event, the partitions execute on a
+ * pool of worker threads all their events with timestamp lower than
+ * T + Lookahead, where Lookahead is the minimum delay of the events a
+ * partition schedules on another context. In a wireless scenario this is
+ * the minimum propagation delay of the SpectrumChannel, i.e., the minimum
+ * distance between two nodes divided by the speed of light. A window never
+ * crosses the timestamp of a global event, and an event scheduled on
+ * another context within the current window aborts the simulation.
+ *
+ * The events sent to another context are buffered and delivered at the end
+ * of the window in the order of the sending context, so that the execution
+ * does not depend on the number of threads or on their interleaving. As
+ * with DefaultSimulatorImpl, the events of a context with the same
+ * timestamp are executed in the order they were inserted.
+ *
+ * Within a window an event must only access the state of its own node:
+ * the models which share state among the nodes are not safe to use with
+ * this implementation. In the same way, Simulator::IsExpired,
+ * Simulator::Cancel and Simulator::Remove abort when an event checks or
+ * removes an event of another context, since the clock and the queue of
+ * the other context may be changed concurrently; the events without a
+ * context can be checked at any time, and all of them between the windows,
+ * e.g., by an event scheduled with Simulator::Schedule before the
+ * simulation starts. Simulator::Stop takes effect at the end of the
+ * current window.
+ *
+ * Since the spectrum channels share the propagation models, and their
+ * caches, among all the nodes, the MilliCar sidelink models, like the
+ * MmWaveSidelinkSpectrumChannel and the MmWaveVehicularPropagationLossModel,
+ * and the helpers which write a single trace file for all the nodes are not
+ * supported by this implementation.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  MultithreadedSimulatorImpl ();
+  /** Destructor. */
+  ~MultithreadedSimulatorImpl ();
+
+  // Inherited
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (const Time &delay);
+  virtual EventId Schedule (const Time &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+  virtual uint64_t GetEventCount (void) const;
+
+  /**
+   * Get the number of time windows executed so far.
+   * \return The number of windows.
+   */
+  uint64_t GetWindowCount (void) const;
+
+private:
+  virtual void DoDispose (void);
+
+  /** An event sent to another context, delivered at the end of the window. */
+  struct RemoteEvent
+  {
+    /** The destination context. */
+    uint32_t context;
+    /** The absolute event timestamp. */
+    uint64_t timestamp;
+    /** The event implementation. */
+    EventImpl *event;
+  };
+
+  /** The events and the clock of an execution context. */
+  struct Partition
+  {
+    /** The execution context. */
+    uint32_t context;
+    /** The event priority queue. */
+    Ptr<Scheduler> events;
+    /** Next event unique id. */
+    uint32_t uid;
+    /** Unique id of the current event. */
+    uint32_t currentUid;
+    /** Timestamp of the current event. */
+    uint64_t currentTs;
+    /** The event count. */
+    uint64_t eventCount;
+    /** Number of events that have been inserted but not yet scheduled. */
+    int unscheduledEvents;
+    /** The events sent to other contexts during the current window. */
+    std::vector<RemoteEvent> outbox;
+  };
+
+  /** Wrap an event scheduled by a thread external to the simulation. */
+  struct EventWithContext
+  {
+    /** The event context. */
+    uint32_t context;
+    /** Event timestamp, relative to the time of the merge. */
+    uint64_t timestamp;
+    /** The event implementation. */
+    EventImpl *event;
+  };
+
+  /**
+   * Get the partition of the event being executed by the calling thread.
+   * \return The current partition, or the global one outside the windows.
+   */
+  Partition * GetCurrentPartition (void) const;
+  /**
+   * Get the partition of a context.
+   * \param [in] context The execution context.
+   * \return The partition, or 0 if the context has no partition yet.
+   */
+  Partition * FindPartition (uint32_t context) const;
+  /**
+   * Get the partition of a context, creating it if needed.
+   * \param [in] context The execution context.
+   * \return The partition.
+   */
+  Partition * GetPartition (uint32_t context);
+  /**
+   * Insert an event in a partition.
+   * \param [in] partition The partition.
+   * \param [in] ts The absolute timestamp.
+   * \param [in] event The event implementation.
+   * \return The scheduler key of the event.
+   */
+  Scheduler::EventKey Insert (Partition *partition, uint64_t ts, EventImpl *event);
+  /** Deliver the events sent among the contexts and by external threads. */
+  void ProcessRemoteEvents (void);
+  /**
+   * Execute the events of a partition up to the end of the window.
+   * \param [in] partition The partition.
+   * \param [in] windowEnd The first timestamp not included in the window.
+   */
+  void ProcessPartition (Partition *partition, uint64_t windowEnd);
+  /** Execute the active partitions of the current window. */
+  void ProcessActivePartitions (void);
+  /** Body of the worker threads. */
+  void Worker (void);
+  /** Start the worker threads. */
+  void StartWorkers (void);
+  /** Stop and join the worker threads. */
+  void StopWorkers (void);
+
+  /** Container type for the partitions, sorted by context. */
+  typedef std::map<uint32_t, Partition *> Partitions;
+  /** The partitions, including the global one. */
+  Partitions m_partitions;
+  /** The partition of the events without a context. */
+  Partition *m_global;
+  /** The factory of the event queues. */
+  ObjectFactory m_schedulerFactory;
+
+  /** The events scheduled by threads external to the simulation. */
+  std::list<EventWithContext> m_eventsWithContext;
+  /** Flag \c true if there are no events from external threads. */
+  bool m_eventsWithContextEmpty;
+  /** Mutex to control access to the list of events from external threads. */
+  SystemMutex m_eventsWithContextMutex;
+
+  /** Container type for the events to run at Simulator::Destroy() */
+  typedef std::list<EventId> DestroyEvents;
+  /** The container of events to run at Destroy. */
+  DestroyEvents m_destroyEvents;
+  /** Flag calling for the end of the simulation. */
+  std::atomic<bool> m_stop;
+
+  /** The minimum delay of the events sent to another context. */
+  Time m_lookahead;
+  /** The number of threads executing the partitions, 0 for one per core. */
+  uint32_t m_threads;
+  /** The number of windows executed so far. */
+  uint64_t m_windowCount;
+
+  /** The partitions with events in the current window. */
+  std::vector<Partition *> m_active;
+  /** Index of the next active partition to execute. */
+  std::atomic<uint32_t> m_nextActive;
+  /** The first timestamp not included in the current window. */
+  uint64_t m_windowEnd;
+  /** The worker threads. */
+  std::vector<Ptr<SystemThread> > m_workers;
+  /** Mutex protecting the window generation and the worker state. */
+  std::mutex m_windowMutex;
+  /** Signals the start of a window to the workers. */
+  std::condition_variable m_windowStart;
+  /** Signals the end of the work of all the threads. */
+  std::condition_variable m_windowDone;
+  /** The number of windows dispatched to the workers. */
+  uint64_t m_generation;
+  /** The number of threads still executing the current window. */
+  uint32_t m_pending;
+  /** Flag asking the workers to exit. */
+  bool m_exit;
+
+  /** Main execution thread. */
+  SystemThread::ThreadId m_main;
+  /** The partition executed by the calling thread. */
+  static thread_local Partition *m_current;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SIMULATION_FORK_H
+#define SIMULATION_FORK_H
+
+#include "nstime.h"
+#include "callback.h"
+
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::SimulationFork declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup core
+ *
+ * Fork the simulation into branches, to run a parameter sweep after a
+ * common warm-up.
+ *
+ * At the time given to Schedule(), the process forks one child process per
+ * branch. Each child inherits the whole state of the simulation, applies
+ * the attribute overrides of its branch and continues the simulation,
+ * while the parent waits for all the children and then stops. The
+ * warm-up, e.g., the start of the mobility traces and the creation of the
+ * nodes, is thus paid once per sweep.
+ *
+ * An override with a path starting with "/" is applied with Config::Set to
+ * the existing objects, otherwise with Config::SetDefault to the objects
+ * created afterwards. The values are given as strings, as on the command
+ * line.
+ *
+ * The resources which cannot be shared among the processes must be handled
+ * by the simulation script:
+ * - the prepare callbacks run in the parent before the fork, e.g., to flush
+ *   the output files or to save the state of an external simulator;
+ * - the child callbacks run in each child after the fork, e.g., to open
+ *   per-branch output files, named with GetFileName(), or to connect to a
+ *   new instance of an external simulator.
+ *
+ * Before forking, the fork flushes \c std::cout, \c std::cerr and the C
+ * streams only. The C++ file streams, e.g., the \c std::ofstream of a
+ * trace helper, and the buffers of the trace writers are inherited by each
+ * child with their unwritten content: they must be flushed by a prepare
+ * callback, and reopened under a per-branch name by a child callback,
+ * otherwise the records are duplicated and the branches write to the same
+ * file.
+ *
+ * The children share the state of the random variable streams, so that the
+ * branches differ only by their overrides. Only the thread calling the
+ * fork survives in the children: the fork must not happen while other
+ * threads are running, e.g., with an asynchronous trace writer.
+ */
+class SimulationFork
+{
+public:
+  /** The attribute overrides of a branch, as (path, value) pairs. */
+  typedef std::vector<std::pair<std::string, std::string> > Overrides;
+
+  /** Branch of the process which did not fork, or of the parent. */
+  static const uint32_t NO_BRANCH = 0xffffffff;
+
+  /**
+   * Add a branch.
+   * \param [in] overrides The attribute overrides of the branch.
+   * \return The index of the branch.
+   */
+  static uint32_t AddBranch (const Overrides &overrides);
+  /**
+   * Schedule the fork.
+   * \param [in] at The absolute simulation time of the fork.
+   * \param [in] maxChildren The maximum number of children running at
+   *             the same time, 0 to run all the branches at once.
+   */
+  static void Schedule (const Time &at, uint32_t maxChildren = 0);
+  /**
+   * Add a callback run in the parent before the fork.
+   * \param [in] cb The callback.
+   */
+  static void AddPrepareCallback (Callback<void> cb);
+  /**
+   * Add a callback run in each child after the fork.
+   * \param [in] cb The callback, invoked with the index of the branch.
+   */
+  static void AddChildCallback (Callback<void, uint32_t> cb);
+  /**
+   * Get the branch of this process.
+   * \return The index of the branch, or NO_BRANCH.
+   */
+  static uint32_t GetBranch (void);
+  /**
+   * Check if this process is the parent of the branches.
+   * \return \c true in the parent after the fork.
+   */
+  static bool HasForked (void);
+  /**
+   * Get the name of an output file of this process.
+   *
+   * In a child, the index of the branch is appended to the name of the
+   * file, before the extension, e.g., "out.txt" becomes "out-branch2.txt".
+   * \param [in] filename The name of the file.
+   * \return The name of the file of this branch.
+   */
+  static std::string GetFileName (std::string filename);
+
+private:
+  /** Fork the children and wait for them, or apply the overrides. */
+  static void Fork (void);
+};
+
+} // namespace ns3
+
+#endif /* SIMULATION_FORK_H */
@@ -8,10 +8,12 @@
 #include "ns3/mobility-module.h"
 #include "ns3/netanim-module.h"
 #include "ns3/rain-snow-attenuation.h"
+#include "ns3/simulation-fork.h"
 #include "ns3/system-wall-clock-ms.h"
 #include "ns3/traci-applications-module.h"
 #include "ns3/traci-module.h"
 #include <fstream>
+#include <sstream>
 #include <sys/stat.h>
 
 using namespace ns3;
@@ -20,6 +22,43 @@ using namespace millicar;
 Ptr<TraciClient> sumoClient = CreateObject<TraciClient>();
 Ptr<MmWaveVehicularHelper> helper = CreateObject<MmWaveVehicularHelper>();
 bool combined_rain_snow;
+std::string sumoStateFile = "sumo_paderborn_state.xml";
+
+// save the SUMO state and flush the traces before forking the branches of
+// the rain sweep, the children would write the buffered records again
+void PrepareFork() {
+  sumoClient->SumoSaveState(sumoStateFile);
+  Ptr<MmWaveVehicularTracesHelper> traces = helper->GetPhyTracesHelper();
+  if (traces)
+    traces->Flush();
+}
+
+// continue a branch of the rain sweep with its own SUMO instance and output
+void StartBranch(uint32_t branch) {
+  sumoClient->SetAttribute(
+      "SumoAdditionalCmdOptions",
+      StringValue("--fcd-output " +
+                  SimulationFork::GetFileName("sumo_paderborn.xml")));
+  sumoClient->SumoRestart(sumoStateFile, 100 * (branch + 1));
+
+  Ptr<MmWaveVehicularTracesHelper> traces = helper->GetPhyTracesHelper();
+  if (traces) {
+    StringValue fileName;
+    helper->GetAttribute("PhyTraceFileName", fileName);
+    traces->SetFileName(SimulationFork::GetFileName(fileName.Get()));
+  }
+
+  // the weather models are created again with the rain rate of the branch
+  Config::MatchContainer models = Config::LookupMatches(
+      "/ChannelList/*/$ns3::SpectrumChannel/PropagationLossModel");
+  for (Config::MatchContainer::Iterator it = models.Begin();
+       it != models.End(); ++it) {
+    Ptr<MmWaveVehicularPropagationLossModel> pathloss =
+        DynamicCast<MmWaveVehicularPropagationLossModel>(*it);
+    if (pathloss)
+      pathloss->ResetWeatherAttenuation();
+  }
+}
 
 int main(int argc, char *argv[]) {
 
@@ -36,6 +75,8 @@ int main(int argc, char *argv[]) {
   std::string channel_condition;
   std::string scenario;
   ns3::Time simulationTime(ns3::Seconds(200));
+  double forkTime = 0;   // time in s of the fork of the rain sweep
+  std::string rainSweep; // comma separated rain intensities of the sweep
 
   CommandLine cmd;
 
@@ -57,6 +98,13 @@ int main(int argc, char *argv[]) {
   cmd.AddValue("alpha", "Regression coefficient alpha", alpha);
   cmd.AddValue("altitude", "Altitude in meters above the sea level", altitude);
   cmd.AddValue("h0", "Mean annual 0C isotherm height above mean sea level", h0);
+  cmd.AddValue("forkTime",
+               "Time in s after which the simulation forks one process per "
+               "rain intensity of rainSweep, 0 to disable",
+               forkTime);
+  cmd.AddValue("rainSweep",
+               "Comma separated rain intensities simulated after forkTime",
+               rainSweep);
 
   cmd.Parse(argc, argv);
 
@@ -69,6 +117,8 @@ int main(int argc, char *argv[]) {
                      StringValue(scenario));
   Config::SetDefault("ns3::MmWaveVehicularHelper::Bandwidth",
                      DoubleValue(bandwidth));
+  Config::SetDefault("ns3::RainAttenuation::RainRate",
+                     UintegerValue(intensityOfRain));
   Config::SetDefault("ns3::RainAttenuation::k", DoubleValue(k));
   Config::SetDefault("ns3::RainAttenuation::alpha", DoubleValue(alpha));
   Config::SetDefault("ns3::RainSnowAttenuation::altitude",
@@ -147,6 +197,21 @@ int main(int argc, char *argv[]) {
   // start traci client with given function pointers
   sumoClient->SumoSetup(setupNewWifiNode, shutdownWifiNode);
 
+  // run the warm-up once, then fork one branch per rain intensity
+  if (forkTime > 0 && !rainSweep.empty()) {
+    std::stringstream sweep(rainSweep);
+    std::string intensity;
+    while (std::getline(sweep, intensity, ',')) {
+      SimulationFork::Overrides overrides;
+      overrides.push_back(
+          std::make_pair("ns3::RainAttenuation::RainRate", intensity));
+      SimulationFork::AddBranch(overrides);
+    }
+    SimulationFork::AddPrepareCallback(MakeCallback(&PrepareFork));
+    SimulationFork::AddChildCallback(MakeCallback(&StartBranch));
+    SimulationFork::Schedule(Seconds(forkTime));
+  }
+
   Simulator::Stop(simulationTime);
   Simulator::Run();
   Simulator::Destroy();
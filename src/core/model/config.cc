@@ -25,7 +25,11 @@
 #include "names.h"
 #include "pointer.h"
 #include "log.h"
+#include "simple-ref-count.h"
 
+#include <cstdlib>
+#include <list>
+#include <set>
 #include <sstream>
 
 /**
@@ -182,6 +186,9 @@ MatchContainer::DisconnectWithoutContext (std::string name, const CallbackBase &
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once, at construction, into the ranges
+ * of the matching indices.
  */
 class ArrayMatcher
 {
@@ -201,6 +208,12 @@ public:
   bool Matches (std::size_t i) const;
 
 private:
+  /**
+   * Parse an alternative of the Config path specification.
+   *
+   * \param [in] element The alternative.
+   */
+  void Parse (std::string element);
   /**
    * Convert a string to an \c uint32_t.
    *
@@ -211,75 +224,78 @@ private:
   bool StringToUint32 (std::string str, uint32_t *value) const;
   /** The Config path element. */
   std::string m_element;
+  /** Flag \c true if any index matches. */
+  bool m_any;
+  /** The ranges of the matching indices, bounds included. */
+  std::vector<std::pair<uint32_t, uint32_t> > m_ranges;
 
 };  // class ArrayMatcher
 
 
 ArrayMatcher::ArrayMatcher (std::string element)
-  : m_element (element)
+  : m_element (element),
+    m_any (false)
 {
   NS_LOG_FUNCTION (this << element);
-}
-bool
-ArrayMatcher::Matches (std::size_t i) const
-{
-  NS_LOG_FUNCTION (this << i);
-  if (m_element == "*")
+  std::string::size_type start = 0;
+  std::string::size_type tmp;
+  while ((tmp = element.find ("|", start)) != std::string::npos)
     {
-      NS_LOG_DEBUG ("Array " << i << " matches *");
-      return true;
+      Parse (element.substr (start, tmp - start));
+      start = tmp + 1;
     }
-  std::string::size_type tmp;
-  tmp = m_element.find ("|");
-  if (tmp != std::string::npos)
+  Parse (element.substr (start));
+}
+void
+ArrayMatcher::Parse (std::string element)
+{
+  NS_LOG_FUNCTION (this << element);
+  if (element == "*")
     {
-      std::string left = m_element.substr (0, tmp - 0);
-      std::string right = m_element.substr (tmp + 1, m_element.size () - (tmp + 1));
-      ArrayMatcher matcher = ArrayMatcher (left);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array " << i << " matches " << left);
-          return true;
-        }
-      matcher = ArrayMatcher (right);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array " << i << " matches " << right);
-          return true;
-        }
-      NS_LOG_DEBUG ("Array " << i << " does not match " << m_element);
-      return false;
+      m_any = true;
+      return;
     }
-  std::string::size_type leftBracket = m_element.find ("[");
-  std::string::size_type rightBracket = m_element.find ("]");
-  std::string::size_type dash = m_element.find ("-");
-  if (leftBracket == 0 && rightBracket == m_element.size () - 1
+  std::string::size_type leftBracket = element.find ("[");
+  std::string::size_type rightBracket = element.find ("]");
+  std::string::size_type dash = element.find ("-");
+  if (leftBracket == 0 && rightBracket == element.size () - 1
       && dash > leftBracket && dash < rightBracket)
     {
-      std::string lowerBound = m_element.substr (leftBracket + 1, dash - (leftBracket + 1));
-      std::string upperBound = m_element.substr (dash + 1, rightBracket - (dash + 1));
+      std::string lowerBound = element.substr (leftBracket + 1, dash - (leftBracket + 1));
+      std::string upperBound = element.substr (dash + 1, rightBracket - (dash + 1));
       uint32_t min;
       uint32_t max;
       if (StringToUint32 (lowerBound, &min)
-          && StringToUint32 (upperBound, &max)
-          && i >= min && i <= max)
+          && StringToUint32 (upperBound, &max))
         {
-          NS_LOG_DEBUG ("Array " << i << " matches " << m_element);
-          return true;
-        }
-      else
-        {
-          NS_LOG_DEBUG ("Array " << i << " does not " << m_element);
-          return false;
+          m_ranges.push_back (std::make_pair (min, max));
         }
+      return;
     }
   uint32_t value;
-  if (StringToUint32 (m_element, &value)
-      && i == value)
+  if (StringToUint32 (element, &value))
+    {
+      m_ranges.push_back (std::make_pair (value, value));
+    }
+}
+bool
+ArrayMatcher::Matches (std::size_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  if (m_any)
     {
       NS_LOG_DEBUG ("Array " << i << " matches " << m_element);
       return true;
     }
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator range = m_ranges.begin ();
+       range != m_ranges.end (); ++range)
+    {
+      if (i >= range->first && i <= range->second)
+        {
+          NS_LOG_DEBUG ("Array " << i << " matches " << m_element);
+          return true;
+        }
+    }
   NS_LOG_DEBUG ("Array " << i << " does not match " << m_element);
   return false;
 }
@@ -294,6 +310,132 @@ ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
   return !iss.bad () && !iss.fail ();
 }
 
+/**
+ * \ingroup config-impl
+ * A Config path, split once into its elements, and the matchers of the
+ * elements which may be array indices.
+ */
+class CompiledPath : public SimpleRefCount<CompiledPath>
+{
+public:
+  /**
+   * Construct from a Config path.
+   *
+   * \param [in] path The Config path.
+   */
+  CompiledPath (std::string path);
+  /**
+   * Get the number of elements.
+   *
+   * \returns The number of elements of the Config path.
+   */
+  std::size_t GetN (void) const;
+  /**
+   * Get an element.
+   *
+   * \param [in] i The index of the element.
+   * \returns The element.
+   */
+  const std::string & GetElement (std::size_t i) const;
+  /**
+   * Get the matcher of an element.
+   *
+   * \param [in] i The index of the element.
+   * \returns The matcher of the element as an array index.
+   */
+  const ArrayMatcher & GetMatcher (std::size_t i) const;
+  /**
+   * Test if the leading elements match the elements of a resolved path.
+   *
+   * \param [in] elements The elements of the resolved path.
+   * \returns \c true if the resolved path matches the leading elements.
+   */
+  bool MatchesPrefix (const std::vector<std::string> &elements) const;
+  /**
+   * Split a Config path into its elements.
+   *
+   * \param [in] path The Config path.
+   * \returns The elements.
+   */
+  static std::vector<std::string> Split (std::string path);
+
+private:
+  /** The elements of the Config path. */
+  std::vector<std::string> m_elements;
+  /** The matchers of the elements. */
+  std::vector<ArrayMatcher> m_matchers;
+
+};  // class CompiledPath
+
+CompiledPath::CompiledPath (std::string path)
+  : m_elements (Split (path))
+{
+  NS_LOG_FUNCTION (this << path);
+  m_matchers.reserve (m_elements.size ());
+  for (std::vector<std::string>::const_iterator i = m_elements.begin (); i != m_elements.end (); ++i)
+    {
+      m_matchers.push_back (ArrayMatcher (*i));
+    }
+}
+std::size_t
+CompiledPath::GetN (void) const
+{
+  return m_elements.size ();
+}
+const std::string &
+CompiledPath::GetElement (std::size_t i) const
+{
+  return m_elements[i];
+}
+const ArrayMatcher &
+CompiledPath::GetMatcher (std::size_t i) const
+{
+  return m_matchers[i];
+}
+bool
+CompiledPath::MatchesPrefix (const std::vector<std::string> &elements) const
+{
+  NS_LOG_FUNCTION (this << elements.size ());
+  if (elements.size () > m_elements.size ())
+    {
+      return false;
+    }
+  for (std::size_t i = 0; i < elements.size (); ++i)
+    {
+      const std::string &element = elements[i];
+      if (element == m_elements[i] || m_elements[i] == "*")
+        {
+          continue;
+        }
+      if (element.empty ()
+          || element.find_first_not_of ("0123456789") != std::string::npos
+          || !m_matchers[i].Matches (std::strtoul (element.c_str (), 0, 10)))
+        {
+          return false;
+        }
+    }
+  return true;
+}
+std::vector<std::string>
+CompiledPath::Split (std::string path)
+{
+  NS_LOG_FUNCTION (path);
+  // the path may or may not start and end with a '/'
+  std::vector<std::string> elements;
+  std::string::size_type start = path.find ("/") == 0 ? 1 : 0;
+  while (start < path.size ())
+    {
+      std::string::size_type next = path.find ("/", start);
+      if (next == std::string::npos)
+        {
+          next = path.size ();
+        }
+      elements.push_back (path.substr (start, next - start));
+      start = next + 1;
+    }
+  return elements;
+}
+
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
@@ -307,6 +449,12 @@ public:
    * \param [in] path The Config path.
    */
   Resolver (std::string path);
+  /**
+   * Construct from a compiled Config path.
+   *
+   * \param [in] path The compiled Config path.
+   */
+  Resolver (Ptr<const CompiledPath> path);
   /** Destructor. */
   virtual ~Resolver ();
 
@@ -318,25 +466,32 @@ public:
    *                  in the Config path.
    */
   void Resolve (Ptr<Object> root);
+  /**
+   * Parse the remaining elements of the stored Config path, beginning at
+   * an object already resolved by the leading elements.
+   *
+   * \param [in] elements The elements of the path of the object, matching
+   *                      the leading elements of the Config path.
+   * \param [in] object The object.
+   */
+  void ResolveFrom (const std::vector<std::string> &elements, Ptr<Object> object);
 
 private:
-  /** Ensure the Config path starts and ends with a '/'. */
-  void Canonicalize (void);
   /**
    * Parse the next element in the Config path.
    *
-   * \param [in] path The remaining portion of the Config path.
+   * \param [in] index The index of the next element of the Config path.
    * \param [in] root The object corresponding to the current position
    *                  in the Config path.
    */
-  void DoResolve (std::string path, Ptr<Object> root);
+  void DoResolve (std::size_t index, Ptr<Object> root);
   /**
    * Parse an index on the Config path.
    *
-   * \param [in] path The remaining Config path.
+   * \param [in] index The index of the next element of the Config path.
    * \param [in,out] vector The resulting list of matching objects.
    */
-  void DoArrayResolve (std::string path, const ObjectPtrContainerValue &vector);
+  void DoArrayResolve (std::size_t index, const ObjectPtrContainerValue &vector);
   /**
    * Handle one object found on the path.
    *
@@ -360,46 +515,42 @@ private:
   /** Current list of path tokens. */
   std::vector<std::string> m_workStack;
   /** The Config path. */
-  std::string m_path;
+  Ptr<const CompiledPath> m_path;
 
 };  // class Resolver
 
 Resolver::Resolver (std::string path)
+  : m_path (Create<CompiledPath> (path))
+{
+  NS_LOG_FUNCTION (this << path);
+}
+Resolver::Resolver (Ptr<const CompiledPath> path)
   : m_path (path)
 {
   NS_LOG_FUNCTION (this << path);
-  Canonicalize ();
 }
 Resolver::~Resolver ()
 {
   NS_LOG_FUNCTION (this);
 }
+
 void
-Resolver::Canonicalize (void)
+Resolver::Resolve (Ptr<Object> root)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << root);
 
-  // ensure that we start and end with a '/'
-  std::string::size_type tmp = m_path.find ("/");
-  if (tmp != 0)
-    {
-      // no slash at start
-      m_path = "/" + m_path;
-    }
-  tmp = m_path.find_last_of ("/");
-  if (tmp != (m_path.size () - 1))
-    {
-      // no slash at end
-      m_path = m_path + "/";
-    }
+  DoResolve (0, root);
 }
 
 void
-Resolver::Resolve (Ptr<Object> root)
+Resolver::ResolveFrom (const std::vector<std::string> &elements, Ptr<Object> object)
 {
-  NS_LOG_FUNCTION (this << root);
+  NS_LOG_FUNCTION (this << elements.size () << object);
+  NS_ASSERT (m_path->MatchesPrefix (elements));
 
-  DoResolve (m_path, root);
+  m_workStack = elements;
+  DoResolve (elements.size (), object);
+  m_workStack.clear ();
 }
 
 std::string
@@ -425,13 +576,11 @@ Resolver::DoResolveOne (Ptr<Object> object)
 }
 
 void
-Resolver::DoResolve (std::string path, Ptr<Object> root)
+Resolver::DoResolve (std::size_t index, Ptr<Object> root)
 {
-  NS_LOG_FUNCTION (this << path << root);
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
+  NS_LOG_FUNCTION (this << index << root);
 
-  if (next == std::string::npos)
+  if (index == m_path->GetN ())
     {
       //
       // If root is zero, we're beginning to see if we can use the object name
@@ -447,8 +596,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
         }
       return;
     }
-  std::string item = path.substr (1, next - 1);
-  std::string pathLeft = path.substr (next, path.size () - next);
+  const std::string &item = m_path->GetElement (index);
 
   //
   // If root is zero, we're beginning to see if we can use the object name
@@ -459,11 +607,10 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   //
   if (root == 0)
     {
-      std::string::size_type offset = path.find ("/Names");
-      if (offset == 0)
+      if (item.compare (0, 5, "Names") == 0)
         {
           m_workStack.push_back (item);
-          DoResolve (pathLeft, root);
+          DoResolve (index + 1, root);
           m_workStack.pop_back ();
           return;
         }
@@ -480,7 +627,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       NS_LOG_DEBUG ("Name system resolved item = " << item << " to " << namedObject);
       m_workStack.push_back (item);
-      DoResolve (pathLeft, namedObject);
+      DoResolve (index + 1, namedObject);
       m_workStack.pop_back ();
       return;
     }
@@ -510,68 +657,78 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
           return;
         }
       m_workStack.push_back (item);
-      DoResolve (pathLeft, object);
+      DoResolve (index + 1, object);
       m_workStack.pop_back ();
     }
   else
     {
       // this is a normal attribute.
-      TypeId tid;
-      TypeId nextTid = root->GetInstanceTypeId ();
-      bool foundMatch = false;
-
-      do
+      std::vector<struct TypeId::AttributeInformation> infos;
+      TypeId tid = root->GetInstanceTypeId ();
+      if (item == "*")
         {
-          tid = nextTid;
-
-          for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
+          TypeId nextTid = tid;
+          do
             {
-              struct TypeId::AttributeInformation info;
-              info = tid.GetAttribute (i);
-              if (info.name != item && item != "*")
-                {
-                  continue;
-                }
-              // attempt to cast to a pointer checker.
-              const PointerChecker *pChecker = dynamic_cast<const PointerChecker *> (PeekPointer (info.checker));
-              if (pChecker != 0)
+              tid = nextTid;
+              for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
                 {
-                  NS_LOG_DEBUG ("GetAttribute(ptr)=" << info.name << " on path=" << GetResolvedPath ());
-                  PointerValue pValue;
-                  root->GetAttribute (info.name, pValue);
-                  Ptr<Object> object = pValue.Get<Object> ();
-                  if (object == 0)
-                    {
-                      NS_LOG_ERROR ("Requested object name=\"" << item <<
-                                    "\" exists on path=\"" << GetResolvedPath () << "\""
-                                    " but is null.");
-                      continue;
-                    }
-                  foundMatch = true;
-                  m_workStack.push_back (info.name);
-                  DoResolve (pathLeft, object);
-                  m_workStack.pop_back ();
+                  infos.push_back (tid.GetAttribute (i));
                 }
-              // attempt to cast to an object vector.
-              const ObjectPtrContainerChecker *vectorChecker =
-                dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker));
-              if (vectorChecker != 0)
+              nextTid = tid.GetParent ();
+            }
+          while (nextTid != tid);
+        }
+      else
+        {
+          // the attribute names are unique along the hierarchy of a type
+          struct TypeId::AttributeInformation info;
+          if (tid.LookupAttributeByName (item, &info))
+            {
+              infos.push_back (info);
+            }
+        }
+
+      bool foundMatch = false;
+      for (std::vector<struct TypeId::AttributeInformation>::const_iterator info = infos.begin ();
+           info != infos.end (); ++info)
+        {
+          // attempt to cast to a pointer checker.
+          const PointerChecker *pChecker = dynamic_cast<const PointerChecker *> (PeekPointer (info->checker));
+          if (pChecker != 0)
+            {
+              NS_LOG_DEBUG ("GetAttribute(ptr)=" << info->name << " on path=" << GetResolvedPath ());
+              PointerValue pValue;
+              root->GetAttribute (info->name, pValue);
+              Ptr<Object> object = pValue.Get<Object> ();
+              if (object == 0)
                 {
-                  NS_LOG_DEBUG ("GetAttribute(vector)=" << info.name << " on path=" << GetResolvedPath () << pathLeft);
-                  foundMatch = true;
-                  ObjectPtrContainerValue vector;
-                  root->GetAttribute (info.name, vector);
-                  m_workStack.push_back (info.name);
-                  DoArrayResolve (pathLeft, vector);
-                  m_workStack.pop_back ();
+                  NS_LOG_ERROR ("Requested object name=\"" << item <<
+                                "\" exists on path=\"" << GetResolvedPath () << "\""
+                                " but is null.");
+                  continue;
                 }
-              // this could be anything else and we don't know what to do with it.
-              // So, we just ignore it.
+              foundMatch = true;
+              m_workStack.push_back (info->name);
+              DoResolve (index + 1, object);
+              m_workStack.pop_back ();
             }
-
-          nextTid = tid.GetParent ();
+          // attempt to cast to an object vector.
+          const ObjectPtrContainerChecker *vectorChecker =
+            dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info->checker));
+          if (vectorChecker != 0)
+            {
+              NS_LOG_DEBUG ("GetAttribute(vector)=" << info->name << " on path=" << GetResolvedPath ());
+              foundMatch = true;
+              ObjectPtrContainerValue vector;
+              root->GetAttribute (info->name, vector);
+              m_workStack.push_back (info->name);
+              DoArrayResolve (index + 1, vector);
+              m_workStack.pop_back ();
+            }
+          // this could be anything else and we don't know what to do with it.
+          // So, we just ignore it.
         }
-      while (nextTid != tid);
 
       if (!foundMatch)
         {
@@ -582,20 +739,15 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
 }
 
 void
-Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &container)
+Resolver::DoArrayResolve (std::size_t index, const ObjectPtrContainerValue &container)
 {
-  NS_LOG_FUNCTION (this << path << &container);
-  NS_ASSERT (path != "");
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-  if (next == std::string::npos)
+  NS_LOG_FUNCTION (this << index << &container);
+  if (index == m_path->GetN ())
     {
       return;
     }
-  std::string item = path.substr (1, next - 1);
-  std::string pathLeft = path.substr (next, path.size () - next);
 
-  ArrayMatcher matcher = ArrayMatcher (item);
+  const ArrayMatcher &matcher = m_path->GetMatcher (index);
   ObjectPtrContainerValue::Iterator it;
   for (it = container.Begin (); it != container.End (); ++it)
     {
@@ -604,7 +756,7 @@ Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &conta
           std::ostringstream oss;
           oss << (*it).first;
           m_workStack.push_back (oss.str ());
-          DoResolve (pathLeft, (*it).second);
+          DoResolve (index + 1, (*it).second);
           m_workStack.pop_back ();
         }
     }
@@ -633,6 +785,25 @@ public:
   void Disconnect (std::string path, const CallbackBase &cb);
   /** \copydoc Config::LookupMatches() */
   MatchContainer LookupMatches (std::string path);
+  /**
+   * Find the objects which match a compiled Config path.
+   *
+   * \param [in] path The compiled Config path.
+   * \param [in] text The Config path.
+   * \returns The matching objects.
+   */
+  MatchContainer LookupMatches (Ptr<const CompiledPath> path, std::string text);
+  /**
+   * Connect a callback to the matching trace sources, now and whenever a
+   * matching object is added.
+   *
+   * \param [in] path A path to match trace sources.
+   * \param [in] cb The callback to connect to the matching trace sources.
+   * \param [in] withContext Flag \c true to pass the context to the callback.
+   */
+  void ConnectIncremental (std::string path, const CallbackBase &cb, bool withContext);
+  /** \copydoc Config::NotifyNewObject() */
+  void NotifyNewObject (std::string path, Ptr<Object> object);
 
   /** \copydoc Config::RegisterRootNamespaceObject() */
   void RegisterRootNamespaceObject (Ptr<Object> obj);
@@ -653,12 +824,54 @@ private:
    * \param [in,out] leaf The trailing part of the \pname{path}.
    */
   void ParsePath (std::string path, std::string *root, std::string *leaf) const;
+  /**
+   * Remove the incremental connections of a callback.
+   *
+   * \param [in] path The Config path of the connections.
+   * \param [in] cb The callback.
+   * \param [in] withContext Flag \c true for the connections with context.
+   */
+  void RemoveIncremental (std::string path, const CallbackBase &cb, bool withContext);
+  /**
+   * Check if the first element of a path is an attribute of a root object.
+   *
+   * \param [in] obj The root object.
+   * \param [in] name The first element of the path.
+   * \returns \c true if \pname{name} is an attribute of \pname{obj}.
+   */
+  bool IsRootAttribute (Ptr<Object> obj, std::string name) const;
+  /**
+   * Check if the first element of a path is an attribute of any root object.
+   *
+   * \param [in] name The first element of the path.
+   * \returns \c true if \pname{name} is an attribute of a registered root.
+   */
+  bool IsRootAttribute (std::string name) const;
 
   /** Container type to hold the root Config path tokens. */
   typedef std::vector<Ptr<Object> > Roots;
 
+  /** A callback connected to the objects matching a path when they are added. */
+  struct IncrementalConnection
+  {
+    /** The Config path. */
+    std::string path;
+    /** The compiled leading part of the path, up to the final slash. */
+    Ptr<const CompiledPath> root;
+    /** The name of the trace source. */
+    std::string leaf;
+    /** The callback. */
+    CallbackBase cb;
+    /** Flag \c true to pass the context to the callback. */
+    bool withContext;
+    /** The contexts of the objects already connected. */
+    std::set<std::string> connected;
+  };
+
   /** The list of Config path roots. */
   Roots m_roots;
+  /** The incremental connections. */
+  std::list<IncrementalConnection> m_incremental;
 
 };  // class ConfigImpl
 
@@ -718,6 +931,7 @@ ConfigImpl::DisconnectWithoutContext (std::string path, const CallbackBase &cb)
                                            << " does not exits on path " << root.substr (0, lastFwdSlash));
     }
   container.DisconnectWithoutContext (leaf, cb);
+  RemoveIncremental (path, cb, false);
 }
 bool
 ConfigImpl::ConnectFailSafe (std::string path, const CallbackBase &cb)
@@ -745,16 +959,24 @@ ConfigImpl::Disconnect (std::string path, const CallbackBase &cb)
                                            << " does not exits on path " << root.substr (0, lastFwdSlash));
     }
   container.Disconnect (leaf, cb);
+  RemoveIncremental (path, cb, true);
 }
 
 MatchContainer
 ConfigImpl::LookupMatches (std::string path)
 {
   NS_LOG_FUNCTION (this << path);
+  return LookupMatches (Create<CompiledPath> (path), path);
+}
+
+MatchContainer
+ConfigImpl::LookupMatches (Ptr<const CompiledPath> path, std::string text)
+{
+  NS_LOG_FUNCTION (this << path << text);
   class LookupMatchesResolver : public Resolver
   {
 public:
-    LookupMatchesResolver (std::string path)
+    LookupMatchesResolver (Ptr<const CompiledPath> path)
       : Resolver (path)
     {
     }
@@ -778,7 +1000,105 @@ public:
   //
   resolver.Resolve (0);
 
-  return MatchContainer (resolver.m_objects, resolver.m_contexts, path);
+  return MatchContainer (resolver.m_objects, resolver.m_contexts, text);
+}
+
+void
+ConfigImpl::ConnectIncremental (std::string path, const CallbackBase &cb, bool withContext)
+{
+  NS_LOG_FUNCTION (this << path << &cb << withContext);
+
+  m_incremental.push_back (IncrementalConnection ());
+  IncrementalConnection &connection = m_incremental.back ();
+  std::string root;
+  ParsePath (path, &root, &connection.leaf);
+  connection.path = path;
+  connection.root = Create<CompiledPath> (root);
+  connection.cb = cb;
+  connection.withContext = withContext;
+
+  MatchContainer container = LookupMatches (connection.root, root);
+  for (std::size_t i = 0; i < container.GetN (); ++i)
+    {
+      std::string context = container.GetMatchedPath (i);
+      connection.connected.insert (context);
+      if (withContext)
+        {
+          container.Get (i)->TraceConnect (connection.leaf, context + connection.leaf, cb);
+        }
+      else
+        {
+          container.Get (i)->TraceConnectWithoutContext (connection.leaf, cb);
+        }
+    }
+}
+
+void
+ConfigImpl::NotifyNewObject (std::string path, Ptr<Object> object)
+{
+  NS_LOG_FUNCTION (this << path << object);
+  if (m_incremental.empty ())
+    {
+      return;
+    }
+
+  class NotifyResolver : public Resolver
+  {
+public:
+    NotifyResolver (IncrementalConnection &connection)
+      : Resolver (connection.root),
+        m_connection (connection)
+    {
+    }
+    virtual void DoOne (Ptr<Object> object, std::string path)
+    {
+      // the same object may be notified more than once, e.g., when
+      // a trace source is found through a new aggregate
+      if (!m_connection.connected.insert (path).second)
+        {
+          return;
+        }
+      NS_LOG_DEBUG ("Connect " << m_connection.path << " to " << path);
+      if (m_connection.withContext)
+        {
+          object->TraceConnect (m_connection.leaf, path + m_connection.leaf, m_connection.cb);
+        }
+      else
+        {
+          object->TraceConnectWithoutContext (m_connection.leaf, m_connection.cb);
+        }
+    }
+    IncrementalConnection &m_connection;
+  };
+
+  std::vector<std::string> elements = CompiledPath::Split (path);
+  for (std::list<IncrementalConnection>::iterator i = m_incremental.begin (); i != m_incremental.end (); ++i)
+    {
+      if (i->root->MatchesPrefix (elements))
+        {
+          NotifyResolver resolver (*i);
+          resolver.ResolveFrom (elements, object);
+        }
+    }
+}
+
+void
+ConfigImpl::RemoveIncremental (std::string path, const CallbackBase &cb, bool withContext)
+{
+  NS_LOG_FUNCTION (this << path << &cb << withContext);
+  std::list<IncrementalConnection>::iterator i = m_incremental.begin ();
+  while (i != m_incremental.end ())
+    {
+      if (i->path == path && i->withContext == withContext
+          && i->cb.GetImpl ()->IsEqual (cb.GetImpl ()))
+        {
+          i = m_incremental.erase (i);
+        }
+      else
+        {
+          ++i;
+        }
+    }
 }
 
 void
@@ -798,11 +1118,50 @@ ConfigImpl::UnregisterRootNamespaceObject (Ptr<Object> obj)
       if (*i == obj)
         {
           m_roots.erase (i);
-          return;
+          break;
+        }
+    }
+
+  // drop the incremental connections which start from the object, e.g.,
+  // the ones to the NodeList when it is disposed at Simulator::Destroy,
+  // unless another root provides the same attribute
+  std::list<IncrementalConnection>::iterator i = m_incremental.begin ();
+  while (i != m_incremental.end ())
+    {
+      if (i->root->GetN () > 0
+          && IsRootAttribute (obj, i->root->GetElement (0))
+          && !IsRootAttribute (i->root->GetElement (0)))
+        {
+          NS_LOG_DEBUG ("Remove the incremental connection " << i->path);
+          i = m_incremental.erase (i);
+        }
+      else
+        {
+          ++i;
         }
     }
 }
 
+bool
+ConfigImpl::IsRootAttribute (Ptr<Object> obj, std::string name) const
+{
+  struct TypeId::AttributeInformation info;
+  return obj->GetInstanceTypeId ().LookupAttributeByName (name, &info);
+}
+
+bool
+ConfigImpl::IsRootAttribute (std::string name) const
+{
+  for (Roots::const_iterator i = m_roots.begin (); i != m_roots.end (); ++i)
+    {
+      if (IsRootAttribute (*i, name))
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
 std::size_t
 ConfigImpl::GetRootNamespaceObjectN (void) const
 {
@@ -937,6 +1296,24 @@ MatchContainer LookupMatches (std::string path)
   NS_LOG_FUNCTION (path);
   return ConfigImpl::Get ()->LookupMatches (path);
 }
+void
+ConnectIncremental (std::string path, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (path << &cb);
+  ConfigImpl::Get ()->ConnectIncremental (path, cb, true);
+}
+void
+ConnectWithoutContextIncremental (std::string path, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (path << &cb);
+  ConfigImpl::Get ()->ConnectIncremental (path, cb, false);
+}
+void
+NotifyNewObject (std::string path, Ptr<Object> object)
+{
+  NS_LOG_FUNCTION (path << object);
+  ConfigImpl::Get ()->NotifyNewObject (path, object);
+}
 
 void RegisterRootNamespaceObject (Ptr<Object> obj)
 {
@@ -288,6 +288,52 @@ private:
  */
 MatchContainer LookupMatches (std::string path);
 
+/**
+ * \ingroup config
+ * \param [in] path A path to match trace sources.
+ * \param [in] cb The callback to connect to the matching trace sources.
+ *
+ * This function connects the input callback, with context, to the
+ * trace sources which match the input path, like Config::Connect, and
+ * keeps the connection pending: the trace sources of the objects
+ * matching the path which are added afterwards, as announced by
+ * Config::NotifyNewObject, are connected too.  Each new object is
+ * resolved by itself, rather than walking the whole namespace again, so
+ * that a connection to a trace source of all the devices of all the
+ * nodes, made before the nodes are created, costs a constant time per
+ * added node or device.
+ *
+ * The pending connection is removed by Config::Disconnect with the same
+ * path and callback, or when the root object of the path is unregistered
+ * by Config::UnregisterRootNamespaceObject, as the NodeList is at
+ * Simulator::Destroy.
+ */
+void ConnectIncremental (std::string path, const CallbackBase &cb);
+/**
+ * \ingroup config
+ * \param [in] path A path to match trace sources.
+ * \param [in] cb The callback to connect to the matching trace sources.
+ *
+ * This function is the equivalent of Config::ConnectIncremental for
+ * Config::ConnectWithoutContext.  The pending connection is removed by
+ * Config::DisconnectWithoutContext with the same path and callback, or
+ * when the root object of the path is unregistered.
+ */
+void ConnectWithoutContextIncremental (std::string path, const CallbackBase &cb);
+/**
+ * \ingroup config
+ * \param [in] path The resolved path of the object, e.g., "/NodeList/3".
+ * \param [in] object The object.
+ *
+ * Notify that an object was added to the namespace, to connect it to
+ * the pending incremental connections whose path starts with a pattern
+ * matching the path of the object.  The containers of the namespace
+ * call it when they add an object, e.g., the NodeList when a node is
+ * created and a Node when a device is added, and they may call it again
+ * for the same object: each trace source is connected only once.
+ */
+void NotifyNewObject (std::string path, Ptr<Object> object);
+
 /**
  * \ingroup config
  * \param [in] obj A new root object
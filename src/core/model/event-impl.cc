@@ -21,6 +21,9 @@
 #include "event-impl.h"
 #include "log.h"
 
+#include <atomic>
+#include <new>
+
 /**
  * \file
  * \ingroup events
@@ -31,6 +34,128 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EventImpl");
 
+namespace {
+
+/** The size classes of the event pool are multiples of this size. */
+const std::size_t EVENT_POOL_GRANULARITY = 16;
+/** The number of size classes, larger events are not pooled. */
+const std::size_t EVENT_POOL_CLASSES = 16;
+
+/**
+ * \ingroup events
+ * The free lists of the event memory of a thread.
+ */
+class EventPool
+{
+public:
+  EventPool ()
+    : m_destroyed (false)
+  {
+    for (std::size_t i = 0; i < EVENT_POOL_CLASSES; i++)
+      {
+        m_free[i] = 0;
+      }
+  }
+  ~EventPool ()
+  {
+    for (std::size_t i = 0; i < EVENT_POOL_CLASSES; i++)
+      {
+        while (m_free[i] != 0)
+          {
+            Block *block = m_free[i];
+            m_free[i] = block->next;
+            ::operator delete (block);
+          }
+      }
+    // the events released after the exit of the thread, e.g., by static
+    // objects, are not pooled any more
+    m_destroyed = true;
+  }
+  /**
+   * Allocate a block of a size class.
+   * \param [in] sizeClass The size class.
+   * \returns The block.
+   */
+  void * Allocate (std::size_t sizeClass)
+  {
+    Block *block = m_free[sizeClass];
+    if (block == 0)
+      {
+        return ::operator new ((sizeClass + 1) * EVENT_POOL_GRANULARITY);
+      }
+    m_free[sizeClass] = block->next;
+    return block;
+  }
+  /**
+   * Release a block of a size class.
+   * \param [in] p The block.
+   * \param [in] sizeClass The size class.
+   */
+  void Deallocate (void *p, std::size_t sizeClass)
+  {
+    if (m_destroyed)
+      {
+        ::operator delete (p);
+        return;
+      }
+    Block *block = static_cast<Block *> (p);
+    block->next = m_free[sizeClass];
+    m_free[sizeClass] = block;
+  }
+
+private:
+  /** A free block, linked to the next one of the same size class. */
+  struct Block
+  {
+    Block *next; //!< The next free block.
+  };
+  Block *m_free[EVENT_POOL_CLASSES]; //!< The free lists of each size class.
+  bool m_destroyed;                  //!< The thread has exited.
+};
+
+/** The event pool of each thread. */
+thread_local EventPool g_eventPool;
+/** The number of events allocated and not yet deleted. */
+std::atomic<uint64_t> g_outstandingEvents (0);
+
+} // unnamed namespace
+
+void *
+EventImpl::operator new (std::size_t size)
+{
+  // Do not add function logging here, it would be called for each event
+  g_outstandingEvents.fetch_add (1, std::memory_order_relaxed);
+  std::size_t sizeClass = (size - 1) / EVENT_POOL_GRANULARITY;
+  if (sizeClass >= EVENT_POOL_CLASSES)
+    {
+      return ::operator new (size);
+    }
+  return g_eventPool.Allocate (sizeClass);
+}
+
+void
+EventImpl::operator delete (void *p, std::size_t size)
+{
+  if (p == 0)
+    {
+      return;
+    }
+  g_outstandingEvents.fetch_sub (1, std::memory_order_relaxed);
+  std::size_t sizeClass = (size - 1) / EVENT_POOL_GRANULARITY;
+  if (sizeClass >= EVENT_POOL_CLASSES)
+    {
+      ::operator delete (p);
+      return;
+    }
+  g_eventPool.Deallocate (p, sizeClass);
+}
+
+uint64_t
+EventImpl::GetOutstandingEvents (void)
+{
+  return g_outstandingEvents.load (std::memory_order_relaxed);
+}
+
 EventImpl::~EventImpl ()
 {
   NS_LOG_FUNCTION (this);
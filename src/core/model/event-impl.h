@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
 #include "simple-ref-count.h"
 
 /**
@@ -66,6 +67,37 @@ public:
    */
   bool IsCancelled (void);
 
+  /**
+   * Allocate the memory of an event.
+   *
+   * The events are small and short lived, so the memory is recycled
+   * through thread-local free lists, one for each size class of
+   * 16 bytes, up to 256 bytes. A block released by a thread other than
+   * the one which allocated it, e.g., an event scheduled with
+   * Simulator::ScheduleWithContext from another thread, joins the free
+   * list of the releasing thread.
+   *
+   * \param [in] size The size of the event.
+   * \returns The allocated memory.
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * Release the memory of an event.
+   *
+   * \param [in] p The memory of the event.
+   * \param [in] size The size of the event.
+   */
+  static void operator delete (void *p, std::size_t size);
+  /**
+   * Get the number of events allocated and not yet deleted.
+   *
+   * This includes the events held by the simulator and by EventId
+   * instances.
+   *
+   * \returns The number of outstanding events.
+   */
+  static uint64_t GetOutstandingEvents (void);
+
 protected:
   /**
    * Implementation for Invoke().
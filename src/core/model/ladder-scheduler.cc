@@ -0,0 +1,323 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+#include "event-impl.h"
+#include "uinteger.h"
+#include "assert.h"
+#include "log.h"
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<LadderScheduler> ()
+    .AddAttribute ("BucketThreshold",
+                   "The maximum number of events of a bucket which is "
+                   "sorted without being split into a new rung.",
+                   UintegerValue (50),
+                   MakeUintegerAccessor (&LadderScheduler::m_threshold),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("MaxRungs",
+                   "The maximum number of rungs of the ladder.",
+                   UintegerValue (8),
+                   MakeUintegerAccessor (&LadderScheduler::m_maxRungs),
+                   MakeUintegerChecker<uint32_t> ())
+  ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_topMin (0),
+    m_topMax (0),
+    m_topStart (0),
+    m_nRungs (0),
+    m_qSize (0),
+    m_threshold (50),
+    m_maxRungs (8)
+{
+  NS_LOG_FUNCTION (this);
+}
+LadderScheduler::~LadderScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint32_t
+LadderScheduler::FindRung (uint64_t ts) const
+{
+  // each rung covers the events from its current bucket up to the
+  // current bucket of the rung above
+  for (uint32_t i = 0; i < m_nRungs; i++)
+    {
+      const Rung &rung = m_rungs[i];
+      if (ts >= rung.m_start + rung.m_current * rung.m_width)
+        {
+          return i;
+        }
+    }
+  return m_nRungs;
+}
+
+LadderScheduler::Bucket &
+LadderScheduler::GetBucket (Rung &rung, uint64_t ts) const
+{
+  uint64_t index = (ts - rung.m_start) / rung.m_width;
+  NS_ASSERT (index < rung.m_nBuckets);
+  return rung.m_buckets[index];
+}
+
+LadderScheduler::Rung &
+LadderScheduler::AddRung (uint64_t start, uint64_t span, uint32_t nEvents)
+{
+  NS_LOG_FUNCTION (this << start << span << nEvents);
+  if (m_rungs.size () <= m_nRungs)
+    {
+      // the rungs are never moved, so that the references to their buckets
+      // stay valid while a bucket is split
+      m_rungs.reserve (std::max<std::size_t> (m_maxRungs, m_nRungs + 1));
+      m_rungs.resize (m_nRungs + 1);
+    }
+  Rung &rung = m_rungs[m_nRungs];
+  m_nRungs++;
+  // one bucket per event, on average
+  rung.m_width = std::max<uint64_t> ((span + nEvents - 1) / nEvents, 1);
+  rung.m_nBuckets = (span + rung.m_width - 1) / rung.m_width;
+  if (rung.m_buckets.size () < rung.m_nBuckets)
+    {
+      rung.m_buckets.resize (rung.m_nBuckets);
+    }
+  rung.m_start = start;
+  rung.m_current = 0;
+  rung.m_count = 0;
+  return rung;
+}
+
+void
+LadderScheduler::Transfer (Bucket &bucket, Rung *rung)
+{
+  if (rung != 0)
+    {
+      for (Bucket::const_iterator i = bucket.begin (); i != bucket.end (); ++i)
+        {
+          GetBucket (*rung, i->key.m_ts).push_back (*i);
+        }
+      rung->m_count += bucket.size ();
+    }
+  else
+    {
+      NS_ASSERT (m_bottom.empty ());
+      m_bottom.insert (m_bottom.end (), bucket.begin (), bucket.end ());
+      std::sort (m_bottom.begin (), m_bottom.end ());
+    }
+  bucket.clear ();
+}
+
+void
+LadderScheduler::RefillBottom (void)
+{
+  NS_ASSERT (m_bottom.empty () && m_qSize > 0);
+  while (true)
+    {
+      if (m_nRungs == 0)
+        {
+          NS_ASSERT (!m_top.empty ());
+          if (m_top.size () <= m_threshold || m_topMin == m_topMax || m_maxRungs == 0)
+            {
+              m_topStart = m_topMax + 1;
+              Transfer (m_top, 0);
+              return;
+            }
+          Rung &rung = AddRung (m_topMin, m_topMax - m_topMin + 1, m_top.size ());
+          m_topStart = rung.m_start + rung.m_nBuckets * rung.m_width;
+          Transfer (m_top, &rung);
+          continue;
+        }
+
+      uint32_t index = m_nRungs - 1;
+      if (m_rungs[index].m_count == 0)
+        {
+          m_nRungs--;
+          continue;
+        }
+      while (m_rungs[index].m_buckets[m_rungs[index].m_current].empty ())
+        {
+          m_rungs[index].m_current++;
+        }
+      Rung &rung = m_rungs[index];
+      Bucket &bucket = rung.m_buckets[rung.m_current];
+      uint64_t bucketStart = rung.m_start + rung.m_current * rung.m_width;
+      uint64_t bucketWidth = rung.m_width;
+      rung.m_count -= bucket.size ();
+      rung.m_current++;
+
+      bool split = bucket.size () > m_threshold && m_nRungs < m_maxRungs && bucketWidth > 1;
+      if (split)
+        {
+          // the events with the same timestamp can only be sorted
+          split = false;
+          for (Bucket::const_iterator i = bucket.begin () + 1; i != bucket.end (); ++i)
+            {
+              if (i->key.m_ts != bucket.front ().key.m_ts)
+                {
+                  split = true;
+                  break;
+                }
+            }
+        }
+      if (!split)
+        {
+          Transfer (bucket, 0);
+          return;
+        }
+      Rung &child = AddRung (bucketStart, bucketWidth, bucket.size ());
+      Transfer (bucket, &child);
+    }
+}
+
+void
+LadderScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint64_t ts = ev.key.m_ts;
+  if (ts >= m_topStart)
+    {
+      if (m_top.empty ())
+        {
+          m_topMin = ts;
+          m_topMax = ts;
+        }
+      else
+        {
+          m_topMin = std::min (m_topMin, ts);
+          m_topMax = std::max (m_topMax, ts);
+        }
+      m_top.push_back (ev);
+    }
+  else
+    {
+      uint32_t index = FindRung (ts);
+      if (index < m_nRungs)
+        {
+          GetBucket (m_rungs[index], ts).push_back (ev);
+          m_rungs[index].m_count++;
+        }
+      else if (m_bottom.empty () || m_bottom.back () < ev)
+        {
+          // the common case of an event with the latest timestamp
+          m_bottom.push_back (ev);
+        }
+      else
+        {
+          m_bottom.insert (std::upper_bound (m_bottom.begin (), m_bottom.end (), ev), ev);
+        }
+    }
+  m_qSize++;
+}
+
+bool
+LadderScheduler::IsEmpty (void) const
+{
+  return m_qSize == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  if (m_bottom.empty ())
+    {
+      // refilling Bottom does not change the set of events
+      const_cast<LadderScheduler *> (this)->RefillBottom ();
+    }
+  return m_bottom.front ();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  if (m_bottom.empty ())
+    {
+      RefillBottom ();
+    }
+  Scheduler::Event ev = m_bottom.front ();
+  m_bottom.pop_front ();
+  m_qSize--;
+  NS_LOG_DEBUG ("remove " << ev.impl << " at " << ev.key.m_ts);
+  return ev;
+}
+
+void
+LadderScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  NS_ASSERT (!IsEmpty ());
+  uint64_t ts = ev.key.m_ts;
+  Bucket *bucket = 0;
+  uint32_t index = m_nRungs;
+  if (ts >= m_topStart)
+    {
+      bucket = &m_top;
+    }
+  else
+    {
+      index = FindRung (ts);
+      if (index < m_nRungs)
+        {
+          bucket = &GetBucket (m_rungs[index], ts);
+        }
+    }
+
+  if (bucket != 0)
+    {
+      // the events in Top and in the buckets are not sorted
+      Bucket::iterator i = std::find (bucket->begin (), bucket->end (), ev);
+      NS_ASSERT_MSG (i != bucket->end (), "Event not found");
+      *i = bucket->back ();
+      bucket->pop_back ();
+      if (index < m_nRungs)
+        {
+          m_rungs[index].m_count--;
+        }
+    }
+  else
+    {
+      std::deque<Scheduler::Event>::iterator i = std::lower_bound (m_bottom.begin (), m_bottom.end (), ev);
+      NS_ASSERT_MSG (i != m_bottom.end () && *i == ev, "Event not found");
+      m_bottom.erase (i);
+    }
+  m_qSize--;
+}
+
+} // namespace ns3
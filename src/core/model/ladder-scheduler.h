@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <deque>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue of
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Tang, Goh and Thng][Tang].
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * The events are kept in three tiers:
+ * - Top: an unsorted vector of the events far in the future;
+ * - Ladder: up to MaxRungs rungs of buckets, each rung spanning one bucket
+ *   of the rung above with finer buckets;
+ * - Bottom: a sorted deque of the earliest events.
+ *
+ * When Bottom is empty, the first non-empty bucket of the lowest rung is
+ * either split into a new rung, if it holds more than BucketThreshold
+ * events, or sorted into Bottom. A bucket whose events all share the same
+ * timestamp is never split. This is the common case of slot-periodic
+ * workloads, where a transmission schedules the reception of all the
+ * receivers at the same time: the bucket is sorted once, and the events
+ * with the same timestamp inserted later are appended to Bottom in
+ * constant time.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time  | Reason
+ * :----------- | :--------------- | :-----
+ * Insert()     | ~Constant        | Append to Top or to a bucket
+ * IsEmpty()    | Constant         | Explicit queue size
+ * PeekNext()   | ~Constant        | Possible transfer of a bucket to Bottom
+ * Remove()     | Linear           | Search within Top, a bucket or Bottom
+ * RemoveNext() | ~Constant        | Possible transfer of a bucket to Bottom
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | MaxRungs x bucket array          | Buckets are reused
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  LadderScheduler ();
+  /** Destructor. */
+  virtual ~LadderScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** Bucket type: an unsorted vector of Events. */
+  typedef std::vector<Scheduler::Event> Bucket;
+
+  /** A rung of the ladder. */
+  struct Rung
+  {
+    /** The buckets, only the first m_nBuckets are in use. */
+    std::vector<Bucket> m_buckets;
+    /** Number of buckets in use. */
+    uint32_t m_nBuckets;
+    /** Start of the first bucket, in dimensionless time units. */
+    uint64_t m_start;
+    /** Duration of a bucket, in dimensionless time units. */
+    uint64_t m_width;
+    /** Index of the first bucket which may hold events. */
+    uint32_t m_current;
+    /** Number of events in the rung. */
+    uint32_t m_count;
+  };
+
+  /**
+   * Find the rung which covers a timestamp.
+   *
+   * \param [in] ts The dimensionless time.
+   * \returns The rung index, or the number of rungs if the timestamp
+   *          belongs to Bottom.
+   */
+  uint32_t FindRung (uint64_t ts) const;
+  /**
+   * Get the bucket of a rung which covers a timestamp.
+   *
+   * \param [in] rung The rung.
+   * \param [in] ts The dimensionless time.
+   * \returns The bucket.
+   */
+  Bucket & GetBucket (Rung &rung, uint64_t ts) const;
+  /**
+   * Set up a new rung below the existing ones.
+   *
+   * \param [in] start The start of the rung.
+   * \param [in] span The time covered by the rung.
+   * \param [in] nEvents The number of events the rung will hold.
+   * \returns The new rung.
+   */
+  Rung & AddRung (uint64_t start, uint64_t span, uint32_t nEvents);
+  /**
+   * Move the events of a bucket to a rung, or to Bottom.
+   *
+   * \param [in,out] bucket The bucket, emptied.
+   * \param [in] rung The rung, or 0 to sort the events into Bottom.
+   */
+  void Transfer (Bucket &bucket, Rung *rung);
+  /** Refill Bottom with the earliest events, Bottom must be empty. */
+  void RefillBottom (void);
+
+  /** The events far in the future. */
+  Bucket m_top;
+  /** The smallest timestamp in Top. */
+  uint64_t m_topMin;
+  /** The largest timestamp in Top. */
+  uint64_t m_topMax;
+  /** The events with a timestamp not lower than this one go to Top. */
+  uint64_t m_topStart;
+  /** The rungs, only the first m_nRungs are in use. */
+  std::vector<Rung> m_rungs;
+  /** Number of rungs in use. */
+  uint32_t m_nRungs;
+  /** The earliest events, sorted. */
+  std::deque<Scheduler::Event> m_bottom;
+  /** Number of events in queue. */
+  uint32_t m_qSize;
+  /** Maximum number of events of a bucket sorted into Bottom. */
+  uint32_t m_threshold;
+  /** Maximum number of rungs. */
+  uint32_t m_maxRungs;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
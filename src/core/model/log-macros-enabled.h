@@ -144,6 +144,8 @@
  * NS_LOG (LOG_DEBUG, "a number="<<aNumber<<", anotherNumber="<<anotherNumber);
  * \endcode
  *
+ * If the LogRingBuffer is enabled, the message is stored there instead.
+ *
  * \param [in] level The log level
  * \param [in] msg The message to log
  * \internal
@@ -154,6 +156,11 @@
   do {                                                          \
       if (g_log.IsEnabled (level))                              \
         {                                                       \
+          if (ns3::LogRingBuffer::IsEnabled ())                 \
+            {                                                   \
+              ns3::LogRecord (g_log, __FUNCTION__, level) << msg; \
+              break;                                            \
+            }                                                   \
           NS_LOG_APPEND_TIME_PREFIX;                            \
           NS_LOG_APPEND_NODE_PREFIX;                            \
           NS_LOG_APPEND_CONTEXT;                                \
@@ -176,6 +183,12 @@
   do {                                                          \
       if (g_log.IsEnabled (ns3::LOG_FUNCTION))                  \
         {                                                       \
+          if (ns3::LogRingBuffer::IsEnabled ())                 \
+            {                                                   \
+              ns3::LogRecord (g_log, __FUNCTION__,              \
+                              ns3::LOG_FUNCTION, true);         \
+              break;                                            \
+            }                                                   \
           NS_LOG_APPEND_TIME_PREFIX;                            \
           NS_LOG_APPEND_NODE_PREFIX;                            \
           NS_LOG_APPEND_CONTEXT;                                \
@@ -212,6 +225,13 @@
     {                                                           \
       if (g_log.IsEnabled (ns3::LOG_FUNCTION))                  \
         {                                                       \
+          if (ns3::LogRingBuffer::IsEnabled ())                 \
+            {                                                   \
+              ns3::LogRecord (g_log, __FUNCTION__,              \
+                              ns3::LOG_FUNCTION, true)          \
+                << parameters;                                  \
+              break;                                            \
+            }                                                   \
           NS_LOG_APPEND_TIME_PREFIX;                            \
           NS_LOG_APPEND_NODE_PREFIX;                            \
           NS_LOG_APPEND_CONTEXT;                                \
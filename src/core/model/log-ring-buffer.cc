@@ -0,0 +1,602 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "log-ring-buffer.h"
+#include "log.h"
+#include "simulator.h"
+#include "nstime.h"
+#include "assert.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iomanip>
+
+/**
+ * \file
+ * \ingroup logging
+ * ns3::LogRingBuffer and ns3::LogRecord implementations.
+ */
+
+namespace ns3 {
+
+/** The types of the stored arguments. */
+enum LogArgType
+{
+  LOG_ARG_SIGNED,       //!< A signed integer.
+  LOG_ARG_UNSIGNED,     //!< An unsigned integer.
+  LOG_ARG_DOUBLE,       //!< A floating point value.
+  LOG_ARG_POINTER,      //!< A raw pointer.
+  LOG_ARG_TIME,         //!< A Time value, in time steps.
+  LOG_ARG_BOOL,         //!< A boolean.
+  LOG_ARG_CHAR,         //!< A character.
+  LOG_ARG_INT8,         //!< An int8_t.
+  LOG_ARG_UINT8,        //!< A uint8_t.
+  LOG_ARG_STRING,       //!< A string, quoted among function parameters.
+  LOG_ARG_TEXT,         //!< A formatted value.
+  LOG_ARG_VALUE,        //!< A LogRecordValue.
+  LOG_ARG_MANIPULATOR,  //!< A std::ostream manipulator.
+  LOG_ARG_IOS_MANIPULATOR  //!< A std::ios_base manipulator.
+};
+
+/** An argument of a record. */
+struct LogArg
+{
+  uint8_t type;         //!< The LogArgType.
+  uint8_t length;       //!< The length of a string or formatted value.
+  uint8_t offset;       //!< The offset of a string or formatted value.
+  union
+  {
+    int64_t i;          //!< A signed integer.
+    uint64_t u;         //!< An unsigned integer, boolean or character.
+    double d;           //!< A floating point value.
+    const void *p;      //!< A raw pointer.
+    LogRecordValue *v;  //!< A copy of a value, owned by the record.
+    std::ostream & (*m)(std::ostream &);       //!< A std::ostream manipulator.
+    std::ios_base & (*b)(std::ios_base &);     //!< A std::ios_base manipulator.
+  } value;              //!< The value of the argument.
+};
+
+struct LogRingBuffer::Slot
+{
+  /** The maximum number of arguments. */
+  static const uint32_t MAX_ARGS = 8;
+  /** The size of the storage of the strings. */
+  static const uint32_t TEXT_SIZE = 128;
+
+  const LogComponent *component;  //!< The log component.
+  const char *function;           //!< The name of the logging function.
+  int64_t time;                   //!< The simulation time, in time steps.
+  uint32_t context;               //!< The simulator context.
+  uint32_t level;                 //!< The LogLevel of the message.
+  uint32_t prefixes;              //!< The prefixes enabled when logging.
+  bool parameters;                //!< Flag \c true for NS_LOG_FUNCTION.
+  bool truncated;                 //!< Flag \c true if arguments were dropped.
+  uint8_t nArgs;                  //!< The number of arguments.
+  uint8_t textLength;             //!< The used storage of the strings.
+  LogArg args[MAX_ARGS];          //!< The arguments.
+  char text[TEXT_SIZE];           //!< The storage of the strings.
+};
+
+bool LogRingBuffer::m_enabled = false;
+
+namespace {
+
+/** The state of the ring buffer. */
+struct LogRingBufferState
+{
+  /** Constructor. */
+  LogRingBufferState ()
+    : next (0)
+  {}
+  /** The records. */
+  std::vector<LogRingBuffer::Slot> slots;
+  /** The number of records logged so far. */
+  std::atomic<uint64_t> next;
+};
+
+/**
+ * Get the state of the ring buffer.
+ * \return The state.
+ */
+LogRingBufferState &
+GetState (void)
+{
+  static LogRingBufferState state;
+  return state;
+}
+
+/**
+ * Add an argument to a record.
+ * \param [in,out] slot The record.
+ * \param [in] type The LogArgType of the argument.
+ * \return The argument, or 0 if the record is full.
+ */
+LogArg *
+NewArg (LogRingBuffer::Slot *slot, LogArgType type)
+{
+  if (slot->nArgs == LogRingBuffer::Slot::MAX_ARGS)
+    {
+      slot->truncated = true;
+      return 0;
+    }
+  LogArg *arg = &slot->args[slot->nArgs++];
+  arg->type = type;
+  return arg;
+}
+
+/**
+ * Release the copies of the values stored in a record, and empty it.
+ * \param [in,out] slot The record.
+ */
+void
+ReleaseArgs (LogRingBuffer::Slot *slot)
+{
+  for (uint8_t i = 0; i < slot->nArgs; i++)
+    {
+      if (slot->args[i].type == LOG_ARG_VALUE)
+        {
+          delete slot->args[i].value.v;
+        }
+    }
+  slot->nArgs = 0;
+}
+
+/**
+ * Print a simulation time as DefaultTimePrinter.
+ * \param [in,out] os The output stream.
+ * \param [in] ts The time, in time steps.
+ */
+void
+PrintTime (std::ostream &os, int64_t ts)
+{
+  os << std::fixed;
+  switch (Time::GetResolution ())
+    {
+      // *NS_CHECK_STYLE_OFF*
+    case Time::US :    os << std::setprecision (6);   break;
+    case Time::NS :    os << std::setprecision (9);   break;
+    case Time::PS :    os << std::setprecision (12);  break;
+    case Time::FS :    os << std::setprecision (15);  break;
+      // *NS_CHECK_STYLE_ON*
+
+    default:
+      // default C++ precision of 5
+      os << std::setprecision (5);
+    }
+  os << Time (ts).As (Time::S);
+}
+
+/**
+ * Print an argument.
+ * \param [in,out] os The output stream.
+ * \param [in] slot The record.
+ * \param [in] arg The argument.
+ */
+void
+PrintArg (std::ostream &os, const LogRingBuffer::Slot &slot, const LogArg &arg)
+{
+  switch (arg.type)
+    {
+    case LOG_ARG_SIGNED:
+      os << arg.value.i;
+      break;
+    case LOG_ARG_UNSIGNED:
+      os << arg.value.u;
+      break;
+    case LOG_ARG_DOUBLE:
+      os << arg.value.d;
+      break;
+    case LOG_ARG_POINTER:
+      os << arg.value.p;
+      break;
+    case LOG_ARG_TIME:
+      os << Time (arg.value.i);
+      break;
+    case LOG_ARG_BOOL:
+      os << (arg.value.u != 0);
+      break;
+    case LOG_ARG_CHAR:
+      os << static_cast<char> (arg.value.u);
+      break;
+    case LOG_ARG_INT8:
+      if (slot.parameters)
+        {
+          os << static_cast<int16_t> (static_cast<int8_t> (arg.value.u));
+        }
+      else
+        {
+          os << static_cast<char> (arg.value.u);
+        }
+      break;
+    case LOG_ARG_UINT8:
+      if (slot.parameters)
+        {
+          os << static_cast<uint16_t> (static_cast<uint8_t> (arg.value.u));
+        }
+      else
+        {
+          os << static_cast<char> (arg.value.u);
+        }
+      break;
+    case LOG_ARG_STRING:
+    case LOG_ARG_TEXT:
+      {
+        bool quoted = slot.parameters && arg.type == LOG_ARG_STRING;
+        if (quoted)
+          {
+            os << "\"";
+          }
+        os.write (slot.text + arg.offset, arg.length);
+        if (quoted)
+          {
+            os << "\"";
+          }
+        break;
+      }
+    case LOG_ARG_VALUE:
+      arg.value.v->Print (os);
+      break;
+    case LOG_ARG_MANIPULATOR:
+      os << arg.value.m;
+      break;
+    case LOG_ARG_IOS_MANIPULATOR:
+      os << arg.value.b;
+      break;
+    default:
+      NS_ASSERT_MSG (false, "Unknown argument type " << static_cast<uint32_t> (arg.type));
+    }
+}
+
+/**
+ * Print a record as the NS_LOG macros.
+ * \param [in,out] os The output stream.
+ * \param [in] slot The record.
+ */
+void
+PrintSlot (std::ostream &os, const LogRingBuffer::Slot &slot)
+{
+  std::ios_base::fmtflags ff = os.flags ();
+  std::streamsize oldPrecision = os.precision ();
+  char oldFill = os.fill ();
+
+  if (slot.prefixes & LOG_PREFIX_TIME)
+    {
+      PrintTime (os, slot.time);
+      os.flags (ff);
+      os.precision (oldPrecision);
+      os << " ";
+    }
+  if (slot.prefixes & LOG_PREFIX_NODE)
+    {
+      if (slot.context == Simulator::NO_CONTEXT)
+        {
+          os << "-1 ";
+        }
+      else
+        {
+          os << slot.context << " ";
+        }
+    }
+  if (slot.parameters)
+    {
+      os << slot.component->Name () << ":" << slot.function << "(";
+    }
+  else
+    {
+      if (slot.prefixes & LOG_PREFIX_FUNC)
+        {
+          os << slot.component->Name () << ":" << slot.function << "(): ";
+        }
+      if (slot.prefixes & LOG_PREFIX_LEVEL)
+        {
+          os << "[" << LogComponent::GetLevelLabel (static_cast<LogLevel> (slot.level)) << "] ";
+        }
+    }
+  bool first = true;
+  for (uint8_t i = 0; i < slot.nArgs; i++)
+    {
+      const LogArg &arg = slot.args[i];
+      bool manipulator = arg.type == LOG_ARG_MANIPULATOR || arg.type == LOG_ARG_IOS_MANIPULATOR;
+      if (slot.parameters && !manipulator)
+        {
+          if (!first)
+            {
+              os << ", ";
+            }
+          first = false;
+        }
+      PrintArg (os, slot, arg);
+    }
+  if (slot.truncated)
+    {
+      os << "...";
+    }
+  if (slot.parameters)
+    {
+      os << ")";
+    }
+  os << std::endl;
+
+  os.flags (ff);
+  os.precision (oldPrecision);
+  os.fill (oldFill);
+}
+
+} // unnamed namespace
+
+void
+LogRingBuffer::Enable (uint32_t records)
+{
+  NS_ASSERT_MSG (records > 0, "The ring buffer needs at least one record");
+  LogRingBufferState &state = GetState ();
+  Clear ();
+  state.slots.assign (records, Slot ());
+  state.next = 0;
+  m_enabled = true;
+}
+
+void
+LogRingBuffer::Disable (void)
+{
+  m_enabled = false;
+}
+
+void
+LogRingBuffer::Dump (std::ostream &os)
+{
+  LogRingBufferState &state = GetState ();
+  uint64_t next = state.next;
+  uint64_t size = state.slots.size ();
+  uint64_t first = next > size ? next - size : 0;
+  for (uint64_t i = first; i < next; i++)
+    {
+      PrintSlot (os, state.slots[i % size]);
+    }
+}
+
+void
+LogRingBuffer::Clear (void)
+{
+  LogRingBufferState &state = GetState ();
+  for (std::vector<Slot>::iterator i = state.slots.begin (); i != state.slots.end (); ++i)
+    {
+      ReleaseArgs (&*i);
+    }
+  state.next = 0;
+}
+
+LogRingBuffer::Slot *
+LogRingBuffer::Claim (void)
+{
+  LogRingBufferState &state = GetState ();
+  uint64_t index = state.next.fetch_add (1, std::memory_order_relaxed);
+  return &state.slots[index % state.slots.size ()];
+}
+
+
+LogRecord::LogRecord (const LogComponent &component, const char *function,
+                      uint32_t level, bool parameters)
+  : m_slot (LogRingBuffer::Claim ())
+{
+  m_slot->component = &component;
+  m_slot->function = function;
+  m_slot->level = level;
+  m_slot->parameters = parameters;
+  m_slot->truncated = false;
+  ReleaseArgs (m_slot);
+  m_slot->textLength = 0;
+  m_slot->prefixes = 0;
+  m_slot->time = 0;
+  m_slot->context = Simulator::NO_CONTEXT;
+  // as the NS_LOG macros, the time and the node are known only once the
+  // simulator exists
+  if (component.IsEnabled (LOG_PREFIX_TIME) && LogGetTimePrinter () != 0)
+    {
+      m_slot->prefixes |= LOG_PREFIX_TIME;
+      m_slot->time = Simulator::Now ().GetTimeStep ();
+    }
+  if (component.IsEnabled (LOG_PREFIX_NODE) && LogGetNodePrinter () != 0)
+    {
+      m_slot->prefixes |= LOG_PREFIX_NODE;
+      m_slot->context = Simulator::GetContext ();
+    }
+  if (component.IsEnabled (LOG_PREFIX_FUNC))
+    {
+      m_slot->prefixes |= LOG_PREFIX_FUNC;
+    }
+  if (component.IsEnabled (LOG_PREFIX_LEVEL))
+    {
+      m_slot->prefixes |= LOG_PREFIX_LEVEL;
+    }
+}
+
+LogRecord &
+LogRecord::operator<< (const char *text)
+{
+  if (text == 0)
+    {
+      AddPointer (text);
+    }
+  else
+    {
+      AddText (text, std::strlen (text), true);
+    }
+  return *this;
+}
+
+LogRecord &
+LogRecord::operator<< (const std::string &text)
+{
+  AddText (text.c_str (), text.size (), true);
+  return *this;
+}
+
+LogRecord &
+LogRecord::operator<< (char value)
+{
+  LogArg *arg = NewArg (m_slot, LOG_ARG_CHAR);
+  if (arg != 0)
+    {
+      arg->value.u = static_cast<unsigned char> (value);
+    }
+  return *this;
+}
+
+LogRecord &
+LogRecord::operator<< (signed char value)
+{
+  LogArg *arg = NewArg (m_slot, LOG_ARG_INT8);
+  if (arg != 0)
+    {
+      arg->value.u = static_cast<unsigned char> (value);
+    }
+  return *this;
+}
+
+LogRecord &
+LogRecord::operator<< (unsigned char value)
+{
+  LogArg *arg = NewArg (m_slot, LOG_ARG_UINT8);
+  if (arg != 0)
+    {
+      arg->value.u = value;
+    }
+  return *this;
+}
+
+LogRecord &
+LogRecord::operator<< (bool value)
+{
+  LogArg *arg = NewArg (m_slot, LOG_ARG_BOOL);
+  if (arg != 0)
+    {
+      arg->value.u = value ? 1 : 0;
+    }
+  return *this;
+}
+
+LogRecord &
+LogRecord::operator<< (std::ostream & (*manipulator)(std::ostream &))
+{
+  LogArg *arg = NewArg (m_slot, LOG_ARG_MANIPULATOR);
+  if (arg != 0)
+    {
+      arg->value.m = manipulator;
+    }
+  return *this;
+}
+
+LogRecord &
+LogRecord::operator<< (std::ios_base & (*manipulator)(std::ios_base &))
+{
+  LogArg *arg = NewArg (m_slot, LOG_ARG_IOS_MANIPULATOR);
+  if (arg != 0)
+    {
+      arg->value.b = manipulator;
+    }
+  return *this;
+}
+
+void
+LogRecord::AddSigned (int64_t value)
+{
+  LogArg *arg = NewArg (m_slot, LOG_ARG_SIGNED);
+  if (arg != 0)
+    {
+      arg->value.i = value;
+    }
+}
+
+void
+LogRecord::AddUnsigned (uint64_t value)
+{
+  LogArg *arg = NewArg (m_slot, LOG_ARG_UNSIGNED);
+  if (arg != 0)
+    {
+      arg->value.u = value;
+    }
+}
+
+void
+LogRecord::AddDouble (double value)
+{
+  LogArg *arg = NewArg (m_slot, LOG_ARG_DOUBLE);
+  if (arg != 0)
+    {
+      arg->value.d = value;
+    }
+}
+
+void
+LogRecord::AddPointer (const void *pointer)
+{
+  LogArg *arg = NewArg (m_slot, LOG_ARG_POINTER);
+  if (arg != 0)
+    {
+      arg->value.p = pointer;
+    }
+}
+
+LogRecord &
+LogRecord::operator<< (const Time &time)
+{
+  LogArg *arg = NewArg (m_slot, LOG_ARG_TIME);
+  if (arg != 0)
+    {
+      arg->value.i = time.GetTimeStep ();
+    }
+  return *this;
+}
+
+void
+LogRecord::AddValue (LogRecordValue *value)
+{
+  LogArg *arg = NewArg (m_slot, LOG_ARG_VALUE);
+  if (arg == 0)
+    {
+      delete value;
+      return;
+    }
+  arg->value.v = value;
+}
+
+void
+LogRecord::AddText (const char *text, std::size_t length, bool quoted)
+{
+  std::size_t available = LogRingBuffer::Slot::TEXT_SIZE - m_slot->textLength;
+  if (available == 0)
+    {
+      m_slot->truncated = true;
+      return;
+    }
+  LogArg *arg = NewArg (m_slot, quoted ? LOG_ARG_STRING : LOG_ARG_TEXT);
+  if (arg == 0)
+    {
+      return;
+    }
+  if (length > available)
+    {
+      length = available;
+      m_slot->truncated = true;
+    }
+  arg->offset = m_slot->textLength;
+  arg->length = length;
+  std::memcpy (m_slot->text + m_slot->textLength, text, length);
+  m_slot->textLength += length;
+}
+
+} // namespace ns3
@@ -0,0 +1,522 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_LOG_RING_BUFFER_H
+#define NS3_LOG_RING_BUFFER_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup logging
+ * ns3::LogRingBuffer and ns3::LogRecord declarations.
+ */
+
+namespace ns3 {
+
+class LogComponent;
+class Time;
+template <typename T>
+class Ptr;
+
+/**
+ * \ingroup logging
+ *
+ * A binary ring buffer of the last log messages.
+ *
+ * When the ring buffer is enabled, the enabled NS_LOG macros store their
+ * arguments in the buffer instead of writing them on \c std::clog: the
+ * integers, the floating point values, the Time values, the raw pointers,
+ * the Ptr and the manipulators without arguments, e.g., \c std::hex, are
+ * stored as they are, the strings are copied, and the arguments are
+ * formatted only by Dump(). The buffer keeps the last records, so that the
+ * diagnostics of a long run can stay enabled and be dumped when something
+ * goes wrong.
+ *
+ * The other arguments, e.g., a SpectrumValue, are copied in a LogRecordValue
+ * and formatted by Dump() with their usual \c operator<<, so the copy keeps
+ * alive the objects they hold through a Ptr until the record is overwritten,
+ * and the objects they refer to through a raw pointer must still exist when
+ * the buffer is dumped. The arguments which cannot be copied, or whose
+ * \c operator<< needs a non-const reference, are formatted when they are
+ * logged. The manipulators with arguments, e.g., \c std::setw, are ignored,
+ * and so is NS_LOG_APPEND_CONTEXT. The time and node prefixes are printed as
+ * by DefaultTimePrinter and DefaultNodePrinter.
+ *
+ * \code
+ *   LogComponentEnable ("MmWaveSidelinkMac", LOG_LEVEL_ALL);
+ *   LogRingBuffer::Enable (100000);
+ *   Simulator::Run ();
+ *   LogRingBuffer::Dump (std::cerr);
+ * \endcode
+ */
+class LogRingBuffer
+{
+public:
+  /**
+   * Enable the ring buffer, clearing the stored records.
+   * \param [in] records The number of records kept.
+   */
+  static void Enable (uint32_t records);
+  /** Disable the ring buffer, the logs go to \c std::clog again. */
+  static void Disable (void);
+  /**
+   * Check if the ring buffer is enabled.
+   * \return \c true if the logs are stored in the ring buffer.
+   */
+  static bool IsEnabled (void)
+  {
+    return m_enabled;
+  }
+  /**
+   * Format the stored records, from the oldest to the newest.
+   * \param [in,out] os The output stream.
+   */
+  static void Dump (std::ostream &os);
+  /** Discard the stored records. */
+  static void Clear (void);
+
+  /** A record of the ring buffer, defined in the implementation. */
+  struct Slot;
+
+private:
+  friend class LogRecord;
+
+  /**
+   * Get the slot of a new record, overwriting the oldest one.
+   * \return The slot.
+   */
+  static Slot * Claim (void);
+
+  /** Flag \c true if the ring buffer is enabled. */
+  static bool m_enabled;
+};
+
+/**
+ * \ingroup logging
+ *
+ * Check if a type is copied in a LogRecordValue when it is logged in the
+ * LogRingBuffer, i.e., if it is not stored as it is.
+ *
+ * \tparam T The type, without references and cv-qualifiers.
+ */
+template <typename T>
+struct LogRecordFormatted
+{
+  /** Flag \c true if the type is copied in a LogRecordValue. */
+  static const bool value = !std::is_arithmetic<T>::value && !std::is_pointer<T>::value;
+};
+
+/**
+ * \ingroup logging
+ * The strings are copied.
+ */
+template <>
+struct LogRecordFormatted<std::string>
+{
+  /** Flag \c true if the type is copied in a LogRecordValue. */
+  static const bool value = false;
+};
+
+/**
+ * \ingroup logging
+ * The Time values are stored as they are.
+ */
+template <>
+struct LogRecordFormatted<Time>
+{
+  /** Flag \c true if the type is copied in a LogRecordValue. */
+  static const bool value = false;
+};
+
+/**
+ * \ingroup logging
+ * The Ptr are stored as raw pointers, as their \c operator<< prints them.
+ * \tparam T The pointed type.
+ */
+template <typename T>
+struct LogRecordFormatted<Ptr<T> >
+{
+  /** Flag \c true if the type is copied in a LogRecordValue. */
+  static const bool value = false;
+};
+
+/**
+ * \ingroup logging
+ * The elements of the vectors are logged one by one.
+ * \tparam T The type of the elements.
+ */
+template <typename T>
+struct LogRecordFormatted<std::vector<T> >
+{
+  /** Flag \c true if the type is copied in a LogRecordValue. */
+  static const bool value = false;
+};
+
+/**
+ * \ingroup logging
+ *
+ * Check if a value can be copied in a LogRecordValue, i.e., if it can be
+ * copied and formatted through a const reference.
+ *
+ * \tparam T The type, without references and cv-qualifiers.
+ */
+template <typename T>
+class LogRecordDeferred
+{
+  /**
+   * Check if a const T can be formatted.
+   * \tparam U The type.
+   * \return std::true_type.
+   */
+  template <typename U>
+  static auto Check (int)
+  -> decltype (std::declval<std::ostream &> () << std::declval<const U &> (), std::true_type ());
+  /**
+   * Fallback if a const T cannot be formatted.
+   * \tparam U The type.
+   * \return std::false_type.
+   */
+  template <typename U>
+  static std::false_type Check (...);
+
+public:
+  /** Flag \c true if the type can be copied in a LogRecordValue. */
+  static const bool value = std::is_copy_constructible<T>::value
+    && decltype (Check<T> (0))::value;
+};
+
+/**
+ * \ingroup logging
+ *
+ * A value stored in the LogRingBuffer, formatted only when the buffer is
+ * dumped.
+ */
+class LogRecordValue
+{
+public:
+  /** Destructor. */
+  virtual ~LogRecordValue ()
+  {}
+  /**
+   * Format the value.
+   * \param [in,out] os The output stream.
+   */
+  virtual void Print (std::ostream &os) const = 0;
+};
+
+/**
+ * \ingroup logging
+ *
+ * A copy of a logged value.
+ *
+ * \tparam T The type of the value.
+ */
+template <typename T>
+class LogRecordValueImpl : public LogRecordValue
+{
+public:
+  /**
+   * Constructor.
+   * \param [in] value The value.
+   */
+  LogRecordValueImpl (const T &value)
+    : m_value (value)
+  {}
+  virtual void Print (std::ostream &os) const
+  {
+    os << m_value;
+  }
+
+private:
+  T m_value;  //!< The copy of the value.
+};
+
+/**
+ * \ingroup logging
+ *
+ * Store a log message in the LogRingBuffer.
+ *
+ * A temporary LogRecord is created by the NS_LOG macros, and the message
+ * is streamed into it with \c operator<<.
+ */
+class LogRecord
+{
+public:
+  /**
+   * Constructor.
+   * \param [in] component The log component.
+   * \param [in] function The name of the logging function.
+   * \param [in] level The LogLevel of the message.
+   * \param [in] parameters \c true for the parameters of NS_LOG_FUNCTION,
+   *             which are printed separated by ", ".
+   */
+  LogRecord (const LogComponent &component, const char *function,
+             uint32_t level, bool parameters = false);
+
+  /**
+   * Store a string.
+   * \param [in] text The string.
+   * \return This LogRecord, so it's chainable.
+   */
+  LogRecord & operator<< (const char *text);
+  /**
+   * \copydoc operator<<(const char*)
+   */
+  LogRecord & operator<< (const std::string &text);
+  /**
+   * Store a character.
+   * \param [in] value The character.
+   * \return This LogRecord, so it's chainable.
+   */
+  LogRecord & operator<< (char value);
+  /**
+   * Store an int8_t, printed as an integer among function parameters.
+   * \param [in] value The value.
+   * \return This LogRecord, so it's chainable.
+   */
+  LogRecord & operator<< (signed char value);
+  /**
+   * Store a uint8_t, printed as an integer among function parameters.
+   * \param [in] value The value.
+   * \return This LogRecord, so it's chainable.
+   */
+  LogRecord & operator<< (unsigned char value);
+  /**
+   * Store a boolean.
+   * \param [in] value The value.
+   * \return This LogRecord, so it's chainable.
+   */
+  LogRecord & operator<< (bool value);
+  /**
+   * Store a manipulator, e.g., \c std::endl.
+   * \param [in] manipulator The manipulator.
+   * \return This LogRecord, so it's chainable.
+   */
+  LogRecord & operator<< (std::ostream & (*manipulator)(std::ostream &));
+  /**
+   * Store a manipulator, e.g., \c std::hex.
+   * \param [in] manipulator The manipulator.
+   * \return This LogRecord, so it's chainable.
+   */
+  LogRecord & operator<< (std::ios_base & (*manipulator)(std::ios_base &));
+
+  /**
+   * Store an integer.
+   * \tparam T \deduced The integer type.
+   * \param [in] value The value.
+   * \return This LogRecord, so it's chainable.
+   */
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value, LogRecord &>::type
+  operator<< (T value);
+  /**
+   * Store a floating point value.
+   * \tparam T \deduced The floating point type.
+   * \param [in] value The value.
+   * \return This LogRecord, so it's chainable.
+   */
+  template <typename T>
+  typename std::enable_if<std::is_floating_point<T>::value, LogRecord &>::type
+  operator<< (T value);
+  /**
+   * Store a raw pointer.
+   * \tparam T \deduced The pointed type.
+   * \param [in] pointer The pointer.
+   * \return This LogRecord, so it's chainable.
+   */
+  template <typename T>
+  LogRecord & operator<< (const T *pointer);
+  /**
+   * Store a Ptr, as a raw pointer.
+   * \tparam T \deduced The pointed type.
+   * \param [in] pointer The Ptr.
+   * \return This LogRecord, so it's chainable.
+   */
+  template <typename T>
+  LogRecord & operator<< (const Ptr<T> &pointer);
+  /**
+   * Store a Time value.
+   * \param [in] time The value.
+   * \return This LogRecord, so it's chainable.
+   */
+  LogRecord & operator<< (const Time &time);
+  /**
+   * Store each element of a vector, as ParameterLogger does.
+   * \tparam T \deduced The type of the elements.
+   * \param [in] vector The vector.
+   * \return This LogRecord, so it's chainable.
+   */
+  template <typename T>
+  LogRecord & operator<< (const std::vector<T> &vector);
+  /**
+   * Store a copy of any other value, or format it if it cannot be copied
+   * in a LogRecordValue.
+   * \tparam T \deduced The type of the value.
+   * \param [in] value The value.
+   * \return This LogRecord, so it's chainable.
+   */
+  template <typename T>
+  typename std::enable_if<LogRecordFormatted<typename std::decay<T>::type>::value, LogRecord &>::type
+  operator<< (T &&value);
+
+private:
+  /**
+   * Store a signed integer.
+   * \param [in] value The value.
+   */
+  void AddSigned (int64_t value);
+  /**
+   * Store an unsigned integer.
+   * \param [in] value The value.
+   */
+  void AddUnsigned (uint64_t value);
+  /**
+   * Store a floating point value.
+   * \param [in] value The value.
+   */
+  void AddDouble (double value);
+  /**
+   * Store a raw pointer.
+   * \param [in] pointer The pointer.
+   */
+  void AddPointer (const void *pointer);
+  /**
+   * Copy a string.
+   * \param [in] text The string.
+   * \param [in] length The length of the string.
+   * \param [in] quoted \c true to quote the string among function parameters.
+   */
+  void AddText (const char *text, std::size_t length, bool quoted);
+  /**
+   * Store a copy of a value.
+   * \param [in] value The copy, owned by the record.
+   */
+  void AddValue (LogRecordValue *value);
+  /**
+   * Store a copy of a value.
+   * \tparam T \deduced The type of the value.
+   * \param [in] value The value.
+   */
+  template <typename T>
+  void AddValue (const T &value, std::true_type);
+  /**
+   * Format and store a value which cannot be copied in a LogRecordValue.
+   * \tparam T \deduced The type of the value.
+   * \param [in] value The value.
+   */
+  template <typename T>
+  void AddValue (T &&value, std::false_type);
+
+  LogRingBuffer::Slot *m_slot;  //!< The slot of the record.
+};
+
+} // namespace ns3
+
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3 {
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value, LogRecord &>::type
+LogRecord::operator<< (T value)
+{
+  if (std::is_signed<T>::value)
+    {
+      AddSigned (static_cast<int64_t> (value));
+    }
+  else
+    {
+      AddUnsigned (static_cast<uint64_t> (value));
+    }
+  return *this;
+}
+
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, LogRecord &>::type
+LogRecord::operator<< (T value)
+{
+  AddDouble (static_cast<double> (value));
+  return *this;
+}
+
+template <typename T>
+LogRecord &
+LogRecord::operator<< (const T *pointer)
+{
+  AddPointer (pointer);
+  return *this;
+}
+
+template <typename T>
+LogRecord &
+LogRecord::operator<< (const Ptr<T> &pointer)
+{
+  AddPointer (PeekPointer (pointer));
+  return *this;
+}
+
+template <typename T>
+LogRecord &
+LogRecord::operator<< (const std::vector<T> &vector)
+{
+  for (typename std::vector<T>::const_iterator i = vector.begin (); i != vector.end (); ++i)
+    {
+      *this << *i;
+    }
+  return *this;
+}
+
+template <typename T>
+typename std::enable_if<LogRecordFormatted<typename std::decay<T>::type>::value, LogRecord &>::type
+LogRecord::operator<< (T &&value)
+{
+  typedef typename std::decay<T>::type Value;
+  AddValue (std::forward<T> (value),
+            std::integral_constant<bool, LogRecordDeferred<Value>::value> ());
+  return *this;
+}
+
+template <typename T>
+void
+LogRecord::AddValue (const T &value, std::true_type)
+{
+  AddValue (new LogRecordValueImpl<T> (value));
+}
+
+template <typename T>
+void
+LogRecord::AddValue (T &&value, std::false_type)
+{
+  std::ostringstream oss;
+  oss << value;
+  std::string text = oss.str ();
+  AddText (text.c_str (), text.size (), false);
+}
+
+} // namespace ns3
+
+#endif /* NS3_LOG_RING_BUFFER_H */
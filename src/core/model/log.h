@@ -29,6 +29,7 @@
 
 #include "node-printer.h"
 #include "time-printer.h"
+#include "log-ring-buffer.h"
 #include "log-macros-enabled.h"
 #include "log-macros-disabled.h"
 
@@ -81,6 +82,15 @@
  *   NS_LOG_FUNCTION (this << arg1 << args);
  * \endcode
  * Use NS_LOG_FUNCTION_NOARGS() only in static functions with no arguments.
+ *
+ * The components compiled with logging can be restricted at configure
+ * time, e.g., in an optimized build:
+ * \code
+ *   $ ./waf configure -d optimized --enable-log-components=MmWaveSidelinkMac:MmWaveVehicularNetDevice
+ * \endcode
+ * The NS_LOG macros of the other components become no-ops at compile time,
+ * see NS3_LOG_COMPONENTS. The logs can also be kept in a binary ring
+ * buffer, formatted only when dumped, see LogRingBuffer.
  */
 /** @{ */
 
@@ -203,7 +213,8 @@ void LogComponentDisableAll (enum LogLevel level);
  * \param [in] name The log component name.
  */
 #define NS_LOG_COMPONENT_DEFINE(name)                           \
-  static ns3::LogComponent g_log = ns3::LogComponent (name, __FILE__)
+  static ns3::CompiledLogComponent<ns3::LogComponentIsCompiledIn (NS3_LOG_COMPONENTS, name)> \
+  g_log (name, __FILE__)
 
 /**
  * Define a logging component with a mask.
@@ -214,7 +225,22 @@ void LogComponentDisableAll (enum LogLevel level);
  * \param [in] mask The default mask.
  */
 #define NS_LOG_COMPONENT_DEFINE_MASK(name, mask)                \
-  static ns3::LogComponent g_log = ns3::LogComponent (name, __FILE__, mask)
+  static ns3::CompiledLogComponent<ns3::LogComponentIsCompiledIn (NS3_LOG_COMPONENTS, name)> \
+  g_log (name, __FILE__, mask)
+
+#ifndef NS3_LOG_COMPONENTS
+/**
+ * The ':'-separated list of the log components compiled with logging,
+ * "*" for all of them.
+ *
+ * The NS_LOG macros of the other components are no-ops at compile time,
+ * although the components are still registered. It is set by the
+ * \c --enable-log-components option of \c waf \c configure. The log
+ * components of the templates, see NS_LOG_TEMPLATE_DECLARE, are always
+ * compiled.
+ */
+#define NS3_LOG_COMPONENTS "*"
+#endif
 
 /**
  * Declare a reference to a Log component.
@@ -434,6 +460,95 @@ private:
 
 };  // class LogComponent
 
+inline bool
+LogComponent::IsEnabled (const enum LogLevel level) const
+{
+  return (level & m_levels) != 0;
+}
+
+/**
+ * A LogComponent whose logging can be compiled out.
+ *
+ * This is the type of the component defined by NS_LOG_COMPONENT_DEFINE.
+ * If \p COMPILED is \c false, IsEnabled() is \c false at compile time,
+ * and the code of the NS_LOG macros is removed by the optimizer.
+ *
+ * \tparam COMPILED \c true if the logging of the component is compiled.
+ */
+template <bool COMPILED>
+class CompiledLogComponent : public LogComponent
+{
+public:
+  /**
+   * Constructor.
+   *
+   * \param [in] name The user-visible name for this component.
+   * \param [in] file The source code file which defined this LogComponent.
+   * \param [in] mask LogLevels blocked for this LogComponent.
+   */
+  CompiledLogComponent (const std::string & name,
+                        const std::string & file,
+                        const enum LogLevel mask = LOG_NONE)
+    : LogComponent (name, file, mask)
+  {}
+  /**
+   * Check if this LogComponent is compiled and enabled for \c level
+   *
+   * \param [in] level The level to check for.
+   * \return \c true if we are enabled at \c level.
+   */
+  bool IsEnabled (const enum LogLevel level) const
+  {
+    return COMPILED && LogComponent::IsEnabled (level);
+  }
+};
+
+/**
+ * Check if the entry of a component list is a name.
+ *
+ * \param [in] entry The entry, terminated by ':' or by the end of the list.
+ * \param [in] name The name.
+ * \return \c true if the entry is the name.
+ */
+constexpr bool
+LogComponentListEntryIs (const char *entry, const char *name)
+{
+  return (*entry == '\0' || *entry == ':')
+         ? *name == '\0'
+         : (*entry == *name && LogComponentListEntryIs (entry + 1, name + 1));
+}
+
+/**
+ * Get the next entry of a component list.
+ *
+ * \param [in] entry The entry.
+ * \return The next entry, or the end of the list.
+ */
+constexpr const char *
+LogComponentListNext (const char *entry)
+{
+  return *entry == '\0' ? entry
+         : *entry == ':' ? entry + 1
+         : LogComponentListNext (entry + 1);
+}
+
+/**
+ * Check if a log component is in a list of components, at compile time.
+ *
+ * \param [in] list The ':'-separated list of components, "*" matches all
+ *            the components.
+ * \param [in] name The name of the component.
+ * \return \c true if the component is in the list.
+ */
+constexpr bool
+LogComponentIsCompiledIn (const char *list, const char *name)
+{
+  return *list != '\0'
+         && (LogComponentListEntryIs (list, "*")
+             || LogComponentListEntryIs (list, name)
+             || LogComponentIsCompiledIn (LogComponentListNext (list), name));
+}
+
 /**
  * Get the LogComponent registered with the given name.
  *
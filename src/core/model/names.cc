@@ -16,7 +16,7 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
-#include <map>
+#include <unordered_map>
 #include "object.h"
 #include "log.h"
 #include "assert.h"
@@ -75,8 +75,8 @@ public:
   /** The object corresponding to this NameNode. */
   Ptr<Object> m_object;
 
-  /** Children of this NameNode. */
-  std::map<std::string, NameNode *> m_nameMap;
+  /** Children of this NameNode, by interned name. */
+  std::unordered_map<uint32_t, NameNode *> m_nameMap;
 };
 
 NameNode::NameNode ()
@@ -247,8 +247,30 @@ public:
    *          the requested type.
    */
   Ptr<Object> Find (Ptr<Object> context, std::string name);
+  /**
+   * Internal implementation for ns3::Names::Find(const Handle &)
+   *
+   * \param [in] handle The cached lookup of a name space path.
+   * \returns A smart pointer to the named object.
+   */
+  Ptr<Object> Find (const Names::Handle &handle);
 
 private:
+  /**
+   * Get the interned identifier of a name, adding it if needed.
+   *
+   * \param [in] name The name.
+   * \returns The identifier of the name.
+   */
+  uint32_t Intern (const std::string &name);
+  /**
+   * Find a child of a NameNode.
+   *
+   * \param [in] node The node to search.
+   * \param [in] name The name of the child.
+   * \returns The child, or 0 if no child has this name.
+   */
+  NameNode * FindChild (const NameNode *node, const std::string &name) const;
   
   /**
    * Check if an object has a name.
@@ -270,10 +292,21 @@ private:
   NameNode m_root;
 
   /** Map from object pointers to their NameNodes. */
-  std::map<Ptr<Object>, NameNode *> m_objectMap;
+  std::unordered_map<Object *, NameNode *> m_objectMap;
+  /**
+   * Map from the names to their interned identifiers, the path segments
+   * are hashed once per lookup and the children are indexed by integer.
+   */
+  std::unordered_map<std::string, uint32_t> m_atoms;
+  /** Number of additions of names, for the cached lookups. */
+  uint64_t m_additions;
+  /** Number of renames and clears, for the cached lookups. */
+  uint64_t m_changes;
 };
 
 NamesPriv::NamesPriv ()
+  : m_additions (1),
+    m_changes (1)
 {
   NS_LOG_FUNCTION (this);
 
@@ -297,13 +330,15 @@ NamesPriv::Clear (void)
   // Every name is associated with an object in the object map, so freeing the
   // NameNodes in this map will free all of the memory allocated for the NameNodes
   //
-  for (std::map<Ptr<Object>, NameNode *>::iterator i = m_objectMap.begin (); i != m_objectMap.end (); ++i)
+  for (std::unordered_map<Object *, NameNode *>::iterator i = m_objectMap.begin (); i != m_objectMap.end (); ++i)
     {
       delete i->second;
       i->second = 0;
     }
 
   m_objectMap.clear ();
+  m_atoms.clear ();
+  m_changes++;
 
   m_root.m_parent = 0;
   m_root.m_name = "Names";
@@ -413,8 +448,9 @@ NamesPriv::Add (Ptr<Object> context, std::string name, Ptr<Object> object)
     }
 
   NameNode *newNode = new NameNode (node, name, object);
-  node->m_nameMap[name] = newNode;
-  m_objectMap[object] = newNode;
+  node->m_nameMap[Intern (name)] = newNode;
+  m_objectMap[PeekPointer (object)] = newNode;
+  m_additions++;
 
   return true;
 }
@@ -516,8 +552,8 @@ NamesPriv::Rename (Ptr<Object> context, std::string oldname, std::string newname
       return false;
     }
 
-  std::map<std::string, NameNode *>::iterator i = node->m_nameMap.find (oldname);
-  if (i == node->m_nameMap.end ())
+  NameNode *changeNode = FindChild (node, oldname);
+  if (changeNode == 0)
     {
       NS_LOG_LOGIC ("Old name does not exist in name map");
       return false;
@@ -533,10 +569,10 @@ NamesPriv::Rename (Ptr<Object> context, std::string oldname, std::string newname
       // 3.  Changing the name string in the name node;
       // 4.  Adding the name node back in the map under the newname.
       //
-      NameNode *changeNode = i->second;
-      node->m_nameMap.erase (i);
+      node->m_nameMap.erase (Intern (oldname));
       changeNode->m_name = newname;
-      node->m_nameMap[newname] = changeNode;
+      node->m_nameMap[Intern (newname)] = changeNode;
+      m_changes++;
       return true;
     }
 }
@@ -546,7 +582,7 @@ NamesPriv::FindName (Ptr<Object> object)
 {
   NS_LOG_FUNCTION (this << object);
 
-  std::map<Ptr<Object>, NameNode *>::iterator i = m_objectMap.find (object);
+  std::unordered_map<Object *, NameNode *>::iterator i = m_objectMap.find (PeekPointer (object));
   if (i == m_objectMap.end ())
     {
       NS_LOG_LOGIC ("Object does not exist in object map");
@@ -564,7 +600,7 @@ NamesPriv::FindPath (Ptr<Object> object)
 {
   NS_LOG_FUNCTION (this << object);
 
-  std::map<Ptr<Object>, NameNode *>::iterator i = m_objectMap.find (object);
+  std::unordered_map<Object *, NameNode *>::iterator i = m_objectMap.find (PeekPointer (object));
   if (i == m_objectMap.end ())
     {
       NS_LOG_LOGIC ("Object does not exist in object map");
@@ -628,53 +664,38 @@ NamesPriv::Find (std::string path)
   // the /Names name space and we have eaten the leading slash. e.g.,
   // remaining = "ClientNode/eth0"
   //
-  // The start of the search is always at the root of the name space.
+  // The start of the search is always at the root of the name space.  The
+  // segments are copied into the same string, to avoid an allocation per
+  // segment.
   //
+  std::string segment;
+  std::string::size_type start = 0;
   for (;;)
     {
-      NS_LOG_LOGIC ("Looking for the object of name " << remaining);
-      offset = remaining.find ("/");
+      NS_LOG_LOGIC ("Looking for the object of name " << remaining.substr (start));
+      offset = remaining.find ("/", start);
+      segment.assign (remaining, start, offset == std::string::npos ? std::string::npos : offset - start);
+      node = FindChild (node, segment);
+      if (node == 0)
+        {
+          NS_LOG_LOGIC ("Name does not exist in name map");
+          return 0;
+        }
       if (offset == std::string::npos)
         {
           //
           // There are no remaining slashes so this is the last segment of the
           // specified name.  We're done when we find it
           //
-          std::map<std::string, NameNode *>::iterator i = node->m_nameMap.find (remaining);
-          if (i == node->m_nameMap.end ())
-            {
-              NS_LOG_LOGIC ("Name does not exist in name map");
-              return 0;
-            }
-          else
-            {
-              NS_LOG_LOGIC ("Name parsed, found object");
-              return i->second->m_object;
-            }
-        }
-      else
-        {
-          //
-          // There are more slashes so this is an intermediate segment of the
-          // specified name.  We need to "recurse" when we find this segment.
-          //
-          offset = remaining.find ("/");
-          std::string segment = remaining.substr (0, offset);
-
-          std::map<std::string, NameNode *>::iterator i = node->m_nameMap.find (segment);
-          if (i == node->m_nameMap.end ())
-            {
-              NS_LOG_LOGIC ("Name does not exist in name map");
-              return 0;
-            }
-          else
-            {
-              node = i->second;
-              remaining = remaining.substr (offset + 1);
-              NS_LOG_LOGIC ("Intermediate segment parsed");
-              continue;
-            }
+          NS_LOG_LOGIC ("Name parsed, found object");
+          return node->m_object;
         }
+      //
+      // There are more slashes so this is an intermediate segment of the
+      // specified name.  We need to "recurse" when we find this segment.
+      //
+      start = offset + 1;
+      NS_LOG_LOGIC ("Intermediate segment parsed");
     }
 
   NS_ASSERT_MSG (node, "NamesPriv::Find(): Internal error:  this can't happen");
@@ -715,8 +736,8 @@ NamesPriv::Find (Ptr<Object> context, std::string name)
         }
     }
 
-  std::map<std::string, NameNode *>::iterator i = node->m_nameMap.find (name);
-  if (i == node->m_nameMap.end ())
+  NameNode *child = FindChild (node, name);
+  if (child == 0)
     {
       NS_LOG_LOGIC ("Name does not exist in name map");
       return 0;
@@ -724,16 +745,65 @@ NamesPriv::Find (Ptr<Object> context, std::string name)
   else
     {
       NS_LOG_LOGIC ("Name exists in name map");
-      return i->second->m_object;
+      return child->m_object;
     }
 }
 
+Ptr<Object>
+NamesPriv::Find (const Names::Handle &handle)
+{
+  NS_LOG_FUNCTION (this << handle.m_path);
+
+  //
+  // A found object stays valid until a name is renamed or the names are
+  // cleared, while a missing name may have been added since the lookup.
+  //
+  if (handle.m_changes == m_changes
+      && (handle.m_object != 0 || handle.m_additions == m_additions))
+    {
+      NS_LOG_LOGIC ("Cached lookup is valid");
+      return handle.m_object;
+    }
+  Ptr<Object> object = Find (handle.m_path);
+  handle.m_object = PeekPointer (object);
+  handle.m_additions = m_additions;
+  handle.m_changes = m_changes;
+  return object;
+}
+
+uint32_t
+NamesPriv::Intern (const std::string &name)
+{
+  NS_LOG_FUNCTION (this << name);
+  std::unordered_map<std::string, uint32_t>::iterator i =
+    m_atoms.insert (std::make_pair (name, static_cast<uint32_t> (m_atoms.size ()))).first;
+  return i->second;
+}
+
+NameNode *
+NamesPriv::FindChild (const NameNode *node, const std::string &name) const
+{
+  NS_LOG_FUNCTION (this << node << name);
+  std::unordered_map<std::string, uint32_t>::const_iterator atom = m_atoms.find (name);
+  if (atom == m_atoms.end ())
+    {
+      // a name which was never added
+      return 0;
+    }
+  std::unordered_map<uint32_t, NameNode *>::const_iterator i = node->m_nameMap.find (atom->second);
+  if (i == node->m_nameMap.end ())
+    {
+      return 0;
+    }
+  return i->second;
+}
+
 NameNode *
 NamesPriv::IsNamed (Ptr<Object> object)
 {
   NS_LOG_FUNCTION (this << object);
 
-  std::map<Ptr<Object>, NameNode *>::iterator i = m_objectMap.find (object);
+  std::unordered_map<Object *, NameNode *>::iterator i = m_objectMap.find (PeekPointer (object));
   if (i == m_objectMap.end ())
     {
       NS_LOG_LOGIC ("Object does not exist in object map, returning NameNode 0");
@@ -751,8 +821,7 @@ NamesPriv::IsDuplicateName (NameNode *node, std::string name)
 {
   NS_LOG_FUNCTION (this << node << name);
 
-  std::map<std::string, NameNode *>::iterator i = node->m_nameMap.find (name);
-  if (i == node->m_nameMap.end ())
+  if (FindChild (node, name) == 0)
     {
       NS_LOG_LOGIC ("Name does not exist in name map");
       return false;
@@ -855,4 +924,32 @@ Names::FindInternal (Ptr<Object> context, std::string name)
   return NamesPriv::Get ()->Find (context, name);
 }
 
+Ptr<Object>
+Names::FindInternal (const Handle &handle)
+{
+  NS_LOG_FUNCTION (handle.GetPath ());
+  return NamesPriv::Get ()->Find (handle);
+}
+
+Names::Handle::Handle ()
+  : m_object (0),
+    m_additions (0),
+    m_changes (0)
+{}
+
+Names::Handle::Handle (std::string path)
+  : m_path (path),
+    m_object (0),
+    m_additions (0),
+    m_changes (0)
+{
+  NS_LOG_FUNCTION (this << path);
+}
+
+std::string
+Names::Handle::GetPath (void) const
+{
+  return m_path;
+}
+
 } // namespace ns3
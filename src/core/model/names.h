@@ -22,6 +22,9 @@
 #include "ptr.h"
 #include "object.h"
 
+#include <stdint.h>
+#include <string>
+
 /**
  * \file
  * \ingroup config
@@ -414,6 +417,62 @@ public:
   template <typename T>
   static Ptr<T> Find (Ptr<Object> context, std::string name);
 
+  /**
+   * \brief A lookup of a name space path, cached until the names change.
+   *
+   * Looking up a path by string hashes each of its segments.  When the
+   * same name is resolved over and over, e.g., per packet, keep a Handle
+   * instead: the first Names::Find resolves the path and the following
+   * ones return the cached object in constant time.  The cached object is
+   * resolved again after a rename or a clear of the names, and a path
+   * which was not found is resolved again after a name is added.
+   *
+   * A Handle is not shared among threads.
+   */
+  class Handle
+  {
+  public:
+    /** Constructor of a handle to no path. */
+    Handle ();
+    /**
+     * Constructor.
+     *
+     * \param [in] path A string containing a name space path, as for
+     *             Names::Find(std::string).
+     */
+    Handle (std::string path);
+    /**
+     * Get the path of the handle.
+     *
+     * \returns The name space path.
+     */
+    std::string GetPath (void) const;
+
+  private:
+    friend class NamesPriv;
+
+    /** The name space path. */
+    std::string m_path;
+    /** The object found by the last lookup, or 0. */
+    mutable Object *m_object;
+    /** The number of additions of names at the last lookup. */
+    mutable uint64_t m_additions;
+    /** The number of changes of names at the last lookup. */
+    mutable uint64_t m_changes;
+  };
+
+  /**
+   * \brief Given a cached lookup of a name space path, look to see if
+   * there's an object in the system with that associated to it.
+   *
+   * \param [in] handle The cached lookup of the path.
+   *
+   * \returns A smart pointer to the named object converted to
+   *          the requested type.
+   */
+  template <typename T>
+  static Ptr<T> Find (const Handle &handle);
+
 private:
   /**
    * \brief Non-templated internal version of Names::Find
@@ -447,6 +506,15 @@ private:
    * \returns A smart pointer to the named object.
    */
   static Ptr<Object> FindInternal (Ptr<Object> context, std::string name);
+
+  /**
+   * \brief Non-templated internal version of Names::Find
+   *
+   * \param [in] handle The cached lookup of the path.
+   *
+   * \returns A smart pointer to the named object.
+   */
+  static Ptr<Object> FindInternal (const Handle &handle);
 };
 
 
@@ -498,6 +566,22 @@ Names::Find (Ptr<Object> context, std::string name)
     }
 }
 
+template <typename T>
+/* static */
+Ptr<T>
+Names::Find (const Handle &handle)
+{
+  Ptr<Object> obj = FindInternal (handle);
+  if (obj)
+    {
+      return obj->GetObject<T> ();
+    }
+  else
+    {
+      return 0;
+    }
+}
+
 } // namespace ns3
 
 #endif /* OBJECT_NAMES_H */
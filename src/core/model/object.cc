@@ -93,15 +93,25 @@ Object::GetTypeId (void)
 }
 
 
+struct Object::Aggregates *
+Object::AllocateAggregates (uint32_t n)
+{
+  NS_LOG_FUNCTION (n);
+  struct Aggregates *aggregates =
+    (struct Aggregates *)std::malloc (sizeof(struct Aggregates) + (n - 1) * sizeof(Object*));
+  aggregates->n = n;
+  std::memset (aggregates->cacheTid, 0, sizeof (aggregates->cacheTid));
+  return aggregates;
+}
+
 Object::Object ()
   : m_tid (Object::GetTypeId ()),
     m_disposed (false),
     m_initialized (false),
-    m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates))),
+    m_aggregates (AllocateAggregates (1)),
     m_getObjectCount (0)
 {
   NS_LOG_FUNCTION (this);
-  m_aggregates->n = 1;
   m_aggregates->buffer[0] = this;
 }
 Object::~Object ()
@@ -120,6 +130,8 @@ Object::~Object ()
           m_aggregates->n--;
         }
     }
+  // the cached lookups may refer to this object
+  std::memset (m_aggregates->cacheTid, 0, sizeof (m_aggregates->cacheTid));
   // finally, if all objects have been removed from the list,
   // delete the aggregate list
   if (m_aggregates->n == 0)
@@ -132,10 +144,9 @@ Object::Object (const Object &o)
   : m_tid (o.m_tid),
     m_disposed (false),
     m_initialized (false),
-    m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates))),
+    m_aggregates (AllocateAggregates (1)),
     m_getObjectCount (0)
 {
-  m_aggregates->n = 1;
   m_aggregates->buffer[0] = this;
 }
 void
@@ -152,16 +163,11 @@ Object::DoGetObject (TypeId tid) const
   NS_ASSERT (CheckLoose ());
 
   uint32_t n = m_aggregates->n;
-  TypeId objectTid = Object::GetTypeId ();
   for (uint32_t i = 0; i < n; i++)
     {
       Object *current = m_aggregates->buffer[i];
       TypeId cur = current->GetInstanceTypeId ();
-      while (cur != tid && cur != objectTid)
-        {
-          cur = cur.GetParent ();
-        }
-      if (cur == tid)
+      if (cur == tid || cur.IsChildOf (tid))
         {
           // This is an attempt to 'cache' the result of this lookup.
           // the idea is that if we perform a lookup for a TypeId on this object,
@@ -173,6 +179,11 @@ Object::DoGetObject (TypeId tid) const
           current->m_getObjectCount++;
           // then, update the sort
           UpdateSortedArray (m_aggregates, i);
+          // and the lookup cache, which makes the next lookups constant time
+          uint16_t uid = tid.GetUid ();
+          uint32_t slot = uid & (Aggregates::CACHE_SIZE - 1);
+          m_aggregates->cacheTid[slot] = uid;
+          m_aggregates->cacheObject[slot] = current;
           // finally, return the match
           return const_cast<Object *> (current);
         }
@@ -260,9 +271,7 @@ Object::AggregateObject (Ptr<Object> o)
   Object *other = PeekPointer (o);
   // first create the new aggregate buffer.
   uint32_t total = m_aggregates->n + other->m_aggregates->n;
-  struct Aggregates *aggregates =
-    (struct Aggregates *)std::malloc (sizeof(struct Aggregates) + (total - 1) * sizeof(Object*));
-  aggregates->n = total;
+  struct Aggregates *aggregates = AllocateAggregates (total);
 
   // copy our buffer to the new buffer
   std::memcpy (&aggregates->buffer[0],
@@ -341,15 +341,44 @@ private:
    * chunk of memory than the struct to allow space for a larger
    * variable sized buffer whose size is indicated by the element
    * \c n
+   *
+   * The result of the latest GetObject() lookups is cached in a small
+   * direct-mapped table indexed by the TypeId uid, which is valid as long
+   * as the list does not change: a new list is allocated by each
+   * aggregation.
    */
   struct Aggregates
   {
+    /** The size of the lookup cache, a power of two. */
+    enum
+    {
+      CACHE_SIZE = 4
+    };
     /** The number of entries in \c buffer. */
     uint32_t n;
+    /** The TypeId uid of each entry of the lookup cache, 0 if empty. */
+    uint16_t cacheTid[CACHE_SIZE];
+    /** The Object found for each entry of the lookup cache. */
+    Object *cacheObject[CACHE_SIZE];
     /** The array of Objects. */
     Object *buffer[1];
   };
 
+  /**
+   * Allocate a list of aggregates, with an empty lookup cache.
+   *
+   * \param [in] n The number of entries in the list.
+   * \return The list, with \c n set.
+   */
+  static struct Aggregates * AllocateAggregates (uint32_t n);
+  /**
+   * Find an Object of TypeId tid in the lookup cache of the aggregates.
+   *
+   * \param [in] tid The TypeId we're looking for
+   * \return The matching Object, or 0 if the lookup is not cached.
+   */
+  inline Object * LookupCache (TypeId tid) const;
+
   /**
    * Find an Object of TypeId tid in the aggregates of this Object.
    *
@@ -465,10 +494,28 @@ ObjectDeleter::Delete (Object *object)
   object->DoDelete ();
 }
 
+Object *
+Object::LookupCache (TypeId tid) const
+{
+  uint16_t uid = tid.GetUid ();
+  uint32_t slot = uid & (Aggregates::CACHE_SIZE - 1);
+  if (m_aggregates->cacheTid[slot] == uid)
+    {
+      return m_aggregates->cacheObject[slot];
+    }
+  return 0;
+}
+
 template <typename T>
 Ptr<T>
 Object::GetObject () const
 {
+  // The lookups are cached, so that the repeated ones take constant time.
+  Object *cached = LookupCache (T::GetTypeId ());
+  if (cached != 0)
+    {
+      return Ptr<T> (static_cast<T *> (cached));
+    }
   // This is an optimization: if the cast works (which is likely),
   // things will be pretty fast.
   T *result = dynamic_cast<T *> (m_aggregates->buffer[0]);
@@ -497,6 +544,11 @@ template <typename T>
 Ptr<T>
 Object::GetObject (TypeId tid) const
 {
+  Object *cached = LookupCache (tid);
+  if (cached != 0)
+    {
+      return Ptr<T> (static_cast<T *> (cached));
+    }
   Ptr<Object> found = DoGetObject (tid);
   if (found != 0)
     {
@@ -132,6 +132,16 @@ RandomVariableStream::GetStream (void) const
   return m_stream;
 }
 
+void
+RandomVariableStream::GetValues (double *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  for (std::size_t i = 0; i < n; i++)
+    {
+      values[i] = GetValue ();
+    }
+}
+
 RngStream *
 RandomVariableStream::Peek (void) const
 {
@@ -210,6 +220,29 @@ UniformRandomVariable::GetInteger (void)
   return (uint32_t)GetValue (m_min, m_max + 1);
 }
 
+void
+UniformRandomVariable::GetValues (double *values, std::size_t n, double min, double max)
+{
+  NS_LOG_FUNCTION (this << values << n << min << max);
+  Peek ()->RandU01 (values, n);
+  bool antithetic = IsAntithetic ();
+  for (std::size_t i = 0; i < n; i++)
+    {
+      double v = min + values[i] * (max - min);
+      if (antithetic)
+        {
+          v = min + (max - v);
+        }
+      values[i] = v;
+    }
+}
+void
+UniformRandomVariable::GetValues (double *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  GetValues (values, n, m_min, m_max);
+}
+
 NS_OBJECT_ENSURE_REGISTERED (ConstantRandomVariable);
 
 TypeId
@@ -764,6 +797,66 @@ NormalRandomVariable::GetInteger (void)
   return (uint32_t)GetValue (m_mean, m_variance, m_bound);
 }
 
+void
+NormalRandomVariable::GetValues (double *values, std::size_t n, double mean, double variance, double bound)
+{
+  NS_LOG_FUNCTION (this << values << n << mean << variance << bound);
+  // the same draws as GetValue (mean, variance, bound), including the
+  // value kept for the next call
+  std::size_t i = 0;
+  if (n > 0 && m_nextValid)
+    {
+      m_nextValid = false;
+      values[i++] = m_next;
+    }
+  RngStream *rng = Peek ();
+  bool antithetic = IsAntithetic ();
+  double stddev = std::sqrt (variance);
+  while (i < n)
+    {
+      double u1 = rng->RandU01 ();
+      double u2 = rng->RandU01 ();
+      if (antithetic)
+        {
+          u1 = (1 - u1);
+          u2 = (1 - u2);
+        }
+      double v1 = 2 * u1 - 1;
+      double v2 = 2 * u2 - 1;
+      double w = v1 * v1 + v2 * v2;
+      if (w <= 1.0)
+        {
+          double y = std::sqrt ((-2 * std::log (w)) / w);
+          double x2 = mean + v2 * y * stddev;
+          bool x2Valid = std::fabs (x2 - mean) <= bound;
+          double x1 = mean + v1 * y * stddev;
+          if (std::fabs (x1 - mean) <= bound)
+            {
+              values[i++] = x1;
+              if (x2Valid && i == n)
+                {
+                  m_next = x2;
+                  m_nextValid = true;
+                }
+              else if (x2Valid)
+                {
+                  values[i++] = x2;
+                }
+            }
+          else if (x2Valid)
+            {
+              values[i++] = x2;
+            }
+        }
+    }
+}
+void
+NormalRandomVariable::GetValues (double *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  GetValues (values, n, m_mean, m_variance, m_bound);
+}
+
 NS_OBJECT_ENSURE_REGISTERED (LogNormalRandomVariable);
 
 TypeId
@@ -30,6 +30,7 @@
 #include "object.h"
 #include "attribute-helper.h"
 #include <stdint.h>
+#include <cstddef>
 
 /**
  * \file
@@ -149,6 +150,18 @@ public:
    */
   virtual uint32_t GetInteger (void) = 0;
 
+  /**
+   * \brief Get the next random values as doubles drawn from the distribution.
+   *
+   * The values are the same as those of \p n calls to GetValue(void),
+   * and the stream is left in the same state. The default implementation
+   * calls GetValue(void); the distributions override it to draw the
+   * values without a virtual call per value.
+   * \param [out] values The random values.
+   * \param [in] n The number of values.
+   */
+  virtual void GetValues (double *values, std::size_t n);
+
 protected:
   /**
    * \brief Get the pointer to the underlying RngStream.
@@ -281,6 +294,16 @@ public:
    */
   uint32_t GetInteger (uint32_t min, uint32_t max);
 
+  /**
+   * \brief Get the next random values drawn from the distribution.
+   * \param [out] values The random values, as \p n calls to
+   *             GetValue(double,double).
+   * \param [in] n The number of values.
+   * \param [in] min Low end of the range (included).
+   * \param [in] max High end of the range (excluded).
+   */
+  void GetValues (double *values, std::size_t n, double min, double max);
+
   // Inherited from RandomVariableStream
   /**
    * \brief Get the next random value as a double drawn from the distribution.
@@ -294,6 +317,7 @@ public:
    * \note The upper limit is included in the output range.
    */
   virtual uint32_t GetInteger (void);
+  virtual void GetValues (double *values, std::size_t n);
 
 private:
   /** The lower bound on values that can be returned by this RNG stream. */
@@ -1227,6 +1251,21 @@ public:
    */
   virtual uint32_t GetInteger (void);
 
+  /**
+   * \brief Get the next random values from a normal distribution with the specified mean, variance, and bound.
+   * \param [out] values The random values, as \p n calls to
+   *             GetValue(double,double,double).
+   * \param [in] n The number of values.
+   * \param [in] mean Mean value for the normal distribution.
+   * \param [in] variance Variance value for the normal distribution.
+   * \param [in] bound Bound on values returned.
+   */
+  void GetValues (double *values, std::size_t n, double mean, double variance,
+                  double bound = NormalRandomVariable::INFINITE_VALUE);
+
+  // Inherited from RandomVariableStream
+  virtual void GetValues (double *values, std::size_t n);
+
 private:
   /** The mean value for the normal distribution returned by this RNG stream. */
   double m_mean;
@@ -21,6 +21,7 @@
 #define RNGSTREAM_H
 #include <string>
 #include <stdint.h>
+#include <cstddef>
 
 /**
  * \file
@@ -70,6 +71,16 @@ public:
    * \returns The next random.
    */
   double RandU01 (void);
+  /**
+   * Generate the next random numbers for this stream.
+   *
+   * The numbers are the same as those of \pname{n} calls to RandU01(),
+   * but the state is kept in registers across the calls.
+   *
+   * \param [out] values The random numbers.
+   * \param [in] n The number of random numbers.
+   */
+  void RandU01 (double *values, std::size_t n);
 
 private:
   /**
@@ -0,0 +1,242 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "simulation-fork.h"
+#include "simulator.h"
+#include "config.h"
+#include "string.h"
+#include "abort.h"
+#include "log.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::SimulationFork implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SimulationFork");
+
+namespace {
+
+/** The branches and the callbacks of the fork. */
+struct SimulationForkState
+{
+  /** Constructor. */
+  SimulationForkState ()
+    : branch (SimulationFork::NO_BRANCH),
+      forked (false),
+      scheduled (false),
+      maxChildren (0)
+  {}
+  /** The overrides of each branch. */
+  std::vector<SimulationFork::Overrides> branches;
+  /** The callbacks run in the parent before the fork. */
+  std::vector<Callback<void> > prepare;
+  /** The callbacks run in each child after the fork. */
+  std::vector<Callback<void, uint32_t> > child;
+  /** The branch of this process. */
+  uint32_t branch;
+  /** Flag \c true in the parent after the fork. */
+  bool forked;
+  /** Flag \c true if the fork has been scheduled. */
+  bool scheduled;
+  /** The maximum number of children running at the same time. */
+  uint32_t maxChildren;
+};
+
+/**
+ * Get the state of the fork.
+ * \return The state.
+ */
+SimulationForkState &
+GetState (void)
+{
+  static SimulationForkState state;
+  return state;
+}
+
+/**
+ * Wait for a child to terminate.
+ * \return \c true if the child exited with success.
+ */
+bool
+WaitChild (void)
+{
+  int status;
+  pid_t pid;
+  do
+    {
+      pid = waitpid (-1, &status, 0);
+    }
+  while (pid < 0 && errno == EINTR);
+  NS_ABORT_MSG_IF (pid < 0, "waitpid failed: " << std::strerror (errno));
+  bool success = WIFEXITED (status) && WEXITSTATUS (status) == 0;
+  if (!success)
+    {
+      NS_LOG_WARN ("Branch process " << pid << " failed with status " << status);
+    }
+  return success;
+}
+
+} // unnamed namespace
+
+uint32_t
+SimulationFork::AddBranch (const Overrides &overrides)
+{
+  NS_LOG_FUNCTION (overrides.size ());
+  SimulationForkState &state = GetState ();
+  NS_ABORT_MSG_IF (state.forked || state.branch != NO_BRANCH, "Branch added after the fork");
+  state.branches.push_back (overrides);
+  return state.branches.size () - 1;
+}
+
+void
+SimulationFork::Schedule (const Time &at, uint32_t maxChildren)
+{
+  NS_LOG_FUNCTION (at << maxChildren);
+  SimulationForkState &state = GetState ();
+  NS_ABORT_MSG_IF (state.scheduled, "The fork can be scheduled only once");
+  NS_ABORT_MSG_IF (at < Simulator::Now (), "The fork cannot be scheduled in the past");
+  state.scheduled = true;
+  state.maxChildren = maxChildren;
+  Simulator::Schedule (at - Simulator::Now (), &SimulationFork::Fork);
+}
+
+void
+SimulationFork::AddPrepareCallback (Callback<void> cb)
+{
+  NS_LOG_FUNCTION (&cb);
+  GetState ().prepare.push_back (cb);
+}
+
+void
+SimulationFork::AddChildCallback (Callback<void, uint32_t> cb)
+{
+  NS_LOG_FUNCTION (&cb);
+  GetState ().child.push_back (cb);
+}
+
+uint32_t
+SimulationFork::GetBranch (void)
+{
+  return GetState ().branch;
+}
+
+bool
+SimulationFork::HasForked (void)
+{
+  return GetState ().forked;
+}
+
+std::string
+SimulationFork::GetFileName (std::string filename)
+{
+  uint32_t branch = GetState ().branch;
+  if (branch == NO_BRANCH)
+    {
+      return filename;
+    }
+  std::string suffix = "-branch" + std::to_string (branch);
+  std::string::size_type slash = filename.find_last_of ('/');
+  std::string::size_type dot = filename.find_last_of ('.');
+  if (dot == std::string::npos || dot == 0 || (slash != std::string::npos && dot <= slash + 1))
+    {
+      return filename + suffix;
+    }
+  return filename.substr (0, dot) + suffix + filename.substr (dot);
+}
+
+void
+SimulationFork::Fork (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  SimulationForkState &state = GetState ();
+  if (state.branches.empty ())
+    {
+      NS_LOG_WARN ("No branches, the simulation continues without forking");
+      return;
+    }
+
+  for (std::vector<Callback<void> >::const_iterator i = state.prepare.begin ();
+       i != state.prepare.end (); ++i)
+    {
+      (*i)();
+    }
+  // the buffered output would be written by the parent and by each child,
+  // the C++ file streams are flushed by the prepare callbacks
+  std::cout.flush ();
+  std::cerr.flush ();
+  std::fflush (0);
+
+  uint32_t running = 0;
+  uint32_t failed = 0;
+  for (uint32_t branch = 0; branch < state.branches.size (); ++branch)
+    {
+      if (state.maxChildren != 0 && running == state.maxChildren)
+        {
+          failed += WaitChild () ? 0 : 1;
+          running--;
+        }
+      pid_t pid = fork ();
+      NS_ABORT_MSG_IF (pid < 0, "fork failed: " << std::strerror (errno));
+      if (pid == 0)
+        {
+          state.branch = branch;
+          for (std::vector<Callback<void, uint32_t> >::const_iterator i = state.child.begin ();
+               i != state.child.end (); ++i)
+            {
+              (*i)(branch);
+            }
+          const Overrides &overrides = state.branches[branch];
+          for (Overrides::const_iterator i = overrides.begin (); i != overrides.end (); ++i)
+            {
+              NS_LOG_INFO ("Branch " << branch << ": " << i->first << "=" << i->second);
+              if (!i->first.empty () && i->first[0] == '/')
+                {
+                  Config::Set (i->first, StringValue (i->second));
+                }
+              else
+                {
+                  Config::SetDefault (i->first, StringValue (i->second));
+                }
+            }
+          return;
+        }
+      NS_LOG_INFO ("Branch " << branch << " runs in process " << pid);
+      running++;
+    }
+  while (running > 0)
+    {
+      failed += WaitChild () ? 0 : 1;
+      running--;
+    }
+  NS_LOG_INFO (state.branches.size () - failed << " of " << state.branches.size () << " branches succeeded");
+
+  state.forked = true;
+  Simulator::Stop ();
+}
+
+} // namespace ns3
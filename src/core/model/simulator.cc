@@ -152,6 +152,14 @@ Simulator::Destroy (void)
   (*pimpl)->Destroy ();
   (*pimpl)->Unref ();
   *pimpl = 0;
+
+  // the implementation released all the pending events, the remaining ones
+  // are held by EventId instances which are still alive
+  uint64_t outstanding = EventImpl::GetOutstandingEvents ();
+  if (outstanding != 0)
+    {
+      NS_LOG_LOGIC (outstanding << " events are still allocated, held by EventId instances which are still alive");
+    }
 }
 
 void
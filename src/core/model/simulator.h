@@ -119,6 +119,10 @@ public:
    * After this method has been invoked, it is actually possible
    * to restart a new simulation with a set of calls to Simulator::Run,
    * Simulator::Schedule and Simulator::ScheduleWithContext.
+   *
+   * The events which are still allocated afterwards are held by EventId
+   * instances which are still alive, e.g., members of the models, and are
+   * released with them.
    */
   static void Destroy (void);
 
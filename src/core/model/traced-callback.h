@@ -21,7 +21,7 @@
 #ifndef TRACED_CALLBACK_H
 #define TRACED_CALLBACK_H
 
-#include <list>
+#include <vector>
 #include "callback.h"
 
 /**
@@ -46,6 +46,14 @@ namespace ns3 {
  * calling the \c operator() form with the appropriate
  * number of arguments.
  *
+ * The callers which build the arguments only for the trace can check
+ * IsEmpty() first, and skip them when no Callback is connected.
+ *
+ * A Callback may connect or disconnect Callbacks while the chain is
+ * invoked: the invocation calls all the Callbacks connected when it
+ * started and not disconnected yet, in order, and the Callbacks connected
+ * in the meantime are called from the next invocation.
+ *
  * \tparam Ts \explicit Types of the functor arguments.
  */
 template<typename... Ts>
@@ -89,6 +97,15 @@ public:
    * \param [in] args The arguments to the functor
    */
   void operator() (Ts... args) const;
+  /**
+   * Check if the chain of Callbacks is empty.
+   *
+   * \return \c true if no Callback is connected.
+   */
+  bool IsEmpty (void) const
+  {
+    return m_callbackList.size () == m_nullified;
+  }
 
   /**
    *  TracedCallback signature for POD.
@@ -105,11 +122,28 @@ private:
   /**
    * Container type for holding the chain of Callbacks.
    *
+   * The Callbacks are contiguous, so that the chain is invoked without
+   * chasing list nodes.
+   *
    * \tparam Ts \deduced Types of the functor arguments.
    */
-  typedef std::list<Callback<void,Ts...> > CallbackList;
-  /** The chain of Callbacks. */
-  CallbackList m_callbackList;
+  typedef std::vector<Callback<void,Ts...> > CallbackList;
+
+  /** Remove from the chain the Callbacks disconnected while it was invoked. */
+  void RemoveNullified (void) const;
+
+  /**
+   * The chain of Callbacks.
+   *
+   * The Callbacks disconnected while the chain is invoked are nullified
+   * rather than erased, so that the indices of the following ones do not
+   * change, and removed at the end of the invocation.
+   */
+  mutable CallbackList m_callbackList;
+  /** The number of nullified Callbacks in the chain. */
+  mutable std::size_t m_nullified;
+  /** The number of nested invocations of the chain in progress. */
+  mutable uint32_t m_invoking;
 };
 
 } // namespace ns3
@@ -123,7 +157,9 @@ namespace ns3 {
 
 template<typename... Ts>
 TracedCallback<Ts...>::TracedCallback ()
-  : m_callbackList ()
+  : m_callbackList (),
+    m_nullified (0),
+    m_invoking (0)
 {}
 template<typename... Ts>
 void
@@ -155,14 +191,20 @@ TracedCallback<Ts...>::DisconnectWithoutContext (const CallbackBase & callback)
   for (typename CallbackList::iterator i = m_callbackList.begin ();
        i != m_callbackList.end (); /* empty */)
     {
-      if ((*i).IsEqual (callback))
+      if ((*i).IsNull () || !(*i).IsEqual (callback))
         {
-          i = m_callbackList.erase (i);
+          i++;
         }
-      else
+      else if (m_invoking > 0)
         {
+          (*i).Nullify ();
+          m_nullified++;
           i++;
         }
+      else
+        {
+          i = m_callbackList.erase (i);
+        }
     }
 }
 template<typename... Ts>
@@ -181,11 +223,43 @@ template<typename... Ts>
 void
 TracedCallback<Ts...>::operator() (Ts... args) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  // a Callback may connect another one to the chain, which reallocates
+  // the vector, or disconnect itself, which releases its implementation,
+  // hence the index and the copy of the Callback
+  m_invoking++;
+  std::size_t size = m_callbackList.size ();
+  for (std::size_t i = 0; i < size; i++)
+    {
+      if (!m_callbackList[i].IsNull ())
+        {
+          Callback<void,Ts...> cb = m_callbackList[i];
+          cb (args...);
+        }
+    }
+  m_invoking--;
+  if (m_invoking == 0 && m_nullified > 0)
+    {
+      RemoveNullified ();
+    }
+}
+
+template<typename... Ts>
+void
+TracedCallback<Ts...>::RemoveNullified (void) const
+{
+  for (typename CallbackList::iterator i = m_callbackList.begin ();
+       i != m_callbackList.end (); /* empty */)
     {
-      (*i)(args...);
+      if ((*i).IsNull ())
+        {
+          i = m_callbackList.erase (i);
+        }
+      else
+        {
+          i++;
+        }
     }
+  m_nullified = 0;
 }
 
 } // namespace ns3
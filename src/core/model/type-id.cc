@@ -143,6 +143,13 @@ public:
    * \returns The parent type id of the type id.
    */
   uint16_t GetParent (uint16_t uid) const;
+  /**
+   * Check if a type id is a child of another.
+   * \param [in] uid The id.
+   * \param [in] ancestor The id of the candidate ancestor.
+   * \returns \c true if \p ancestor is a strict ancestor of \p uid.
+   */
+  bool IsChildOf (uint16_t uid, uint16_t ancestor) const;
   /**
    * Get the group name of a type id.
    * \param [in] uid The id.
@@ -302,6 +309,12 @@ private:
     TypeId::hash_t hash;
     /** The parent type id. */
     uint16_t parent;
+    /**
+     * The ids of the ancestors, from the root of the hierarchy to this
+     * type id included, set with the parent.  Empty if the ancestry of the
+     * parent was not known yet.
+     */
+    std::vector<uint16_t> ancestry;
     /** The group name. */
     std::string groupName;
     /** The size of the object represented by this type id. */
@@ -471,6 +484,23 @@ IidManager::SetParent (uint16_t uid, uint16_t parent)
   NS_ASSERT (parent <= m_information.size ());
   struct IidInformation *information = LookupInformation (uid);
   information->parent = parent;
+  // the parent is registered before its children, so that its ancestry
+  // is already known: the depth of a type id in its hierarchy indexes the
+  // ancestry of its children
+  information->ancestry.clear ();
+  if (parent == uid)
+    {
+      information->ancestry.push_back (uid);
+    }
+  else if (parent != 0)
+    {
+      struct IidInformation *parentInformation = LookupInformation (parent);
+      if (!parentInformation->ancestry.empty ())
+        {
+          information->ancestry = parentInformation->ancestry;
+          information->ancestry.push_back (uid);
+        }
+    }
 }
 void
 IidManager::SetGroupName (uint16_t uid, std::string groupName)
@@ -559,6 +589,31 @@ IidManager::GetParent (uint16_t uid) const
   NS_LOG_LOGIC (IIDL << pid);
   return pid;
 }
+bool
+IidManager::IsChildOf (uint16_t uid, uint16_t ancestor) const
+{
+  NS_LOG_FUNCTION (IID << uid << ancestor);
+  struct IidInformation *information = LookupInformation (uid);
+  struct IidInformation *ancestorInformation = LookupInformation (ancestor);
+  if (!information->ancestry.empty () && !ancestorInformation->ancestry.empty ())
+    {
+      std::size_t depth = ancestorInformation->ancestry.size () - 1;
+      return depth < information->ancestry.size () - 1
+             && information->ancestry[depth] == ancestor;
+    }
+  // the ancestry is unknown, climb the hierarchy
+  uint16_t current = uid;
+  while (current != ancestor && current != 0)
+    {
+      uint16_t parent = LookupInformation (current)->parent;
+      if (parent == current)
+        {
+          break;
+        }
+      current = parent;
+    }
+  return current == ancestor && uid != ancestor;
+}
 std::string
 IidManager::GetGroupName (uint16_t uid) const
 {
@@ -958,12 +1013,7 @@ bool
 TypeId::IsChildOf (TypeId other) const
 {
   NS_LOG_FUNCTION (this << other.GetUid ());
-  TypeId tmp = *this;
-  while (tmp != other && tmp != tmp.GetParent ())
-    {
-      tmp = tmp.GetParent ();
-    }
-  return tmp == other && *this != other;
+  return IidManager::Get ()->IsChildOf (m_tid, other.m_tid);
 }
 std::string
 TypeId::GetGroupName (void) const
@@ -1181,12 +1231,6 @@ TypeId::LookupTraceSourceByName (std::string name) const
   return LookupTraceSourceByName (name, &info);
 }
 
-uint16_t
-TypeId::GetUid (void) const
-{
-  NS_LOG_FUNCTION (this);
-  return m_tid;
-}
 void
 TypeId::SetUid (uint16_t uid)
 {
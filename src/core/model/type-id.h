@@ -207,6 +207,9 @@ public:
    * Calling this method is roughly similar to calling dynamic_cast
    * except that you do not need object instances: you can do the check
    * with TypeId instances instead.
+   *
+   * The check takes constant time: each TypeId records its ancestors
+   * when its parent is set.
    */
   bool IsChildOf (TypeId other) const;
 
@@ -504,7 +507,7 @@ public:
    * This is really an internal method which users are not expected
    * to use.
    */
-  uint16_t GetUid (void) const;
+  inline uint16_t GetUid (void) const;
   /**
    * Set the internal id of this TypeId.
    *
@@ -611,6 +614,12 @@ TypeId &TypeId::operator = (const TypeId &o)
 }
 TypeId::~TypeId ()
 {}
+uint16_t
+TypeId::GetUid (void) const
+{
+  return m_tid;
+}
+
 inline bool operator == (TypeId a, TypeId b)
 {
   return a.m_tid == b.m_tid;
@@ -840,6 +840,179 @@ SearchAttributesOfParentObjectsTestCase::DoRun (void)
 
 }
 
+/**
+ * \ingroup config-tests
+ * Test the connections which are applied to the objects added afterwards.
+ */
+class IncrementalConnectConfigTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  IncrementalConnectConfigTestCase ();
+  /** Destructor. */
+  virtual ~IncrementalConnectConfigTestCase ()
+  {}
+
+  /**
+   * Trace callback with context path.
+   * \param path The context path.
+   * \param old The old value.
+   * \param newValue The new value.
+   */
+  void TraceWithPath (std::string path, int16_t old, int16_t newValue)
+  {
+    NS_UNUSED (old);
+    m_newValue = newValue;
+    m_path = path;
+    m_count++;
+  }
+
+private:
+  virtual void DoRun (void);
+
+  int16_t m_newValue; //!< Flag to detect tracing result.
+  std::string m_path; //!< The context path.
+  uint32_t m_count;   //!< The number of trace calls.
+};
+
+IncrementalConnectConfigTestCase::IncrementalConnectConfigTestCase ()
+  : TestCase ("Check the incremental connections to the objects added after the connect")
+{}
+
+void
+IncrementalConnectConfigTestCase::DoRun (void)
+{
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Config::RegisterRootNamespaceObject (root);
+
+  //
+  // An object added before the connect is connected by the connect.
+  //
+  Ptr<ConfigTestObject> a0 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> b0 = CreateObject<ConfigTestObject> ();
+  a0->SetNodeB (b0);
+  root->AddNodeA (a0);
+
+  Config::ConnectIncremental ("/NodesA/[0-1]|3/NodeB/Source",
+                              MakeCallback (&IncrementalConnectConfigTestCase::TraceWithPath, this));
+
+  m_count = 0;
+  b0->SetAttribute ("Source", IntegerValue (-2));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -2, "Trace 0 did not fire as expected");
+  NS_TEST_ASSERT_MSG_EQ (m_path, "/NodesA/0/NodeB/Source", "Trace 0 did not provide expected context");
+  NS_TEST_ASSERT_MSG_EQ (m_count, 1, "Trace 0 fired more than once");
+
+  //
+  // An object added after the connect is connected when it is notified,
+  // only once even if it is notified again.
+  //
+  Ptr<ConfigTestObject> a1 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> b1 = CreateObject<ConfigTestObject> ();
+  a1->SetNodeB (b1);
+  root->AddNodeA (a1);
+
+  m_count = 0;
+  b1->SetAttribute ("Source", IntegerValue (-2));
+  NS_TEST_ASSERT_MSG_EQ (m_count, 0, "Trace 1 fired before the notification");
+
+  Config::NotifyNewObject ("/NodesA/1", a1);
+  Config::NotifyNewObject ("/NodesA/1", a1);
+  Config::NotifyNewObject ("/NodesA/1/NodeB", b1);
+  b1->SetAttribute ("Source", IntegerValue (-3));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -3, "Trace 1 did not fire as expected");
+  NS_TEST_ASSERT_MSG_EQ (m_path, "/NodesA/1/NodeB/Source", "Trace 1 did not provide expected context");
+  NS_TEST_ASSERT_MSG_EQ (m_count, 1, "Trace 1 connected more than once");
+
+  //
+  // An object which does not match the path is not connected.
+  //
+  Ptr<ConfigTestObject> a2 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> b2 = CreateObject<ConfigTestObject> ();
+  a2->SetNodeB (b2);
+  root->AddNodeA (a2);
+  Config::NotifyNewObject ("/NodesA/2", a2);
+  Config::NotifyNewObject ("/NodesB/3", a2);
+
+  m_count = 0;
+  b2->SetAttribute ("Source", IntegerValue (-4));
+  NS_TEST_ASSERT_MSG_EQ (m_count, 0, "Trace 2 fired unexpectedly");
+
+  //
+  // The connect and the following notifications match the same objects
+  // as a lookup of the whole namespace.
+  //
+  Ptr<ConfigTestObject> a3 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> b3 = CreateObject<ConfigTestObject> ();
+  a3->SetNodeB (b3);
+  root->AddNodeA (a3);
+  Config::NotifyNewObject ("/NodesA/3", a3);
+
+  Config::MatchContainer container = Config::LookupMatches ("/NodesA/[0-1]|3/NodeB");
+  NS_TEST_ASSERT_MSG_EQ (container.GetN (), 3, "Unexpected number of matches");
+  NS_TEST_ASSERT_MSG_EQ (container.GetMatchedPath (2), "/NodesA/3/NodeB/", "Unexpected match");
+  m_count = 0;
+  b3->SetAttribute ("Source", IntegerValue (-5));
+  NS_TEST_ASSERT_MSG_EQ (m_path, "/NodesA/3/NodeB/Source", "Trace 3 did not provide expected context");
+  NS_TEST_ASSERT_MSG_EQ (m_count, 1, "Trace 3 did not fire as expected");
+
+  //
+  // The disconnect removes the pending connection.
+  //
+  Config::Disconnect ("/NodesA/[0-1]|3/NodeB/Source",
+                      MakeCallback (&IncrementalConnectConfigTestCase::TraceWithPath, this));
+  Ptr<ConfigTestObject> a4 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> b4 = CreateObject<ConfigTestObject> ();
+  a4->SetNodeB (b4);
+  root->AddNodeA (a4);
+  Config::NotifyNewObject ("/NodesA/1", a4);
+
+  m_count = 0;
+  b0->SetAttribute ("Source", IntegerValue (-6));
+  b4->SetAttribute ("Source", IntegerValue (-7));
+  NS_TEST_ASSERT_MSG_EQ (m_count, 0, "Trace fired after the disconnect");
+
+  //
+  // Unregistering the root, as the NodeList does at Simulator::Destroy,
+  // removes the pending connections: the objects of a new root with the
+  // same path, e.g., the nodes of the next run, are not connected.
+  //
+  Config::ConnectIncremental ("/NodesA/*/NodeB/Source",
+                              MakeCallback (&IncrementalConnectConfigTestCase::TraceWithPath, this));
+  Config::UnregisterRootNamespaceObject (root);
+
+  root = CreateObject<ConfigTestObject> ();
+  Config::RegisterRootNamespaceObject (root);
+  Ptr<ConfigTestObject> a5 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> b5 = CreateObject<ConfigTestObject> ();
+  a5->SetNodeB (b5);
+  root->AddNodeA (a5);
+  Config::NotifyNewObject ("/NodesA/0", a5);
+
+  m_count = 0;
+  b5->SetAttribute ("Source", IntegerValue (-8));
+  NS_TEST_ASSERT_MSG_EQ (m_count, 0, "Trace of the previous root fired after the re-creation");
+
+  //
+  // A connection made after the re-creation applies to the new objects.
+  //
+  Config::ConnectIncremental ("/NodesA/*/NodeB/Source",
+                              MakeCallback (&IncrementalConnectConfigTestCase::TraceWithPath, this));
+  Ptr<ConfigTestObject> a6 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> b6 = CreateObject<ConfigTestObject> ();
+  a6->SetNodeB (b6);
+  root->AddNodeA (a6);
+  Config::NotifyNewObject ("/NodesA/1", a6);
+
+  m_count = 0;
+  b6->SetAttribute ("Source", IntegerValue (-9));
+  NS_TEST_ASSERT_MSG_EQ (m_path, "/NodesA/1/NodeB/Source", "Trace 6 did not provide expected context");
+  NS_TEST_ASSERT_MSG_EQ (m_count, 1, "Trace 6 did not fire as expected");
+
+  Config::Disconnect ("/NodesA/*/NodeB/Source",
+                      MakeCallback (&IncrementalConnectConfigTestCase::TraceWithPath, this));
+  Config::UnregisterRootNamespaceObject (root);
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -858,6 +1031,7 @@ ConfigTestSuite::ConfigTestSuite ()
   AddTestCase (new UnderRootNamespaceConfigTestCase);
   AddTestCase (new ObjectVectorConfigTestCase);
   AddTestCase (new SearchAttributesOfParentObjectsTestCase);
+  AddTestCase (new IncrementalConnectConfigTestCase);
 }
 
 /**
@@ -0,0 +1,262 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+
+#include <sstream>
+#include <string>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup logging
+ * \ingroup log-tests
+ * Log test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup log-tests Log test suite
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+NS_LOG_COMPONENT_DEFINE ("LogTestSuite");
+
+/** A component with its logging compiled. */
+static CompiledLogComponent<true> g_compiledIn ("LogTestCompiledIn", __FILE__);
+/** A component with its logging compiled out. */
+static CompiledLogComponent<false> g_compiledOut ("LogTestCompiledOut", __FILE__);
+/** The component of the LogRecord tests. */
+static CompiledLogComponent<true> g_ringLog ("LogTestRingBuffer", __FILE__);
+
+
+/**
+ * \ingroup log-tests
+ *
+ * Test the selection of the log components compiled with logging.
+ */
+class LogCompiledInTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  LogCompiledInTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LogCompiledInTestCase::LogCompiledInTestCase ()
+  : TestCase ("Check the log components compiled with logging")
+{}
+
+void
+LogCompiledInTestCase::DoRun (void)
+{
+  NS_TEST_ASSERT_MSG_EQ (LogComponentIsCompiledIn ("*", "Node"), true, "* matches all the components");
+  NS_TEST_ASSERT_MSG_EQ (LogComponentIsCompiledIn ("Node", "Node"), true, "Single component");
+  NS_TEST_ASSERT_MSG_EQ (LogComponentIsCompiledIn ("Channel:Node:Mac", "Node"), true, "Middle of the list");
+  NS_TEST_ASSERT_MSG_EQ (LogComponentIsCompiledIn ("Channel:Node", "Node"), true, "End of the list");
+  NS_TEST_ASSERT_MSG_EQ (LogComponentIsCompiledIn ("Channel:*", "Node"), true, "* at the end of the list");
+  NS_TEST_ASSERT_MSG_EQ (LogComponentIsCompiledIn ("Channel:Mac", "Node"), false, "Not in the list");
+  NS_TEST_ASSERT_MSG_EQ (LogComponentIsCompiledIn ("NodeList", "Node"), false, "Prefix of an entry");
+  NS_TEST_ASSERT_MSG_EQ (LogComponentIsCompiledIn ("Nod", "Node"), false, "Entry prefix of the name");
+  NS_TEST_ASSERT_MSG_EQ (LogComponentIsCompiledIn ("", "Node"), false, "Empty list");
+  static_assert (LogComponentIsCompiledIn ("A:B", "B"), "LogComponentIsCompiledIn is not a constant expression");
+
+  g_compiledIn.Enable (LOG_LEVEL_ALL);
+  g_compiledOut.Enable (LOG_LEVEL_ALL);
+  NS_TEST_ASSERT_MSG_EQ (g_compiledIn.IsEnabled (LOG_DEBUG), true, "Compiled component not enabled");
+  NS_TEST_ASSERT_MSG_EQ (g_compiledOut.IsEnabled (LOG_DEBUG), false, "Compiled out component enabled");
+  NS_TEST_ASSERT_MSG_EQ (static_cast<LogComponent &> (g_compiledOut).IsEnabled (LOG_DEBUG), true,
+                         "Compiled out component not registered as enabled");
+  g_compiledIn.Disable (LOG_LEVEL_ALL);
+  g_compiledOut.Disable (LOG_LEVEL_ALL);
+}
+
+
+/**
+ * \ingroup log-tests
+ *
+ * A value counting its copies and how many times it is formatted.
+ */
+struct LogTestValue
+{
+  /** Constructor. */
+  LogTestValue ()
+  {
+    alive++;
+  }
+  /** Copy constructor. */
+  LogTestValue (const LogTestValue &)
+  {
+    alive++;
+  }
+  /** Destructor. */
+  ~LogTestValue ()
+  {
+    alive--;
+  }
+  static int alive;    //!< The number of existing values.
+  static int printed;  //!< The number of times the values were formatted.
+};
+
+int LogTestValue::alive = 0;
+int LogTestValue::printed = 0;
+
+/**
+ * Format a LogTestValue.
+ * \param [in,out] os The output stream.
+ * \param [in] value The value.
+ * \return The output stream.
+ */
+std::ostream &
+operator << (std::ostream &os, const LogTestValue &value)
+{
+  LogTestValue::printed++;
+  os << "value";
+  return os;
+}
+
+/**
+ * \ingroup log-tests
+ *
+ * Test the LogRingBuffer.
+ */
+class LogRingBufferTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  LogRingBufferTestCase ();
+
+private:
+  virtual void DoRun (void);
+  virtual void DoTeardown (void);
+  /**
+   * Dump the ring buffer.
+   * \return The formatted records.
+   */
+  std::string Dump (void);
+};
+
+LogRingBufferTestCase::LogRingBufferTestCase ()
+  : TestCase ("Check the binary ring buffer of the logs")
+{}
+
+std::string
+LogRingBufferTestCase::Dump (void)
+{
+  std::ostringstream oss;
+  LogRingBuffer::Dump (oss);
+  return oss.str ();
+}
+
+void
+LogRingBufferTestCase::DoRun (void)
+{
+  LogRingBuffer::Enable (2);
+  NS_TEST_ASSERT_MSG_EQ (LogRingBuffer::IsEnabled (), true, "Ring buffer not enabled");
+  NS_TEST_ASSERT_MSG_EQ (Dump (), "", "Records in a new ring buffer");
+
+  LogRecord (g_ringLog, "First", LOG_DEBUG) << "lost";
+  LogRecord (g_ringLog, "Second", LOG_FUNCTION, true) << this << std::string ("x")
+                                                     << int8_t (-3) << 2.5 << true;
+  LogRecord (g_ringLog, "Third", LOG_DEBUG) << "hex " << std::hex << 255 << " " << 'c';
+  std::ostringstream expected;
+  expected << "LogTestRingBuffer:Second(" << this << ", \"x\", -3, 2.5, 1)" << std::endl
+           << "hex ff c" << std::endl;
+  NS_TEST_ASSERT_MSG_EQ (Dump (), expected.str (), "Wrong records, or oldest record not overwritten");
+
+  LogRingBuffer::Clear ();
+  NS_TEST_ASSERT_MSG_EQ (Dump (), "", "Records after Clear");
+
+  g_ringLog.Enable (LogLevel (LOG_PREFIX_FUNC | LOG_PREFIX_LEVEL));
+  LogRecord (g_ringLog, "Fourth", LOG_INFO) << "time " << Seconds (1);
+  LogRecord (g_ringLog, "Fifth", LOG_FUNCTION, true) << 1 << 2 << 3 << 4 << 5 << 6 << 7 << 8 << 9;
+  g_ringLog.Disable (LOG_PREFIX_ALL);
+  expected.str ("");
+  expected << "LogTestRingBuffer:Fourth(): [INFO ] time " << Seconds (1) << std::endl
+           << "LogTestRingBuffer:Fifth(1, 2, 3, 4, 5, 6, 7, 8...)" << std::endl;
+  NS_TEST_ASSERT_MSG_EQ (Dump (), expected.str (), "Wrong prefixes or truncation");
+
+  LogRingBuffer::Clear ();
+  {
+    LogTestValue value;
+    Ptr<Object> object = CreateObject<Object> ();
+    LogRecord (g_ringLog, "Sixth", LOG_DEBUG) << value << " " << object;
+    NS_TEST_ASSERT_MSG_EQ (LogTestValue::printed, 0, "Value formatted when logged");
+    NS_TEST_ASSERT_MSG_EQ (LogTestValue::alive, 2, "Value not copied in the record");
+    NS_TEST_ASSERT_MSG_EQ (object->GetReferenceCount (), 1, "Ptr held by the record");
+    expected.str ("");
+    expected << "value " << object << std::endl;
+    NS_TEST_ASSERT_MSG_EQ (Dump (), expected.str (), "Wrong copied value or Ptr");
+    NS_TEST_ASSERT_MSG_EQ (LogTestValue::printed, 1, "Value not formatted by Dump");
+  }
+  NS_TEST_ASSERT_MSG_EQ (LogTestValue::alive, 1, "Copy released before the record");
+  LogRingBuffer::Clear ();
+  NS_TEST_ASSERT_MSG_EQ (LogTestValue::alive, 0, "Copy not released by Clear");
+
+#ifdef NS3_LOG_ENABLE
+  LogRingBuffer::Clear ();
+  LogComponentEnable ("LogTestSuite", LOG_LEVEL_ALL);
+  NS_LOG_FUNCTION (7 << "s");
+  NS_LOG_DEBUG ("n=" << 3);
+  LogComponentDisable ("LogTestSuite", LOG_LEVEL_ALL);
+  NS_TEST_ASSERT_MSG_EQ (Dump (), "LogTestSuite:DoRun(7, \"s\")\nn=3\n", "Wrong records of the NS_LOG macros");
+#endif
+}
+
+void
+LogRingBufferTestCase::DoTeardown (void)
+{
+  LogRingBuffer::Disable ();
+}
+
+
+/**
+ * \ingroup log-tests
+ *
+ * Log test suite.
+ */
+class LogTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  LogTestSuite ();
+};
+
+LogTestSuite::LogTestSuite ()
+  : TestSuite ("log")
+{
+  AddTestCase (new LogCompiledInTestCase);
+  AddTestCase (new LogRingBufferTestCase);
+}
+
+/**
+ * \ingroup log-tests
+ * LogTestSuite instance variable.
+ */
+static LogTestSuite g_logTestSuite;
+
+
+}  // namespace tests
+
+}  // namespace ns3
@@ -975,6 +975,83 @@ AlternateFindTestCase::DoRun (void)
                          "Unexpectedly able to GetObject<TestObject> on an AlternateTestObject");
 }
 
+/**
+ * \ingroup names-tests
+ * Test the Object Name Service can cache the lookup of a path.
+ *
+ *     Find (const Handle &handle);
+ *
+ */
+class HandleFindTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  HandleFindTestCase ();
+  /** Destructor. */
+  virtual ~HandleFindTestCase ();
+
+private:
+  virtual void DoRun (void);
+  virtual void DoTeardown (void);
+};
+
+HandleFindTestCase::HandleFindTestCase ()
+  : TestCase ("Check Names::Find with a cached Handle")
+{}
+
+HandleFindTestCase::~HandleFindTestCase ()
+{}
+
+void
+HandleFindTestCase::DoTeardown (void)
+{
+  Names::Clear ();
+}
+
+void
+HandleFindTestCase::DoRun (void)
+{
+  Ptr<TestObject> found;
+
+  Names::Handle handle ("/Names/Name One/Child");
+  Names::Handle relative ("Name One/Child");
+  found = Names::Find<TestObject> (handle);
+  NS_TEST_ASSERT_MSG_EQ (found, 0, "Unexpectedly found a non-existent Object");
+
+  Ptr<TestObject> objectOne = CreateObject<TestObject> ();
+  Names::Add ("Name One", objectOne);
+  Ptr<TestObject> childOfObjectOne = CreateObject<TestObject> ();
+  Names::Add ("Name One/Child", childOfObjectOne);
+
+  found = Names::Find<TestObject> (handle);
+  NS_TEST_ASSERT_MSG_EQ (found, childOfObjectOne, "Could not find a name added after the lookup");
+  found = Names::Find<TestObject> (handle);
+  NS_TEST_ASSERT_MSG_EQ (found, childOfObjectOne, "Could not find a cached name");
+  found = Names::Find<TestObject> (relative);
+  NS_TEST_ASSERT_MSG_EQ (found, childOfObjectOne, "Could not find a relative name");
+
+  Ptr<AlternateTestObject> alternate = Names::Find<AlternateTestObject> (handle);
+  NS_TEST_ASSERT_MSG_EQ (alternate, 0, "Unexpectedly found an Object of the wrong type");
+
+  Names::Rename ("Name One/Child", "Other Child");
+  found = Names::Find<TestObject> (handle);
+  NS_TEST_ASSERT_MSG_EQ (found, 0, "Unexpectedly found a renamed Object");
+  Names::Rename ("Name One/Other Child", "Child");
+  found = Names::Find<TestObject> (handle);
+  NS_TEST_ASSERT_MSG_EQ (found, childOfObjectOne, "Could not find a name renamed back");
+
+  Names::Clear ();
+  found = Names::Find<TestObject> (handle);
+  NS_TEST_ASSERT_MSG_EQ (found, 0, "Unexpectedly found a cleared Object");
+
+  Ptr<TestObject> objectTwo = CreateObject<TestObject> ();
+  Names::Add ("Name One", objectTwo);
+  Ptr<TestObject> childOfObjectTwo = CreateObject<TestObject> ();
+  Names::Add ("Name One/Child", childOfObjectTwo);
+  found = Names::Find<TestObject> (handle);
+  NS_TEST_ASSERT_MSG_EQ (found, childOfObjectTwo, "Could not find a name added after a clear");
+}
+
 /**
  * \ingroup names-tests
  * Names Test Suite
@@ -1003,6 +1080,7 @@ NamesTestSuite::NamesTestSuite ()
   AddTestCase (new FullyQualifiedFindTestCase);
   AddTestCase (new RelativeFindTestCase);
   AddTestCase (new AlternateFindTestCase);
+  AddTestCase (new HandleFindTestCase);
 }
 
 /**
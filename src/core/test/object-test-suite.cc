@@ -23,6 +23,9 @@
 #include "ns3/object-factory.h"
 #include "ns3/assert.h"
 
+#include <ctime>
+#include <iostream>
+
 /**
  * \file
  * \ingroup core-tests
@@ -402,6 +405,60 @@ AggregateObjectTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_NE (baseA, 0, "Unable to GetObject on released object");
 }
 
+/**
+ * \ingroup object-tests
+ * Test the lookups cached by GetObject.
+ */
+class GetObjectCacheTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  GetObjectCacheTestCase ();
+  /** Destructor. */
+  virtual ~GetObjectCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+GetObjectCacheTestCase::GetObjectCacheTestCase ()
+  : TestCase ("Check the cache of the GetObject lookups")
+{}
+
+GetObjectCacheTestCase::~GetObjectCacheTestCase ()
+{}
+
+void
+GetObjectCacheTestCase::DoRun (void)
+{
+  Ptr<DerivedA> derivedA = CreateObject<DerivedA> ();
+  Ptr<DerivedB> derivedB = CreateObject<DerivedB> ();
+
+  //
+  // A lookup which fails is not cached, and does not hide the objects
+  // aggregated later.
+  //
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<BaseB> (), 0, "Unexpectedly found a BaseB through derivedA");
+  derivedA->AggregateObject (derivedB);
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<BaseB> (), derivedB, "Cannot GetObject (through derivedA) for BaseB Object");
+
+  //
+  // The repeated lookups, which are served by the cache, return the same
+  // objects as the first ones, also when the types share the same entry
+  // of the cache.
+  //
+  for (uint32_t i = 0; i < 3; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<BaseA> (), derivedA, "Wrong BaseA through derivedA");
+      NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<BaseA> (), derivedA, "Wrong BaseA through derivedB");
+      NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<DerivedA> (), derivedA, "Wrong DerivedA through derivedB");
+      NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<BaseB> (), derivedB, "Wrong BaseB through derivedA");
+      NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<DerivedB> (), derivedB, "Wrong DerivedB through derivedA");
+      NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<Object> (BaseB::GetTypeId ()), derivedB, "Wrong BaseB by TypeId");
+      NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<BaseA> (DerivedA::GetTypeId ()), derivedA, "Wrong DerivedA by TypeId");
+    }
+}
+
 /**
  * \ingroup object-tests
  * Test an Object factory can create Objects
@@ -492,6 +549,7 @@ ObjectTestSuite::ObjectTestSuite ()
   AddTestCase (new CreateObjectTestCase);
   AddTestCase (new AggregateObjectTestCase);
   AddTestCase (new ObjectFactoryTestCase);
+  AddTestCase (new GetObjectCacheTestCase);
 }
 
 /**
@@ -501,6 +559,130 @@ ObjectTestSuite::ObjectTestSuite ()
 static ObjectTestSuite g_objectTestSuite;
 
 
+/**
+ * \ingroup object-tests
+ * Measure the average time of a GetObject lookup.
+ */
+class GetObjectTimeTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  GetObjectTimeTestCase ();
+  /** Destructor. */
+  virtual ~GetObjectTimeTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Print the time of a lookup.
+   * \param [in] how The lookup.
+   * \param [in] delta The clock ticks of all the repetitions.
+   */
+  void Report (const std::string how, const uint32_t delta) const;
+
+  /** Number of repetitions of each lookup. */
+  enum
+  {
+    REPETITIONS = 10000000
+  };
+};
+
+GetObjectTimeTestCase::GetObjectTimeTestCase ()
+  : TestCase ("Measure average GetObject time")
+{}
+
+GetObjectTimeTestCase::~GetObjectTimeTestCase ()
+{}
+
+void
+GetObjectTimeTestCase::DoRun (void)
+{
+  Ptr<DerivedA> derivedA = CreateObject<DerivedA> ();
+  Ptr<DerivedB> derivedB = CreateObject<DerivedB> ();
+  derivedA->AggregateObject (derivedB);
+  uint32_t found = 0;
+
+  // the type of the first aggregate
+  int start = clock ();
+  for (uint32_t j = 0; j < REPETITIONS; ++j)
+    {
+      found += (derivedA->GetObject<DerivedA> () != 0);
+    }
+  int stop = clock ();
+  Report ("first aggregate", stop - start);
+
+  // a parent type of another aggregate
+  start = clock ();
+  for (uint32_t j = 0; j < REPETITIONS; ++j)
+    {
+      found += (derivedA->GetObject<BaseB> () != 0);
+    }
+  stop = clock ();
+  Report ("parent of another aggregate", stop - start);
+
+  // alternate lookups of all the types
+  start = clock ();
+  for (uint32_t j = 0; j < REPETITIONS / 4; ++j)
+    {
+      found += (derivedB->GetObject<BaseA> () != 0);
+      found += (derivedB->GetObject<DerivedA> () != 0);
+      found += (derivedA->GetObject<BaseB> () != 0);
+      found += (derivedA->GetObject<DerivedB> () != 0);
+    }
+  stop = clock ();
+  Report ("alternate types", stop - start);
+
+  // the hierarchy check behind the lookups which are not cached
+  TypeId derivedTid = DerivedB::GetTypeId ();
+  TypeId baseTid = BaseB::GetTypeId ();
+  start = clock ();
+  for (uint32_t j = 0; j < REPETITIONS; ++j)
+    {
+      found += derivedTid.IsChildOf (baseTid);
+    }
+  stop = clock ();
+  Report ("TypeId::IsChildOf", stop - start);
+
+  NS_TEST_ASSERT_MSG_EQ (found, 4 * REPETITIONS, "Lookups failed");
+}
+
+void
+GetObjectTimeTestCase::Report (const std::string how,
+                               const uint32_t    delta) const
+{
+  double per = 1E9 * double(delta) / (REPETITIONS * double(CLOCKS_PER_SEC));
+
+  std::cout << "object: GetObject time: " << how << ": "
+            << "ticks: " << delta
+            << "\tper: "   << per
+            << " ns/lookup"
+            << std::endl;
+}
+
+/**
+ * \ingroup object-tests
+ * The Test Suite of the Object performance tests.
+ */
+class ObjectPerformanceSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  ObjectPerformanceSuite ();
+};
+
+ObjectPerformanceSuite::ObjectPerformanceSuite ()
+  : TestSuite ("object-perf", PERFORMANCE)
+{
+  AddTestCase (new GetObjectTimeTestCase);
+}
+
+/**
+ * \ingroup object-tests
+ * ObjectPerformanceSuite instance variable.
+ */
+static ObjectPerformanceSuite g_objectPerformanceSuite;
+
+
 }    // namespace tests
 
 }  // namespace ns3
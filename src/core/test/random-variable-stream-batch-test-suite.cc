@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/integer.h"
+#include "ns3/object-factory.h"
+#include "ns3/random-variable-stream.h"
+
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup randomvariable
+ * RandomVariableStream::GetValues test suite.
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup core-tests
+ *
+ * Check that RandomVariableStream::GetValues draws the same values as
+ * GetValue, and leaves the stream in the same state.
+ */
+class RandomVariableStreamBatchTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor.
+   * \param [in] name The name of the distribution.
+   * \param [in] antithetic Flag \c true for antithetic values.
+   */
+  RandomVariableStreamBatchTestCase (std::string name, bool antithetic);
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Create a stream of the distribution.
+   * \return The stream.
+   */
+  Ptr<RandomVariableStream> Create (void);
+
+  std::string m_name;  //!< The name of the distribution.
+  bool m_antithetic;   //!< Flag \c true for antithetic values.
+};
+
+RandomVariableStreamBatchTestCase::RandomVariableStreamBatchTestCase (std::string name, bool antithetic)
+  : TestCase ("Check GetValues of " + name + (antithetic ? " with antithetic values" : "")),
+    m_name (name),
+    m_antithetic (antithetic)
+{}
+
+Ptr<RandomVariableStream>
+RandomVariableStreamBatchTestCase::Create (void)
+{
+  Ptr<RandomVariableStream> stream;
+  if (m_name == "Uniform")
+    {
+      stream = CreateObjectWithAttributes<UniformRandomVariable> ("Min", DoubleValue (-3.0),
+                                                                  "Max", DoubleValue (7.0));
+    }
+  else if (m_name == "Normal")
+    {
+      stream = CreateObjectWithAttributes<NormalRandomVariable> ("Mean", DoubleValue (2.0),
+                                                                 "Variance", DoubleValue (3.0));
+    }
+  else if (m_name == "BoundedNormal")
+    {
+      // the rejected values change the pairing of the draws
+      stream = CreateObjectWithAttributes<NormalRandomVariable> ("Bound", DoubleValue (0.5));
+    }
+  else
+    {
+      stream = CreateObject<ExponentialRandomVariable> ();
+    }
+  stream->SetAttribute ("Antithetic", BooleanValue (m_antithetic));
+  stream->SetStream (42);
+  return stream;
+}
+
+void
+RandomVariableStreamBatchTestCase::DoRun (void)
+{
+  Ptr<RandomVariableStream> scalar = Create ();
+  Ptr<RandomVariableStream> batch = Create ();
+
+  // batches of odd and even sizes, so that a normal value may be kept
+  // for the next call
+  uint32_t sizes[] = { 1, 2, 3, 0, 7, 64, 5, 1, 100 };
+  for (uint32_t s = 0; s < sizeof (sizes) / sizeof (sizes[0]); s++)
+    {
+      std::vector<double> values (sizes[s] + 1);
+      batch->GetValues (values.data (), sizes[s]);
+      for (uint32_t i = 0; i < sizes[s]; i++)
+        {
+          double expected = scalar->GetValue ();
+          NS_TEST_ASSERT_MSG_EQ (values[i], expected, "Value " << i << " of batch " << s << " differs from GetValue");
+        }
+    }
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (batch->GetValue (), scalar->GetValue (), "Different state after the batches");
+    }
+}
+
+
+/**
+ * \ingroup core-tests
+ *
+ * RandomVariableStream::GetValues test suite.
+ */
+class RandomVariableStreamBatchTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  RandomVariableStreamBatchTestSuite ();
+};
+
+RandomVariableStreamBatchTestSuite::RandomVariableStreamBatchTestSuite ()
+  : TestSuite ("random-variable-stream-batch", UNIT)
+{
+  const char *names[] = { "Uniform", "Normal", "BoundedNormal", "Exponential" };
+  for (uint32_t i = 0; i < sizeof (names) / sizeof (names[0]); i++)
+    {
+      AddTestCase (new RandomVariableStreamBatchTestCase (names[i], false));
+      AddTestCase (new RandomVariableStreamBatchTestCase (names[i], true));
+    }
+}
+
+/** RandomVariableStreamBatchTestSuite instance variable. */
+static RandomVariableStreamBatchTestSuite g_randomVariableStreamBatchTestSuite;
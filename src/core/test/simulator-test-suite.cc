@@ -24,6 +24,12 @@
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/ladder-scheduler.h"
+#include "ns3/uinteger.h"
+#include "ns3/event-impl.h"
+#include "ns3/make-event.h"
+
+#include <vector>
 
 using namespace ns3;
 
@@ -465,6 +471,158 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class SimulatorEventPoolTestCase : public TestCase
+{
+public:
+  SimulatorEventPoolTestCase ();
+  virtual void DoRun (void);
+  void Event0 (void);
+  void Event3 (int a, int b, int c);
+  void Event5 (uint64_t a, uint64_t b, uint64_t c, uint64_t d, uint64_t e);
+  uint32_t m_count;
+};
+
+SimulatorEventPoolTestCase::SimulatorEventPoolTestCase ()
+  : TestCase ("Check that the events are released to the pool")
+{}
+void
+SimulatorEventPoolTestCase::Event0 (void)
+{
+  m_count++;
+}
+void
+SimulatorEventPoolTestCase::Event3 (int a, int b, int c)
+{
+  m_count++;
+}
+void
+SimulatorEventPoolTestCase::Event5 (uint64_t a, uint64_t b, uint64_t c, uint64_t d, uint64_t e)
+{
+  m_count++;
+}
+void
+SimulatorEventPoolTestCase::DoRun (void)
+{
+  uint64_t outstanding = EventImpl::GetOutstandingEvents ();
+  m_count = 0;
+
+  // a released block is reused by the next event of the same size
+  EventImpl *first = MakeEvent (&SimulatorEventPoolTestCase::Event0, this);
+  first->Unref ();
+  EventImpl *second = MakeEvent (&SimulatorEventPoolTestCase::Event0, this);
+  NS_TEST_EXPECT_MSG_EQ (first, second, "The event memory is not reused");
+  NS_TEST_EXPECT_MSG_EQ (EventImpl::GetOutstandingEvents (), outstanding + 1, "Wrong number of outstanding events");
+  second->Unref ();
+
+  {
+    std::vector<EventId> ids;
+    for (uint32_t i = 0; i < 100; i++)
+      {
+        ids.push_back (Simulator::Schedule (MicroSeconds (i), &SimulatorEventPoolTestCase::Event0, this));
+        ids.push_back (Simulator::Schedule (MicroSeconds (i), &SimulatorEventPoolTestCase::Event3, this, 0, 0, 0));
+        ids.push_back (Simulator::Schedule (MicroSeconds (i), &SimulatorEventPoolTestCase::Event5, this, 0, 0, 0, 0, 0));
+      }
+    for (uint32_t i = 0; i < ids.size (); i += 3)
+      {
+        Simulator::Cancel (ids[i]);
+        Simulator::Remove (ids[i + 1]);
+      }
+    // pending at the end of the simulation
+    Simulator::Schedule (Seconds (1), &SimulatorEventPoolTestCase::Event0, this);
+    Simulator::Stop (MicroSeconds (200));
+    Simulator::Run ();
+    NS_TEST_EXPECT_MSG_EQ (m_count, 100, "Wrong number of executed events");
+    NS_TEST_EXPECT_MSG_GT (EventImpl::GetOutstandingEvents (), outstanding, "The EventId instances hold the events");
+  }
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (EventImpl::GetOutstandingEvents (), outstanding, "Events leaked after Simulator::Destroy");
+
+  // an event held across Simulator::Destroy is released with its EventId
+  {
+    EventId id = Simulator::Schedule (Seconds (1), &SimulatorEventPoolTestCase::Event0, this);
+    Simulator::Destroy ();
+    NS_TEST_EXPECT_MSG_EQ (EventImpl::GetOutstandingEvents (), outstanding + 1, "Event held by an EventId released by Simulator::Destroy");
+  }
+  NS_TEST_EXPECT_MSG_EQ (EventImpl::GetOutstandingEvents (), outstanding, "Event leaked after the release of its EventId");
+}
+
+class SchedulerOrderTestCase : public TestCase
+{
+public:
+  SchedulerOrderTestCase (TypeId schedulerType);
+  virtual void DoRun (void);
+  TypeId m_schedulerType;
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase (TypeId schedulerType)
+  : TestCase ("Check the order of slot-periodic events in " + schedulerType.GetName () +
+              " against ns3::MapScheduler"),
+    m_schedulerType (schedulerType)
+{}
+void
+SchedulerOrderTestCase::DoRun (void)
+{
+  ObjectFactory factory (m_schedulerType.GetName ());
+  factory.Set ("BucketThreshold", UintegerValue (4));
+  Ptr<Scheduler> scheduler = factory.Create<Scheduler> ();
+  Ptr<Scheduler> reference = CreateObject<MapScheduler> ();
+
+  // events at multiples of a symbol, with bursts at the same timestamp,
+  // interleaved with removals of pending events
+  uint64_t now = 0;
+  uint32_t uid = 4;
+  uint64_t state = 1;
+  std::vector<Scheduler::Event> pending;
+  for (uint32_t i = 0; i < 20000; i++)
+    {
+      state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+      uint32_t draw = state >> 33;
+      if (draw % 3 != 0 || reference->IsEmpty ())
+        {
+          uint32_t burst = draw % 7 == 0 ? 1 + draw % 31 : 1;
+          uint64_t ts = now + 8928 * ((draw >> 8) % 30);
+          for (uint32_t j = 0; j < burst; j++)
+            {
+              Scheduler::Event ev;
+              ev.impl = 0;
+              ev.key.m_ts = ts;
+              ev.key.m_uid = uid++;
+              ev.key.m_context = 0;
+              scheduler->Insert (ev);
+              reference->Insert (ev);
+              pending.push_back (ev);
+            }
+        }
+      else if (draw % 11 == 0)
+        {
+          Scheduler::Event ev = pending[draw % pending.size ()];
+          if (ev.key.m_ts > now || (ev.key.m_ts == now && !(reference->PeekNext ().key > ev.key)))
+            {
+              pending[draw % pending.size ()] = pending.back ();
+              pending.pop_back ();
+              scheduler->Remove (ev);
+              reference->Remove (ev);
+            }
+        }
+      else
+        {
+          NS_TEST_ASSERT_MSG_EQ ((scheduler->PeekNext ().key == reference->PeekNext ().key), true, "Wrong next event");
+          Scheduler::Event ev = scheduler->RemoveNext ();
+          Scheduler::Event expected = reference->RemoveNext ();
+          NS_TEST_ASSERT_MSG_EQ (ev.key.m_ts, expected.key.m_ts, "Wrong timestamp of the next event");
+          NS_TEST_ASSERT_MSG_EQ (ev.key.m_uid, expected.key.m_uid, "Wrong uid of the next event");
+          now = ev.key.m_ts;
+        }
+    }
+  while (!reference->IsEmpty ())
+    {
+      NS_TEST_ASSERT_MSG_EQ (scheduler->IsEmpty (), false, "Events lost");
+      NS_TEST_ASSERT_MSG_EQ (scheduler->RemoveNext ().key.m_uid, reference->RemoveNext ().key.m_uid, "Wrong order of the remaining events");
+    }
+  NS_TEST_ASSERT_MSG_EQ (scheduler->IsEmpty (), true, "Spurious events");
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -483,5 +641,9 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (PriorityQueueScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    AddTestCase (new SimulatorEventPoolTestCase (), TestCase::QUICK);
+    AddTestCase (new SchedulerOrderTestCase (LadderScheduler::GetTypeId ()), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
@@ -67,6 +67,7 @@ BasicTracedCallbackTestCase::DoRun (void)
   // these methods do is to set corresponding member variables m_one and m_two.
   //
   TracedCallback<uint8_t, double> trace;
+  NS_TEST_ASSERT_MSG_EQ (trace.IsEmpty (), true, "New trace not empty");
 
   //
   // Connect both callbacks to their respective test methods.  If we hit the
@@ -75,6 +76,7 @@ BasicTracedCallbackTestCase::DoRun (void)
   //
   trace.ConnectWithoutContext (MakeCallback (&BasicTracedCallbackTestCase::CbOne, this));
   trace.ConnectWithoutContext (MakeCallback (&BasicTracedCallbackTestCase::CbTwo, this));
+  NS_TEST_ASSERT_MSG_EQ (trace.IsEmpty (), false, "Trace with callbacks empty");
   m_one = false;
   m_two = false;
   trace (1, 2);
@@ -95,6 +97,7 @@ BasicTracedCallbackTestCase::DoRun (void)
   // If we now disconnect callback two then neither callback should be called.
   //
   trace.DisconnectWithoutContext (MakeCallback (&BasicTracedCallbackTestCase::CbTwo, this));
+  NS_TEST_ASSERT_MSG_EQ (trace.IsEmpty (), true, "Trace without callbacks not empty");
   m_one = false;
   m_two = false;
   trace (1, 2);
@@ -113,6 +116,159 @@ BasicTracedCallbackTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_two, true, "Callback CbTwo not called");
 }
 
+class ReentrantTracedCallbackTestCase : public TestCase
+{
+public:
+  ReentrantTracedCallbackTestCase ();
+  virtual ~ReentrantTracedCallbackTestCase ()
+  {}
+
+private:
+  virtual void DoRun (void);
+
+  void CbOne (uint8_t a, double b);
+  void CbTwo (uint8_t a, double b);
+  void CbThree (uint8_t a, double b);
+  void CbDisconnectSelf (uint8_t a, double b);
+  void CbDisconnectOne (uint8_t a, double b);
+  void CbDisconnectThree (uint8_t a, double b);
+  void CbConnectThree (uint8_t a, double b);
+
+  TracedCallback<uint8_t, double> m_trace;
+  uint32_t m_one;
+  uint32_t m_two;
+  uint32_t m_three;
+  uint32_t m_self;
+};
+
+ReentrantTracedCallbackTestCase::ReentrantTracedCallbackTestCase ()
+  : TestCase ("Check TracedCallback connections and disconnections from a callback")
+{}
+
+void
+ReentrantTracedCallbackTestCase::CbOne (uint8_t a, double b)
+{
+  NS_UNUSED (a);
+  NS_UNUSED (b);
+  m_one++;
+}
+
+void
+ReentrantTracedCallbackTestCase::CbTwo (uint8_t a, double b)
+{
+  NS_UNUSED (a);
+  NS_UNUSED (b);
+  m_two++;
+}
+
+void
+ReentrantTracedCallbackTestCase::CbThree (uint8_t a, double b)
+{
+  NS_UNUSED (a);
+  NS_UNUSED (b);
+  m_three++;
+}
+
+void
+ReentrantTracedCallbackTestCase::CbDisconnectSelf (uint8_t a, double b)
+{
+  NS_UNUSED (a);
+  NS_UNUSED (b);
+  m_self++;
+  m_trace.DisconnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbDisconnectSelf, this));
+}
+
+void
+ReentrantTracedCallbackTestCase::CbDisconnectOne (uint8_t a, double b)
+{
+  NS_UNUSED (a);
+  NS_UNUSED (b);
+  m_trace.DisconnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbOne, this));
+}
+
+void
+ReentrantTracedCallbackTestCase::CbDisconnectThree (uint8_t a, double b)
+{
+  NS_UNUSED (a);
+  NS_UNUSED (b);
+  m_trace.DisconnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbThree, this));
+}
+
+void
+ReentrantTracedCallbackTestCase::CbConnectThree (uint8_t a, double b)
+{
+  NS_UNUSED (a);
+  NS_UNUSED (b);
+  m_trace.ConnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbThree, this));
+}
+
+void
+ReentrantTracedCallbackTestCase::DoRun (void)
+{
+  //
+  // A callback which disconnects itself is called once, and the following
+  // callbacks are still called by the same invocation.
+  //
+  m_one = m_two = m_three = m_self = 0;
+  m_trace.ConnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbOne, this));
+  m_trace.ConnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbDisconnectSelf, this));
+  m_trace.ConnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbTwo, this));
+  m_trace.ConnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbThree, this));
+  m_trace (1, 2);
+  NS_TEST_ASSERT_MSG_EQ (m_self, 1, "Callback CbDisconnectSelf not called");
+  NS_TEST_ASSERT_MSG_EQ (m_one, 1, "Callback CbOne not called");
+  NS_TEST_ASSERT_MSG_EQ (m_two, 1, "Callback CbTwo skipped after a disconnection");
+  NS_TEST_ASSERT_MSG_EQ (m_three, 1, "Callback CbThree skipped after a disconnection");
+  m_trace (1, 2);
+  NS_TEST_ASSERT_MSG_EQ (m_self, 1, "Callback CbDisconnectSelf called after its disconnection");
+  NS_TEST_ASSERT_MSG_EQ (m_two, 2, "Callback CbTwo not called");
+  NS_TEST_ASSERT_MSG_EQ (m_three, 2, "Callback CbThree not called");
+
+  //
+  // A callback which disconnects an earlier one does not skip the following
+  // callbacks, and one which disconnects a later one prevents its call.
+  //
+  m_trace.ConnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbDisconnectOne, this));
+  m_trace.ConnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbDisconnectThree, this));
+  m_trace.ConnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbThree, this));
+  m_one = m_two = m_three = 0;
+  m_trace (1, 2);
+  // CbThree is connected twice: the first one is called before CbDisconnectThree
+  NS_TEST_ASSERT_MSG_EQ (m_one, 1, "Callback CbOne not called before its disconnection");
+  NS_TEST_ASSERT_MSG_EQ (m_two, 1, "Callback CbTwo not called");
+  NS_TEST_ASSERT_MSG_EQ (m_three, 1, "Callback CbThree called after its disconnection");
+  m_one = m_two = m_three = 0;
+  m_trace (1, 2);
+  NS_TEST_ASSERT_MSG_EQ (m_one, 0, "Callback CbOne called after its disconnection");
+  NS_TEST_ASSERT_MSG_EQ (m_two, 1, "Callback CbTwo not called");
+  NS_TEST_ASSERT_MSG_EQ (m_three, 0, "Callback CbThree called after its disconnection");
+
+  //
+  // A callback connected by another one is called from the next invocation.
+  //
+  m_trace.DisconnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbTwo, this));
+  m_trace.DisconnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbDisconnectOne, this));
+  m_trace.DisconnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbDisconnectThree, this));
+  NS_TEST_ASSERT_MSG_EQ (m_trace.IsEmpty (), true, "Trace without callbacks not empty");
+  m_trace.ConnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbConnectThree, this));
+  m_three = 0;
+  m_trace (1, 2);
+  NS_TEST_ASSERT_MSG_EQ (m_three, 0, "Callback CbThree called by the invocation which connected it");
+  m_trace (1, 2);
+  NS_TEST_ASSERT_MSG_EQ (m_three, 1, "Callback CbThree not called after its connection");
+
+  //
+  // The trace is empty after the disconnection of its only callback.
+  //
+  m_trace.DisconnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbConnectThree, this));
+  m_trace.DisconnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbThree, this));
+  m_trace.ConnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbDisconnectSelf, this));
+  m_self = 0;
+  m_trace (1, 2);
+  NS_TEST_ASSERT_MSG_EQ (m_self, 1, "Callback CbDisconnectSelf not called");
+  NS_TEST_ASSERT_MSG_EQ (m_trace.IsEmpty (), true, "Trace not empty after the disconnection of its callback");
+}
+
 class TracedCallbackTestSuite : public TestSuite
 {
 public:
@@ -123,6 +279,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite ()
   : TestSuite ("traced-callback", UNIT)
 {
   AddTestCase (new BasicTracedCallbackTestCase, TestCase::QUICK);
+  AddTestCase (new ReentrantTracedCallbackTestCase, TestCase::QUICK);
 }
 
 static TracedCallbackTestSuite tracedCallbackTestSuite;
@@ -21,6 +21,8 @@
 #include <iostream>
 #include <iomanip>
 #include <ctime>
+#include <algorithm>
+#include <vector>
 
 #include "ns3/integer.h"
 #include "ns3/double.h"
@@ -334,6 +336,52 @@ DeprecatedAttributeTestCase::DoRun (void)
 }
 
 
+//----------------------------
+//
+// Test the ancestry of all TypeIds
+
+class AncestryTestCase : public TestCase
+{
+public:
+  AncestryTestCase ();
+  virtual ~AncestryTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+AncestryTestCase::AncestryTestCase ()
+  : TestCase ("Check IsChildOf against the parent chain of all TypeIds")
+{}
+
+AncestryTestCase::~AncestryTestCase ()
+{}
+
+void
+AncestryTestCase::DoRun (void)
+{
+  uint16_t nids = TypeId::GetRegisteredN ();
+  for (uint16_t i = 0; i < nids; ++i)
+    {
+      const TypeId tid = TypeId::GetRegistered (i);
+      // climb the hierarchy of tid, some test TypeIds have no parent
+      std::vector<TypeId> ancestors;
+      TypeId cur = tid;
+      while (cur.GetParent ().GetUid () != 0 && cur != cur.GetParent ())
+        {
+          cur = cur.GetParent ();
+          ancestors.push_back (cur);
+        }
+      for (uint16_t j = 0; j < nids; ++j)
+        {
+          const TypeId other = TypeId::GetRegistered (j);
+          bool expected = std::find (ancestors.begin (), ancestors.end (), other) != ancestors.end ();
+          NS_TEST_ASSERT_MSG_EQ (tid.IsChildOf (other), expected,
+                                 tid.GetName () << " child of " << other.GetName ());
+        }
+    }
+}
+
+
 //----------------------------
 //
 // Performance test
@@ -447,6 +495,7 @@ TypeIdTestSuite::TypeIdTestSuite ()
   AddTestCase (new UniqueTypeIdTestCase, QUICK);
   AddTestCase (new CollisionTestCase, QUICK);
   AddTestCase (new DeprecatedAttributeTestCase, QUICK);
+  AddTestCase (new AncestryTestCase, QUICK);
 }
 
 static TypeIdTestSuite g_TypeIdTestSuite;
@@ -0,0 +1,383 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "ns3/mmwave-vehicular-net-device.h"
+#include "ns3/mmwave-vehicular-helper.h"
+#include "ns3/mmwave-vehicular-profiler.h"
+#include "ns3/mobility-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/core-module.h"
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <sys/resource.h>
+
+NS_LOG_COMPONENT_DEFINE ("VehicularBenchmark");
+
+using namespace ns3;
+using namespace millicar;
+
+/**
+  This script measures the scalability of the module. It runs, one after the
+  other, a set of simulations obtained by combining the values passed for the
+  number of vehicles, the bandwidth, the numerology, the number of antenna
+  elements and the traffic load. Each value is a comma separated list, e.g.,
+  --numVehicles=10,20,50 --numerology=2,3.
+  The vehicles are organized in groups which travel at constant speed, either
+  along the lanes of a highway or along the streets of a Manhattan grid, and in
+  each group every vehicle sends a constant bit rate UDP flow to the next one.
+  For each simulation, a line with the configuration, the wall clock time spent
+  to set up and run the simulation, the number of events processed per second,
+  the peak resident set size and the number of received packets is written in
+  CSV format to the standard output or to the file set with --outputFile.
+  If ns-3 was configured with --enable-millicar-profiling, the line also
+  reports the time spent in the channel model, in the PHY reception, in the
+  MAC scheduler and in the RLC, otherwise these columns are zero. The RLC time
+  covers the transmission side, i.e., the PDCP and RLC processing of the sent
+  packets and the segmentation on each transmission opportunity, and it is not
+  included in the MAC time. The RLC delivers the received SDUs up to the
+  application within the same call, so the reception side is not separable and
+  is included in the PHY time.
+*/
+
+uint32_t g_rxPackets = 0; //!< number of received packets in the current run
+
+static void Rx (Ptr<const Packet> p)
+{
+  g_rxPackets++;
+}
+
+/**
+ * Parses a comma separated list of values
+ * \param list the string to parse
+ * \return the parsed values
+ */
+template <typename T>
+static std::vector<T>
+ParseList (std::string list)
+{
+  std::vector<T> values;
+  std::istringstream iss (list);
+  std::string item;
+  while (std::getline (iss, item, ','))
+  {
+    std::istringstream itemStream (item);
+    T value;
+    itemStream >> value;
+    NS_ABORT_MSG_IF (itemStream.fail (), "Invalid value " << item << " in list " << list);
+    values.push_back (value);
+  }
+  NS_ABORT_MSG_IF (values.empty (), "Empty list of values");
+  return values;
+}
+
+/**
+ * Returns the peak resident set size of the process in kB
+ * \return the peak RSS
+ */
+static uint64_t
+GetPeakRss ()
+{
+  std::ifstream status ("/proc/self/status");
+  std::string line;
+  while (std::getline (status, line))
+  {
+    if (line.compare (0, 6, "VmHWM:") == 0)
+    {
+      return std::stoull (line.substr (6));
+    }
+  }
+
+  // not Linux, fall back to the peak of the whole process
+  struct rusage usage;
+  getrusage (RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+/**
+ * Resets the peak resident set size of the process, if supported, so that
+ * each run reports its own peak
+ */
+static void
+ResetPeakRss ()
+{
+  std::ofstream clearRefs ("/proc/self/clear_refs");
+  if (clearRefs.is_open ())
+  {
+    clearRefs << "5";
+  }
+}
+
+/// configuration of a single run
+struct BenchmarkConfig
+{
+  std::string scenario; //!< "highway" or "urban"
+  uint32_t numVehicles; //!< number of vehicles
+  double bandwidth; //!< bandwidth in Hz
+  uint16_t numerology; //!< numerology index
+  uint32_t antennaElements; //!< number of antenna elements of each device
+  double load; //!< offered load of each flow in Mbps
+};
+
+/**
+ * Places the vehicles and sets their velocity
+ * \param vehicles the vehicles
+ * \param scenario "highway" or "urban"
+ * \param groupSize the number of vehicles in each group
+ * \param speed the speed of the vehicles in m/s
+ */
+static void
+PlaceVehicles (NodeContainer vehicles, std::string scenario, uint32_t groupSize, double speed)
+{
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (vehicles);
+
+  double intraGroupDistance = 10; // m
+  double interGroupDistance = 100; // m
+  double groupLength = groupSize * intraGroupDistance + interGroupDistance;
+  for (uint32_t i = 0; i < vehicles.GetN (); i++)
+  {
+    uint32_t group = i / groupSize;
+    double offset = (i % groupSize) * intraGroupDistance;
+    Vector position;
+    Vector velocity;
+    if (scenario == "highway")
+    {
+      // the groups are distributed over 4 lanes, 4 m wide
+      uint32_t numLanes = 4;
+      position = Vector ((group / numLanes) * groupLength + offset, (group % numLanes) * 4.0, 0);
+      velocity = Vector (speed, 0, 0);
+    }
+    else if (scenario == "urban")
+    {
+      // the groups are distributed over the streets of a grid with 250 m
+      // wide blocks, half of them along the x axis and half along the y axis
+      uint32_t numStreets = 4;
+      double blockSize = 250;
+      uint32_t street = group % numStreets;
+      double along = ((group / (2 * numStreets)) * groupLength + offset);
+      if ((group / numStreets) % 2 == 0)
+      {
+        position = Vector (along, street * blockSize, 0);
+        velocity = Vector (speed, 0, 0);
+      }
+      else
+      {
+        position = Vector (street * blockSize, along, 0);
+        velocity = Vector (0, speed, 0);
+      }
+    }
+    else
+    {
+      NS_FATAL_ERROR ("Unknown scenario " << scenario);
+    }
+    vehicles.Get (i)->GetObject<MobilityModel> ()->SetPosition (position);
+    vehicles.Get (i)->GetObject<ConstantVelocityMobilityModel> ()->SetVelocity (velocity);
+  }
+}
+
+int main (int argc, char *argv[])
+{
+  std::string scenario = "highway";
+  std::string numVehiclesList = "10,20";
+  std::string bandwidthList = "1e8";
+  std::string numerologyList = "3";
+  std::string antennaElementsList = "16";
+  std::string loadList = "1";
+  uint32_t groupSize = 5;
+  double speed = 20; // m/s
+  uint32_t packetSize = 1024; // bytes
+  bool fading = true;
+  uint32_t runs = 1;
+  Time simTime = Seconds (1.0);
+  std::string outputFile = "";
+
+  CommandLine cmd;
+  cmd.Usage ("MilliCar scalability benchmark.\n"
+             "For each combination of the listed values, writes a CSV line with the wall clock time, "
+             "the events per second, the peak RSS and the received packets. With --enable-millicar-profiling, "
+             "the channelTime, phyTime, macTime and rlcTime columns report the time spent in each model. "
+             "rlcTime covers only the transmission side of the RLC, i.e., the processing of the sent packets "
+             "and of the transmission opportunities, and it is not included in macTime. The RLC delivers the "
+             "received packets up to the application within the same call, so the reception side of the RLC "
+             "is included in phyTime.");
+  cmd.AddValue ("scenario", "The mobility scenario, highway or urban", scenario);
+  cmd.AddValue ("numVehicles", "Comma separated list of numbers of vehicles", numVehiclesList);
+  cmd.AddValue ("bandwidth", "Comma separated list of bandwidths in Hz", bandwidthList);
+  cmd.AddValue ("numerology", "Comma separated list of numerology indexes", numerologyList);
+  cmd.AddValue ("antennaElements", "Comma separated list of numbers of antenna elements", antennaElementsList);
+  cmd.AddValue ("load", "Comma separated list of offered loads of each flow in Mbps", loadList);
+  cmd.AddValue ("groupSize", "The number of vehicles in each group", groupSize);
+  cmd.AddValue ("vehicleSpeed", "The speed of the vehicles in m/s", speed);
+  cmd.AddValue ("packetSize", "The size of the packets in bytes", packetSize);
+  cmd.AddValue ("fading", "If true, use the 3GPP fast fading model", fading);
+  cmd.AddValue ("runs", "The number of runs for each configuration", runs);
+  cmd.AddValue ("simTime", "The duration of each simulation", simTime);
+  cmd.AddValue ("outputFile", "The CSV file where results are written, standard output if empty", outputFile);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (groupSize < 2, "Each group must contain at least two vehicles");
+
+  std::vector<BenchmarkConfig> configs;
+  for (uint32_t numVehicles : ParseList<uint32_t> (numVehiclesList))
+  {
+    for (double bandwidth : ParseList<double> (bandwidthList))
+    {
+      for (uint16_t numerology : ParseList<uint16_t> (numerologyList))
+      {
+        for (uint32_t antennaElements : ParseList<uint32_t> (antennaElementsList))
+        {
+          for (double load : ParseList<double> (loadList))
+          {
+            configs.push_back ({scenario, numVehicles, bandwidth, numerology, antennaElements, load});
+          }
+        }
+      }
+    }
+  }
+
+  std::ofstream outFile;
+  if (!outputFile.empty ())
+  {
+    outFile.open (outputFile.c_str ());
+    NS_ABORT_MSG_IF (!outFile.is_open (), "Can't open file " << outputFile);
+  }
+  std::ostream& out = outputFile.empty () ? std::cout : outFile;
+
+  out << "scenario,numVehicles,bandwidth,numerology,antennaElements,load,run,"
+      << "simTime,setupWallTime,runWallTime,events,eventsPerSecond,peakRssKb,"
+      << "txPackets,rxPackets,channelTime,phyTime,macTime,rlcTime" << std::endl;
+
+  Config::SetDefault ("ns3::MmWaveSidelinkMac::UseAmc", BooleanValue (true));
+  Config::SetDefault ("ns3::MmWavePhyMacCommon::CenterFreq", DoubleValue (60.0e9));
+  Config::SetDefault ("ns3::MmWaveVehicularNetDevice::RlcType", StringValue ("LteRlcUm"));
+  Config::SetDefault ("ns3::MmWaveVehicularPropagationLossModel::Scenario", StringValue (scenario == "urban" ? "V2V-Urban" : "V2V-Highway"));
+  Config::SetDefault ("ns3::MmWaveVehicularHelper::SchedulingPatternOption", StringValue ("Optimized"));
+  Config::SetDefault ("ns3::MmWaveSidelinkMac::ReservationPeriod", UintegerValue (100));
+
+  for (const BenchmarkConfig& config : configs)
+  {
+    for (uint32_t run = 1; run <= runs; run++)
+    {
+      NS_LOG_INFO ("Run " << run << " with " << config.numVehicles << " vehicles, bandwidth " << config.bandwidth
+                   << " Hz, numerology " << config.numerology << ", " << config.antennaElements
+                   << " antenna elements, load " << config.load << " Mbps");
+
+      RngSeedManager::SetRun (run);
+      Config::SetDefault ("ns3::MmWaveVehicularHelper::Bandwidth", DoubleValue (config.bandwidth));
+      Config::SetDefault ("ns3::MmWaveVehicularAntennaArrayModel::AntennaElements", UintegerValue (config.antennaElements));
+      g_rxPackets = 0;
+      ResetPeakRss ();
+
+      std::chrono::steady_clock::time_point setupStart = std::chrono::steady_clock::now ();
+
+      NodeContainer vehicles;
+      vehicles.Create (config.numVehicles);
+      PlaceVehicles (vehicles, config.scenario, groupSize, speed);
+
+      Ptr<MmWaveVehicularHelper> helper = CreateObject<MmWaveVehicularHelper> ();
+      helper->SetPropagationLossModelType ("ns3::MmWaveVehicularPropagationLossModel");
+      if (fading)
+      {
+        helper->SetSpectrumPropagationLossModelType ("ns3::MmWaveVehicularSpectrumPropagationLossModel");
+      }
+      helper->SetNumerology (config.numerology);
+      NetDeviceContainer devs = helper->InstallMmWaveVehicularNetDevices (vehicles);
+
+      InternetStackHelper internet;
+      internet.Install (vehicles);
+
+      Ipv4AddressHelper ipv4;
+      ipv4.SetBase ("10.1.0.0", "255.255.0.0");
+      ipv4.Assign (devs);
+
+      for (uint32_t first = 0; first < config.numVehicles; first += groupSize)
+      {
+        NetDeviceContainer group;
+        for (uint32_t i = first; i < std::min (first + groupSize, config.numVehicles); i++)
+        {
+          group.Add (devs.Get (i));
+        }
+        helper->PairDevices (group);
+      }
+      helper->ConfigureSchedulingPatterns (devs);
+
+      uint16_t port = 4000;
+      UdpServerHelper server (port);
+      ApplicationContainer serverApps = server.Install (vehicles);
+      serverApps.Start (Seconds (0.0));
+      for (uint32_t i = 0; i < serverApps.GetN (); i++)
+      {
+        serverApps.Get (i)->TraceConnectWithoutContext ("Rx", MakeCallback (&Rx));
+      }
+
+      Time interPacketInterval = Seconds (packetSize * 8 / (config.load * 1e6));
+      uint64_t txPackets = 0;
+      for (uint32_t i = 0; i + 1 < config.numVehicles; i++)
+      {
+        if ((i + 1) % groupSize == 0)
+        {
+          // the last vehicle of each group does not transmit
+          continue;
+        }
+
+        UdpClientHelper client (vehicles.Get (i + 1)->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal (), port);
+        client.SetAttribute ("MaxPackets", UintegerValue (0xFFFFFFFF));
+        client.SetAttribute ("Interval", TimeValue (interPacketInterval));
+        client.SetAttribute ("PacketSize", UintegerValue (packetSize));
+        ApplicationContainer clientApps = client.Install (vehicles.Get (i));
+        clientApps.Start (MilliSeconds (100));
+        clientApps.Stop (simTime);
+        txPackets += std::ceil ((simTime - MilliSeconds (100)).GetSeconds () / interPacketInterval.GetSeconds ());
+      }
+
+      std::chrono::steady_clock::time_point runStart = std::chrono::steady_clock::now ();
+      Simulator::Stop (simTime + MilliSeconds (100));
+      Simulator::Run ();
+      std::chrono::steady_clock::time_point runEnd = std::chrono::steady_clock::now ();
+
+      uint64_t events = Simulator::GetEventCount ();
+      uint64_t peakRss = GetPeakRss ();
+      double channelTime = (MmWaveVehicularProfiler::GetStats (MmWaveVehicularProfiler::CALC_RX_PSD).m_totalNs
+                            + MmWaveVehicularProfiler::GetStats (MmWaveVehicularProfiler::GET_LOSS).m_totalNs) * 1e-9;
+      double phyTime = (MmWaveVehicularProfiler::GetStats (MmWaveVehicularProfiler::START_RX_DATA).m_totalNs
+                        + MmWaveVehicularProfiler::GetStats (MmWaveVehicularProfiler::END_RX_DATA).m_totalNs) * 1e-9;
+      // the transmission opportunities of the RLC are nested in the MAC scheduler
+      double rlcTxOpportunityTime = MmWaveVehicularProfiler::GetStats (MmWaveVehicularProfiler::RLC_TX_OPPORTUNITY).m_totalNs * 1e-9;
+      double macTime = MmWaveVehicularProfiler::GetStats (MmWaveVehicularProfiler::MAC_SCHEDULER).m_totalNs * 1e-9 - rlcTxOpportunityTime;
+      double rlcTime = MmWaveVehicularProfiler::GetStats (MmWaveVehicularProfiler::RLC_TX_SDU).m_totalNs * 1e-9 + rlcTxOpportunityTime;
+      Simulator::Destroy ();
+      // the next run assigns the same addresses again
+      Ipv4AddressGenerator::Reset ();
+
+      double setupWallTime = std::chrono::duration<double> (runStart - setupStart).count ();
+      double runWallTime = std::chrono::duration<double> (runEnd - runStart).count ();
+      out << config.scenario << "," << config.numVehicles << "," << config.bandwidth << ","
+          << config.numerology << "," << config.antennaElements << "," << config.load << ","
+          << run << "," << simTime.GetSeconds () << "," << setupWallTime << "," << runWallTime << ","
+          << events << "," << (runWallTime > 0 ? events / runWallTime : 0) << "," << peakRss << ","
+          << txPackets << "," << g_rxPackets << "," << channelTime << "," << phyTime << ","
+          << macTime << "," << rlcTime << std::endl;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,173 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "ns3/mmwave-vehicular-net-device.h"
+#include "ns3/mmwave-vehicular-helper.h"
+#include "ns3/mobility-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/core-module.h"
+
+NS_LOG_COMPONENT_DEFINE ("VehicularLargeGroup");
+
+using namespace ns3;
+using namespace millicar;
+
+/**
+  This script creates a large group of vehicles (200 by default) organized in
+  platoons, which travel at constant speed along the lanes of a highway.
+  In each platoon, every vehicle periodically sends a UDP packet to the vehicle
+  in front of it.
+  The whole group shares the channel, and the slots are either assigned by a
+  single scheduling pattern spanning multiple subframes, where vehicles farther
+  apart than the reuse distance transmit in the same slot, or autonomously
+  selected by each vehicle using the sensing based allocation.
+  At the end of the simulation, the packet delivery ratio is printed.
+*/
+
+uint32_t g_rxPackets = 0; //!< total number of received packets
+
+static void Rx (Ptr<const Packet> p)
+{
+  g_rxPackets++;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t numVehicles = 200;
+  uint32_t platoonSize = 10;
+  uint32_t numLanes = 4;
+  double intraPlatoonDistance = 10; // m
+  double interPlatoonDistance = 100; // m
+  double laneWidth = 4; // m
+  double speed = 30; // m/s
+  double reuseDistance = 250; // m
+  bool sensing = false;
+  uint32_t packetSize = 200; // bytes
+  Time interPacketInterval = MilliSeconds (100);
+  Time endTime = Seconds (2.0);
+
+  CommandLine cmd;
+  cmd.AddValue ("numVehicles", "The number of vehicles", numVehicles);
+  cmd.AddValue ("platoonSize", "The number of vehicles in each platoon", platoonSize);
+  cmd.AddValue ("numLanes", "The number of lanes of the highway", numLanes);
+  cmd.AddValue ("vehicleSpeed", "The speed of the vehicles in m/s", speed);
+  cmd.AddValue ("reuseDistance", "The minimum distance in meters between vehicles scheduled in the same slot", reuseDistance);
+  cmd.AddValue ("sensing", "If true, use the sensing based allocation instead of the scheduling pattern", sensing);
+  cmd.AddValue ("packetSize", "The size of the packets in bytes", packetSize);
+  cmd.AddValue ("interPacketInterval", "The interval between two packets", interPacketInterval);
+  cmd.AddValue ("endTime", "The duration of the simulation", endTime);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (platoonSize < 2, "Each platoon must contain at least two vehicles");
+
+  Config::SetDefault ("ns3::MmWaveSidelinkMac::UseAmc", BooleanValue (true));
+  Config::SetDefault ("ns3::MmWavePhyMacCommon::CenterFreq", DoubleValue (60.0e9));
+  Config::SetDefault ("ns3::MmWaveVehicularNetDevice::RlcType", StringValue ("LteRlcUm"));
+  Config::SetDefault ("ns3::MmWaveVehicularPropagationLossModel::ChannelCondition", StringValue ("l"));
+  Config::SetDefault ("ns3::MmWaveVehicularHelper::Bandwidth", DoubleValue (1e8));
+  Config::SetDefault ("ns3::MmWaveVehicularHelper::ReuseDistance", DoubleValue (reuseDistance));
+  Config::SetDefault ("ns3::MmWaveVehicularHelper::SchedulingPatternOption", StringValue (sensing ? "Sensing" : "Optimized"));
+  // the reservation period must contain enough slots for the whole group
+  Config::SetDefault ("ns3::MmWaveSidelinkMac::ReservationPeriod", UintegerValue (100));
+
+  // create the nodes
+  NodeContainer vehicles;
+  vehicles.Create (numVehicles);
+
+  // create the mobility models, each platoon travels on a lane
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (vehicles);
+
+  for (uint32_t i = 0; i < numVehicles; i++)
+  {
+    uint32_t platoon = i / platoonSize;
+    uint32_t lane = platoon % numLanes;
+    double x = (platoon / numLanes) * (interPlatoonDistance + platoonSize * intraPlatoonDistance)
+               + (i % platoonSize) * intraPlatoonDistance;
+    vehicles.Get (i)->GetObject<MobilityModel> ()->SetPosition (Vector (x, lane * laneWidth, 0));
+    vehicles.Get (i)->GetObject<ConstantVelocityMobilityModel> ()->SetVelocity (Vector (speed, 0, 0));
+  }
+
+  // create and configure the helper
+  Ptr<MmWaveVehicularHelper> helper = CreateObject<MmWaveVehicularHelper> ();
+  helper->SetPropagationLossModelType ("ns3::MmWaveVehicularPropagationLossModel");
+  helper->SetNumerology (3);
+  NetDeviceContainer devs = helper->InstallMmWaveVehicularNetDevices (vehicles);
+
+  InternetStackHelper internet;
+  internet.Install (vehicles);
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.0.0", "255.255.0.0");
+  ipv4.Assign (devs);
+
+  // activate the bearers among the vehicles of the same platoon
+  for (uint32_t first = 0; first < numVehicles; first += platoonSize)
+  {
+    NetDeviceContainer platoon;
+    for (uint32_t i = first; i < std::min (first + platoonSize, numVehicles); i++)
+    {
+      platoon.Add (devs.Get (i));
+    }
+    helper->PairDevices (platoon);
+  }
+
+  // configure a single scheduling pattern for the whole group
+  helper->ConfigureSchedulingPatterns (devs);
+
+  // each vehicle sends packets to the one in front of it
+  uint16_t port = 4000;
+  UdpServerHelper server (port);
+  ApplicationContainer serverApps = server.Install (vehicles);
+  serverApps.Start (Seconds (0.0));
+  for (uint32_t i = 0; i < serverApps.GetN (); i++)
+  {
+    serverApps.Get (i)->TraceConnectWithoutContext ("Rx", MakeCallback (&Rx));
+  }
+
+  uint32_t expectedPackets = 0;
+  for (uint32_t i = 0; i < numVehicles; i++)
+  {
+    if ((i + 1) % platoonSize == 0 || i + 1 == numVehicles)
+    {
+      // the platoon leader does not transmit
+      continue;
+    }
+
+    UdpClientHelper client (vehicles.Get (i + 1)->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal (), port);
+    client.SetAttribute ("MaxPackets", UintegerValue (0xFFFFFFFF));
+    client.SetAttribute ("Interval", TimeValue (interPacketInterval));
+    client.SetAttribute ("PacketSize", UintegerValue (packetSize));
+    ApplicationContainer clientApps = client.Install (vehicles.Get (i));
+    clientApps.Start (Seconds (0.1));
+    clientApps.Stop (endTime);
+    expectedPackets += std::ceil ((endTime - Seconds (0.1)).GetSeconds () / interPacketInterval.GetSeconds ());
+  }
+
+  Simulator::Stop (endTime + Seconds (0.1));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::cout << "Received packets: " << g_rxPackets << "/" << expectedPackets
+            << " (PDR " << double (g_rxPackets) / expectedPackets << ")" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,57 @@
+# -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+"""
+Converts a binary SINR/MCS trace written by MmWaveVehicularTracesHelper
+(MmWaveVehicularHelper::PhyTraceFormat=Binary) to CSV, with the same columns
+of the text trace: time [s], RNTI, SINR [dB], number of symbols, TB size
+[bytes] and MCS.
+
+Usage: python3 vehicular-traces-to-csv.py <trace file> [<csv file>]
+"""
+
+import math
+import struct
+import sys
+
+## the record layout for each field type of the schema
+FIELD_FORMATS = {'int64': 'q', 'float64': 'd', 'uint32': 'I', 'uint16': 'H', 'uint8': 'B'}
+
+
+def read_header(trace):
+    if trace.read(4) != b'MCTR':
+        raise ValueError("not a MilliCar binary trace")
+    version, record_size, seed, run, schema_length = struct.unpack('<HHIQI', trace.read(20))
+    if version != 1:
+        raise ValueError("unsupported trace version %d" % version)
+    schema = trace.read(schema_length).decode('ascii')
+    fields = [field.split(':') for field in schema.split(',')]
+    record_format = '<' + ''.join(FIELD_FORMATS[field_type] for _, field_type in fields)
+    if struct.calcsize(record_format) != record_size:
+        raise ValueError("the schema does not match the record size")
+    return seed, run, [name for name, _ in fields], struct.Struct(record_format)
+
+
+def main(argv):
+    if len(argv) not in (2, 3):
+        sys.stderr.write(__doc__)
+        return 1
+
+    with open(argv[1], 'rb') as trace:
+        seed, run, names, record = read_header(trace)
+        output = open(argv[2], 'w') if len(argv) == 3 else sys.stdout
+        sys.stderr.write("seed %d run %d\n" % (seed, run))
+        output.write("time,rnti,sinr_db,num_sym,tb_size,mcs\n")
+        while True:
+            data = trace.read(record.size)
+            if len(data) < record.size:
+                break
+            values = dict(zip(names, record.unpack(data)))
+            output.write("%.9f,%d,%s,%d,%d,%d\n" % (values['time_ns'] * 1e-9, values['rnti'],
+                                                    repr(10 * math.log10(values['sinr'])),
+                                                    values['num_sym'], values['tb_size'], values['mcs']))
+        if output is not sys.stdout:
+            output.close()
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
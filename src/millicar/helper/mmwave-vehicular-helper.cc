@@ -27,6 +27,12 @@
 #include "ns3/mmwave-vehicular-spectrum-propagation-loss-model.h"
 #include "ns3/pointer.h"
 #include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/enum.h"
+#include "ns3/mobility-model.h"
+#include "ns3/simulator.h"
+#include <limits>
 
 namespace ns3 {
 
@@ -37,7 +43,6 @@ namespace millicar {
 NS_OBJECT_ENSURE_REGISTERED (MmWaveVehicularHelper); // TODO check if this has to be defined here
 
 MmWaveVehicularHelper::MmWaveVehicularHelper ()
-: m_phyTraceHelper{CreateObject<MmWaveVehicularTracesHelper>("sinr-mcs.txt")} // TODO name as attribute
 {
   NS_LOG_FUNCTION (this);
 }
@@ -54,6 +59,15 @@ MmWaveVehicularHelper::GetTypeId ()
   TypeId ("ns3::MmWaveVehicularHelper")
   .SetParent<Object> ()
   .AddConstructor<MmWaveVehicularHelper> ()
+  .AddAttribute ("ChannelType",
+                 "The type of spectrum channel to be used. "
+                 "The allowed values for this attributes are the type names "
+                 "of any class inheriting from ns3::SpectrumChannel, e.g., "
+                 "ns3::MmWaveSidelinkSpectrumChannel to deliver each transmission "
+                 "with one event per propagation delay and receiving node.",
+                 StringValue ("ns3::SingleModelSpectrumChannel"),
+                 MakeStringAccessor (&MmWaveVehicularHelper::m_channelType),
+                 MakeStringChecker ())
   .AddAttribute ("PropagationLossModel",
                  "The type of path-loss model to be used. "
                  "The allowed values for this attributes are the type names "
@@ -75,6 +89,14 @@ MmWaveVehicularHelper::GetTypeId ()
                  StringValue (""),
                  MakeStringAccessor (&MmWaveVehicularHelper::SetPropagationDelayModelType),
                  MakeStringChecker ())
+  .AddAttribute ("Scheduler",
+                 "The type of scheduler to be used by the sidelink MAC. "
+                 "The allowed values for this attributes are the type names "
+                 "of any class inheriting from ns3::MmWaveSidelinkScheduler.",
+                 StringValue ("ns3::MmWaveSidelinkRrScheduler"),
+                 MakeStringAccessor (&MmWaveVehicularHelper::SetSchedulerType,
+                                     &MmWaveVehicularHelper::GetSchedulerType),
+                 MakeStringChecker ())
   .AddAttribute ("Numerology",
                  "Numerology to use for the definition of the frame structure."
                  "2 : subcarrier spacing will be set to 60 KHz"
@@ -90,12 +112,38 @@ MmWaveVehicularHelper::GetTypeId ()
   .AddAttribute ("SchedulingPatternOption",
                  "The type of scheduling pattern option to be used for resources assignation."
                  "Default   : one single slot per subframe for each device"
-                 "Optimized : each slot of the subframe is used",
+                 "Optimized : each slot of the subframe is used"
+                 "Sensing   : each device autonomously reserves a slot based on the sensed transmissions",
                  EnumValue(DEFAULT),
                  MakeEnumAccessor (&MmWaveVehicularHelper::SetSchedulingPatternOptionType,
                                    &MmWaveVehicularHelper::GetSchedulingPatternOptionType),
                  MakeEnumChecker(DEFAULT, "Default",
-                                 OPTIMIZED, "Optimized"))
+                                 OPTIMIZED, "Optimized",
+                                 SENSING, "Sensing"))
+  .AddAttribute ("ReuseDistance",
+                 "Minimum distance in meters between devices of the same group "
+                 "scheduled in the same slot. If zero, each slot is assigned to a single device.",
+                 DoubleValue (0.0),
+                 MakeDoubleAccessor (&MmWaveVehicularHelper::m_reuseDistance),
+                 MakeDoubleChecker<double> (0.0))
+  .AddAttribute ("PhyTraceFileName",
+                 "The name of the file where the SINR and MCS of the received transport blocks are traced",
+                 StringValue ("sinr-mcs.txt"),
+                 MakeStringAccessor (&MmWaveVehicularHelper::m_phyTraceFileName),
+                 MakeStringChecker ())
+  .AddAttribute ("PhyTraceFormat",
+                 "The format of the SINR and MCS trace file",
+                 EnumValue (MmWaveVehicularTracesHelper::TEXT),
+                 MakeEnumAccessor (&MmWaveVehicularHelper::m_phyTraceFormat),
+                 MakeEnumChecker (MmWaveVehicularTracesHelper::TEXT, "Text",
+                                  MmWaveVehicularTracesHelper::BINARY, "Binary"))
+  .AddAttribute ("LazyBearerActivation",
+                 "If true, the bearer between two devices of the same group is activated "
+                 "when the first packet between them is sent, instead of activating the "
+                 "bearers between all the pairs of devices when they are paired.",
+                 BooleanValue (false),
+                 MakeBooleanAccessor (&MmWaveVehicularHelper::m_lazyBearerActivation),
+                 MakeBooleanChecker ())
   ;
 
   return tid;
@@ -116,8 +164,12 @@ MmWaveVehicularHelper::DoInitialize ()
                                                                              "Bandwidth", DoubleValue (m_bandwidth));
   }
 
+  // create the helper for the PHY traces
+  m_phyTraceHelper = CreateObject<MmWaveVehicularTracesHelper> (m_phyTraceFileName, m_phyTraceFormat);
+
   // create the channel
-  m_channel = CreateObject<SingleModelSpectrumChannel> ();
+  ObjectFactory channelFactory (m_channelType);
+  m_channel = channelFactory.Create<SpectrumChannel> ();
   if (!m_propagationLossModelType.empty ())
   {
     ObjectFactory factory (m_propagationLossModelType);
@@ -165,6 +217,29 @@ MmWaveVehicularHelper::GetConfigurationParameters () const
   return m_phyMacConfig;
 }
 
+Ptr<MmWaveVehicularTracesHelper>
+MmWaveVehicularHelper::GetPhyTracesHelper () const
+{
+  NS_LOG_FUNCTION (this);
+  return m_phyTraceHelper;
+}
+
+int64_t
+MmWaveVehicularHelper::AssignStreams (NetDeviceContainer c, int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  int64_t currentStream = stream;
+  for (NetDeviceContainer::Iterator i = c.Begin (); i != c.End (); ++i)
+  {
+    Ptr<MmWaveVehicularNetDevice> device = DynamicCast<MmWaveVehicularNetDevice> (*i);
+    if (device)
+    {
+      currentStream += device->GetMac ()->AssignStreams (currentStream);
+    }
+  }
+  return (currentStream - stream);
+}
+
 void
 MmWaveVehicularHelper::SetNumerology (uint8_t index)
 {
@@ -239,6 +314,15 @@ MmWaveVehicularHelper::InstallSingleMmWaveVehicularNetDevice (Ptr<Node> node, ui
   Ptr<MmWaveSidelinkMac> mac = CreateObject<MmWaveSidelinkMac> (m_phyMacConfig);
   mac->SetRnti (rnti);
 
+  // with the sensing based allocation, the MAC needs to know the sensed
+  // transmissions
+  if (m_schedulingOpt == SENSING)
+  {
+    mac->SetAttribute ("SensingBasedAllocation", BooleanValue (true));
+    ssp->SetSidelinkSensingCallback (MakeCallback (&MmWaveSidelinkPhy::GenerateSensingReport, phy));
+  }
+  mac->SetScheduler (m_schedulerFactory.Create<MmWaveSidelinkScheduler> ());
+
   // connect phy and mac
   phy->SetPhySapUser (mac->GetPhySapUser ());
   mac->SetPhySapProvider (phy->GetPhySapProvider ());
@@ -260,164 +344,366 @@ MmWaveVehicularHelper::InstallSingleMmWaveVehicularNetDevice (Ptr<Node> node, ui
   return device;
 }
 
-void
+uint32_t
 MmWaveVehicularHelper::PairDevices (NetDeviceContainer devices)
 {
   NS_LOG_FUNCTION (this);
 
-  // TODO update this part to enable a more flexible configuration of the
-  // scheduling pattern
-
-  std::vector<uint16_t> pattern = CreateSchedulingPattern(devices);
+  uint32_t groupId = m_groups.size ();
+  m_groups.push_back (DeviceGroup ());
 
-  uint8_t bearerId = 1;
- 
   for (NetDeviceContainer::Iterator i = devices.Begin (); i != devices.End (); ++i)
-    {
-      
-      Ptr<MmWaveVehicularNetDevice> di = DynamicCast<MmWaveVehicularNetDevice> (*i);
-      Ptr<Node> iNode = di->GetNode ();
-      Ptr<Ipv4> iNodeIpv4 = iNode->GetObject<Ipv4> ();
-      NS_ASSERT_MSG (iNodeIpv4 != 0, "Nodes need to have IPv4 installed before pairing can be activated");
-
-      di->GetMac ()->SetSfAllocationInfo (pattern); // this is called ONCE for each NetDevice
-     
-      for (NetDeviceContainer::Iterator j = i + 1; j != devices.End (); ++j)
-      { 
-          
-        Ptr<MmWaveVehicularNetDevice> dj = DynamicCast<MmWaveVehicularNetDevice> (*j);
-        Ptr<Node> jNode = dj->GetNode ();
-        Ptr<Ipv4> jNodeIpv4 = jNode->GetObject<Ipv4> ();
-        NS_ASSERT_MSG (jNodeIpv4 != 0, "Nodes need to have IPv4 installed before pairing can be activated");
-        
-        
-        // initialize the <IP address, RNTI> map of the devices
-        int32_t interface =  jNodeIpv4->GetInterfaceForDevice (dj);
-        
-        Ipv4Address diAddr = iNodeIpv4->GetAddress (interface, 0).GetLocal ();
-        //std::cout<< "It stops here"<<std::endl;
-        Ipv4Address djAddr = jNodeIpv4->GetAddress (interface, 0).GetLocal ();
-         
-         
-        // register the associated devices in the PHY
-        di->GetPhy ()->AddDevice (dj->GetMac ()->GetRnti (), dj);
-        dj->GetPhy ()->AddDevice (di->GetMac ()->GetRnti (), di);
-
-        // bearer activation by creating a logical channel between the two devices
-        NS_LOG_DEBUG("Activation of bearer between " << diAddr << " and " << djAddr);
-        NS_LOG_DEBUG("Bearer ID: " << uint32_t(bearerId) << " - Associate RNTI " << di->GetMac ()->GetRnti () << " to " << dj->GetMac ()->GetRnti ());
-
-        di->ActivateBearer(bearerId, dj->GetMac ()->GetRnti (), djAddr);
-        dj->ActivateBearer(bearerId, di->GetMac ()->GetRnti (), diAddr);
-        bearerId++;
-      }
+  {
+    DoAddDeviceToGroup (groupId, DynamicCast<MmWaveVehicularNetDevice> (*i));
+  }
 
+  ConfigureSchedulingPatterns (devices);
 
-    }
+  return groupId;
+}
+
+void
+MmWaveVehicularHelper::AddDeviceToGroup (uint32_t groupId, Ptr<NetDevice> device)
+{
+  NS_LOG_FUNCTION (this << groupId << device);
+  NS_ASSERT_MSG (groupId < m_groups.size (), "Unknown group " << groupId);
+
+  Ptr<MmWaveVehicularNetDevice> d = DynamicCast<MmWaveVehicularNetDevice> (device);
+  DoAddDeviceToGroup (groupId, d);
+
+  if (m_schedulingOpt != SENSING)
+  {
+    // the device does not transmit until the pattern of the group is updated
+    d->GetMac ()->SetSfAllocationInfo (std::vector<uint16_t> (m_phyMacConfig->GetSlotsPerSubframe (), 0));
+  }
+  ScheduleSchedulingPatternsUpdate (groupId);
 }
 
-uint8_t 
-MmWaveVehicularHelper::newPairingSystem(NetDeviceContainer devices, uint8_t id)
+void
+MmWaveVehicularHelper::RemoveDeviceFromGroup (Ptr<NetDevice> device)
 {
-  std::vector<uint16_t> pattern = CreateSchedulingPattern(devices);
-
-  uint8_t bearerId = id;
-  NetDeviceContainer::Iterator i = devices.End() -1;
-  Ptr<MmWaveVehicularNetDevice> di = DynamicCast<MmWaveVehicularNetDevice> (*i);
-  Ptr<Node> iNode = di->GetNode ();
-  Ptr<Ipv4> iNodeIpv4 = iNode->GetObject<Ipv4> ();
-  NS_ASSERT_MSG (iNodeIpv4 != 0, "Nodes need to have IPv4 installed before pairing can be activated");
-  di->GetMac ()->SetSfAllocationInfo (pattern); // this is called ONCE for each NetDevice
-  for (NetDeviceContainer::Iterator j = devices.Begin (); j != i; ++j)
+  NS_LOG_FUNCTION (this << device);
+
+  auto groupIt = m_deviceToGroup.find (device);
+  NS_ASSERT_MSG (groupIt != m_deviceToGroup.end (), "The device does not belong to any group");
+  uint32_t groupId = groupIt->second;
+  DeviceGroup& group = m_groups [groupId];
+  m_deviceToGroup.erase (groupIt);
+
+  Ptr<MmWaveVehicularNetDevice> di = DynamicCast<MmWaveVehicularNetDevice> (device);
+  uint16_t iRnti = di->GetMac ()->GetRnti ();
+
+  NetDeviceContainer devices;
+  for (NetDeviceContainer::Iterator j = group.m_devices.Begin (); j != group.m_devices.End (); ++j)
   {
-    std::cout<<"I am here"<<std::endl;
-      Ptr<MmWaveVehicularNetDevice> dj = DynamicCast<MmWaveVehicularNetDevice> (*j);
-      Ptr<Node> jNode = dj->GetNode ();
-        Ptr<Ipv4> jNodeIpv4 = jNode->GetObject<Ipv4> ();
-        NS_ASSERT_MSG (jNodeIpv4 != 0, "Nodes need to have IPv4 installed before pairing can be activated");
-
-        // initialize the <IP address, RNTI> map of the devices
-        int32_t interface =  jNodeIpv4->GetInterfaceForDevice (dj);
-        Ipv4Address diAddr = iNodeIpv4->GetAddress (interface, 0).GetLocal ();
-        Ipv4Address djAddr = jNodeIpv4->GetAddress (interface, 0).GetLocal ();
-
-        // register the associated devices in the PHY
-        di->GetPhy ()->AddDevice (dj->GetMac ()->GetRnti (), dj);
-        dj->GetPhy ()->AddDevice (di->GetMac ()->GetRnti (), di);
-        
-        
-
-        // bearer activation by creating a logical channel between the two devices
-        NS_LOG_DEBUG("Activation of bearer between " << diAddr << " and " << djAddr);
-        NS_LOG_DEBUG("Bearer ID: " << uint32_t(bearerId) << " - Associate RNTI " << di->GetMac ()->GetRnti () << " to " << dj->GetMac ()->GetRnti ());
-        std::cout<< "Bearer ID: " << uint32_t(bearerId) << " - Associate RNTI " << unsigned(di->GetMac ()->GetRnti ()) << " to " << unsigned(dj->GetMac ()->GetRnti ()) <<std::endl;
-
-        di->ActivateBearer(bearerId, dj->GetMac ()->GetRnti (), djAddr);
-        dj->ActivateBearer(bearerId, di->GetMac ()->GetRnti (), diAddr);
-        bearerId++;
-        std::cout<<"The value of the bearer is: "<< unsigned(bearerId)<<std::endl;
+    if (*j == device)
+    {
+      continue;
     }
+    devices.Add (*j);
+
+    Ptr<MmWaveVehicularNetDevice> dj = DynamicCast<MmWaveVehicularNetDevice> (*j);
+    uint16_t jRnti = dj->GetMac ()->GetRnti ();
+    di->DeactivateBearer (jRnti);
+    dj->DeactivateBearer (iRnti);
+    di->GetPhy ()->RemoveDevice (jRnti);
+    dj->GetPhy ()->RemoveDevice (iRnti);
+    di->GetMac ()->RemoveDevice (jRnti);
+    dj->GetMac ()->RemoveDevice (iRnti);
+  }
+  group.m_devices = devices;
+  group.m_addressToDevice.erase (GetIpv4Address (di));
+  di->SetBearerRequestCallback (MakeNullCallback<void, Ptr<MmWaveVehicularNetDevice>, Ipv4Address> ());
+
+  if (m_schedulingOpt != SENSING)
+  {
+    di->GetMac ()->SetSfAllocationInfo (std::vector<uint16_t> (m_phyMacConfig->GetSlotsPerSubframe (), 0));
+  }
+  ScheduleSchedulingPatternsUpdate (groupId);
+}
 
-    return bearerId;
+void
+MmWaveVehicularHelper::DoAddDeviceToGroup (uint32_t groupId, Ptr<MmWaveVehicularNetDevice> device)
+{
+  NS_LOG_FUNCTION (this << groupId << device);
+  NS_ASSERT_MSG (m_deviceToGroup.find (device) == m_deviceToGroup.end (), "The device already belongs to a group");
+
+  DeviceGroup& group = m_groups [groupId];
+  if (m_lazyBearerActivation)
+  {
+    device->SetBearerRequestCallback (MakeCallback (&MmWaveVehicularHelper::ActivateBearerOnDemand, this));
+  }
+  else
+  {
+    for (NetDeviceContainer::Iterator j = group.m_devices.Begin (); j != group.m_devices.End (); ++j)
+    {
+      ActivateBearers (DynamicCast<MmWaveVehicularNetDevice> (*j), device);
     }
+  }
+
+  group.m_devices.Add (device);
+  group.m_addressToDevice [GetIpv4Address (device)] = device;
+  m_deviceToGroup [device] = groupId;
+}
+
+void
+MmWaveVehicularHelper::ActivateBearers (Ptr<MmWaveVehicularNetDevice> di, Ptr<MmWaveVehicularNetDevice> dj)
+{
+  NS_LOG_FUNCTION (this << di << dj);
+
+  uint16_t iRnti = di->GetMac ()->GetRnti ();
+  uint16_t jRnti = dj->GetMac ()->GetRnti ();
+
+  // register the associated devices in the PHY
+  di->GetPhy ()->AddDevice (jRnti, dj);
+  dj->GetPhy ()->AddDevice (iRnti, di);
+
+  // the LCID has to be the same on both the endpoints, since the receiver
+  // uses it to select the RLC instance
+  uint8_t lcid = 1;
+  while (!di->IsLcidAvailable (lcid) || !dj->IsLcidAvailable (lcid))
+  {
+    NS_ABORT_MSG_IF (lcid == std::numeric_limits<uint8_t>::max (),
+                     "No logical channel available between RNTI " << iRnti << " and " << jRnti);
+    lcid++;
+  }
+
+  // bearer activation by creating a logical channel between the two devices
+  Ipv4Address diAddr = GetIpv4Address (di);
+  Ipv4Address djAddr = GetIpv4Address (dj);
+  NS_LOG_DEBUG ("Activation of bearer between " << diAddr << " and " << djAddr);
+  NS_LOG_DEBUG ("LCID: " << uint32_t (lcid) << " - Associate RNTI " << iRnti << " to " << jRnti);
+
+  di->ActivateBearer (lcid, jRnti, djAddr);
+  dj->ActivateBearer (lcid, iRnti, diAddr);
+}
+
+void
+MmWaveVehicularHelper::ActivateBearerOnDemand (Ptr<MmWaveVehicularNetDevice> device, Ipv4Address dest)
+{
+  NS_LOG_FUNCTION (this << device << dest);
+
+  auto groupIt = m_deviceToGroup.find (device);
+  if (groupIt == m_deviceToGroup.end ())
+  {
+    return;
+  }
+
+  const DeviceGroup& group = m_groups [groupIt->second];
+  auto destIt = group.m_addressToDevice.find (dest);
+  if (destIt == group.m_addressToDevice.end () || destIt->second == device)
+  {
+    NS_LOG_WARN ("Destination " << dest << " does not belong to the group of the device");
+    return;
+  }
+
+  if (!device->HasBearer (destIt->second->GetMac ()->GetRnti ()))
+  {
+    ActivateBearers (device, destIt->second);
+  }
+}
+
+void
+MmWaveVehicularHelper::ScheduleSchedulingPatternsUpdate (uint32_t groupId)
+{
+  NS_LOG_FUNCTION (this << groupId);
+
+  DeviceGroup& group = m_groups [groupId];
+  if (!group.m_patternUpdateEvent.IsRunning ())
+  {
+    group.m_patternUpdateEvent = Simulator::ScheduleNow (&MmWaveVehicularHelper::UpdateSchedulingPatterns, this, groupId);
+  }
+}
+
+void
+MmWaveVehicularHelper::UpdateSchedulingPatterns (uint32_t groupId)
+{
+  NS_LOG_FUNCTION (this << groupId);
+
+  const DeviceGroup& group = m_groups [groupId];
+  if (group.m_devices.GetN () > 0)
+  {
+    ConfigureSchedulingPatterns (group.m_devices);
+  }
+}
+
+Ipv4Address
+MmWaveVehicularHelper::GetIpv4Address (Ptr<MmWaveVehicularNetDevice> device) const
+{
+  Ptr<Ipv4> ipv4 = device->GetNode ()->GetObject<Ipv4> ();
+  NS_ASSERT_MSG (ipv4 != 0, "Nodes need to have IPv4 installed before pairing can be activated");
+  int32_t interface = ipv4->GetInterfaceForDevice (device);
+  NS_ASSERT_MSG (interface >= 0, "The device has no IPv4 interface");
+  return ipv4->GetAddress (interface, 0).GetLocal ();
+}
 
 std::vector<uint16_t>
 MmWaveVehicularHelper::CreateSchedulingPattern (NetDeviceContainer devices)
 {
-  // The maximum supported number of vehicles in the group is equal to the available number of slots per subframe
-  // TODO implement scheduling pattern that support groups with a number of vehicle greater than the number of slots per subframe
-  NS_ABORT_MSG_IF (devices.GetN () > m_phyMacConfig->GetSlotsPerSubframe (), "Too many devices");
+  NS_ABORT_MSG_IF (m_schedulingOpt == SENSING, "The scheduling pattern is not used by the sensing based allocation");
+
+  std::vector<std::vector<uint32_t> > groups = CreateReuseGroups (devices);
+  std::vector<uint32_t> groupPattern = CreateGroupPattern (groups.size ());
+
+  // each slot reports the RNTI of the first device of the scheduled group
+  std::vector<uint16_t> pattern (groupPattern.size (), 0);
+  for (uint32_t slot = 0; slot < groupPattern.size (); slot++)
+  {
+    if (groupPattern [slot] < groups.size ())
+    {
+      Ptr<MmWaveVehicularNetDevice> d = DynamicCast<MmWaveVehicularNetDevice> (devices.Get (groups [groupPattern [slot]].front ()));
+      pattern [slot] = d->GetMac ()->GetRnti ();
+    }
+  }
+  return pattern;
+}
+
+void
+MmWaveVehicularHelper::ConfigureSchedulingPatterns (NetDeviceContainer devices)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_schedulingOpt == SENSING)
+  {
+    // each device autonomously selects its slots
+    return;
+  }
 
-  // NOTE fixed scheduling pattern, set in configuration time and assumed the same for each subframe
+  std::vector<std::vector<uint32_t> > groups = CreateReuseGroups (devices);
+  std::vector<uint32_t> groupPattern = CreateGroupPattern (groups.size ());
 
-  uint8_t slotPerSf = m_phyMacConfig->GetSlotsPerSubframe ();
-  std::vector<uint16_t> pattern;
+  for (uint32_t i = 0; i < devices.GetN (); i++)
+  {
+    Ptr<MmWaveVehicularNetDevice> di = DynamicCast<MmWaveVehicularNetDevice> (devices.Get (i));
+    Ptr<MobilityModel> iMobility = di->GetNode ()->GetObject<MobilityModel> ();
+
+    // for each group, select the device this one prepares for the reception from
+    std::vector<uint16_t> groupRnti (groups.size (), 0);
+    for (uint32_t g = 0; g < groups.size (); g++)
+    {
+      double minDistance = std::numeric_limits<double>::max ();
+      for (uint32_t j : groups [g])
+      {
+        Ptr<MmWaveVehicularNetDevice> dj = DynamicCast<MmWaveVehicularNetDevice> (devices.Get (j));
+        if (j == i)
+        {
+          // this device transmits in the slots of its group
+          groupRnti [g] = di->GetMac ()->GetRnti ();
+          break;
+        }
+        double distance = iMobility->GetDistanceFrom (dj->GetNode ()->GetObject<MobilityModel> ());
+        if (distance < minDistance)
+        {
+          minDistance = distance;
+          groupRnti [g] = dj->GetMac ()->GetRnti ();
+        }
+      }
+    }
+
+    std::vector<uint16_t> pattern (groupPattern.size (), 0);
+    for (uint32_t slot = 0; slot < groupPattern.size (); slot++)
+    {
+      if (groupPattern [slot] < groups.size ())
+      {
+        pattern [slot] = groupRnti [groupPattern [slot]];
+      }
+    }
+    di->GetMac ()->SetSfAllocationInfo (pattern);
+  }
+}
+
+std::vector<std::vector<uint32_t> >
+MmWaveVehicularHelper::CreateReuseGroups (NetDeviceContainer devices) const
+{
+  std::vector<std::vector<uint32_t> > groups;
+  for (uint32_t i = 0; i < devices.GetN (); i++)
+  {
+    bool assigned = false;
+    if (m_reuseDistance > 0)
+    {
+      Ptr<MobilityModel> iMobility = devices.Get (i)->GetNode ()->GetObject<MobilityModel> ();
+      NS_ASSERT_MSG (iMobility, "Missing mobility model");
+      for (auto& group : groups)
+      {
+        bool farEnough = true;
+        for (uint32_t j : group)
+        {
+          if (iMobility->GetDistanceFrom (devices.Get (j)->GetNode ()->GetObject<MobilityModel> ()) < m_reuseDistance)
+          {
+            farEnough = false;
+            break;
+          }
+        }
+        if (farEnough)
+        {
+          group.push_back (i);
+          assigned = true;
+          break;
+        }
+      }
+    }
+
+    if (!assigned)
+    {
+      groups.push_back (std::vector<uint32_t> (1, i));
+    }
+  }
+
+  NS_LOG_DEBUG (devices.GetN () << " devices partitioned in " << groups.size () << " groups");
+  return groups;
+}
+
+std::vector<uint32_t>
+MmWaveVehicularHelper::CreateGroupPattern (uint32_t numGroups) const
+{
+  NS_ABORT_MSG_IF (numGroups == 0, "No devices");
+
+  // the pattern spans the minimum number of subframes needed to assign at
+  // least one slot to each group, and it is repeated over time
+  uint32_t slotPerSf = m_phyMacConfig->GetSlotsPerSubframe ();
+  uint32_t numSf = std::ceil (double (numGroups) / slotPerSf);
+  uint32_t numSlots = numSf * slotPerSf;
+  NS_LOG_DEBUG ("The pattern spans " << numSf << " subframes");
+
+  std::vector<uint32_t> pattern;
 
   switch (m_schedulingOpt)
   {
     case DEFAULT:
     {
-      // Each slot in the subframe is assigned to a different user.
-      // If (numDevices < numSlots), the remaining available slots are unused
-      pattern = std::vector<uint16_t> (slotPerSf);
-      for (uint16_t i = 0; i < devices.GetN (); i++)
+      // Each slot in the pattern is assigned to a different group.
+      // If (numGroups < numSlots), the remaining available slots are unused
+      pattern = std::vector<uint32_t> (numSlots, numGroups);
+      for (uint32_t i = 0; i < numGroups; i++)
       {
-        Ptr<MmWaveVehicularNetDevice> di = DynamicCast<MmWaveVehicularNetDevice> (devices.Get (i));
-        pattern.at(i) = di->GetMac ()->GetRnti ();
-        NS_LOG_DEBUG ("slot " << i << " assigned to rnti " << di->GetMac ()->GetRnti ());
+        pattern.at (i) = i;
+        NS_LOG_DEBUG ("slot " << i << " assigned to group " << i);
       }
       break;
     }
     case OPTIMIZED:
     {
-      // Each slot in the subframe is used
-      uint8_t slotPerDev = std::floor ( slotPerSf / devices.GetN ());
-      uint8_t remainingSlots = slotPerSf % devices.GetN ();
+      // Each slot in the pattern is used
+      uint32_t slotPerGroup = numSlots / numGroups;
+      uint32_t remainingSlots = numSlots % numGroups;
 
-      NS_LOG_DEBUG("Minimum number of slots per device = " << (uint16_t)slotPerDev);
-      NS_LOG_DEBUG("Available slots = " << (uint16_t)slotPerSf);
+      NS_LOG_DEBUG("Minimum number of slots per group = " << slotPerGroup);
+      NS_LOG_DEBUG("Available slots = " << numSlots);
 
-      uint8_t slotCnt = 0;
-
-      for (uint16_t i = 0; i < devices.GetN (); i++)
+      for (uint32_t i = 0; i < numGroups; i++)
       {
-        Ptr<MmWaveVehicularNetDevice> di = DynamicCast<MmWaveVehicularNetDevice> (devices.Get (i));
-
-        for (uint8_t j = 0; j < slotPerDev; j++)
+        for (uint32_t j = 0; j < slotPerGroup; j++)
         {
-          pattern.push_back(di->GetMac ()->GetRnti ());
-          NS_LOG_DEBUG ("slot " << uint16_t(slotCnt) << " assigned to rnti " << di->GetMac ()->GetRnti ());
-          slotCnt++;
+          NS_LOG_DEBUG ("slot " << pattern.size () << " assigned to group " << i);
+          pattern.push_back (i);
         }
       }
 
-      NS_LOG_DEBUG("Remaining slots = " << (uint16_t)remainingSlots);
-      for (uint16_t i = 0; i < remainingSlots; i++)
+      NS_LOG_DEBUG("Remaining slots = " << remainingSlots);
+      for (uint32_t i = 0; i < remainingSlots; i++)
       {
-        Ptr<MmWaveVehicularNetDevice> di = DynamicCast<MmWaveVehicularNetDevice> (devices.Get (i));
-        pattern.push_back(di->GetMac ()->GetRnti ());
-        NS_LOG_DEBUG ("slot " << uint16_t(slotCnt) << " assigned to rnti " << di->GetMac ()->GetRnti ());
-        slotCnt++;
+        NS_LOG_DEBUG ("slot " << pattern.size () << " assigned to group " << i);
+        pattern.push_back (i);
       }
       break;
     }
@@ -451,6 +737,20 @@ MmWaveVehicularHelper::SetPropagationDelayModelType (std::string pdm)
   m_propagationDelayModelType = pdm;
 }
 
+void
+MmWaveVehicularHelper::SetSchedulerType (std::string type)
+{
+  NS_LOG_FUNCTION (this << type);
+  m_schedulerFactory = ObjectFactory ();
+  m_schedulerFactory.SetTypeId (type);
+}
+
+std::string
+MmWaveVehicularHelper::GetSchedulerType () const
+{
+  return m_schedulerFactory.GetTypeId ().GetName ();
+}
+
 void
 MmWaveVehicularHelper::SetSchedulingPatternOptionType (SchedulingPatternOption_t spo)
 {
@@ -26,6 +26,9 @@
 #include "ns3/spectrum-channel.h"
 #include "ns3/mmwave-phy-mac-common.h"
 #include "ns3/mmwave-vehicular-traces-helper.h"
+#include "ns3/object-factory.h"
+#include "ns3/event-id.h"
+#include "ns3/ipv4-address.h"
 
 namespace ns3 {
 
@@ -73,6 +76,14 @@ public:
    */
   Ptr<mmwave::MmWavePhyMacCommon> GetConfigurationParameters () const;
 
+  /**
+   * Retrieve the helper writing the SINR and MCS trace, e.g., to flush it
+   * or to continue it in another file
+   * \return a pointer to the MmWaveVehicularTracesHelper, null before the
+   *         installation of the devices
+   */
+  Ptr<MmWaveVehicularTracesHelper> GetPhyTracesHelper () const;
+
   /**
    * Set the propagation loss model type
    * \param plm the type id of the propagation loss model to use
@@ -92,12 +103,46 @@ public:
   void SetPropagationDelayModelType (std::string pdm);
 
   /**
-   * Associate the devices in the container
+   * Set the type of scheduler used by the sidelink MAC
+   * \param type the type id of the scheduler to use
+   */
+  void SetSchedulerType (std::string type);
+
+  /**
+   * Get the type of scheduler used by the sidelink MAC
+   * \return the type id of the scheduler
+   */
+  std::string GetSchedulerType () const;
+
+  /**
+   * Associate the devices in the container. If the LazyBearerActivation
+   * attribute is true, the bearer between two devices of the group is
+   * activated when the first packet between them is sent, otherwise the
+   * bearers between all the pairs of devices are activated here.
    * \param devices the NetDeviceContainer with the devices
+   * \return the identifier of the group of associated devices
+   */
+  uint32_t PairDevices (NetDeviceContainer devices);
+
+  /**
+   * Associate a device to the devices of a group created with PairDevices,
+   * e.g., when a new vehicle enters the scenario. The scheduling pattern of
+   * the group is updated once for all the devices added or removed at the
+   * same simulation time, until then the new device does not transmit.
+   * \param groupId the identifier of the group
+   * \param device the device
    */
-  void PairDevices (NetDeviceContainer devices);
-  
-  uint8_t newPairingSystem(NetDeviceContainer devices, uint8_t id);
+  void AddDeviceToGroup (uint32_t groupId, Ptr<NetDevice> device);
+
+  /**
+   * Remove a device from its group, e.g., when a vehicle leaves the
+   * scenario. The bearers between the device and the other devices of the
+   * group are deactivated, their PHYs and MACs forget each other, e.g., the
+   * queued PDUs and the CQI histories, and the device is not scheduled
+   * anymore.
+   * \param device the device
+   */
+  void RemoveDeviceFromGroup (Ptr<NetDevice> device);
 
   /**
    * Configure the numerology index
@@ -106,17 +151,42 @@ public:
   void SetNumerology (uint8_t index);
 
   /**
-   * Configure the scheduling pattern for a specific group of devices
+   * Assign a fixed random variable stream number to the random variables
+   * used by the MAC of the devices in the container. The devices should
+   * have been installed with InstallMmWaveVehicularNetDevices.
+   * \param c the NetDeviceContainer with the devices
+   * \param stream first stream index to use
+   * \return the number of stream indices (possibly zero) that have been assigned
+   */
+  int64_t AssignStreams (NetDeviceContainer c, int64_t stream);
+
+  /**
+   * Configure the scheduling pattern for a specific group of devices. If the
+   * group contains more devices than the number of slots per subframe, the
+   * pattern spans multiple subframes. If the ReuseDistance attribute is
+   * positive, devices which are farther apart than the reuse distance may be
+   * scheduled in the same slot: in this case, each slot reports the RNTI of
+   * the first device scheduled in it.
    * \param devices the NetDeviceContainer with the devices
    * \return a vector of integers representing the scheduling pattern
   */
   std::vector<uint16_t> CreateSchedulingPattern (NetDeviceContainer devices);
 
+  /**
+   * Compute the scheduling pattern for a specific group of devices and set it
+   * in the MAC of each device. With spatial reuse, in the slots assigned to
+   * other devices each device prepares for the reception from the closest
+   * transmitting device.
+   * \param devices the NetDeviceContainer with the devices
+   */
+  void ConfigureSchedulingPatterns (NetDeviceContainer devices);
+
   /**
    * Identifies the supported scheduling pattern policies
    */
   enum SchedulingPatternOption_t {DEFAULT = 1,
-                                   OPTIMIZED = 2};
+                                   OPTIMIZED = 2,
+                                   SENSING = 3};
 
   /**
   * Set the scheduling pattern option type
@@ -143,7 +213,81 @@ private:
    */
   Ptr<MmWaveVehicularNetDevice> InstallSingleMmWaveVehicularNetDevice (Ptr<Node> n, uint16_t rnti);
 
+  /**
+   * Partition the devices into groups which can transmit in the same slot.
+   * Each device is added to the first group whose devices are all farther
+   * than m_reuseDistance, or to a new group.
+   * \param devices the NetDeviceContainer with the devices
+   * \return the groups, each one containing the indexes of the devices
+   */
+  std::vector<std::vector<uint32_t> > CreateReuseGroups (NetDeviceContainer devices) const;
+
+  /**
+   * Assign the slots to the groups according to m_schedulingOpt. The pattern
+   * spans the minimum number of subframes needed to serve all the groups.
+   * \param numGroups the number of groups
+   * \return the index of the group scheduled in each slot, numGroups if the
+   *         slot is not used
+   */
+  std::vector<uint32_t> CreateGroupPattern (uint32_t numGroups) const;
+
+  /**
+   * Add a device to a group and, if the bearers are not activated on demand,
+   * activate the bearers with the other devices of the group
+   * \param groupId the identifier of the group
+   * \param device the device
+   */
+  void DoAddDeviceToGroup (uint32_t groupId, Ptr<MmWaveVehicularNetDevice> device);
+
+  /**
+   * Register two devices in the PHY of each other and activate the bearer
+   * between them, using the lowest LCID which is available on both devices
+   * \param di the first device
+   * \param dj the second device
+   */
+  void ActivateBearers (Ptr<MmWaveVehicularNetDevice> di, Ptr<MmWaveVehicularNetDevice> dj);
+
+  /**
+   * Activate the bearer between a device and the device of the same group
+   * with the given address. Used as bearer request callback by the devices
+   * when LazyBearerActivation is true.
+   * \param device the device which requested the bearer
+   * \param dest the IPv4 address of the destination
+   */
+  void ActivateBearerOnDemand (Ptr<MmWaveVehicularNetDevice> device, Ipv4Address dest);
+
+  /**
+   * Schedule the update of the scheduling pattern of a group, if not already
+   * scheduled at the current simulation time
+   * \param groupId the identifier of the group
+   */
+  void ScheduleSchedulingPatternsUpdate (uint32_t groupId);
+
+  /**
+   * Update the scheduling pattern of a group
+   * \param groupId the identifier of the group
+   */
+  void UpdateSchedulingPatterns (uint32_t groupId);
+
+  /**
+   * Return the IPv4 address of a device
+   * \param device the device
+   * \return the IPv4 address
+   */
+  Ipv4Address GetIpv4Address (Ptr<MmWaveVehicularNetDevice> device) const;
+
+  /**
+   * A group of devices which can communicate with each other
+   */
+  struct DeviceGroup
+  {
+    NetDeviceContainer m_devices; //!< the devices of the group
+    std::map<Ipv4Address, Ptr<MmWaveVehicularNetDevice> > m_addressToDevice; //!< map between the IPv4 addresses and the devices of the group
+    EventId m_patternUpdateEvent; //!< the pending update of the scheduling pattern
+  };
+
   Ptr<SpectrumChannel> m_channel; //!< the SpectrumChannel
+  std::string m_channelType; //!< the type id of the SpectrumChannel to be used
   Ptr<mmwave::MmWavePhyMacCommon> m_phyMacConfig; //!< the configuration parameters
   uint16_t m_rntiCounter; //!< a counter to set the RNTIs
   uint8_t m_numerologyIndex; //!< numerology index
@@ -151,9 +295,16 @@ private:
   std::string m_propagationLossModelType; //!< the type id of the propagation loss model to be used
   std::string m_spectrumPropagationLossModelType; //!< the type id of the spectrum propagation loss model to be used
   std::string m_propagationDelayModelType; //!< the type id of the delay model to be used
+  ObjectFactory m_schedulerFactory; //!< the factory used to create the sidelink schedulers
   SchedulingPatternOption_t m_schedulingOpt; //!< the type of scheduling pattern policy to be adopted
+  double m_reuseDistance; //!< minimum distance between devices scheduled in the same slot, 0 to disable the spatial reuse
+  bool m_lazyBearerActivation; //!< if true, the bearers are activated when the first packet is sent
+  std::vector<DeviceGroup> m_groups; //!< the groups of associated devices
+  std::map<Ptr<NetDevice>, uint32_t> m_deviceToGroup; //!< map between the devices and the identifier of their group
 
   Ptr<MmWaveVehicularTracesHelper> m_phyTraceHelper; //!< Ptr to an helper for the physical layer traces
+  std::string m_phyTraceFileName; //!< the name of the file of the physical layer traces
+  MmWaveVehicularTracesHelper::TraceFormat m_phyTraceFormat; //!< the format of the file of the physical layer traces
 
 };
 
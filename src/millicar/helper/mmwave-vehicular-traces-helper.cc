@@ -20,6 +20,8 @@
 #include "mmwave-vehicular-traces-helper.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/rng-seed-manager.h"
+#include <cstring>
 
 namespace ns3 {
 
@@ -29,31 +31,136 @@ namespace millicar {
 
 NS_OBJECT_ENSURE_REGISTERED (MmWaveVehicularTracesHelper);
 
-MmWaveVehicularTracesHelper::MmWaveVehicularTracesHelper (std::string filename)
-: m_filename(filename)
+/// the version of the binary format
+static const uint16_t kBinaryVersion = 1;
+/// the size of a record of the binary format, in bytes
+static const uint16_t kBinaryRecordSize = 24;
+/// the size of the buffer of the binary records, in bytes
+static const std::size_t kBinaryBufferSize = 1 << 16;
+/// the fields of a record of the binary format
+static const char kBinarySchema[] = "time_ns:int64,sinr:float64,tb_size:uint32,rnti:uint16,num_sym:uint8,mcs:uint8";
+
+MmWaveVehicularTracesHelper::MmWaveVehicularTracesHelper (std::string filename, TraceFormat format)
+: m_filename(filename),
+  m_format (format),
+  m_flushScheduled (false)
 {
   NS_LOG_FUNCTION (this);
 
-  if(!m_outputFile.is_open())
+  if (m_format == BINARY)
   {
-    m_outputFile.open(m_filename.c_str());
-    if (!m_outputFile.is_open ())
-    {
-      NS_FATAL_ERROR ("Could not open tracefile");
-    }
+    m_buffer.reserve (kBinaryBufferSize);
   }
+  Open ();
 }
 
 MmWaveVehicularTracesHelper::~MmWaveVehicularTracesHelper ()
 {
   NS_LOG_FUNCTION (this);
+  Flush ();
+}
+
+void
+MmWaveVehicularTracesHelper::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  Flush ();
+  m_outputFile.close ();
+  Object::DoDispose ();
+}
+
+void
+MmWaveVehicularTracesHelper::Open ()
+{
+  m_outputFile.open(m_filename.c_str(), m_format == BINARY ? std::ios::out | std::ios::binary : std::ios::out);
+  if (!m_outputFile.is_open ())
+  {
+    NS_FATAL_ERROR ("Could not open tracefile " << m_filename);
+  }
+
+  if (m_format == BINARY)
+  {
+    WriteBinaryHeader ();
+  }
+}
+
+void
+MmWaveVehicularTracesHelper::SetFileName (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  Flush ();
+  m_outputFile.close ();
+  m_filename = filename;
+  Open ();
+}
+
+void
+MmWaveVehicularTracesHelper::WriteBinaryHeader ()
+{
+  uint32_t schemaLength = sizeof (kBinarySchema) - 1;
+  m_outputFile.write ("MCTR", 4);
+  Append (kBinaryVersion, 2);
+  Append (kBinaryRecordSize, 2);
+  Append (RngSeedManager::GetSeed (), 4);
+  Append (RngSeedManager::GetRun (), 8);
+  Append (schemaLength, 4);
+  Flush ();
+  m_outputFile.write (kBinarySchema, schemaLength);
+}
+
+void
+MmWaveVehicularTracesHelper::Append (uint64_t value, uint8_t size)
+{
+  for (uint8_t i = 0; i < size; i++)
+  {
+    m_buffer.push_back (static_cast<uint8_t> (value >> (8 * i)));
+  }
+}
+
+void
+MmWaveVehicularTracesHelper::Flush ()
+{
+  if (!m_buffer.empty () && m_outputFile.is_open ())
+  {
+    m_outputFile.write (reinterpret_cast<const char*> (m_buffer.data ()), m_buffer.size ());
+    m_buffer.clear ();
+  }
+  if (m_outputFile.is_open ())
+  {
+    m_outputFile.flush ();
+  }
 }
 
 void
 MmWaveVehicularTracesHelper::McsSinrCallback(const SpectrumValue& sinr, uint16_t rnti, uint8_t numSym, uint32_t tbSize, uint8_t mcs)
 {
+  if (!m_flushScheduled)
+  {
+    // the helper may outlive the simulation, make sure the buffered records
+    // are written when the simulation ends
+    Simulator::ScheduleDestroy (&MmWaveVehicularTracesHelper::Flush, Ptr<MmWaveVehicularTracesHelper> (this));
+    m_flushScheduled = true;
+  }
+
   double sinrAvg = Sum (sinr) / (sinr.GetSpectrumModel ()->GetNumBands ());
-  m_outputFile << Simulator::Now().GetSeconds() << "\t" << rnti << "\t" << 10 * std::log10 (sinrAvg) << "\t" << (uint32_t)numSym << "\t" << tbSize << "\t" << (uint32_t)mcs << std::endl;
+  if (m_format == TEXT)
+  {
+    m_outputFile << Simulator::Now().GetSeconds() << "\t" << rnti << "\t" << 10 * std::log10 (sinrAvg) << "\t" << (uint32_t)numSym << "\t" << tbSize << "\t" << (uint32_t)mcs << "\n";
+    return;
+  }
+
+  uint64_t sinrBits;
+  std::memcpy (&sinrBits, &sinrAvg, sizeof (sinrBits));
+  Append (Simulator::Now ().GetNanoSeconds (), 8);
+  Append (sinrBits, 8);
+  Append (tbSize, 4);
+  Append (rnti, 2);
+  Append (numSym, 1);
+  Append (mcs, 1);
+  if (m_buffer.size () + kBinaryRecordSize > kBinaryBufferSize)
+  {
+    Flush ();
+  }
 }
 
 }
@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "mmwave-sidelink-edf-scheduler.h"
+#include "ns3/log.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveSidelinkEdfScheduler");
+
+namespace millicar {
+
+NS_OBJECT_ENSURE_REGISTERED (MmWaveSidelinkEdfScheduler);
+
+TypeId
+MmWaveSidelinkEdfScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MmWaveSidelinkEdfScheduler")
+    .SetParent<MmWaveSidelinkScheduler> ()
+    .AddConstructor<MmWaveSidelinkEdfScheduler> ()
+  ;
+  return tid;
+}
+
+MmWaveSidelinkEdfScheduler::MmWaveSidelinkEdfScheduler (void)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MmWaveSidelinkEdfScheduler::~MmWaveSidelinkEdfScheduler (void)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+std::vector<SlGrant>
+MmWaveSidelinkEdfScheduler::ScheduleSlot (const std::vector<SlSchedulingRequest>& requests, uint32_t availableSymbols)
+{
+  NS_LOG_FUNCTION (this << requests.size () << availableSymbols);
+
+  // sort by increasing time to the deadline of the head of line packet, i.e.,
+  // the delay budget of the bearer minus the head of line delay, ties are
+  // broken by LCID
+  std::vector<SlSchedulingRequest> sorted (requests);
+  std::sort (sorted.begin (), sorted.end (),
+             [] (const SlSchedulingRequest& a, const SlSchedulingRequest& b)
+             {
+               Time aDeadline = a.delayBudget - a.holDelay;
+               Time bDeadline = b.delayBudget - b.holDelay;
+               return aDeadline < bDeadline || (aDeadline == bDeadline && a.lcid < b.lcid);
+             });
+
+  for (auto it = sorted.begin (); it != sorted.end (); it++)
+  {
+    NS_LOG_DEBUG ("lcid " << uint16_t (it->lcid) << " time to deadline " << (it->delayBudget - it->holDelay).GetMicroSeconds () << " us");
+    if (it->holDelay > it->delayBudget)
+    {
+      NS_LOG_INFO ("lcid " << uint16_t (it->lcid) << " missed the deadline");
+    }
+  }
+
+  return AllocateInOrder (sorted, availableSymbols);
+}
+
+} // namespace millicar
+
+} // namespace ns3
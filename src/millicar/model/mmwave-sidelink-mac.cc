@@ -22,9 +22,15 @@
 #include "ns3/lte-mac-sap.h"
 #include "ns3/lte-radio-bearer-tag.h"
 #include "mmwave-sidelink-mac.h"
+#include "mmwave-sidelink-rr-scheduler.h"
 #include "ns3/log.h"
 #include "ns3/uinteger.h"
 #include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/simulator.h"
+#include "ns3/mmwave-vehicular-profiler.h"
+#include <limits>
 
 namespace ns3 {
 
@@ -56,6 +62,12 @@ MacSidelinkMemberPhySapUser::SlSinrReport (const SpectrumValue& sinr, uint16_t r
   m_mac->DoSlSinrReport (sinr, rnti, numSym, tbSize);
 }
 
+void
+MacSidelinkMemberPhySapUser::SlSensingReport (uint16_t rnti, double rxPower)
+{
+  m_mac->DoSlSensingReport (rnti, rxPower);
+}
+
 //-----------------------------------------------------------------------
 
 RlcSidelinkMemberMacSapProvider::RlcSidelinkMemberMacSapProvider (Ptr<MmWaveSidelinkMac> mac)
@@ -78,6 +90,85 @@ RlcSidelinkMemberMacSapProvider::ReportBufferStatus (ReportBufferStatusParameter
 
 //-----------------------------------------------------------------------
 
+SlCqiHistory::SlCqiHistory (uint32_t size)
+  : m_reports (size),
+    m_head (0),
+    m_count (0)
+{
+  NS_ASSERT_MSG (size > 0, "The CQI history must contain at least one report");
+}
+
+void
+SlCqiHistory::Add (int cqi, Time timestamp)
+{
+  uint32_t tail = (m_head + m_count) % m_reports.size ();
+  m_reports [tail].cqi = cqi;
+  m_reports [tail].timestamp = timestamp;
+  if (m_count < m_reports.size ())
+  {
+    m_count++;
+  }
+  else
+  {
+    // the history is full, the oldest report has been overwritten
+    m_head = (m_head + 1) % m_reports.size ();
+  }
+}
+
+void
+SlCqiHistory::RemoveOlderThan (Time oldest)
+{
+  while (m_count > 0 && m_reports [m_head].timestamp < oldest)
+  {
+    m_head = (m_head + 1) % m_reports.size ();
+    m_count--;
+  }
+}
+
+uint32_t
+SlCqiHistory::GetSize () const
+{
+  return m_count;
+}
+
+const SlCqiHistory::CqiReport&
+SlCqiHistory::Get (uint32_t i) const
+{
+  NS_ASSERT_MSG (i < m_count, "Index out of range");
+  return m_reports [(m_head + i) % m_reports.size ()];
+}
+
+int
+SlCqiHistory::GetLast () const
+{
+  return Get (m_count - 1).cqi;
+}
+
+int
+SlCqiHistory::GetEwma (double alpha) const
+{
+  // iterate from the oldest to the newest report
+  double ewma = Get (0).cqi;
+  for (uint32_t i = 1; i < m_count; i++)
+  {
+    ewma = alpha * Get (i).cqi + (1 - alpha) * ewma;
+  }
+  return std::floor (ewma);
+}
+
+int
+SlCqiHistory::GetMin () const
+{
+  int cqi = Get (0).cqi;
+  for (uint32_t i = 1; i < m_count; i++)
+  {
+    cqi = std::min (cqi, Get (i).cqi);
+  }
+  return cqi;
+}
+
+//-----------------------------------------------------------------------
+
 NS_OBJECT_ENSURE_REGISTERED (MmWaveSidelinkMac);
 
 TypeId
@@ -95,6 +186,54 @@ MmWaveSidelinkMac::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&MmWaveSidelinkMac::m_useAmc),
                    MakeBooleanChecker ())
+    .AddAttribute ("CqiHistorySize",
+                   "The maximum number of CQI reports stored for each device. "
+                   "When the history is full, the oldest report is overwritten.",
+                   UintegerValue (10),
+                   MakeUintegerAccessor (&MmWaveSidelinkMac::m_cqiHistorySize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("CqiAggregation",
+                   "The method used to obtain the CQI used for link adaptation from the CQI history",
+                   EnumValue (MmWaveSidelinkMac::LAST_CQI),
+                   MakeEnumAccessor (&MmWaveSidelinkMac::m_cqiAggregation),
+                   MakeEnumChecker (MmWaveSidelinkMac::LAST_CQI, "Last",
+                                    MmWaveSidelinkMac::EWMA_CQI, "Ewma",
+                                    MmWaveSidelinkMac::MIN_CQI, "Min"))
+    .AddAttribute ("CqiEwmaAlpha",
+                   "The weight of the newest report when the CQI history is aggregated using the EWMA",
+                   DoubleValue (0.5),
+                   MakeDoubleAccessor (&MmWaveSidelinkMac::m_cqiEwmaAlpha),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+    .AddAttribute ("CqiMaxAge",
+                   "The CQI reports older than this value are discarded. "
+                   "If set to zero, the reports never expire.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&MmWaveSidelinkMac::m_cqiMaxAge),
+                   MakeTimeChecker ())
+    .AddAttribute ("SensingBasedAllocation",
+                   "If true, each device autonomously reserves a slot in each reservation period "
+                   "based on the transmissions sensed in the previous period, and the "
+                   "scheduling pattern set through SetSfAllocationInfo is ignored.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MmWaveSidelinkMac::m_sensingBasedAllocation),
+                   MakeBooleanChecker ())
+    .AddAttribute ("ReservationPeriod",
+                   "The reservation period in number of subframes, used by the sensing based allocation",
+                   UintegerValue (10),
+                   MakeUintegerAccessor (&MmWaveSidelinkMac::m_reservationPeriod),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("ReservationDuration",
+                   "The number of reservation periods after which a new slot is selected, "
+                   "used by the sensing based allocation",
+                   UintegerValue (10),
+                   MakeUintegerAccessor (&MmWaveSidelinkMac::m_reservationDuration),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("SensingThreshold",
+                   "Slots in which a transmission was sensed with a received power (dBm) "
+                   "above this threshold are not selected by the sensing based allocation",
+                   DoubleValue (-90.0),
+                   MakeDoubleAccessor (&MmWaveSidelinkMac::m_sensingThreshold),
+                   MakeDoubleChecker<double> ())
     .AddTraceSource ("SchedulingInfo",
                      "Information regarding the scheduling.",
                      MakeTraceSourceAccessor (&MmWaveSidelinkMac::m_schedulingTrace),
@@ -112,6 +251,11 @@ MmWaveSidelinkMac::MmWaveSidelinkMac (Ptr<mmwave::MmWavePhyMacCommon> pmc)
   // initialize the RNTI to 0
   m_rnti = 0;
 
+  m_slotCounter = 0;
+  m_reservationCounter = 0;
+  m_reservedSlot = 0;
+  m_uniformRv = CreateObject<UniformRandomVariable> ();
+
   // create the PHY SAP USER
   m_phySapUser = new MacSidelinkMemberPhySapUser (this);
 
@@ -121,6 +265,9 @@ MmWaveSidelinkMac::MmWaveSidelinkMac (Ptr<mmwave::MmWavePhyMacCommon> pmc)
   // create the mmwave::MmWaveAmc instance
   m_amc = CreateObject <mmwave::MmWaveAmc> (m_phyMacConfig);
 
+  // create the default scheduler
+  SetScheduler (CreateObject<MmWaveSidelinkRrScheduler> ());
+
   // initialize the scheduling patter
   std::vector<uint16_t> pattern (m_phyMacConfig->GetSlotsPerSubframe (), 0);
   m_sfAllocInfo = pattern;
@@ -136,6 +283,8 @@ MmWaveSidelinkMac::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
   delete m_phySapUser;
+  m_scheduler->Dispose ();
+  m_scheduler = 0;
   Object::DoDispose ();
 }
 
@@ -145,8 +294,24 @@ MmWaveSidelinkMac::DoSlotIndication (mmwave::SfnSf timingInfo)
   NS_LOG_FUNCTION (this);
 
   NS_ASSERT_MSG (m_rnti != 0, "First set the RNTI");
+
+  if (m_sensingBasedAllocation)
+  {
+    // at the beginning of each reservation period, update the reservation
+    uint32_t periodSlots = m_reservationPeriod * m_phyMacConfig->GetSlotsPerSubframe ();
+    if (m_slotCounter % periodSlots == 0)
+    {
+      UpdateReservation ();
+    }
+  }
+
   NS_ASSERT_MSG (!m_sfAllocInfo.empty (), "First set the scheduling pattern");
-  if(m_sfAllocInfo [timingInfo.m_slotNum] == m_rnti) // check if this slot is associated to the user who required it
+
+  // the pattern is repeated every m_sfAllocInfo.size () slots
+  uint32_t slotIdx = m_slotCounter % m_sfAllocInfo.size ();
+  m_slotCounter++;
+
+  if(m_sfAllocInfo [slotIdx] == m_rnti) // check if this slot is associated to the user who required it
   {
     mmwave::SlotAllocInfo allocationInfo = ScheduleResources (timingInfo);
 
@@ -169,10 +334,10 @@ MmWaveSidelinkMac::DoSlotIndication (mmwave::SfnSf timingInfo)
       txBuffer->second.pop_front ();
     }
   }
-  else if (m_sfAllocInfo[timingInfo.m_slotNum] != 0) // if the slot is assigned to another device, prepare for reception
+  else if (m_sfAllocInfo[slotIdx] != 0) // if the slot is assigned to another device, prepare for reception
   {
-    NS_LOG_INFO ("Prepare for reception from rnti " << m_sfAllocInfo[timingInfo.m_slotNum]);
-    m_phySapProvider->PrepareForReception (m_sfAllocInfo[timingInfo.m_slotNum]);
+    NS_LOG_INFO ("Prepare for reception from rnti " << m_sfAllocInfo[slotIdx]);
+    m_phySapProvider->PrepareForReception (m_sfAllocInfo[slotIdx]);
   }
   else // the slot is not assigned to any user
   {
@@ -184,6 +349,7 @@ MmWaveSidelinkMac::DoSlotIndication (mmwave::SfnSf timingInfo)
 mmwave::SlotAllocInfo
 MmWaveSidelinkMac::ScheduleResources (mmwave::SfnSf timingInfo)
 {
+  MILLICAR_PROFILE_SCOPE (MAC_SCHEDULER);
   mmwave::SlotAllocInfo allocationInfo; // stores all the allocation decisions
   allocationInfo.m_sfnSf = timingInfo;
   allocationInfo.m_numSymAlloc = 0;
@@ -200,111 +366,89 @@ MmWaveSidelinkMac::ScheduleResources (mmwave::SfnSf timingInfo)
 
   NS_LOG_DEBUG("availableSymbols =\t" << availableSymbols);
 
-  // compute the number of available symbols per logical channel
-  // NOTE the number of available symbols per LC is rounded down due to the cast
-  // to int
-  uint32_t availableSymbolsPerLc = availableSymbols / m_bufferStatusReportMap.size ();
-
-  NS_LOG_DEBUG("availableSymbolsPerLc =\t" << availableSymbolsPerLc);
+  // collect the information needed by the scheduler for each active logical
+  // channel
+  std::vector<SlSchedulingRequest> requests;
+  for (auto bsrIt = m_bufferStatusReportMap.begin (); bsrIt != m_bufferStatusReportMap.end (); bsrIt++)
+  {
+    SlSchedulingRequest request;
+    request.lcid = bsrIt->second.lcid;
+    request.rnti = bsrIt->second.rnti; // the RNTI of the destination node
+    request.mcs = GetMcs (request.rnti); // select the MCS
+    request.bufferSize = bsrIt->second.txQueueSize + bsrIt->second.retxQueueSize + bsrIt->second.statusPduSize;
+
+    // the HOL delay reported by the RLC increases with the time elapsed since
+    // the report
+    uint16_t holDelay = std::max (bsrIt->second.txQueueHolDelay, bsrIt->second.retxQueueHolDelay);
+    request.holDelay = MilliSeconds (holDelay) + Simulator::Now () - m_bufferStatusReportTime [bsrIt->first];
+    request.delayBudget = m_lcidToDelayBudget [bsrIt->first];
+
+    NS_LOG_DEBUG("rnti " << request.rnti << " mcs = " << uint16_t(request.mcs) << " holDelay = " << request.holDelay.GetMicroSeconds () << " us");
+    requests.push_back (request);
+  }
 
-  // TODO start from the last served lc + 1
-  auto bsrIt = m_bufferStatusReportMap.begin ();
+  std::vector<SlGrant> grants = m_scheduler->ScheduleSlot (requests, availableSymbols);
 
   uint8_t symStart = 0; // indicates the next available symbol in the slot
 
-  // serve the active logical channels with a Round Robin approach
-  while (availableSymbols > 0 && m_bufferStatusReportMap.size () > 0)
+  for (auto grantIt = grants.begin (); grantIt != grants.end (); grantIt++)
   {
-    uint16_t rntiDest = bsrIt->second.rnti; // the RNTI of the destination node
-
-    uint8_t mcs = GetMcs (rntiDest); // select the MCS
-
-    NS_LOG_DEBUG("rnti " << rntiDest << " mcs = " << uint16_t(mcs));
-    // compute the number of bits for this LC
-    uint32_t availableBitsPerLc = m_amc->GetTbSizeFromMcsSymbols(mcs, availableSymbolsPerLc);
-
-    // compute the number of bits required by this LC
-    uint32_t requiredBits = (bsrIt->second.txQueueSize + bsrIt->second.retxQueueSize + bsrIt->second.statusPduSize) * 8;
-
-    // assign a number of bits which is less or equal to the available bits
-    uint32_t assignedBits = 0;
-    if (requiredBits <= availableBitsPerLc)
-    {
-      assignedBits = requiredBits;
-    }
-    else
-    {
-      assignedBits = availableBitsPerLc;
-    }
+    NS_LOG_DEBUG("assignedSymbols =\t" << grantIt->numSym);
 
-    // compute the number of symbols assigned to this LC
-    uint32_t assignedSymbols = m_amc->GetNumSymbolsFromTbsMcs (assignedBits, mcs);
-    NS_LOG_DEBUG("assignedSymbols =\t" << assignedSymbols);
-
-    //if (assignedSymbols <= availableSymbols) // TODO check if needed
-    //{
     // create the TtiAllocInfo object
     mmwave::TtiAllocInfo info;
     info.m_ttiIdx = timingInfo.m_slotNum; // the TB will be sent in this slot
-    info.m_rnti = rntiDest; // the RNTI of the destination node
+    info.m_rnti = grantIt->rnti; // the RNTI of the destination node
     info.m_dci.m_rnti = m_rnti; // my RNTI
-    info.m_dci.m_numSym = assignedSymbols; // the number of symbols required to tx the packet
+    info.m_dci.m_numSym = grantIt->numSym; // the number of symbols required to tx the packet
     info.m_dci.m_symStart = symStart; // index of the first available symbol
-    info.m_dci.m_mcs = mcs;
-    info.m_dci.m_tbSize = assignedBits / 8; // the TB size in bytes
+    info.m_dci.m_mcs = grantIt->mcs;
+    info.m_dci.m_tbSize = grantIt->tbSize; // the TB size in bytes
     info.m_ttiType = mmwave::TtiAllocInfo::TddTtiType::DATA; // the TB carries data
 
     NS_LOG_DEBUG("info.m_dci.m_tbSize =\t" << info.m_dci.m_tbSize);
 
     allocationInfo.m_ttiAllocInfo.push_back (info);
-    allocationInfo.m_numSymAlloc += assignedSymbols;
+    allocationInfo.m_numSymAlloc += grantIt->numSym;
 
     // fire the scheduling trace
-    SlSchedulingCallback traceInfo;
-    traceInfo.frame = timingInfo.m_frameNum;
-    traceInfo.subframe = timingInfo.m_sfNum;
-    traceInfo.slotNum = timingInfo.m_slotNum;
-    traceInfo.symStart = symStart;
-    traceInfo.numSym = assignedSymbols;
-    traceInfo.mcs = mcs;
-    traceInfo.tbSize = assignedBits / 8;
-    traceInfo.txRnti = m_rnti;
-    traceInfo.rxRnti = rntiDest;
-    m_schedulingTrace (traceInfo);
+    if (!m_schedulingTrace.IsEmpty ())
+      {
+        SlSchedulingCallback traceInfo;
+        traceInfo.frame = timingInfo.m_frameNum;
+        traceInfo.subframe = timingInfo.m_sfNum;
+        traceInfo.slotNum = timingInfo.m_slotNum;
+        traceInfo.symStart = symStart;
+        traceInfo.numSym = grantIt->numSym;
+        traceInfo.mcs = grantIt->mcs;
+        traceInfo.tbSize = grantIt->tbSize;
+        traceInfo.txRnti = m_rnti;
+        traceInfo.rxRnti = grantIt->rnti;
+        m_schedulingTrace (traceInfo);
+      }
 
     // notify the RLC
-    LteMacSapUser* macSapUser = m_lcidToMacSap.find (bsrIt->second.lcid)->second;
+    auto macSapIt = m_lcidToMacSap.find (grantIt->lcid);
+    NS_ASSERT_MSG (macSapIt != m_lcidToMacSap.end (), "No MAC SAP user for LCID " << uint16_t (grantIt->lcid));
+    LteMacSapUser* macSapUser = macSapIt->second;
     LteMacSapUser::TxOpportunityParameters params;
-    params.bytes = assignedBits / 8;  // the number of bytes to transmit
+    params.bytes = grantIt->tbSize;  // the number of bytes to transmit
     params.layer = 0;  // the layer of transmission (MIMO) (NOT USED)
     params.harqId = 0; // the HARQ ID (NOT USED)
     params.componentCarrierId = 0; // the component carrier id (NOT USED)
-    params.rnti = rntiDest; // the C-RNTI identifying the destination
-    params.lcid = bsrIt->second.lcid; // the logical channel id
-    macSapUser->NotifyTxOpportunity (params);
+    params.rnti = grantIt->rnti; // the C-RNTI identifying the destination
+    params.lcid = grantIt->lcid; // the logical channel id
+    {
+      MILLICAR_PROFILE_SCOPE (RLC_TX_OPPORTUNITY);
+      macSapUser->NotifyTxOpportunity (params);
+    }
 
     // update the entry in the m_bufferStatusReportMap (delete it if no
     // further resources are needed)
-    bsrIt = UpdateBufferStatusReport (bsrIt->second.lcid, assignedBits / 8);
-
-    // update the number of available symbols
-    availableSymbols -= assignedSymbols;
-
-    // update the availableSymbolsPerLc (if needed)
-    if (availableSymbols < availableSymbolsPerLc)
-    {
-      availableSymbolsPerLc = availableSymbols;
-    }
+    UpdateBufferStatusReport (grantIt->lcid, grantIt->tbSize);
 
     // update index to the next available symbol
-    symStart = symStart + assignedSymbols;
-
-    // if the iterator reached the end of the map, start again
-    if (bsrIt == m_bufferStatusReportMap.end ())
-    {
-      bsrIt = m_bufferStatusReportMap.begin ();
-    }
-
+    symStart = symStart + grantIt->numSym;
   }
   return allocationInfo;
 }
@@ -372,6 +516,8 @@ MmWaveSidelinkMac::DoReportBufferStatus (LteMacSapProvider::ReportBufferStatusPa
 {
   NS_LOG_FUNCTION (this);
 
+  m_bufferStatusReportTime [params.lcid] = Simulator::Now ();
+
   auto bsrIt = m_bufferStatusReportMap.find (params.lcid);
   if (bsrIt != m_bufferStatusReportMap.end ())
   {
@@ -424,8 +570,14 @@ MmWaveSidelinkMac::DoReceivePhyPdu (Ptr<Packet> p)
 
   NS_LOG_DEBUG ("Received a packet " << rxPduParams.rnti << " " << (uint16_t)rxPduParams.lcid);
 
-  LteMacSapUser* macSapUser = m_lcidToMacSap.find(rxPduParams.lcid)->second;
-  macSapUser->ReceivePdu (rxPduParams);
+  auto macSapIt = m_lcidToMacSap.find (rxPduParams.lcid);
+  if (macSapIt == m_lcidToMacSap.end ())
+  {
+    // the bearer has been deactivated while the packet was on the air
+    NS_LOG_INFO ("No logical channel " << (uint16_t)rxPduParams.lcid << ", discard the packet");
+    return;
+  }
+  macSapIt->second->ReceivePdu (rxPduParams);
 }
 
 MmWaveSidelinkPhySapUser*
@@ -465,7 +617,8 @@ void
 MmWaveSidelinkMac::SetSfAllocationInfo (std::vector<uint16_t> pattern)
 {
   NS_LOG_FUNCTION (this);
-  NS_ASSERT_MSG (pattern.size () == m_phyMacConfig->GetSlotsPerSubframe (), "The number of pattern elements must be equal to the number of slots per subframe");
+  NS_ASSERT_MSG (!pattern.empty () && pattern.size () % m_phyMacConfig->GetSlotsPerSubframe () == 0,
+                 "The number of pattern elements must be a multiple of the number of slots per subframe");
   m_sfAllocInfo = pattern;
 }
 
@@ -484,18 +637,148 @@ MmWaveSidelinkMac::DoSlSinrReport (const SpectrumValue& sinr, uint16_t rnti, uin
   // with RNTI = rnti. If so, add the new CQI report, otherwise create a new
   // entry.
   int mcs; // the selected MCS will be stored in this variable
-  if (m_slCqiReported.find (rnti) != m_slCqiReported.end () )
+  int cqi = m_amc->CreateCqiFeedbackWbTdma (sinr, numSym, tbSize, mcs);
+  auto it = m_slCqiReported.find (rnti);
+  if (it == m_slCqiReported.end ())
   {
-    m_slCqiReported.at (rnti).push_back (m_amc->CreateCqiFeedbackWbTdma (sinr, numSym, tbSize, mcs));
+    it = m_slCqiReported.insert (std::make_pair (rnti, SlCqiHistory (m_cqiHistorySize))).first;
   }
-  else
+  it->second.Add (cqi, Simulator::Now ());
+}
+
+bool
+MmWaveSidelinkMac::GetAggregatedCqi (uint16_t rnti, int& cqi)
+{
+  NS_LOG_FUNCTION (this << rnti);
+
+  auto it = m_slCqiReported.find (rnti);
+  if (it == m_slCqiReported.end ())
+  {
+    return false;
+  }
+
+  // discard the stale reports
+  SlCqiHistory& history = it->second;
+  if (!m_cqiMaxAge.IsZero ())
+  {
+    history.RemoveOlderThan (Simulator::Now () - m_cqiMaxAge);
+  }
+
+  if (history.GetSize () == 0)
+  {
+    return false;
+  }
+
+  switch (m_cqiAggregation)
+  {
+    case LAST_CQI:
+      cqi = history.GetLast ();
+      break;
+    case EWMA_CQI:
+      cqi = history.GetEwma (m_cqiEwmaAlpha);
+      break;
+    case MIN_CQI:
+      cqi = history.GetMin ();
+      break;
+    default:
+      NS_FATAL_ERROR ("Unknown CQI aggregation method");
+  }
+
+  NS_LOG_DEBUG ("rnti " << rnti << " aggregated CQI " << cqi << " from " << history.GetSize () << " reports");
+  return true;
+}
+
+void
+MmWaveSidelinkMac::DoSlSensingReport (uint16_t rnti, double rxPower)
+{
+  NS_LOG_FUNCTION (this << rnti << rxPower);
+
+  if (!m_sensingBasedAllocation || m_sensingInfo.empty ())
+  {
+    return;
+  }
+
+  // the report refers to the current slot, i.e., the last indicated one
+  NS_ASSERT_MSG (m_slotCounter > 0, "No slot has been indicated yet");
+  SlSensingInfo& info = m_sensingInfo [(m_slotCounter - 1) % m_sensingInfo.size ()];
+
+  // keep only the strongest transmission sensed in the last reservation period
+  Time periodDuration = m_sensingInfo.size () * m_phyMacConfig->GetSlotPeriod ();
+  if (Simulator::Now () - info.timestamp >= periodDuration || rxPower > info.rxPower)
   {
-    std::vector<int> cqiTemp;
-    cqiTemp.push_back (m_amc->CreateCqiFeedbackWbTdma (sinr, numSym, tbSize, mcs));
-    m_slCqiReported.insert (std::make_pair(rnti, cqiTemp));
+    info.rnti = rnti;
+    info.rxPower = rxPower;
+    info.timestamp = Simulator::Now ();
   }
 }
 
+void
+MmWaveSidelinkMac::UpdateReservation ()
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t periodSlots = m_reservationPeriod * m_phyMacConfig->GetSlotsPerSubframe ();
+  if (m_sensingInfo.size () != periodSlots)
+  {
+    SlSensingInfo empty;
+    empty.rnti = 0;
+    empty.rxPower = -std::numeric_limits<double>::infinity ();
+    empty.timestamp = Seconds (0);
+    m_sensingInfo.assign (periodSlots, empty);
+    m_sfAllocInfo.assign (periodSlots, 0);
+    m_reservationCounter = 0;
+  }
+
+  // discard the information older than one reservation period
+  Time periodDuration = periodSlots * m_phyMacConfig->GetSlotPeriod ();
+  std::vector<double> rxPower (periodSlots);
+  for (uint32_t i = 0; i < periodSlots; i++)
+  {
+    bool valid = Simulator::Now () - m_sensingInfo [i].timestamp <= periodDuration;
+    rxPower [i] = valid ? m_sensingInfo [i].rxPower : -std::numeric_limits<double>::infinity ();
+  }
+
+  if (m_reservationCounter == 0)
+  {
+    // select a random slot among those which have been sensed idle. If all
+    // the slots are busy, select the one with the lowest received power.
+    std::vector<uint32_t> candidates;
+    uint32_t leastInterfered = 0;
+    for (uint32_t i = 0; i < periodSlots; i++)
+    {
+      if (rxPower [i] < m_sensingThreshold)
+      {
+        candidates.push_back (i);
+      }
+      if (rxPower [i] < rxPower [leastInterfered])
+      {
+        leastInterfered = i;
+      }
+    }
+
+    if (candidates.empty ())
+    {
+      m_reservedSlot = leastInterfered;
+    }
+    else
+    {
+      m_reservedSlot = candidates [m_uniformRv->GetInteger (0, candidates.size () - 1)];
+    }
+    m_reservationCounter = m_reservationDuration;
+    NS_LOG_DEBUG ("rnti " << m_rnti << " reserved slot " << m_reservedSlot << " among " << candidates.size () << " idle slots");
+  }
+  m_reservationCounter--;
+
+  // receive in the slots where a transmission from an associated device was
+  // sensed
+  for (uint32_t i = 0; i < periodSlots; i++)
+  {
+    bool sensed = rxPower [i] > -std::numeric_limits<double>::infinity ();
+    m_sfAllocInfo [i] = sensed ? m_sensingInfo [i].rnti : 0;
+  }
+  m_sfAllocInfo [m_reservedSlot] = m_rnti;
+}
+
 uint8_t
 MmWaveSidelinkMac::GetMcs (uint16_t rnti)
 {
@@ -505,14 +788,14 @@ MmWaveSidelinkMac::GetMcs (uint16_t rnti)
   if (m_useAmc)
   {
     // if AMC is used, select the MCS based on the CQI history
-    if (m_slCqiReported.find (rnti) != m_slCqiReported.end ())
+    int cqi;
+    if (GetAggregatedCqi (rnti, cqi))
     {
-      std::vector <int> cqi = m_slCqiReported.find (rnti)->second;
-      mcs = m_amc->GetMcsFromCqi(cqi.back ());
+      mcs = m_amc->GetMcsFromCqi (cqi);
     }
     else
     {
-      mcs = 0; // if the CQI history not found for this device, use the minimum MCS value
+      mcs = 0; // if no valid CQI report is found for this device, use the minimum MCS value
     }
   }
   else
@@ -520,15 +803,75 @@ MmWaveSidelinkMac::GetMcs (uint16_t rnti)
     // if AMC is not used, use a fixed MCS value
     mcs = m_mcs;
   }
-  // TODO: update the method to refresh CQI reports and delete older reports
   return mcs;
 }
 
 void
-MmWaveSidelinkMac::AddMacSapUser (uint8_t lcid, LteMacSapUser* macSapUser)
+MmWaveSidelinkMac::SetScheduler (Ptr<MmWaveSidelinkScheduler> scheduler)
+{
+  NS_LOG_FUNCTION (this);
+  m_scheduler = scheduler;
+  m_scheduler->SetAmc (m_amc);
+}
+
+Ptr<MmWaveSidelinkScheduler>
+MmWaveSidelinkMac::GetScheduler () const
+{
+  return m_scheduler;
+}
+
+void
+MmWaveSidelinkMac::AddMacSapUser (uint8_t lcid, LteMacSapUser* macSapUser, const EpsBearer& bearer)
 {
   NS_LOG_FUNCTION (this);
   m_lcidToMacSap.insert(std::make_pair(lcid, macSapUser));
+  m_lcidToDelayBudget [lcid] = MilliSeconds (bearer.GetPacketDelayBudgetMs ());
+}
+
+void
+MmWaveSidelinkMac::RemoveMacSapUser (uint8_t lcid)
+{
+  NS_LOG_FUNCTION (this << (uint32_t)lcid);
+  m_lcidToMacSap.erase (lcid);
+  m_bufferStatusReportMap.erase (lcid);
+  m_bufferStatusReportTime.erase (lcid);
+  m_lcidToDelayBudget.erase (lcid);
+  if (m_scheduler)
+  {
+    m_scheduler->RemoveLogicalChannel (lcid);
+  }
+
+  // the PDUs of the logical channel would never be delivered
+  for (auto bufferIt = m_txBufferMap.begin (); bufferIt != m_txBufferMap.end (); bufferIt++)
+  {
+    for (auto pduIt = bufferIt->second.begin (); pduIt != bufferIt->second.end ();)
+    {
+      if (pduIt->lcid == lcid)
+      {
+        pduIt = bufferIt->second.erase (pduIt);
+      }
+      else
+      {
+        pduIt++;
+      }
+    }
+  }
+}
+
+void
+MmWaveSidelinkMac::RemoveDevice (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+  m_txBufferMap.erase (rnti);
+  m_slCqiReported.erase (rnti);
+}
+
+int64_t
+MmWaveSidelinkMac::AssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  m_uniformRv->SetStream (stream);
+  return 1;
 }
 
 } // mmwave namespace
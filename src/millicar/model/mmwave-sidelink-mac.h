@@ -21,9 +21,13 @@
 #define SRC_MMWAVE_MODEL_MMWAVE_SIDELINK_MAC_H_
 
 #include "mmwave-sidelink-sap.h"
+#include "mmwave-sidelink-scheduler.h"
 #include "ns3/mmwave-amc.h"
 #include "ns3/mmwave-phy-mac-common.h"
+#include "ns3/eps-bearer.h"
 #include "ns3/traced-callback.h"
+#include "ns3/nstime.h"
+#include "ns3/random-variable-stream.h"
 
 namespace ns3 {
 
@@ -43,6 +47,80 @@ struct SlSchedulingCallback
   uint16_t rxRnti; //!< the RNTI which identifies the destination
 };
 
+/**
+ * \brief Fixed-size history of the CQI reports received from a peer device.
+ *        The reports are stored in a ring buffer, hence the newest report
+ *        overwrites the oldest one once the history is full and the memory
+ *        footprint does not grow with the simulation duration.
+ */
+class SlCqiHistory
+{
+public:
+  /// structure representing a single CQI report
+  struct CqiReport
+  {
+    int cqi; //!< the reported CQI
+    Time timestamp; //!< the time at which the report was generated
+  };
+
+  /**
+   * \brief Class constructor
+   * \param size maximum number of reports stored in the history
+   */
+  SlCqiHistory (uint32_t size);
+
+  /**
+   * \brief Add a new report, overwriting the oldest one if the history is full
+   * \param cqi the reported CQI
+   * \param timestamp the time at which the report was generated
+   */
+  void Add (int cqi, Time timestamp);
+
+  /**
+   * \brief Remove the reports generated before the specified time
+   * \param oldest the generation time of the oldest report to keep
+   */
+  void RemoveOlderThan (Time oldest);
+
+  /**
+   * \brief Return the number of reports currently stored
+   * \return the number of reports
+   */
+  uint32_t GetSize () const;
+
+  /**
+   * \brief Return the i-th report, where 0 is the oldest one
+   * \param i the index of the report
+   * \return the report
+   */
+  const CqiReport& Get (uint32_t i) const;
+
+  /**
+   * \brief Return the CQI of the most recent report
+   * \return the CQI
+   */
+  int GetLast () const;
+
+  /**
+   * \brief Return the exponentially weighted moving average of the reports,
+   *        computed from the oldest to the newest one
+   * \param alpha the weight of the newer report
+   * \return the average CQI, rounded down
+   */
+  int GetEwma (double alpha) const;
+
+  /**
+   * \brief Return the minimum CQI of the reports
+   * \return the CQI
+   */
+  int GetMin () const;
+
+private:
+  std::vector<CqiReport> m_reports; //!< ring buffer containing the reports
+  uint32_t m_head; //!< index of the oldest report
+  uint32_t m_count; //!< number of reports currently stored
+};
+
 class MmWaveSidelinkMac : public Object
 {
 
@@ -56,6 +134,14 @@ public:
    */
   static TypeId GetTypeId (void);
 
+  /// the method used to aggregate the CQI history into a single value
+  enum CqiAggregationType
+  {
+    LAST_CQI, //!< use the most recent report
+    EWMA_CQI, //!< exponentially weighted moving average of the reports
+    MIN_CQI //!< minimum CQI in the history window
+  };
+
   /**
    * \brief Delete default constructor to avoid misuse
    */
@@ -116,8 +202,9 @@ public:
 
   /**
   * \brief set the subframe allocation pattern
-  * \param pattern the allocation pattern. The number of element must be equal to
-  *        number of slots per subframe. Each element represents the RNTI of the
+  * \param pattern the allocation pattern. The number of elements must be a
+  *        multiple of the number of slots per subframe, the pattern is repeated
+  *        every pattern.size () slots. Each element represents the RNTI of the
   *        device scheduled in the corresponding slot.
   */
   void SetSfAllocationInfo (std::vector<uint16_t> pattern);
@@ -140,12 +227,55 @@ public:
    */
   typedef void (* SlSchedulingTracedCallback) (SlSchedulingCallback params);
 
+  /**
+   * \brief Set the scheduler used to allocate the resources among the active
+   *        logical channels
+   * \param scheduler the scheduler
+   */
+  void SetScheduler (Ptr<MmWaveSidelinkScheduler> scheduler);
+
+  /**
+   * \brief Get the scheduler used to allocate the resources among the active
+   *        logical channels
+   * \return the scheduler
+   */
+  Ptr<MmWaveSidelinkScheduler> GetScheduler () const;
+
   /**
    * Associate a MAC SAP user instance to the LCID and add it in the map
    * \param lcid Logical Channel ID
    * \param macSapUser LteMacSapUser to be associated to a single LCID and added to the respective map
+   * \param bearer the QoS of the bearer of the logical channel, whose packet
+   *        delay budget is passed to the scheduler
+   */
+  void AddMacSapUser (uint8_t lcid, LteMacSapUser* macSapUser, const EpsBearer& bearer);
+
+  /**
+   * Remove the MAC SAP user associated to the LCID, together with the
+   * pending buffer status report, the queued PDUs and the scheduler state
+   * of the logical channel
+   * \param lcid Logical Channel ID
+   */
+  void RemoveMacSapUser (uint8_t lcid);
+
+  /**
+   * Remove the state kept for another device, i.e., the PDUs queued for
+   * it and the history of the CQIs it reported, e.g., when the device
+   * leaves the group. Nothing is done if the rnti is unknown.
+   * \param rnti the RNTI of the other device
    */
-  void AddMacSapUser (uint8_t lcid, LteMacSapUser* macSapUser);
+  void RemoveDevice (uint16_t rnti);
+
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by this model, i.e., the one selecting the reserved slot of the
+   * sensing-based reservation. Return the number of streams (possibly zero)
+   * that have been assigned.
+   *
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned by this model
+   */
+  int64_t AssignStreams (int64_t stream);
 
 private:
   // forwarded from PHY SAP
@@ -167,6 +297,21 @@ private:
   */
   void DoSlSinrReport (const SpectrumValue& sinr, uint16_t rnti, uint8_t numSym, uint32_t tbSize);
 
+  /**
+  * \brief Stores the information about a sidelink transmission sensed in the
+  *        current slot, used by the sensing based resource allocation
+  * \params rnti RNTI of the transmitting device, 0 if the device is unknown
+  * \params rxPower the received power in dBm
+  */
+  void DoSlSensingReport (uint16_t rnti, double rxPower);
+
+  /**
+  * \brief Updates the slot reservation based on the sensing information
+  *        collected in the last reservation period and configures the
+  *        reception in the slots reserved by the other devices
+  */
+  void UpdateReservation ();
+
   /**
   * \brief Implements RlcSidelinkMemberMacSapProvider::ReportBufferStatus,
   *        reports the RLC buffer status to the MAC
@@ -182,6 +327,15 @@ private:
   */
   uint8_t GetMcs (uint16_t rnti);
 
+  /**
+  * \brief Aggregate the CQI history of the link towards a specific device,
+  *        discarding the reports older than m_cqiMaxAge
+  * \params rnti the RNTI that identifies the device we want to communicate with
+  * \params cqi the aggregated CQI will be stored in this variable
+  * \returns false if no valid report is available, true otherwise
+  */
+  bool GetAggregatedCqi (uint16_t rnti, int& cqi);
+
   /**
   * \brief Decides how to allocate the available resources to the active
   *        logical channels
@@ -206,14 +360,39 @@ private:
   std::map<uint8_t, LteMacSapUser*> m_lcidToMacSap; //!< map that associates to an LCID the respective MAC SAP
   Ptr<mmwave::MmWavePhyMacCommon> m_phyMacConfig; //!< PHY and MAC configuration pointer
   Ptr<mmwave::MmWaveAmc> m_amc; //!< pointer to AMC instance
+  Ptr<MmWaveSidelinkScheduler> m_scheduler; //!< pointer to the scheduler instance
+  uint64_t m_slotCounter; //!< number of slots since the start of the device
   bool m_useAmc; //!< set to true to use adaptive modulation and coding
   uint8_t m_mcs; //!< the MCS used to transmit the packets if AMC is not used
   uint16_t m_rnti; //!< radio network temporary identifier
   std::vector<uint16_t> m_sfAllocInfo; //!< defines the subframe allocation, m_sfAllocInfo[i] = RNTI of the device scheduled for slot i
   std::map<uint16_t, std::list<LteMacSapProvider::TransmitPduParameters>> m_txBufferMap; //!< map containing the <RNTI, tx buffer> pairs
-  std::map<uint16_t, std::vector<int>> m_slCqiReported; //!< map containing the <RNTI, CQI> pairs
+  std::map<uint16_t, SlCqiHistory> m_slCqiReported; //!< map containing the <RNTI, CQI history> pairs
+  uint32_t m_cqiHistorySize; //!< maximum number of CQI reports stored for each device
+  CqiAggregationType m_cqiAggregation; //!< the method used to aggregate the CQI history
+  double m_cqiEwmaAlpha; //!< weight of the newest report in the EWMA
+  Time m_cqiMaxAge; //!< reports older than this are discarded, zero means never
+
+  /// structure containing the strongest transmission sensed in a slot
+  struct SlSensingInfo
+  {
+    uint16_t rnti; //!< the RNTI of the transmitting device
+    double rxPower; //!< the received power in dBm
+    Time timestamp; //!< the time at which the transmission was sensed
+  };
+
+  bool m_sensingBasedAllocation; //!< set to true to select the slots using the sensing based allocation
+  uint32_t m_reservationPeriod; //!< the reservation period in number of subframes
+  uint32_t m_reservationDuration; //!< the number of reservation periods before the reselection
+  double m_sensingThreshold; //!< slots sensed with a received power above this threshold (in dBm) are considered busy
+  uint32_t m_reservationCounter; //!< number of reservation periods before the next reselection
+  uint32_t m_reservedSlot; //!< index of the reserved slot in the reservation period
+  std::vector<SlSensingInfo> m_sensingInfo; //!< sensing information for each slot of the reservation period
+  Ptr<UniformRandomVariable> m_uniformRv; //!< random variable used to select the reserved slot
   Callback<void, Ptr<Packet> > m_forwardUpCallback; //!< upward callback to the NetDevice
   std::map<uint8_t, LteMacSapProvider::ReportBufferStatusParameters> m_bufferStatusReportMap; //!< map containing the <LCID, buffer status in bits> pairs
+  std::map<uint8_t, Time> m_bufferStatusReportTime; //!< map containing the <LCID, time of the last buffer status report> pairs
+  std::map<uint8_t, Time> m_lcidToDelayBudget; //!< map containing the <LCID, packet delay budget of the bearer> pairs
 
   // trace sources
   TracedCallback<SlSchedulingCallback> m_schedulingTrace; //!< trace source returning information regarding the scheduling
@@ -231,6 +410,8 @@ public:
 
   void SlSinrReport (const SpectrumValue& sinr, uint16_t rnti, uint8_t numSym, uint32_t tbSize) override;
 
+  void SlSensingReport (uint16_t rnti, double rxPower) override;
+
 private:
   Ptr<MmWaveSidelinkMac> m_mac;
 
@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "mmwave-sidelink-pf-scheduler.h"
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include <algorithm>
+#include <limits>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveSidelinkPfScheduler");
+
+namespace millicar {
+
+NS_OBJECT_ENSURE_REGISTERED (MmWaveSidelinkPfScheduler);
+
+TypeId
+MmWaveSidelinkPfScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MmWaveSidelinkPfScheduler")
+    .SetParent<MmWaveSidelinkScheduler> ()
+    .AddConstructor<MmWaveSidelinkPfScheduler> ()
+    .AddAttribute ("TimeWindow",
+                   "Time window, in number of scheduled slots, used to compute the average throughput",
+                   DoubleValue (99.0),
+                   MakeDoubleAccessor (&MmWaveSidelinkPfScheduler::m_timeWindow),
+                   MakeDoubleChecker<double> (1.0))
+  ;
+  return tid;
+}
+
+MmWaveSidelinkPfScheduler::MmWaveSidelinkPfScheduler (void)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MmWaveSidelinkPfScheduler::~MmWaveSidelinkPfScheduler (void)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+std::vector<SlGrant>
+MmWaveSidelinkPfScheduler::ScheduleSlot (const std::vector<SlSchedulingRequest>& requests, uint32_t availableSymbols)
+{
+  NS_LOG_FUNCTION (this << requests.size () << availableSymbols);
+
+  // compute the PF metric of each logical channel
+  std::vector<std::pair<double, SlSchedulingRequest> > metrics;
+  for (auto it = requests.begin (); it != requests.end (); it++)
+  {
+    double achievableRate = std::max (m_amc->GetTbSizeFromMcsSymbols (it->mcs, availableSymbols), 0);
+    double avgThroughput = m_avgThroughput [it->lcid]; // zero for new logical channels
+    double metric = avgThroughput > 0 ? achievableRate / avgThroughput : std::numeric_limits<double>::max ();
+    NS_LOG_DEBUG ("lcid " << uint16_t (it->lcid) << " achievable rate " << achievableRate
+                          << " average throughput " << avgThroughput << " metric " << metric);
+    metrics.push_back (std::make_pair (metric, *it));
+  }
+
+  // sort by decreasing metric, ties are broken by LCID
+  std::sort (metrics.begin (), metrics.end (),
+             [] (const std::pair<double, SlSchedulingRequest>& a, const std::pair<double, SlSchedulingRequest>& b)
+             { return a.first > b.first || (a.first == b.first && a.second.lcid < b.second.lcid); });
+
+  std::vector<SlSchedulingRequest> sorted;
+  for (auto it = metrics.begin (); it != metrics.end (); it++)
+  {
+    sorted.push_back (it->second);
+  }
+  std::vector<SlGrant> grants = AllocateInOrder (sorted, availableSymbols);
+
+  // update the average throughput of the active logical channels
+  for (auto it = requests.begin (); it != requests.end (); it++)
+  {
+    double servedBits = 0;
+    for (auto gIt = grants.begin (); gIt != grants.end (); gIt++)
+    {
+      if (gIt->lcid == it->lcid)
+      {
+        servedBits += gIt->tbSize * 8;
+      }
+    }
+    double& avgThroughput = m_avgThroughput [it->lcid];
+    avgThroughput = (1.0 - (1.0 / m_timeWindow)) * avgThroughput + (1.0 / m_timeWindow) * servedBits;
+  }
+
+  return grants;
+}
+
+void
+MmWaveSidelinkPfScheduler::RemoveLogicalChannel (uint8_t lcid)
+{
+  NS_LOG_FUNCTION (this << uint16_t (lcid));
+  // a new logical channel with the same LCID starts from scratch
+  m_avgThroughput.erase (lcid);
+}
+
+} // namespace millicar
+
+} // namespace ns3
@@ -323,8 +323,15 @@ MmWaveSidelinkPhy::DoPrepareForReceptionFrom (uint16_t rnti)
 { 
 
   NS_LOG_FUNCTION (this);
-  NS_ASSERT_MSG (m_deviceMap.find (rnti) != m_deviceMap.end (), "Cannot find device with rnti " << rnti);
-  m_sidelinkSpectrumPhy->ConfigureBeamforming (m_deviceMap.at (rnti));
+  auto it = m_deviceMap.find (rnti);
+  if (it == m_deviceMap.end ())
+  {
+    // this may happen when the scheduling group contains devices which are
+    // not paired with this one
+    NS_LOG_INFO ("Cannot find device with rnti " << rnti << ", the beamforming configuration is not updated");
+    return;
+  }
+  m_sidelinkSpectrumPhy->ConfigureBeamforming (it->second);
 }
 
 void
@@ -342,6 +349,13 @@ MmWaveSidelinkPhy::AddDevice (uint64_t rnti, Ptr<NetDevice> dev)
   }
 }
 
+void
+MmWaveSidelinkPhy::RemoveDevice (uint64_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+  m_deviceMap.erase (rnti);
+}
+
 void
 MmWaveSidelinkPhy::Receive (Ptr<Packet> p)
 {
@@ -363,5 +377,20 @@ MmWaveSidelinkPhy::GenerateSinrReport (const SpectrumValue& sinr, uint16_t rnti,
   m_phySapUser->SlSinrReport (sinr, rnti, numSym, tbSize);
 }
 
+void
+MmWaveSidelinkPhy::GenerateSensingReport (uint16_t rnti, double rxPower)
+{
+  NS_LOG_FUNCTION (this << rnti << rxPower);
+
+  // the MAC can prepare the reception only from the associated devices
+  if (m_deviceMap.find (rnti) == m_deviceMap.end ())
+  {
+    rnti = 0;
+  }
+
+  // forward the report to the MAC layer
+  m_phySapUser->SlSensingReport (rnti, rxPower);
+}
+
 } // namespace millicar
 } // namespace ns3
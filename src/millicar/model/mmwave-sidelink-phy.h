@@ -116,6 +116,13 @@ public:
    */
   void AddDevice (uint64_t rnti, Ptr<NetDevice> dev);
 
+  /**
+   * Remove a <rnti, device> pair from m_deviceMap, e.g., when the device
+   * leaves the scenario. Nothing is done if the rnti is not in the map.
+   * \param rnti the RNTI identifier
+   */
+  void RemoveDevice (uint64_t rnti);
+
   /**
    * Add a transport block to the transmission buffer, which will be sent in the
    * current slot.
@@ -150,6 +157,14 @@ public:
   */
   void GenerateSinrReport (const SpectrumValue& sinr, uint16_t rnti, uint8_t numSym, uint32_t tbSize, uint8_t mcs);
 
+  /**
+  * Forward to the MAC the report of a sidelink transmission sensed on the
+  * channel
+  * \param rnti the RNTI of the transmitting device
+  * \param rxPower the received power in dBm
+  */
+  void GenerateSensingReport (uint16_t rnti, double rxPower);
+
 private:
 
   /**
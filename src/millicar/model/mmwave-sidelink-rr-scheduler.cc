@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "mmwave-sidelink-rr-scheduler.h"
+#include "ns3/log.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveSidelinkRrScheduler");
+
+namespace millicar {
+
+NS_OBJECT_ENSURE_REGISTERED (MmWaveSidelinkRrScheduler);
+
+TypeId
+MmWaveSidelinkRrScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MmWaveSidelinkRrScheduler")
+    .SetParent<MmWaveSidelinkScheduler> ()
+    .AddConstructor<MmWaveSidelinkRrScheduler> ()
+  ;
+  return tid;
+}
+
+MmWaveSidelinkRrScheduler::MmWaveSidelinkRrScheduler (void)
+  : m_lastServedLcid (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MmWaveSidelinkRrScheduler::~MmWaveSidelinkRrScheduler (void)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+std::vector<SlGrant>
+MmWaveSidelinkRrScheduler::ScheduleSlot (const std::vector<SlSchedulingRequest>& requests, uint32_t availableSymbols)
+{
+  NS_LOG_FUNCTION (this << requests.size () << availableSymbols);
+
+  std::vector<SlGrant> grants;
+  if (requests.empty ())
+  {
+    return grants;
+  }
+
+  // start from the logical channel following the last served one
+  auto first = std::upper_bound (requests.begin (), requests.end (), m_lastServedLcid,
+                                 [] (uint8_t lcid, const SlSchedulingRequest& r) { return lcid < r.lcid; });
+  std::vector<SlSchedulingRequest> active (first, requests.end ());
+  active.insert (active.end (), requests.begin (), first);
+
+  // compute the number of available symbols per logical channel
+  // NOTE the number of available symbols per LC is rounded down, but at least
+  // one symbol is assigned to each LC
+  uint32_t availableSymbolsPerLc = std::max<uint32_t> (availableSymbols / active.size (), 1);
+  NS_LOG_DEBUG ("availableSymbolsPerLc =\t" << availableSymbolsPerLc);
+
+  // serve the active logical channels with a Round Robin approach
+  uint32_t idx = 0;
+  while (availableSymbols > 0 && !active.empty ())
+  {
+    SlGrant grant = CreateGrant (active [idx], availableSymbolsPerLc);
+    if (grant.numSym == 0)
+    {
+      // the remaining symbols cannot accommodate a TB
+      break;
+    }
+    NS_ASSERT_MSG (grant.numSym <= availableSymbols, "Assigned more symbols than available");
+    grants.push_back (grant);
+    m_lastServedLcid = grant.lcid;
+
+    // remove the logical channel if no further resources are needed
+    active [idx].bufferSize -= grant.tbSize;
+    if (active [idx].bufferSize == 0)
+    {
+      active.erase (active.begin () + idx);
+    }
+    else
+    {
+      idx++;
+    }
+
+    // update the number of available symbols
+    availableSymbols -= grant.numSym;
+    if (availableSymbols < availableSymbolsPerLc)
+    {
+      availableSymbolsPerLc = availableSymbols;
+    }
+
+    // if the index reached the end of the list, start again
+    if (idx == active.size ())
+    {
+      idx = 0;
+    }
+  }
+
+  return grants;
+}
+
+} // namespace millicar
+
+} // namespace ns3
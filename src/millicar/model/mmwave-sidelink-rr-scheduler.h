@@ -0,0 +1,64 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef SRC_MILLICAR_MODEL_MMWAVE_SIDELINK_RR_SCHEDULER_H_
+#define SRC_MILLICAR_MODEL_MMWAVE_SIDELINK_RR_SCHEDULER_H_
+
+#include "mmwave-sidelink-scheduler.h"
+
+namespace ns3 {
+
+namespace millicar {
+
+/**
+ * \brief Round Robin sidelink scheduler. The available symbols are evenly
+ *        split among the active logical channels, starting from the one
+ *        following the last served logical channel.
+ */
+class MmWaveSidelinkRrScheduler : public MmWaveSidelinkScheduler
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \brief Class constructor
+   */
+  MmWaveSidelinkRrScheduler (void);
+
+  /**
+   * \brief Class destructor
+   */
+  virtual ~MmWaveSidelinkRrScheduler (void);
+
+  // inherited from MmWaveSidelinkScheduler
+  virtual std::vector<SlGrant> ScheduleSlot (const std::vector<SlSchedulingRequest>& requests, uint32_t availableSymbols) override;
+
+private:
+  uint8_t m_lastServedLcid; //!< the LCID of the last served logical channel
+};
+
+} // namespace millicar
+
+} // namespace ns3
+
+#endif /* SRC_MILLICAR_MODEL_MMWAVE_SIDELINK_RR_SCHEDULER_H_ */
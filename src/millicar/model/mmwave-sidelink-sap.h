@@ -83,6 +83,13 @@ public:
    */
   virtual void SlSinrReport (const SpectrumValue& sinr, uint16_t rnti, uint8_t numSym, uint32_t tbSize) = 0;
 
+  /**
+   * \brief Reports a sidelink transmission sensed on the channel
+   * \param rnti RNTI of the transmitting device, 0 if the device is unknown
+   * \param rxPower the received power in dBm
+   */
+  virtual void SlSensingReport (uint16_t rnti, double rxPower) = 0;
+
 };
 
 } // mmwave namespace
@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "mmwave-sidelink-scheduler.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveSidelinkScheduler");
+
+namespace millicar {
+
+NS_OBJECT_ENSURE_REGISTERED (MmWaveSidelinkScheduler);
+
+TypeId
+MmWaveSidelinkScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MmWaveSidelinkScheduler")
+    .SetParent<Object> ()
+  ;
+  return tid;
+}
+
+MmWaveSidelinkScheduler::MmWaveSidelinkScheduler (void)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MmWaveSidelinkScheduler::~MmWaveSidelinkScheduler (void)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MmWaveSidelinkScheduler::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_amc = 0;
+  Object::DoDispose ();
+}
+
+void
+MmWaveSidelinkScheduler::SetAmc (Ptr<mmwave::MmWaveAmc> amc)
+{
+  NS_LOG_FUNCTION (this);
+  m_amc = amc;
+}
+
+void
+MmWaveSidelinkScheduler::RemoveLogicalChannel (uint8_t lcid)
+{
+  NS_LOG_FUNCTION (this << uint16_t (lcid));
+}
+
+SlGrant
+MmWaveSidelinkScheduler::CreateGrant (const SlSchedulingRequest& request, uint32_t maxSymbols) const
+{
+  NS_ASSERT_MSG (m_amc, "First set the AMC");
+
+  SlGrant grant;
+  grant.lcid = request.lcid;
+  grant.rnti = request.rnti;
+  grant.mcs = request.mcs;
+  grant.numSym = 0;
+  grant.tbSize = 0;
+
+  // compute the number of bits which can be sent using maxSymbols
+  int availableBits = m_amc->GetTbSizeFromMcsSymbols (request.mcs, maxSymbols);
+  if (availableBits <= 0)
+  {
+    // not even the CRC fits in the available symbols
+    return grant;
+  }
+
+  // compute the number of bits required by this LC
+  uint32_t requiredBits = request.bufferSize * 8;
+
+  // assign a number of bits which is less or equal to the available bits
+  uint32_t assignedBits = std::min (requiredBits, uint32_t (availableBits));
+
+  grant.numSym = m_amc->GetNumSymbolsFromTbsMcs (assignedBits, request.mcs);
+  grant.tbSize = assignedBits / 8;
+
+  NS_LOG_DEBUG ("lcid " << uint16_t (grant.lcid) << " rnti " << grant.rnti << " mcs " << uint16_t (grant.mcs)
+                        << " numSym " << grant.numSym << " tbSize " << grant.tbSize);
+  return grant;
+}
+
+std::vector<SlGrant>
+MmWaveSidelinkScheduler::AllocateInOrder (const std::vector<SlSchedulingRequest>& requests, uint32_t availableSymbols) const
+{
+  std::vector<SlGrant> grants;
+  for (auto it = requests.begin (); it != requests.end () && availableSymbols > 0; it++)
+  {
+    SlGrant grant = CreateGrant (*it, availableSymbols);
+    if (grant.numSym == 0)
+    {
+      continue;
+    }
+    grants.push_back (grant);
+    availableSymbols -= grant.numSym;
+  }
+  return grants;
+}
+
+} // namespace millicar
+
+} // namespace ns3
@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef SRC_MILLICAR_MODEL_MMWAVE_SIDELINK_SCHEDULER_H_
+#define SRC_MILLICAR_MODEL_MMWAVE_SIDELINK_SCHEDULER_H_
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/mmwave-amc.h"
+
+namespace ns3 {
+
+namespace millicar {
+
+/// structure describing a logical channel which requires resources
+struct SlSchedulingRequest
+{
+  uint8_t lcid; //!< the logical channel ID
+  uint16_t rnti; //!< the RNTI of the destination
+  uint8_t mcs; //!< the MCS selected for the link towards the destination
+  uint32_t bufferSize; //!< the number of bytes waiting for transmission
+  Time holDelay; //!< the head of line delay of the logical channel
+  Time delayBudget; //!< the packet delay budget of the bearer of the logical channel
+};
+
+/// structure describing the resources assigned to a logical channel
+struct SlGrant
+{
+  uint8_t lcid; //!< the logical channel ID
+  uint16_t rnti; //!< the RNTI of the destination
+  uint8_t mcs; //!< the MCS for the transport block
+  uint32_t numSym; //!< the number of assigned symbols
+  uint32_t tbSize; //!< the TB size in bytes
+};
+
+/**
+ * \brief Base class for the sidelink schedulers. A scheduler decides how to
+ *        distribute the symbols of a slot among the active logical channels
+ *        of a MmWaveSidelinkMac.
+ */
+class MmWaveSidelinkScheduler : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \brief Class constructor
+   */
+  MmWaveSidelinkScheduler (void);
+
+  /**
+   * \brief Class destructor
+   */
+  virtual ~MmWaveSidelinkScheduler (void);
+
+  /**
+   * \brief Set the AMC instance used to compute the TB sizes
+   * \param amc pointer to the mmwave::MmWaveAmc instance
+   */
+  void SetAmc (Ptr<mmwave::MmWaveAmc> amc);
+
+  /**
+   * \brief Distribute the available symbols among the logical channels
+   * \param requests the active logical channels, sorted by LCID
+   * \param availableSymbols the number of symbols available in the slot
+   * \returns the grants, in the order in which they have to be mapped in the slot
+   */
+  virtual std::vector<SlGrant> ScheduleSlot (const std::vector<SlSchedulingRequest>& requests, uint32_t availableSymbols) = 0;
+
+  /**
+   * \brief Forget the state kept for a logical channel, e.g., when its
+   *        bearer is deactivated. Nothing is done by default.
+   * \param lcid the logical channel ID
+   */
+  virtual void RemoveLogicalChannel (uint8_t lcid);
+
+protected:
+  // inherited from Object
+  virtual void DoDispose (void) override;
+
+  /**
+   * \brief Create a grant for a logical channel using at most maxSymbols
+   *        symbols. The grant is limited to the buffer size of the logical
+   *        channel.
+   * \param request the logical channel
+   * \param maxSymbols the maximum number of symbols which can be assigned
+   * \returns the grant
+   */
+  SlGrant CreateGrant (const SlSchedulingRequest& request, uint32_t maxSymbols) const;
+
+  /**
+   * \brief Serve the logical channels in the specified order, each one
+   *        until its buffer is empty or the slot is full
+   * \param requests the logical channels, sorted by decreasing priority
+   * \param availableSymbols the number of symbols available in the slot
+   * \returns the grants
+   */
+  std::vector<SlGrant> AllocateInOrder (const std::vector<SlSchedulingRequest>& requests, uint32_t availableSymbols) const;
+
+  Ptr<mmwave::MmWaveAmc> m_amc; //!< pointer to AMC instance
+};
+
+} // namespace millicar
+
+} // namespace ns3
+
+#endif /* SRC_MILLICAR_MODEL_MMWAVE_SIDELINK_SCHEDULER_H_ */
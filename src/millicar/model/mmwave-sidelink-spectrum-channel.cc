@@ -0,0 +1,258 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "mmwave-sidelink-spectrum-channel.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/net-device.h"
+#include "ns3/mobility-model.h"
+#include "ns3/spectrum-phy.h"
+#include "ns3/spectrum-propagation-loss-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/antenna-model.h"
+#include "ns3/angles.h"
+#include "ns3/node.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+namespace millicar {
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveSidelinkSpectrumChannel");
+
+NS_OBJECT_ENSURE_REGISTERED (MmWaveSidelinkSpectrumChannel);
+
+MmWaveSidelinkSpectrumChannel::MmWaveSidelinkSpectrumChannel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MmWaveSidelinkSpectrumChannel::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_phyList.clear ();
+  m_rxPhys.clear ();
+  m_pathLossDb.clear ();
+  m_pending.clear ();
+  m_spectrumModel = 0;
+  SpectrumChannel::DoDispose ();
+}
+
+TypeId
+MmWaveSidelinkSpectrumChannel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MmWaveSidelinkSpectrumChannel")
+    .SetParent<SpectrumChannel> ()
+    .SetGroupName ("Millicar")
+    .AddConstructor<MmWaveSidelinkSpectrumChannel> ()
+  ;
+  return tid;
+}
+
+void
+MmWaveSidelinkSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
+{
+  NS_LOG_FUNCTION (this << phy);
+  m_phyList.push_back (phy);
+}
+
+void
+MmWaveSidelinkSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
+{
+  NS_LOG_FUNCTION (this << txParams->psd << txParams->duration << txParams->txPhy);
+  NS_ASSERT_MSG (txParams->psd, "NULL txPsd");
+  NS_ASSERT_MSG (txParams->txPhy, "NULL txPhy");
+
+  if (!m_txSigParamsTrace.IsEmpty ())
+    {
+      Ptr<SpectrumSignalParameters> txParamsTrace = txParams->Copy (); // copy it since traced value cannot be const (because of potential underlying DynamicCasts)
+      m_txSigParamsTrace (txParamsTrace);
+    }
+
+  if (m_spectrumModel == 0)
+    {
+      // first packet, record SpectrumModel
+      m_spectrumModel = txParams->psd->GetSpectrumModel ();
+    }
+  else
+    {
+      // all attached SpectrumPhy instances must use the same SpectrumModel
+      NS_ASSERT (*(txParams->psd->GetSpectrumModel ()) == *m_spectrumModel);
+    }
+
+  Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility ();
+
+  // first pass: compute the pathloss and the antenna gains towards all the
+  // receivers and keep only the ones in range, so that the signal parameters
+  // are not copied for the receivers which would discard them
+  m_rxPhys.clear ();
+  m_pathLossDb.clear ();
+  for (PhyList::const_iterator rxPhyIt = m_phyList.begin (); rxPhyIt != m_phyList.end (); ++rxPhyIt)
+    {
+      if (*rxPhyIt == txParams->txPhy)
+        {
+          continue;
+        }
+
+      Ptr<MobilityModel> receiverMobility = (*rxPhyIt)->GetMobility ();
+      double pathLossDb = 0;
+      if (senderMobility && receiverMobility)
+        {
+          double txAntennaGain = 0;
+          double rxAntennaGain = 0;
+          double propagationGainDb = 0;
+          if (txParams->txAntenna != 0)
+            {
+              Angles txAngles (receiverMobility->GetPosition (), senderMobility->GetPosition ());
+              txAntennaGain = txParams->txAntenna->GetGainDb (txAngles);
+              NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
+              pathLossDb -= txAntennaGain;
+            }
+          Ptr<AntennaModel> rxAntenna = (*rxPhyIt)->GetRxAntenna ();
+          if (rxAntenna != 0)
+            {
+              Angles rxAngles (senderMobility->GetPosition (), receiverMobility->GetPosition ());
+              rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
+              NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
+              pathLossDb -= rxAntennaGain;
+            }
+          if (m_propagationLoss)
+            {
+              propagationGainDb = m_propagationLoss->CalcRxPower (0, senderMobility, receiverMobility);
+              NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
+              pathLossDb -= propagationGainDb;
+            }
+          NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
+          m_gainTrace (senderMobility, receiverMobility, txAntennaGain, rxAntennaGain, propagationGainDb, pathLossDb);
+          m_pathLossTrace (txParams->txPhy, *rxPhyIt, pathLossDb);
+          if (pathLossDb > m_maxLossDb)
+            {
+              // beyond range
+              continue;
+            }
+        }
+      m_rxPhys.push_back (*rxPhyIt);
+      m_pathLossDb.push_back (pathLossDb);
+    }
+
+  // second pass: apply the frequency-selective loss to the receivers in range
+  for (std::size_t i = 0; i < m_rxPhys.size (); ++i)
+    {
+      Ptr<MobilityModel> receiverMobility = m_rxPhys[i]->GetMobility ();
+      NS_LOG_LOGIC ("copying signal parameters " << txParams);
+      Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
+      Time delay = MicroSeconds (0);
+
+      if (senderMobility && receiverMobility)
+        {
+          *(rxParams->psd) *= std::pow (10.0, -m_pathLossDb[i] / 10.0);
+
+          if (m_spectrumPropagationLoss)
+            {
+              rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, senderMobility, receiverMobility);
+            }
+
+          if (m_propagationDelay)
+            {
+              delay = m_propagationDelay->GetDelay (senderMobility, receiverMobility);
+            }
+        }
+
+      uint32_t dstNode = Simulator::NO_CONTEXT;
+      Ptr<NetDevice> netDev = m_rxPhys[i]->GetDevice ();
+      if (netDev)
+        {
+          dstNode = netDev->GetNode ()->GetId ();
+        }
+
+      PendingReception pending;
+      pending.m_delay = delay;
+      pending.m_reception.m_params = rxParams;
+      pending.m_reception.m_receiver = m_rxPhys[i];
+      pending.m_reception.m_node = dstNode;
+      m_pending.push_back (pending);
+    }
+  m_rxPhys.clear ();
+
+  // a single event per propagation delay and receiving node delivers the
+  // signal to the receivers of that node, in its context
+  std::stable_sort (m_pending.begin (), m_pending.end (), &MmWaveSidelinkSpectrumChannel::CompareDelayAndNode);
+  std::size_t first = 0;
+  while (first < m_pending.size ())
+    {
+      std::size_t last = first + 1;
+      while (last < m_pending.size () && m_pending[last].m_delay == m_pending[first].m_delay
+             && m_pending[last].m_reception.m_node == m_pending[first].m_reception.m_node)
+        {
+          ++last;
+        }
+      ReceptionList receptions;
+      receptions.reserve (last - first);
+      for (std::size_t i = first; i < last; ++i)
+        {
+          receptions.push_back (m_pending[i].m_reception);
+        }
+      uint32_t context = receptions.front ().m_node;
+      NS_LOG_LOGIC ("schedule the reception of " << receptions.size () << " receivers after " << m_pending[first].m_delay);
+      Simulator::ScheduleWithContext (context, m_pending[first].m_delay, &MmWaveSidelinkSpectrumChannel::StartRx, this, receptions);
+      first = last;
+    }
+  m_pending.clear ();
+}
+
+bool
+MmWaveSidelinkSpectrumChannel::CompareDelayAndNode (const PendingReception &a, const PendingReception &b)
+{
+  if (a.m_delay != b.m_delay)
+    {
+      return a.m_delay < b.m_delay;
+    }
+  return a.m_reception.m_node < b.m_reception.m_node;
+}
+
+void
+MmWaveSidelinkSpectrumChannel::StartRx (ReceptionList receptions)
+{
+  NS_LOG_FUNCTION (this << receptions.size ());
+  for (ReceptionList::const_iterator it = receptions.begin (); it != receptions.end (); ++it)
+    {
+      it->m_receiver->StartRx (it->m_params);
+    }
+}
+
+std::size_t
+MmWaveSidelinkSpectrumChannel::GetNDevices (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_phyList.size ();
+}
+
+Ptr<NetDevice>
+MmWaveSidelinkSpectrumChannel::GetDevice (std::size_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  return m_phyList.at (i)->GetDevice ()->GetObject<NetDevice> ();
+}
+
+} // namespace millicar
+
+} // namespace ns3
@@ -34,6 +34,7 @@
 #include <ns3/mmwave-mi-error-model.h>
 #include <ns3/mmwave-vehicular-net-device.h>
 #include <ns3/mmwave-vehicular-antenna-array-model.h>
+#include <ns3/mmwave-vehicular-profiler.h>
 
 namespace ns3 {
 
@@ -221,6 +222,13 @@ MmWaveSidelinkSpectrumPhy::SetSidelinkSinrReportCallback (MmWaveSidelinkSinrRepo
   m_slSinrReportCallback.push_back(c);
 }
 
+void
+MmWaveSidelinkSpectrumPhy::SetSidelinkSensingCallback (MmWaveSidelinkSensingCallback c)
+{
+  NS_LOG_FUNCTION (this);
+  m_slSensingCallback = c;
+}
+
 void
 MmWaveSidelinkSpectrumPhy::StartRx (Ptr<SpectrumSignalParameters> params)
 {
@@ -259,6 +267,13 @@ void
 MmWaveSidelinkSpectrumPhy::StartRxData (Ptr<MmWaveSidelinkSpectrumSignalParameters> params)
 {
   NS_LOG_FUNCTION (this);
+  MILLICAR_PROFILE_SCOPE (START_RX_DATA);
+
+  // report the sensed transmission, unless this device is transmitting
+  if (m_state != TX && !m_slSensingCallback.IsNull ())
+    {
+      m_slSensingCallback (params->senderRnti, 10 * std::log10 (Integral (*params->psd)) + 30);
+    }
 
   switch (m_state)
     {
@@ -371,6 +386,7 @@ void
 MmWaveSidelinkSpectrumPhy::EndRxData ()
 {
   NS_LOG_FUNCTION (this);
+  MILLICAR_PROFILE_SCOPE (END_RX_DATA);
   m_interferenceData->EndRx ();
 
   double sinrAvg = Sum (m_sinrPerceived) / (m_sinrPerceived.GetSpectrumModel ()->GetNumBands ());
@@ -74,6 +74,15 @@ typedef Callback< void, Ptr<Packet> > MmWavePhyRxDataEndOkCallback;
 */
 typedef Callback< void, const SpectrumValue&, uint16_t, uint8_t, uint32_t, uint8_t> MmWaveSidelinkSinrReportCallback;
 
+/**
+* This method is used by the MmWaveSidelinkSpectrumPhy to notify the PHY about
+* each sidelink transmission sensed on the channel
+*
+* @param rnti RNTI of the transmitting device
+* @param rxPower received power in dBm
+*/
+typedef Callback< void, uint16_t, double> MmWaveSidelinkSensingCallback;
+
 //typedef Callback< void, std::list<Ptr<MmWaveControlMessage> > > MmWavePhyRxCtrlEndOkCallback;
 
 /**
@@ -226,6 +235,13 @@ public:
   */
   void SetSidelinkSinrReportCallback (MmWaveSidelinkSinrReportCallback c);
 
+  /**
+  * Set the callback used to report the sensed sidelink transmissions
+  *
+  * @param c the callback
+  */
+  void SetSidelinkSensingCallback (MmWaveSidelinkSensingCallback c);
+
   /**
   *
   *
@@ -291,6 +307,7 @@ private:
   //MmWavePhyRxCtrlEndOkCallback m_phyRxCtrlEndOkCallback;
   MmWavePhyRxDataEndOkCallback m_phyRxDataEndOkCallback;  ///< the mmwave sidelink phy receive data end ok callback
   std::vector<MmWaveSidelinkSinrReportCallback> m_slSinrReportCallback; ///< the vector with mmwave sidelink SINR report callbacks
+  MmWaveSidelinkSensingCallback m_slSensingCallback; ///< the mmwave sidelink sensing callback
 
   SpectrumValue m_sinrPerceived; ///< the perceived SINR
 
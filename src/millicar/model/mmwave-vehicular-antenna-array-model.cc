@@ -40,6 +40,9 @@ namespace millicar {
 
 NS_OBJECT_ENSURE_REGISTERED (MmWaveVehicularAntennaArrayModel);
 
+/// the step in dB of the attenuation at which the field pattern is tabulated
+static const double kPatternTableStep = 0.01;
+
 MmWaveVehicularAntennaArrayModel::MmWaveVehicularAntennaArrayModel () :
 m_omniTx {false},
 m_currentPanelId {0},
@@ -47,7 +50,15 @@ m_noPlane {0},
 m_isUe {false},
 m_totNoArrayElements {0},
 m_hpbw {0},       //HPBW value of each antenna element
-m_gMax {0}       //directivity value expressed in dBi and valid only for TRP (see table A.1.6-3 in 38.802)
+m_gMax {0},       //directivity value expressed in dBi and valid only for TRP (see table A.1.6-3 in 38.802)
+m_antennaColumns {0},
+m_frontBackRatio {0},
+m_sideLobeLevel {0},
+m_patternTableGMax {0},
+m_locationsElements {0},
+m_locationsColumns {0},
+m_locationsDisH {0},
+m_locationsDisV {0}
 // :m_minAngle (0),m_maxAngle(2*M_PI)
 {
   m_lastUpdateMap.clear ();
@@ -91,6 +102,12 @@ MmWaveVehicularAntennaArrayModel::GetTypeId ()
                    MakeUintegerAccessor (&MmWaveVehicularAntennaArrayModel::SetTotNoArrayElements,
                                          &MmWaveVehicularAntennaArrayModel::GetTotNoArrayElements),
                    MakeUintegerChecker<uint64_t> ())
+    .AddAttribute ("AntennaColumns",
+                   "The number of antenna elements in each row of the array. "
+                   "If zero, the array is square",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&MmWaveVehicularAntennaArrayModel::m_antennaColumns),
+                   MakeUintegerChecker<uint16_t> ())
     .AddAttribute ("NumSectors",
                    "The number of antenna sectors",
                    UintegerValue (2),
@@ -136,6 +153,27 @@ MmWaveVehicularAntennaArrayModel::GetTotNoArrayElements () const
   return m_totNoArrayElements;
 }
 
+uint16_t
+MmWaveVehicularAntennaArrayModel::GetAntennaColumns () const
+{
+  if (m_antennaColumns == 0)
+  {
+    uint16_t columns = std::round (std::sqrt (m_totNoArrayElements));
+    NS_ABORT_MSG_IF (uint64_t (columns) * columns != m_totNoArrayElements,
+                     "The number of antenna elements of a square array must be a square, set AntennaColumns for a rectangular array");
+    return columns;
+  }
+  NS_ABORT_MSG_IF (m_totNoArrayElements % m_antennaColumns != 0,
+                   "The number of antenna elements must be a multiple of the number of columns");
+  return m_antennaColumns;
+}
+
+uint16_t
+MmWaveVehicularAntennaArrayModel::GetAntennaRows () const
+{
+  return m_totNoArrayElements / GetAntennaColumns ();
+}
+
 void
 MmWaveVehicularAntennaArrayModel::SetDeviceType (bool isUe)
 {
@@ -210,14 +248,12 @@ MmWaveVehicularAntennaArrayModel::SetBeamformingVectorPanelDevices (Ptr<NetDevic
       double hAngleRadian = fmod ((phiAngle + (M_PI / m_noPlane)),2 * M_PI / m_noPlane) - (M_PI / m_noPlane);
       double vAngleRadian = completeAngle.theta;
       double power = 1 / sqrt (m_totNoArrayElements);
-      uint16_t antennaNum [2];
-      antennaNum[0] = sqrt (m_totNoArrayElements);
-      antennaNum[1] = sqrt (m_totNoArrayElements);
+      const std::vector<Vector>& locations = GetAntennaLocations ();
       NS_LOG_INFO ("hAngleRadian: " << hAngleRadian);
 
       for (uint64_t ind = 0; ind < m_totNoArrayElements; ind++)
         {
-          Vector loc = GetAntennaLocation (ind, antennaNum);
+          const Vector& loc = locations[ind];
           double phase = -2 * M_PI * (sin (vAngleRadian) * cos (hAngleRadian) * loc.x
                                       + sin (vAngleRadian) * sin (hAngleRadian) * loc.y
                                       + cos (vAngleRadian) * loc.z);
@@ -339,45 +375,103 @@ MmWaveVehicularAntennaArrayModel::GetRadiationPattern (double vAngleRadian, doub
       return 1;
     }
 
-  while (hAngleRadian >= M_PI)
+  if (m_patternTablePattern != m_antennaElementPattern || m_patternTableGMax != m_gMax)
     {
-      hAngleRadian -= 2 * M_PI;
+      InitRadiationPattern ();
     }
-  while (hAngleRadian < -M_PI)
+
+  // linear interpolation of the field pattern between two samples
+  double position = GetElementAttenuationDb (vAngleRadian, hAngleRadian) / kPatternTableStep;
+  std::size_t index = position;
+  if (index + 1 >= m_patternTable.size ())
     {
-      hAngleRadian += 2 * M_PI;
+      return m_patternTable.back ();
     }
+  double fraction = position - index;
+  return m_patternTable[index] + fraction * (m_patternTable[index + 1] - m_patternTable[index]);
+}
 
-  double vAngle = vAngleRadian * 180 / M_PI;
-  double hAngle = hAngleRadian * 180 / M_PI;
-  //NS_LOG_INFO(" it is " << vAngle);
-  NS_ASSERT_MSG (vAngle >= 0&&vAngle <= 180, "the vertical angle should be the range of [0,180]");
-  //NS_LOG_INFO(" it is " << hAngle);
-  NS_ASSERT_MSG (hAngle >= -180&&hAngle <= 180, "the horizontal angle should be the range of [-180,180]");
+double
+MmWaveVehicularAntennaArrayModel::ComputeRadiationPattern (double vAngleRadian, double hAngleRadian)
+{
+  if (m_isotropicElement)
+    {
+      return 1;
+    }
 
-  double A_M = 0;       //front-back ratio expressed in dB
-  double SLA = 0;       //side-lobe level limit expressed in dB
+  if (m_patternTablePattern != m_antennaElementPattern || m_patternTableGMax != m_gMax)
+    {
+      InitRadiationPattern ();
+    }
+
+  double A = m_gMax - GetElementAttenuationDb (vAngleRadian, hAngleRadian);
+  return sqrt (pow (10,A / 10));     //filed factor term converted to linear;
+}
+
+double
+MmWaveVehicularAntennaArrayModel::GetRadiationPatternMaxError ()
+{
+  // the field pattern is 10^((gMax - x) / 20), the error of the linear
+  // interpolation is bounded by step^2 / 8 times its second derivative
+  double k = std::log (10) / 20 * kPatternTableStep;
+  return k * k / 8 * std::exp (k);
+}
 
+void
+MmWaveVehicularAntennaArrayModel::InitRadiationPattern ()
+{
   if (m_antennaElementPattern == "3GPP-MmWave") //front-back ratio and side-lobe level in case of standard mmWave antenna configuration
   {
-    A_M = 30;
-    SLA = 30;
+    m_frontBackRatio = 30;
+    m_sideLobeLevel = 30;
   }
   else if (m_antennaElementPattern == "3GPP-V2V") //front-back ratio and side-lobe level values in case of V2V antenna configuration
   {
-    A_M = 25;
-    SLA = 25;
+    m_frontBackRatio = 25;
+    m_sideLobeLevel = 25;
   }
   else
   {
     NS_FATAL_ERROR("Unknown antenna element pattern");
   }
 
+  NS_LOG_LOGIC ("Tabulate the " << m_antennaElementPattern << " pattern with gMax " << m_gMax);
+  std::size_t size = std::ceil (m_frontBackRatio / kPatternTableStep) + 1;
+  m_patternTable.resize (size);
+  for (std::size_t i = 0; i < size; i++)
+    {
+      double A = m_gMax - std::min (m_frontBackRatio, i * kPatternTableStep);
+      m_patternTable[i] = sqrt (pow (10,A / 10));
+    }
+  m_patternTablePattern = m_antennaElementPattern;
+  m_patternTableGMax = m_gMax;
+}
+
+double
+MmWaveVehicularAntennaArrayModel::GetElementAttenuationDb (double vAngleRadian, double hAngleRadian)
+{
+  while (hAngleRadian >= M_PI)
+    {
+      hAngleRadian -= 2 * M_PI;
+    }
+  while (hAngleRadian < -M_PI)
+    {
+      hAngleRadian += 2 * M_PI;
+    }
+
+  double vAngle = vAngleRadian * 180 / M_PI;
+  double hAngle = hAngleRadian * 180 / M_PI;
+  //NS_LOG_INFO(" it is " << vAngle);
+  NS_ASSERT_MSG (vAngle >= 0&&vAngle <= 180, "the vertical angle should be the range of [0,180]");
+  //NS_LOG_INFO(" it is " << hAngle);
+  NS_ASSERT_MSG (hAngle >= -180&&hAngle <= 180, "the horizontal angle should be the range of [-180,180]");
+
+  double A_M = m_frontBackRatio;       //front-back ratio expressed in dB
+  double SLA = m_sideLobeLevel;       //side-lobe level limit expressed in dB
+
   double A_v = -1 * std::min (SLA,12 * pow ((vAngle - 90) / m_hpbw,2));      //TODO: check position of z-axis zero
   double A_h = -1 * std::min (A_M,12 * pow (hAngle / m_hpbw,2));
-  double A = m_gMax - 1 * std::min (A_M,-1 * A_v - 1 * A_h);
-
-  return sqrt (pow (10,A / 10));     //filed factor term converted to linear;
+  return std::min (A_M,-1 * A_v - 1 * A_h);
 }
 
 Vector
@@ -391,6 +485,30 @@ MmWaveVehicularAntennaArrayModel::GetAntennaLocation (uint16_t index, uint16_t*
   return loc;
 }
 
+const std::vector<Vector>&
+MmWaveVehicularAntennaArrayModel::GetAntennaLocations ()
+{
+  uint16_t columns = GetAntennaColumns ();
+  if (m_locationsElements != m_totNoArrayElements || m_locationsColumns != columns
+      || m_locationsDisH != m_disH || m_locationsDisV != m_disV)
+    {
+      NS_LOG_LOGIC ("Compute the locations of " << m_totNoArrayElements << " elements in " << columns << " columns");
+      uint16_t antennaNum [2];
+      antennaNum[0] = columns;
+      antennaNum[1] = GetAntennaRows ();
+      m_locations.resize (m_totNoArrayElements);
+      for (uint64_t ind = 0; ind < m_totNoArrayElements; ind++)
+        {
+          m_locations[ind] = GetAntennaLocation (ind, antennaNum);
+        }
+      m_locationsElements = m_totNoArrayElements;
+      m_locationsColumns = columns;
+      m_locationsDisH = m_disH;
+      m_locationsDisV = m_disV;
+    }
+  return m_locations;
+}
+
 void
 MmWaveVehicularAntennaArrayModel::SetSector (uint8_t sector, uint16_t *antennaNum, double elevation)
 {
@@ -31,6 +31,7 @@
 #include "ns3/lte-rlc-um.h"
 #include "ns3/lte-rlc-tm.h"
 #include "ns3/lte-radio-bearer-tag.h"
+#include "ns3/mmwave-vehicular-profiler.h"
 #include "mmwave-sidelink-mac.h"
 #include "mmwave-vehicular-net-device.h"
 
@@ -101,6 +102,12 @@ MmWaveVehicularNetDevice::~MmWaveVehicularNetDevice (void)
 void
 MmWaveVehicularNetDevice::DoDispose (void)
 {
+  for (auto& bearer : m_bearerToInfoMap)
+  {
+    delete bearer.second->m_pdcpSapUser;
+    bearer.second->m_pdcpSapUser = 0;
+  }
+  m_bearerRequestCallback = MakeNullCallback<void, Ptr<MmWaveVehicularNetDevice>, Ipv4Address> ();
   NetDevice::DoDispose ();
 }
 
@@ -282,17 +289,26 @@ MmWaveVehicularNetDevice::GetRlcType (std::string rlcType)
   }
 }
 
-void
-MmWaveVehicularNetDevice::ActivateBearer(const uint8_t bearerId, const uint16_t destRnti, const Address& dest)
+uint16_t
+MmWaveVehicularNetDevice::ActivateBearer(const uint8_t lcid, const uint16_t destRnti, const Address& dest, const EpsBearer& bearer)
 {
-  NS_LOG_FUNCTION(this << bearerId);
-  uint8_t lcid = bearerId; // set the LCID to be equal to the bearerId
-  // future extensions could consider a different mapping
-  // and will actually exploit the following map
-  m_bid2lcid.insert(std::make_pair(bearerId, lcid));
+  NS_LOG_FUNCTION(this << (uint32_t)lcid << destRnti);
+
+  NS_ASSERT_MSG(IsLcidAvailable (lcid), "There's another bearer associated to this LCID: " << uint32_t(lcid));
+  NS_ASSERT_MSG(!HasBearer (destRnti), "There's another bearer associated to this rnti: " << destRnti);
+
+  // select the next free bearer ID, 0 is used by the TFT classifier when no
+  // bearer matches the packet
+  do
+  {
+    m_bidCounter++;
+  }
+  while (m_bidCounter == 0 || m_bearerToInfoMap.find (m_bidCounter) != m_bearerToInfoMap.end ());
+  uint16_t bearerId = m_bidCounter;
 
-  NS_ASSERT_MSG(m_bearerToInfoMap.find (bearerId) == m_bearerToInfoMap.end (),
-    "There's another bearer associated to this bearerId: " << uint32_t(bearerId));
+  m_bid2lcid.insert(std::make_pair(bearerId, lcid));
+  m_lcid2bid.insert(std::make_pair(lcid, bearerId));
+  m_rnti2bid.insert(std::make_pair(destRnti, bearerId));
 
   EpcTft::PacketFilter slFilter;
   slFilter.remoteAddress= Ipv4Address::ConvertFrom(dest);
@@ -312,6 +328,7 @@ MmWaveVehicularNetDevice::ActivateBearer(const uint8_t bearerId, const uint16_t
   tft->Add (slFilter); // Add the packet filter
 
   m_tftClassifier.Add(tft, bearerId);
+  m_remoteAddressToBid [slFilter.remoteAddress] = std::make_pair (slFilter.localAddress, bearerId);
 
   // Create RLC instance with specific RNTI and LCID
   ObjectFactory rlcObjectFactory;
@@ -323,7 +340,7 @@ MmWaveVehicularNetDevice::ActivateBearer(const uint8_t bearerId, const uint16_t
   rlc->SetLcId (lcid);
 
   // Call to the MAC method that created the SAP for binding the MAC instance on this node to the RLC instance just created
-  m_mac->AddMacSapUser(lcid, rlc->GetLteMacSapUser());
+  m_mac->AddMacSapUser(lcid, rlc->GetLteMacSapUser(), bearer);
 
   Ptr<LtePdcp> pdcp = CreateObject<LtePdcp> ();
   pdcp->SetRnti (destRnti); // this is the rnti of the destination
@@ -340,11 +357,72 @@ MmWaveVehicularNetDevice::ActivateBearer(const uint8_t bearerId, const uint16_t
   rbInfo->m_rlc= rlc;
   rbInfo->m_pdcp = pdcp;
   rbInfo->m_rnti = destRnti;
+  rbInfo->m_remoteAddress = slFilter.remoteAddress;
+  rbInfo->m_pdcpSapUser = pdcpSapUser;
 
-  NS_LOG_DEBUG(this << " MmWaveVehicularNetDevice::ActivateBearer() bid: " << (uint32_t)bearerId << " rnti: " << destRnti);
+  NS_LOG_DEBUG(this << " MmWaveVehicularNetDevice::ActivateBearer() bid: " << bearerId << " lcid: " << (uint32_t)lcid << " rnti: " << destRnti);
 
   // insert the tuple <lcid, pdcpSapProvider> in the map of this NetDevice, so that we are able to associate it to them later
   m_bearerToInfoMap.insert (std::make_pair (bearerId, rbInfo));
+
+  return bearerId;
+}
+
+void
+MmWaveVehicularNetDevice::DeactivateBearer (const uint16_t destRnti)
+{
+  NS_LOG_FUNCTION (this << destRnti);
+
+  auto rntiIt = m_rnti2bid.find (destRnti);
+  if (rntiIt == m_rnti2bid.end ())
+  {
+    NS_LOG_DEBUG ("No bearer associated to rnti " << destRnti);
+    return;
+  }
+  uint16_t bearerId = rntiIt->second;
+  uint8_t lcid = BidToLcid (bearerId);
+
+  NS_LOG_DEBUG(this << " MmWaveVehicularNetDevice::DeactivateBearer() bid: " << bearerId << " lcid: " << (uint32_t)lcid << " rnti: " << destRnti);
+
+  auto infoIt = m_bearerToInfoMap.find (bearerId);
+  Ptr<SidelinkRadioBearerInfo> rbInfo = infoIt->second;
+
+  m_tftClassifier.Delete (bearerId);
+  auto addrIt = m_remoteAddressToBid.find (rbInfo->m_remoteAddress);
+  if (addrIt != m_remoteAddressToBid.end () && addrIt->second.second == bearerId)
+  {
+    m_remoteAddressToBid.erase (addrIt);
+  }
+  m_mac->RemoveMacSapUser (lcid);
+
+  rbInfo->m_pdcp->Dispose ();
+  rbInfo->m_rlc->Dispose ();
+  delete rbInfo->m_pdcpSapUser;
+  rbInfo->m_pdcpSapUser = 0;
+
+  m_bearerToInfoMap.erase (infoIt);
+  m_bid2lcid.erase (bearerId);
+  m_lcid2bid.erase (lcid);
+  m_rnti2bid.erase (rntiIt);
+}
+
+bool
+MmWaveVehicularNetDevice::HasBearer (const uint16_t destRnti) const
+{
+  return m_rnti2bid.find (destRnti) != m_rnti2bid.end ();
+}
+
+bool
+MmWaveVehicularNetDevice::IsLcidAvailable (const uint8_t lcid) const
+{
+  return m_lcid2bid.find (lcid) == m_lcid2bid.end ();
+}
+
+void
+MmWaveVehicularNetDevice::SetBearerRequestCallback (BearerRequestCallback cb)
+{
+  NS_LOG_FUNCTION (this);
+  m_bearerRequestCallback = cb;
 }
 
 void
@@ -377,32 +455,68 @@ MmWaveVehicularNetDevice::Send (Ptr<Packet> packet, const Address& dest, uint16_
   NS_LOG_FUNCTION (this);
 
   // classify the incoming packet
-  uint32_t id = m_tftClassifier.Classify (packet, EpcTft::UPLINK, protocolNumber);
-  NS_ASSERT ((id & 0xFFFFFF00) == 0);
-  uint8_t bid = (uint8_t) (id & 0x000000FF);
-  uint8_t lcid = BidToLcid(bid);
+  uint16_t bid = 0;
+  if (protocolNumber == Ipv4L3Protocol::PROT_NUMBER)
+  {
+    // the sidelink filters match the remote address only, thus the bearer is
+    // found with an exact lookup on the IPv4 header, peeked in place
+    Ipv4Header ipv4Header;
+    packet->PeekHeader (ipv4Header);
+    bid = ClassifyIpv4 (ipv4Header);
+    if (bid == 0 && !m_bearerRequestCallback.IsNull ())
+    {
+      // no bearer towards this destination, ask for its activation
+      m_bearerRequestCallback (this, ipv4Header.GetDestination ());
+      bid = ClassifyIpv4 (ipv4Header);
+    }
+  }
+  if (bid == 0)
+  {
+    // fall back to the generic classifier
+    uint32_t id = m_tftClassifier.Classify (packet, EpcTft::UPLINK, protocolNumber);
+    NS_ASSERT ((id & 0xFFFF0000) == 0);
+    bid = (uint16_t) (id & 0x0000FFFF);
+  }
 
   // get the SidelinkRadioBearerInfo
-  NS_ASSERT_MSG(m_bearerToInfoMap.find (bid) != m_bearerToInfoMap.end (), "No logical channel associated to this communication");
-  auto bearerInfo = m_bearerToInfoMap.find (bid)->second;
+  auto bearerIt = m_bearerToInfoMap.find (bid);
+  if (bearerIt == m_bearerToInfoMap.end ())
+  {
+    NS_LOG_WARN ("No logical channel associated to this communication, discard the packet");
+    return false;
+  }
+  auto bearerInfo = bearerIt->second;
+  uint8_t lcid = BidToLcid(bid);
 
   LtePdcpSapProvider::TransmitPdcpSduParameters params;
   params.pdcpSdu = packet;
   params.rnti = bearerInfo->m_rnti;
   params.lcid = lcid;
 
-  NS_LOG_DEBUG(this << " MmWaveVehicularNetDevice::Send() bid " << (uint32_t)bid << " lcid " << (uint32_t)lcid << " rnti " << bearerInfo->m_rnti);
+  NS_LOG_DEBUG(this << " MmWaveVehicularNetDevice::Send() bid " << bid << " lcid " << (uint32_t)lcid << " rnti " << bearerInfo->m_rnti);
 
   packet->RemoveAllPacketTags (); // remove all tags in case there is any
 
   params.pdcpSdu = packet;
+  MILLICAR_PROFILE_SCOPE (RLC_TX_SDU);
   bearerInfo->m_pdcp->GetLtePdcpSapProvider()->TransmitPdcpSdu (params);
 
   return true;
 }
 
+uint16_t
+MmWaveVehicularNetDevice::ClassifyIpv4 (const Ipv4Header& ipv4Header) const
+{
+  auto it = m_remoteAddressToBid.find (ipv4Header.GetDestination ());
+  if (it != m_remoteAddressToBid.end () && it->second.first == ipv4Header.GetSource ())
+  {
+    return it->second.second;
+  }
+  return 0;
+}
+
 uint8_t
-MmWaveVehicularNetDevice::BidToLcid(const uint8_t bearerId) const
+MmWaveVehicularNetDevice::BidToLcid(const uint16_t bearerId) const
 {
   NS_ASSERT_MSG(m_bid2lcid.find(bearerId) != m_bid2lcid.end(),
     "BearerId to LCID mapping not found " << bearerId);
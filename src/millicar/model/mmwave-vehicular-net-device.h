@@ -24,6 +24,8 @@
 #include "ns3/lte-pdcp.h"
 #include "ns3/lte-radio-bearer-info.h"
 #include "ns3/epc-tft-classifier.h"
+#include "ns3/ipv4-header.h"
+#include <unordered_map>
 #include "mmwave-sidelink-phy.h"
 #include "mmwave-sidelink-mac.h"
 
@@ -41,10 +43,12 @@ namespace millicar {
 class SidelinkRadioBearerInfo : public LteRadioBearerInfo
 {
 public:
-  SidelinkRadioBearerInfo (void) {};
+  SidelinkRadioBearerInfo (void) : m_pdcpSapUser (0) {};
   virtual ~SidelinkRadioBearerInfo (void) {};
 
   uint16_t m_rnti; //!< rnti of the other endpoint of this bearer
+  Ipv4Address m_remoteAddress; //!< address of the other endpoint of this bearer
+  LtePdcpSapUser* m_pdcpSapUser; //!< the PDCP SAP user connected to the NetDevice
 };
 
 class MmWaveVehicularNetDevice : public NetDevice
@@ -174,11 +178,47 @@ public:
 
   /**
    * \brief a logical channel with instances of PDCP/RLC layers is created and associated to a specific receiving device
-   * \param bearerId identifier of the tunnel between two devices
+   * \param lcid the logical channel ID, which has to be the same on both the endpoints of the bearer
    * \param destRnti the rnti of the destination
    * \param dest IP destination address
+   * \param bearer the QoS of the bearer, used by the MAC scheduler
+   * \return the identifier of the bearer on this device
   */
-  void ActivateBearer (const uint8_t bearerId, const uint16_t destRnti, const Address& dest);
+  uint16_t ActivateBearer (const uint8_t lcid, const uint16_t destRnti, const Address& dest,
+                           const EpsBearer& bearer = EpsBearer (EpsBearer::NGBR_V2X_MESSAGES));
+
+  /**
+   * \brief release the PDCP/RLC instances of the bearer towards a device
+   * \param destRnti the rnti of the other endpoint of the bearer
+   */
+  void DeactivateBearer (const uint16_t destRnti);
+
+  /**
+   * \brief check if a bearer towards a device is active
+   * \param destRnti the rnti of the other endpoint of the bearer
+   * \return true if the bearer exists
+   */
+  bool HasBearer (const uint16_t destRnti) const;
+
+  /**
+   * \brief check if a logical channel ID is not used by any bearer of this device
+   * \param lcid the logical channel ID
+   * \return true if the LCID is available
+   */
+  bool IsLcidAvailable (const uint8_t lcid) const;
+
+  /**
+   * Callback invoked when a packet has to be sent to an IPv4 destination for
+   * which there is no active bearer. The callback may activate the bearer,
+   * in this case the packet is sent through it.
+   */
+  typedef Callback<void, Ptr<MmWaveVehicularNetDevice>, Ipv4Address> BearerRequestCallback;
+
+  /**
+   * \brief set the callback used to request the activation of a bearer
+   * \param cb the callback
+   */
+  void SetBearerRequestCallback (BearerRequestCallback cb);
 
 protected:
   NetDevice::ReceiveCallback m_rxCallback; //!< callback that is fired when a packet is received
@@ -186,16 +226,20 @@ protected:
 private:
   Ptr<MmWaveSidelinkMac> m_mac; //!< pointer to the MAC instance to be associated to the NetDevice
   Ptr<MmWaveSidelinkPhy> m_phy; //!< pointer to the PHY instance to be associated to the NetDevice
-  std::map<uint8_t, Ptr<SidelinkRadioBearerInfo>> m_bearerToInfoMap; //!< map to store RLC and PDCP instances associated to a specific bearer ID
+  std::map<uint16_t, Ptr<SidelinkRadioBearerInfo>> m_bearerToInfoMap; //!< map to store RLC and PDCP instances associated to a specific bearer ID
   Mac64Address m_macAddr; //!< MAC address associated to the NetDevice
   mutable uint16_t m_mtu; //!< MTU associated to the NetDevice
-  uint8_t m_bidCounter = 0; //!< counter of bearer connections activated for a single UE
+  uint16_t m_bidCounter = 0; //!< counter of bearer connections activated for a single UE
   uint8_t m_lcidCounter = 0; //!< counter of logical channels created on this NetDevice
-  std::map<uint8_t,uint8_t> m_bid2lcid; //!< map from the BID to a unique LCID
+  std::map<uint16_t,uint8_t> m_bid2lcid; //!< map from the BID to a unique LCID
+  std::map<uint8_t,uint16_t> m_lcid2bid; //!< map from the LCID to the BID
+  std::map<uint16_t,uint16_t> m_rnti2bid; //!< map from the rnti of the other endpoint to the BID
+  BearerRequestCallback m_bearerRequestCallback; //!< callback used to activate the bearers on demand
   uint32_t m_ifIndex;
   bool m_linkUp; //!< boolean that indicates if the link is UP (true) or DOWN (false)
   Ptr<Node> m_node; //!< pointer to the node associated to the NetDevice
   EpcTftClassifier m_tftClassifier;
+  std::unordered_map<Ipv4Address, std::pair<Ipv4Address, uint16_t>, Ipv4AddressHash> m_remoteAddressToBid; //!< map from the remote address to the <local address, BID> pair of the matching filter
   std::string m_rlcType;
 
   /**
@@ -203,7 +247,15 @@ private:
    * \param bearerId the bearer
    * \return the logical channel ID
    */
-  uint8_t BidToLcid(const uint8_t bearerId) const;
+  uint8_t BidToLcid(const uint16_t bearerId) const;
+
+  /**
+   * Return the bearer whose filter exactly matches the addresses of an IPv4
+   * packet, without inspecting the rest of the packet
+   * \param ipv4Header the IPv4 header of the packet
+   * \return the bearer ID, 0 if there is no match
+   */
+  uint16_t ClassifyIpv4 (const Ipv4Header& ipv4Header) const;
 };
 
 class PdcpSpecificSidelinkPdcpSapUser : public LtePdcpSapUser
@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "mmwave-vehicular-profiler.h"
+#include "ns3/simulator.h"
+#include "ns3/assert.h"
+#include <iomanip>
+#include <iostream>
+
+namespace ns3 {
+
+namespace millicar {
+
+namespace {
+
+/// the statistics of each section
+MmWaveVehicularProfiler::Stats g_stats[MmWaveVehicularProfiler::NUM_SECTIONS] = {};
+
+/// true if the summary is going to be printed when the simulation is destroyed
+bool g_destroyScheduled = false;
+
+} // anonymous namespace
+
+bool
+MmWaveVehicularProfiler::IsEnabled ()
+{
+#ifdef NS3_MILLICAR_PROFILING
+  return true;
+#else
+  return false;
+#endif
+}
+
+void
+MmWaveVehicularProfiler::Record (Section section, uint64_t durationNs)
+{
+  NS_ASSERT (section < NUM_SECTIONS);
+  if (!g_destroyScheduled)
+  {
+    Simulator::ScheduleDestroy (&MmWaveVehicularProfiler::DoDestroy);
+    g_destroyScheduled = true;
+  }
+
+  Stats& stats = g_stats[section];
+  stats.m_calls++;
+  stats.m_totalNs += durationNs;
+  if (durationNs > stats.m_maxNs)
+  {
+    stats.m_maxNs = durationNs;
+  }
+}
+
+MmWaveVehicularProfiler::Stats
+MmWaveVehicularProfiler::GetStats (Section section)
+{
+  NS_ASSERT (section < NUM_SECTIONS);
+  return g_stats[section];
+}
+
+std::string
+MmWaveVehicularProfiler::GetSectionName (Section section)
+{
+  switch (section)
+  {
+    case CALC_RX_PSD:
+      return "DoCalcRxPowerSpectralDensity";
+    case GET_NEW_CHANNEL:
+      return "GetNewChannel";
+    case UPDATE_CHANNEL:
+      return "UpdateChannel";
+    case CAL_LONG_TERM:
+      return "CalLongTerm";
+    case CAL_BEAMFORMING_GAIN:
+      return "CalBeamformingGain";
+    case GET_LOSS:
+      return "GetLoss";
+    case START_RX_DATA:
+      return "StartRxData";
+    case END_RX_DATA:
+      return "EndRxData";
+    case MAC_SCHEDULER:
+      return "ScheduleResources";
+    case RLC_TX_SDU:
+      return "TransmitPdcpSdu";
+    case RLC_TX_OPPORTUNITY:
+      return "NotifyTxOpportunity";
+    default:
+      NS_FATAL_ERROR ("Unknown section " << section);
+  }
+}
+
+void
+MmWaveVehicularProfiler::Reset ()
+{
+  for (uint32_t i = 0; i < NUM_SECTIONS; i++)
+  {
+    g_stats[i] = Stats ();
+  }
+}
+
+void
+MmWaveVehicularProfiler::Print (std::ostream& os)
+{
+  os << std::left << std::setw (30) << "Section"
+     << std::right << std::setw (12) << "Calls"
+     << std::setw (14) << "Total [s]"
+     << std::setw (14) << "Mean [us]"
+     << std::setw (14) << "Max [us]" << std::endl;
+  for (uint32_t i = 0; i < NUM_SECTIONS; i++)
+  {
+    const Stats& stats = g_stats[i];
+    os << std::left << std::setw (30) << GetSectionName (Section (i))
+       << std::right << std::setw (12) << stats.m_calls
+       << std::setw (14) << stats.m_totalNs * 1e-9
+       << std::setw (14) << (stats.m_calls > 0 ? stats.m_totalNs * 1e-3 / stats.m_calls : 0.0)
+       << std::setw (14) << stats.m_maxNs * 1e-3 << std::endl;
+  }
+}
+
+void
+MmWaveVehicularProfiler::DoDestroy ()
+{
+  Print (std::clog);
+  Reset ();
+  g_destroyScheduled = false;
+}
+
+} // namespace millicar
+
+} // namespace ns3
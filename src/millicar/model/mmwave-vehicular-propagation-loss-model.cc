@@ -31,6 +31,7 @@
 #include "ns3/pointer.h"
 #include <ns3/simulator.h>
 #include <ns3/node.h>
+#include <ns3/mmwave-vehicular-profiler.h>
 #include <random>
 
 namespace ns3 {
@@ -90,6 +91,19 @@ MmWaveVehicularPropagationLossModel::GetTypeId (void)
                    DoubleValue (0.0),
                    MakeDoubleAccessor (&MmWaveVehicularPropagationLossModel::m_percType3Vehicles),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("CacheThreshold",
+                   "The loss of a link is computed again only if one of the two devices "
+                   "moved by more than this distance (m) since the last computation. "
+                   "A negative value, the default, disables the cache.",
+                   DoubleValue (-1.0),
+                   MakeDoubleAccessor (&MmWaveVehicularPropagationLossModel::m_cacheThreshold),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("CacheMaxAge",
+                   "The cached loss of a link is computed again after this time, "
+                   "and the links not used for this time are removed from the cache.",
+                   TimeValue (Seconds (1)),
+                   MakeTimeAccessor (&MmWaveVehicularPropagationLossModel::m_cacheMaxAge),
+                   MakeTimeChecker ())
   ;
   return tid;
 }
@@ -149,22 +163,100 @@ MmWaveVehicularPropagationLossModel::GetWeatherAttenuation (double distance3D, d
   double weatherAtten = 0;
   
 
+  // the weather models are created at the first use, so that they are
+  // configured with the attribute values set before the simulation starts
   if(m_snowEnabled)
   {
-   Ptr<RainSnowAttenuation>snowAtten = CreateObject<RainSnowAttenuation>();
-   weatherAtten = snowAtten->getSnowAttenuation(distance3D, m_frequency, hA, hB);
+    if (!m_snowAttenuation)
+    {
+      m_snowAttenuation = CreateObject<RainSnowAttenuation>();
+    }
+    weatherAtten = m_snowAttenuation->getSnowAttenuation(distance3D, m_frequency, hA, hB);
   }
   else
   {
-    Ptr<RainAttenuation>rainAtten = CreateObject<RainAttenuation>();
-    weatherAtten = rainAtten->getRainAttenuation(distance3D, m_frequency);
+    if (!m_rainAttenuation)
+    {
+      m_rainAttenuation = CreateObject<RainAttenuation>();
+    }
+    weatherAtten = m_rainAttenuation->getRainAttenuation(distance3D, m_frequency);
   }
   
   return weatherAtten;
 }
 
+void
+MmWaveVehicularPropagationLossModel::ResetWeatherAttenuation (void)
+{
+  m_rainAttenuation = 0;
+  m_snowAttenuation = 0;
+  m_lossCache.clear ();
+}
+
 double
 MmWaveVehicularPropagationLossModel::GetLoss (Ptr<MobilityModel> deviceA, Ptr<MobilityModel> deviceB) const
+{
+  MILLICAR_PROFILE_SCOPE (GET_LOSS);
+  if (m_cacheThreshold < 0)
+    {
+      return ComputeLoss (deviceA, deviceB);
+    }
+
+  // the time goes back to zero when the simulator is destroyed
+  Time now = Simulator::Now ();
+  if (now - m_lastCachePurge > m_cacheMaxAge || now < m_lastCachePurge)
+    {
+      PurgeLossCache ();
+    }
+
+  // the loss is symmetric, thus both the directions share the same entry
+  LossCacheKey key (PeekPointer (deviceA), PeekPointer (deviceB));
+  if (key.second < key.first)
+    {
+      std::swap (key.first, key.second);
+    }
+  Vector firstPos = key.first->GetPosition ();
+  Vector secondPos = key.second->GetPosition ();
+
+  auto it = m_lossCache.find (key);
+  if (it != m_lossCache.end ()
+      && now - it->second.m_time <= m_cacheMaxAge
+      && now >= it->second.m_time
+      && CalculateDistance (it->second.m_firstPosition, firstPos) <= m_cacheThreshold
+      && CalculateDistance (it->second.m_secondPosition, secondPos) <= m_cacheThreshold)
+    {
+      return it->second.m_lossDb;
+    }
+
+  LossCacheEntry entry;
+  entry.m_firstPosition = firstPos;
+  entry.m_secondPosition = secondPos;
+  entry.m_lossDb = ComputeLoss (deviceA, deviceB);
+  entry.m_time = now;
+  m_lossCache [key] = entry;
+  return entry.m_lossDb;
+}
+
+void
+MmWaveVehicularPropagationLossModel::PurgeLossCache (void) const
+{
+  Time now = Simulator::Now ();
+  for (auto it = m_lossCache.begin (); it != m_lossCache.end (); )
+    {
+      if (now - it->second.m_time > m_cacheMaxAge || now < it->second.m_time)
+        {
+          it = m_lossCache.erase (it);
+        }
+      else
+        {
+          it++;
+        }
+    }
+  m_lastCachePurge = now;
+}
+
+double
+MmWaveVehicularPropagationLossModel::ComputeLoss (Ptr<MobilityModel> deviceA, Ptr<MobilityModel> deviceB) const
 {
   NS_ASSERT_MSG (m_frequency != 0.0, "Set the operating frequency first!");
   
@@ -543,7 +635,7 @@ MmWaveVehicularPropagationLossModel::GetAdditionalNlosVLoss (double distance3D,
     blockerHeight = 1.6;
     
   }
-  std::cout << "\n The blocker height is: " << blockerHeight << std::endl;
+  NS_LOG_DEBUG ("The blocker height is: " << blockerHeight);
 
   // The additional blockage loss is max {0 dB, a log-normal random variable}
   if (std::min (hA, hB) > blockerHeight)
@@ -577,7 +669,7 @@ MmWaveVehicularPropagationLossModel::GetAdditionalNlosVLoss (double distance3D,
     m_logNorVar->SetAttribute ("Sigma", DoubleValue (sqrt(log10(pow(sigma_a,2) / pow(mu_a,2) + 1))));
     additionalLoss = std::max(0.0, m_logNorVar->GetValue());
   }
-std::cout<< "\n The additional loss is: " <<additionalLoss<<std::endl;
+  NS_LOG_DEBUG ("The additional loss is: " << additionalLoss);
   return additionalLoss;
 }
 
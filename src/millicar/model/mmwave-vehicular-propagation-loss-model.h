@@ -32,7 +32,9 @@
 #include <ns3/mmwave-phy-mac-common.h>
 #include <ns3/rain-snow-attenuation.h>
 #include <ns3/rain-attenuation.h>
+#include <ns3/nstime.h>
 #include <map>
+#include <unordered_map>
 
 /*
  * This propagation loss model for vehicular communications has been implemented based on the 3GPP TR 37.885 v15.2.0 (2019-01).
@@ -47,6 +49,9 @@ namespace ns3 {
 
 namespace millicar {
 
+class RainAttenuation;
+class RainSnowAttenuation;
+
 struct channelCondition
 {
   char m_channelCondition;
@@ -92,6 +97,14 @@ class MmWaveVehicularPropagationLossModel : public PropagationLossModel
      */
     double GetWeatherAttenuation (double distance3D, double hA, double hB) const;
 
+    /**
+     * Drops the weather attenuation models and the cached losses, so that
+     * the models are created again with the current default attribute
+     * values, e.g., after changing the weather in a branch of a
+     * SimulationFork
+     */
+    void ResetWeatherAttenuation (void);
+
     char GetChannelCondition (Ptr<MobilityModel> a, Ptr<MobilityModel> b);
 
     std::string GetScenario ();
@@ -118,6 +131,52 @@ class MmWaveVehicularPropagationLossModel : public PropagationLossModel
      */
     double GetAdditionalNlosVLoss (double distance3D, double hA, double hB) const;
 
+    /**
+     * \param a the mobility model of device A
+     * \param b the mobility model of device B
+     *
+     * \returns the loss between the two devices, without using the cache
+     */
+    double ComputeLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+
+    /**
+     * Remove the entries of the loss cache older than the maximum age,
+     * e.g., the ones of the devices which were removed
+     */
+    void PurgeLossCache (void) const;
+
+    /**
+     * Loss of a link, computed with the devices in the stored positions
+     */
+    struct LossCacheEntry
+    {
+      Vector m_firstPosition; //!< position of the first device of the link
+      Vector m_secondPosition; //!< position of the second device of the link
+      double m_lossDb; //!< the loss in dB
+      Time m_time; //!< the time of the computation of the loss
+    };
+
+    /**
+     * The mobility models of the devices of a link, without holding a
+     * reference to them
+     */
+    typedef std::pair<const MobilityModel *, const MobilityModel *> LossCacheKey;
+
+    /**
+     * Hash function of a LossCacheKey
+     */
+    struct LossCacheKeyHash
+    {
+      /**
+       * \param key the key
+       * \returns the hash of the key
+       */
+      std::size_t operator () (const LossCacheKey &key) const
+      {
+        return std::hash<const MobilityModel *> () (key.first) * 31 + std::hash<const MobilityModel *> () (key.second);
+      }
+    };
+
     double m_frequency;
     double m_lambda;
     double m_minLoss;
@@ -131,6 +190,12 @@ class MmWaveVehicularPropagationLossModel : public PropagationLossModel
     bool m_shadowingEnabled = true;
     double m_percType3Vehicles = 30;
     bool m_snowEnabled = false;
+    mutable Ptr<RainAttenuation> m_rainAttenuation; //!< the rain attenuation model
+    mutable Ptr<RainSnowAttenuation> m_snowAttenuation; //!< the combined rain and wet snow attenuation model
+    double m_cacheThreshold; //!< movement (m) after which the cached loss of a link is recomputed, negative to disable the cache
+    Time m_cacheMaxAge; //!< age after which the cached loss of a link is recomputed and eventually removed
+    mutable Time m_lastCachePurge; //!< the time of the last removal of the old entries of the cache
+    mutable std::unordered_map<LossCacheKey, LossCacheEntry, LossCacheKeyHash> m_lossCache; //!< the cached loss of each link
 };
 
 } // namespace millicar
@@ -30,6 +30,7 @@
 #include <random>       // std::default_random_engine
 #include <ns3/boolean.h>
 #include <ns3/integer.h>
+#include <ns3/mmwave-vehicular-profiler.h>
 
 namespace ns3 {
 
@@ -180,6 +181,7 @@ MmWaveVehicularSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity (Ptr<c
                                                  Ptr<const MobilityModel> b) const
 {
   NS_LOG_FUNCTION (this);
+  MILLICAR_PROFILE_SCOPE (CALC_RX_PSD);
 
   // check if the frequency is correctly set
   NS_ASSERT_MSG (m_frequency != 0.0, "Set the operating frequency first!");
@@ -201,17 +203,16 @@ MmWaveVehicularSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity (Ptr<c
   Ptr<MmWaveVehicularAntennaArrayModel> rxAntennaArray = m_deviceAntennaMap.at (rxDevice);
   NS_LOG_DEBUG ("rx dev " << rxDevice << " antenna " << rxAntennaArray);
 
-  /* txAntennaNum[0]-number of vertical antenna elements
-   * txAntennaNum[1]-number of horizontal antenna elements*/
-  // NOTE: only squared antenna arrays are currently supported
+  /* txAntennaNum[0]-number of horizontal antenna elements, i.e., columns
+   * txAntennaNum[1]-number of vertical antenna elements, i.e., rows*/
   uint16_t txAntennaNum[2];
-  txAntennaNum[0] = sqrt (txAntennaArray->GetTotNoArrayElements ());
-  txAntennaNum[1] = txAntennaNum[0];
+  txAntennaNum[0] = txAntennaArray->GetAntennaColumns ();
+  txAntennaNum[1] = txAntennaArray->GetAntennaRows ();
   NS_LOG_DEBUG ("number of tx antenna elements " << txAntennaNum[0] << " x " << txAntennaNum[1]);
 
   uint16_t rxAntennaNum[2];
-  rxAntennaNum[0] = sqrt (rxAntennaArray->GetTotNoArrayElements ());
-  rxAntennaNum[1] = rxAntennaNum[0];
+  rxAntennaNum[0] = rxAntennaArray->GetAntennaColumns ();
+  rxAntennaNum[1] = rxAntennaArray->GetAntennaRows ();
   NS_LOG_DEBUG ("number of rx antenna elements " << rxAntennaNum[0] << " x " << rxAntennaNum[1]);
 
   if (txAntennaArray->IsOmniTx () || rxAntennaArray->IsOmniTx () )
@@ -367,10 +368,9 @@ MmWaveVehicularSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity (Ptr<c
 
   Ptr<SpectrumValue> bfPsd = CalBeamformingGain (rxPsd, channelParams, longTerm, rxSpeed, txSpeed);
 
-  SpectrumValue bfGain = (*bfPsd) / (*rxPsd);
-  uint8_t nbands = bfGain.GetSpectrumModel ()->GetNumBands ();
-
-  NS_LOG_DEBUG ("****** BF gain == " << Sum (bfGain) / nbands << " RX PSD " << Sum (*rxPsd) / nbands
+  // the beamforming gain is only computed if the debug log is enabled
+  NS_LOG_DEBUG ("****** BF gain == " << Sum ((*bfPsd) / (*rxPsd)) / rxPsd->GetSpectrumModel ()->GetNumBands ()
+                                        << " RX PSD " << Sum (*rxPsd) / rxPsd->GetSpectrumModel ()->GetNumBands ()
                                         << " a pos " << a->GetPosition ()
                                         << " a antenna ID " << txAntennaArray->GetPlanesId ()
                                         << " b pos " << b->GetPosition ()
@@ -383,6 +383,7 @@ MmWaveVehicularSpectrumPropagationLossModel::CalBeamformingGain (Ptr<const Spect
                                        complexVector_t longTerm, Vector rxSpeed, Vector txSpeed) const
 {
   NS_LOG_FUNCTION (this);
+  MILLICAR_PROFILE_SCOPE (CAL_BEAMFORMING_GAIN);
 
   Ptr<SpectrumValue> tempPsd = Copy<SpectrumValue> (txPsd);
 
@@ -486,7 +487,6 @@ MmWaveVehicularSpectrumPropagationLossModel::GetOxygenLoss (double f, double dis
         alpha = (oxygen_loss[idx][1] - oxygen_loss[idx-1][1])/(oxygen_loss[idx][0] - oxygen_loss[idx-1][0])*(f - oxygen_loss[idx-1][0]) + oxygen_loss[idx-1][1];
         loss = alpha / 1e3 * (dist3D + 3e8 * (tau + tauDelta));
         NS_LOG_DEBUG ("f (subband) " << f << " alpha " << alpha << " dB/km loss " << loss << " dB");
-        std::cout<< "\n Oxygen loss is: " << loss <<std::endl;
       }
     }
   }
@@ -517,6 +517,7 @@ MmWaveVehicularSpectrumPropagationLossModel::SetPathlossModel (Ptr<PropagationLo
 complexVector_t
 MmWaveVehicularSpectrumPropagationLossModel::CalLongTerm (Ptr<Params3gpp> params) const
 {
+  MILLICAR_PROFILE_SCOPE (CAL_LONG_TERM);
   uint16_t txAntenna = params->m_txW.size ();
   uint16_t rxAntenna = params->m_rxW.size ();
 
@@ -794,6 +795,7 @@ MmWaveVehicularSpectrumPropagationLossModel::GetNewChannel (Ptr<ParamsTable>  ta
                                   uint16_t *txAntennaNum, uint16_t *rxAntennaNum,  Angles &rxAngle, Angles &txAngle,
                                   Vector speed, double dis2D, double dis3D) const
 {
+  MILLICAR_PROFILE_SCOPE (GET_NEW_CHANNEL);
   uint8_t numOfCluster = table3gpp->m_numOfCluster;
   uint8_t raysPerCluster = table3gpp->m_raysPerCluster;
   Ptr<Params3gpp> channelParams = Create<Params3gpp> ();
@@ -818,10 +820,8 @@ MmWaveVehicularSpectrumPropagationLossModel::GetNewChannel (Ptr<ParamsTable>  ta
       paramNum = 6;
     }
   //Generate paramNum independent LSPs.
-  for (uint8_t iter = 0; iter < paramNum; iter++)
-    {
-      LSPsIndep.push_back (m_normalRv->GetValue ());
-    }
+  LSPsIndep.resize (paramNum);
+  m_normalRv->GetValues (LSPsIndep.data (), paramNum);
   for (uint8_t row = 0; row < paramNum; row++)
     {
       double temp = 0;
@@ -880,9 +880,11 @@ MmWaveVehicularSpectrumPropagationLossModel::GetNewChannel (Ptr<ParamsTable>  ta
   //Step 5: Generate Delays.
   doubleVector_t clusterDelay;
   double minTau = 100.0;
+  doubleVector_t uniformRvs (numOfCluster);
+  m_uniformRv->GetValues (uniformRvs.data (), numOfCluster, 0, 1);
   for (uint8_t cIndex = 0; cIndex < numOfCluster; cIndex++)
     {
-      double tau = -1*table3gpp->m_rTau*DS*log (m_uniformRv->GetValue (0,1));         //(7.5-1)
+      double tau = -1*table3gpp->m_rTau*DS*log (uniformRvs.at (cIndex));         //(7.5-1)
       if (minTau > tau)
         {
           minTau = tau;
@@ -902,10 +904,12 @@ MmWaveVehicularSpectrumPropagationLossModel::GetNewChannel (Ptr<ParamsTable>  ta
   //Step 6: Generate cluster powers.
   doubleVector_t clusterPower;
   double powerSum = 0;
+  doubleVector_t normalRvs (numOfCluster);
+  m_normalRv->GetValues (normalRvs.data (), numOfCluster);
   for (uint8_t cIndex = 0; cIndex < numOfCluster; cIndex++)
     {
       double power = exp (-1 * clusterDelay.at (cIndex) * (table3gpp->m_rTau - 1) / table3gpp->m_rTau / DS) *
-        pow (10,-1 * m_normalRv->GetValue () * table3gpp->m_shadowingStd / 10);                       //(7.5-5)
+        pow (10,-1 * normalRvs.at (cIndex) * table3gpp->m_shadowingStd / 10);                       //(7.5-5)
       powerSum += power;
       clusterPower.push_back (power);
     }
@@ -1095,24 +1099,30 @@ MmWaveVehicularSpectrumPropagationLossModel::GetNewChannel (Ptr<ParamsTable>  ta
       clusterZod.push_back (angle);
     }
 
+  //one uniform RV and four normal RVs per cluster
+  uniformRvs.resize (numReducedCluster);
+  m_uniformRv->GetValues (uniformRvs.data (), numReducedCluster, 0, 1);
+  normalRvs.resize (4 * numReducedCluster);
+  m_normalRv->GetValues (normalRvs.data (), normalRvs.size ());
   for (uint8_t cIndex = 0; cIndex < numReducedCluster; cIndex++)
     {
       int Xn = 1;
-      if (m_uniformRv->GetValue (0,1) < 0.5)
+      if (uniformRvs.at (cIndex) < 0.5)
         {
           Xn = -1;
         }
-      clusterAoa.at (cIndex) = clusterAoa.at (cIndex) * Xn + (m_normalRv->GetValue () * ASA / 7) + rxAngle.phi * 180 / M_PI;        //(7.5-11)
-      clusterAod.at (cIndex) = clusterAod.at (cIndex) * Xn + (m_normalRv->GetValue () * ASD / 7) + txAngle.phi * 180 / M_PI;
+      const double *normalRv = &normalRvs.at (4 * cIndex);
+      clusterAoa.at (cIndex) = clusterAoa.at (cIndex) * Xn + (normalRv[0] * ASA / 7) + rxAngle.phi * 180 / M_PI;        //(7.5-11)
+      clusterAod.at (cIndex) = clusterAod.at (cIndex) * Xn + (normalRv[1] * ASD / 7) + txAngle.phi * 180 / M_PI;
       if (o2i)
         {
-          clusterZoa.at (cIndex) = clusterZoa.at (cIndex) * Xn + (m_normalRv->GetValue () * ZSA / 7) + 90;            //(7.5-16)
+          clusterZoa.at (cIndex) = clusterZoa.at (cIndex) * Xn + (normalRv[2] * ZSA / 7) + 90;            //(7.5-16)
         }
       else
         {
-          clusterZoa.at (cIndex) = clusterZoa.at (cIndex) * Xn + (m_normalRv->GetValue () * ZSA / 7) + rxAngle.theta * 180 / M_PI;            //(7.5-16)
+          clusterZoa.at (cIndex) = clusterZoa.at (cIndex) * Xn + (normalRv[2] * ZSA / 7) + rxAngle.theta * 180 / M_PI;            //(7.5-16)
         }
-      clusterZod.at (cIndex) = clusterZod.at (cIndex) * Xn + (m_normalRv->GetValue () * ZSD / 7) + txAngle.theta * 180 / M_PI + table3gpp->m_offsetZOD;        //(7.5-19)
+      clusterZod.at (cIndex) = clusterZod.at (cIndex) * Xn + (normalRv[3] * ZSD / 7) + txAngle.theta * 180 / M_PI + table3gpp->m_offsetZOD;        //(7.5-19)
 
     }
 
@@ -1341,16 +1351,15 @@ MmWaveVehicularSpectrumPropagationLossModel::GetNewChannel (Ptr<ParamsTable>  ta
 
   //Step 10: Draw initial phases
   double2DVector_t clusterPhase;       //rayAoa_radian[n][m], where n is cluster index, m is ray index
+  uniformRvs.resize (numReducedCluster * raysPerCluster + 1);
+  m_uniformRv->GetValues (uniformRvs.data (), uniformRvs.size (), -1 * M_PI, M_PI);
   for (uint8_t nInd = 0; nInd < numReducedCluster; nInd++)
     {
-      doubleVector_t temp;
-      for (uint8_t mInd = 0; mInd < raysPerCluster; mInd++)
-        {
-          temp.push_back (m_uniformRv->GetValue (-1 * M_PI, M_PI));
-        }
+      doubleVector_t temp (uniformRvs.begin () + nInd * raysPerCluster,
+                           uniformRvs.begin () + (nInd + 1) * raysPerCluster);
       clusterPhase.push_back (temp);
     }
-  double losPhase = m_uniformRv->GetValue (-1 * M_PI, M_PI);
+  double losPhase = uniformRvs.back ();
   channelParams->m_clusterPhase = clusterPhase;
   channelParams->m_losPhase = losPhase;
 
@@ -1395,16 +1404,42 @@ MmWaveVehicularSpectrumPropagationLossModel::GetNewChannel (Ptr<ParamsTable>  ta
           H_usn.at (uIndex).at (sIndex).resize (numReducedCluster);
         }
     }
+  // the field pattern and the direction of the rays do not depend on the
+  // antenna elements, compute them once for all the pairs of elements
+  const std::vector<Vector>& rxLocations = rxAntenna->GetAntennaLocations ();
+  const std::vector<Vector>& txLocations = txAntenna->GetAntennaLocations ();
+  double2DVector_t rayPattern (numReducedCluster, doubleVector_t (raysPerCluster));
+  std::vector< std::vector<Vector> > rxRayDirection (numReducedCluster, std::vector<Vector> (raysPerCluster));
+  std::vector< std::vector<Vector> > txRayDirection (numReducedCluster, std::vector<Vector> (raysPerCluster));
+  for (uint8_t nIndex = 0; nIndex < numReducedCluster; nIndex++)
+    {
+      for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
+        {
+          rayPattern[nIndex][mIndex] = rxAntenna->GetRadiationPattern (rayZoa_radian[nIndex][mIndex],rayAoa_radian[nIndex][mIndex])
+            * txAntenna->GetRadiationPattern (rayZod_radian[nIndex][mIndex],rayAod_radian[nIndex][mIndex]);
+          rxRayDirection[nIndex][mIndex] = Vector (sin (rayZoa_radian[nIndex][mIndex]) * cos (rayAoa_radian[nIndex][mIndex]),
+                                                   sin (rayZoa_radian[nIndex][mIndex]) * sin (rayAoa_radian[nIndex][mIndex]),
+                                                   cos (rayZoa_radian[nIndex][mIndex]));
+          txRayDirection[nIndex][mIndex] = Vector (sin (rayZod_radian[nIndex][mIndex]) * cos (rayAod_radian[nIndex][mIndex]),
+                                                   sin (rayZod_radian[nIndex][mIndex]) * sin (rayAod_radian[nIndex][mIndex]),
+                                                   cos (rayZod_radian[nIndex][mIndex]));
+        }
+    }
+  double losPattern = rxAntenna->GetRadiationPattern (rxAngle.theta,rxAngle.phi)
+    * txAntenna->GetRadiationPattern (txAngle.theta,rxAngle.phi);
+  Vector rxLosDirection (sin (rxAngle.theta) * cos (rxAngle.phi), sin (rxAngle.theta) * sin (rxAngle.phi), cos (rxAngle.theta));
+  Vector txLosDirection (sin (txAngle.theta) * cos (txAngle.phi), sin (txAngle.theta) * sin (txAngle.phi), cos (txAngle.theta));
+
   //double slotTime = Simulator::Now ().GetSeconds ();
   // The following for loops computes the channel coefficients
   for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
     {
-      Vector uLoc = rxAntenna->GetAntennaLocation (uIndex,rxAntennaNum);
+      const Vector& uLoc = rxLocations[uIndex];
 
       for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
         {
 
-          Vector sLoc = txAntenna->GetAntennaLocation (sIndex,txAntennaNum);
+          const Vector& sLoc = txLocations[sIndex];
 
           for (uint8_t nIndex = 0; nIndex < numReducedCluster; nIndex++)
             {
@@ -1416,20 +1451,19 @@ MmWaveVehicularSpectrumPropagationLossModel::GetNewChannel (Ptr<ParamsTable>  ta
                     {
                       double initialPhase = clusterPhase.at (nIndex).at (mIndex);
                       //lambda_0 is accounted in the antenna spacing uLoc and sLoc.
-                      double rxPhaseDiff = 2 * M_PI * (sin (rayZoa_radian[nIndex][mIndex]) * cos (rayAoa_radian[nIndex][mIndex]) * uLoc.x
-                                                       + sin (rayZoa_radian[nIndex][mIndex]) * sin (rayAoa_radian[nIndex][mIndex]) * uLoc.y
-                                                       + cos (rayZoa_radian[nIndex][mIndex]) * uLoc.z);
+                      double rxPhaseDiff = 2 * M_PI * (rxRayDirection[nIndex][mIndex].x * uLoc.x
+                                                       + rxRayDirection[nIndex][mIndex].y * uLoc.y
+                                                       + rxRayDirection[nIndex][mIndex].z * uLoc.z);
 
-                      double txPhaseDiff = 2 * M_PI * (sin (rayZod_radian[nIndex][mIndex]) * cos (rayAod_radian[nIndex][mIndex]) * sLoc.x
-                                                       + sin (rayZod_radian[nIndex][mIndex]) * sin (rayAod_radian[nIndex][mIndex]) * sLoc.y
-                                                       + cos (rayZod_radian[nIndex][mIndex]) * sLoc.z);
+                      double txPhaseDiff = 2 * M_PI * (txRayDirection[nIndex][mIndex].x * sLoc.x
+                                                       + txRayDirection[nIndex][mIndex].y * sLoc.y
+                                                       + txRayDirection[nIndex][mIndex].z * sLoc.z);
                       //Doppler is computed in the CalBeamformingGain function and is simplified to only account for the center anngle of each cluster.
                       //double doppler = 2*M_PI*(sin(rayZoa_radian[nIndex][mIndex])*cos(rayAoa_radian[nIndex][mIndex])*relativeSpeed.x
                       //		+ sin(rayZoa_radian[nIndex][mIndex])*sin(rayAoa_radian[nIndex][mIndex])*relativeSpeed.y
                       //		+ cos(rayZoa_radian[nIndex][mIndex])*relativeSpeed.z)*slotTime*m_phyMacConfig->GetCenterFrequency ()/3e8;
                       rays += exp (std::complex<double> (0, initialPhase))
-                        * (rxAntenna->GetRadiationPattern (rayZoa_radian[nIndex][mIndex],rayAoa_radian[nIndex][mIndex])
-                           * txAntenna->GetRadiationPattern (rayZod_radian[nIndex][mIndex],rayAod_radian[nIndex][mIndex]))
+                        * rayPattern[nIndex][mIndex]
                         * exp (std::complex<double> (0, rxPhaseDiff))
                         * exp (std::complex<double> (0, txPhaseDiff));
                       //*exp(std::complex<double>(0, doppler));
@@ -1451,12 +1485,12 @@ MmWaveVehicularSpectrumPropagationLossModel::GetNewChannel (Ptr<ParamsTable>  ta
                       //ZML:Just remind me that the angle offsets for the 3 subclusters were not generated correctly.
 
                       double initialPhase = clusterPhase.at (nIndex).at (mIndex);
-                      double rxPhaseDiff = 2 * M_PI * (sin (rayZoa_radian[nIndex][mIndex]) * cos (rayAoa_radian[nIndex][mIndex]) * uLoc.x
-                                                       + sin (rayZoa_radian[nIndex][mIndex]) * sin (rayAoa_radian[nIndex][mIndex]) * uLoc.y
-                                                       + cos (rayZoa_radian[nIndex][mIndex]) * uLoc.z);
-                      double txPhaseDiff = 2 * M_PI * (sin (rayZod_radian[nIndex][mIndex]) * cos (rayAod_radian[nIndex][mIndex]) * sLoc.x
-                                                       + sin (rayZod_radian[nIndex][mIndex]) * sin (rayAod_radian[nIndex][mIndex]) * sLoc.y
-                                                       + cos (rayZod_radian[nIndex][mIndex]) * sLoc.z);
+                      double rxPhaseDiff = 2 * M_PI * (rxRayDirection[nIndex][mIndex].x * uLoc.x
+                                                       + rxRayDirection[nIndex][mIndex].y * uLoc.y
+                                                       + rxRayDirection[nIndex][mIndex].z * uLoc.z);
+                      double txPhaseDiff = 2 * M_PI * (txRayDirection[nIndex][mIndex].x * sLoc.x
+                                                       + txRayDirection[nIndex][mIndex].y * sLoc.y
+                                                       + txRayDirection[nIndex][mIndex].z * sLoc.z);
                       //double doppler = 2*M_PI*(sin(rayZoa_radian[nIndex][mIndex])*cos(rayAoa_radian[nIndex][mIndex])*relativeSpeed.x
                       //		+ sin(rayZoa_radian[nIndex][mIndex])*sin(rayAoa_radian[nIndex][mIndex])*relativeSpeed.y
                       //		+ cos(rayZoa_radian[nIndex][mIndex])*relativeSpeed.z)*slotTime*m_phyMacConfig->GetCenterFrequency ()/3e8;
@@ -1471,8 +1505,7 @@ MmWaveVehicularSpectrumPropagationLossModel::GetNewChannel (Ptr<ParamsTable>  ta
                         case 18:
                           //delaySpread= -2*M_PI*(clusterDelay.at(nIndex)+1.28*c_DS)*m_phyMacConfig->GetCenterFrequency ();
                           raysSub2 += exp (std::complex<double> (0, initialPhase))
-                            * (rxAntenna->GetRadiationPattern (rayZoa_radian[nIndex][mIndex],rayAoa_radian[nIndex][mIndex])
-                               * txAntenna->GetRadiationPattern (rayZod_radian[nIndex][mIndex],rayAod_radian[nIndex][mIndex]))
+                            * rayPattern[nIndex][mIndex]
                             * exp (std::complex<double> (0, rxPhaseDiff))
                             * exp (std::complex<double> (0, txPhaseDiff));
                           //*exp(std::complex<double>(0, doppler));
@@ -1484,8 +1517,7 @@ MmWaveVehicularSpectrumPropagationLossModel::GetNewChannel (Ptr<ParamsTable>  ta
                         case 16:
                           //delaySpread = -2*M_PI*(clusterDelay.at(nIndex)+2.56*c_DS)*m_phyMacConfig->GetCenterFrequency ();
                           raysSub3 += exp (std::complex<double> (0, initialPhase))
-                            * (rxAntenna->GetRadiationPattern (rayZoa_radian[nIndex][mIndex],rayAoa_radian[nIndex][mIndex])
-                               * txAntenna->GetRadiationPattern (rayZod_radian[nIndex][mIndex],rayAod_radian[nIndex][mIndex]))
+                            * rayPattern[nIndex][mIndex]
                             * exp (std::complex<double> (0, rxPhaseDiff))
                             * exp (std::complex<double> (0, txPhaseDiff));
                           //*exp(std::complex<double>(0, doppler));
@@ -1494,8 +1526,7 @@ MmWaveVehicularSpectrumPropagationLossModel::GetNewChannel (Ptr<ParamsTable>  ta
                         default:                        //case 1,2,3,4,5,6,7,8,19,20
                                                         //delaySpread = -2*M_PI*clusterDelay.at(nIndex)*m_phyMacConfig->GetCenterFrequency ();
                           raysSub1 += exp (std::complex<double> (0, initialPhase))
-                            * (rxAntenna->GetRadiationPattern (rayZoa_radian[nIndex][mIndex],rayAoa_radian[nIndex][mIndex])
-                               * txAntenna->GetRadiationPattern (rayZod_radian[nIndex][mIndex],rayAod_radian[nIndex][mIndex]))
+                            * rayPattern[nIndex][mIndex]
                             * exp (std::complex<double> (0, rxPhaseDiff))
                             * exp (std::complex<double> (0, txPhaseDiff));
                           //*exp(std::complex<double>(0, doppler));
@@ -1518,19 +1549,18 @@ MmWaveVehicularSpectrumPropagationLossModel::GetNewChannel (Ptr<ParamsTable>  ta
           if (condition == 'l')               //(7.5-29) && (7.5-30)
             {
               std::complex<double> ray (0,0);
-              double rxPhaseDiff = 2 * M_PI * (sin (rxAngle.theta) * cos (rxAngle.phi) * uLoc.x
-                                               + sin (rxAngle.theta) * sin (rxAngle.phi) * uLoc.y
-                                               + cos (rxAngle.theta) * uLoc.z);
-              double txPhaseDiff = 2 * M_PI * (sin (txAngle.theta) * cos (txAngle.phi) * sLoc.x
-                                               + sin (txAngle.theta) * sin (txAngle.phi) * sLoc.y
-                                               + cos (txAngle.theta) * sLoc.z);
+              double rxPhaseDiff = 2 * M_PI * (rxLosDirection.x * uLoc.x
+                                               + rxLosDirection.y * uLoc.y
+                                               + rxLosDirection.z * uLoc.z);
+              double txPhaseDiff = 2 * M_PI * (txLosDirection.x * sLoc.x
+                                               + txLosDirection.y * sLoc.y
+                                               + txLosDirection.z * sLoc.z);
               //double doppler = 2*M_PI*(sin(rxAngle.theta)*cos(rxAngle.phi)*relativeSpeed.x
               //		+ sin(rxAngle.theta)*sin(rxAngle.phi)*relativeSpeed.y
               //		+ cos(rxAngle.theta)*relativeSpeed.z)*slotTime*m_phyMacConfig->GetCenterFrequency ()/3e8;
 
               ray = exp (std::complex<double> (0, losPhase))
-                * (rxAntenna->GetRadiationPattern (rxAngle.theta,rxAngle.phi)
-                   * txAntenna->GetRadiationPattern (txAngle.theta,rxAngle.phi))
+                * losPattern
                 * exp (std::complex<double> (0, rxPhaseDiff))
                 * exp (std::complex<double> (0, txPhaseDiff));
               //*exp(std::complex<double>(0, doppler));
@@ -1634,6 +1664,7 @@ MmWaveVehicularSpectrumPropagationLossModel::UpdateChannel (Ptr<Params3gpp> para
                                   Ptr<MmWaveVehicularAntennaArrayModel> txAntenna, Ptr<MmWaveVehicularAntennaArrayModel> rxAntenna,
                                   uint16_t *txAntennaNum, uint16_t *rxAntennaNum, Angles &rxAngle, Angles &txAngle) const
 {
+  MILLICAR_PROFILE_SCOPE (UPDATE_CHANNEL);
   Ptr<Params3gpp> params = params3gpp;
   uint8_t raysPerCluster = table3gpp->m_raysPerCluster;
   //We first update the current location, the previous location will be updated in the end.
@@ -1672,10 +1703,12 @@ MmWaveVehicularSpectrumPropagationLossModel::UpdateChannel (Ptr<Params3gpp> para
   //Step 6: Generate cluster powers.
   doubleVector_t clusterPower;
   double powerSum = 0;
+  doubleVector_t normalRvs (params->m_numCluster);
+  m_normalRv->GetValues (normalRvs.data (), params->m_numCluster);
   for (uint8_t cIndex = 0; cIndex < params->m_numCluster; cIndex++)
     {
       double power = exp (-1 * clusterDelay.at (cIndex) * (table3gpp->m_rTau - 1) / table3gpp->m_rTau / DS) *
-        pow (10,-1 * m_normalRv->GetValue () * table3gpp->m_shadowingStd / 10);                       //(7.5-5)
+        pow (10,-1 * normalRvs.at (cIndex) * table3gpp->m_shadowingStd / 10);                       //(7.5-5)
       powerSum += power;
       clusterPower.push_back (power);
     }
@@ -1773,10 +1806,12 @@ MmWaveVehicularSpectrumPropagationLossModel::UpdateChannel (Ptr<Params3gpp> para
                 }
 
               //We can generate a new correlated normal RV with the following formula
-              params->m_norRvAngles.at (cInd).at (AOD_INDEX) = R_phi * params->m_norRvAngles.at (cInd).at (AOD_INDEX) + sqrt (1 - R_phi * R_phi) * m_normalRv->GetValue ();
-              params->m_norRvAngles.at (cInd).at (ZOD_INDEX) = R_theta * params->m_norRvAngles.at (cInd).at (ZOD_INDEX) + sqrt (1 - R_theta * R_theta) * m_normalRv->GetValue ();
-              params->m_norRvAngles.at (cInd).at (AOA_INDEX) = R_phi * params->m_norRvAngles.at (cInd).at (AOA_INDEX) + sqrt (1 - R_phi * R_phi) * m_normalRv->GetValue ();
-              params->m_norRvAngles.at (cInd).at (ZOA_INDEX) = R_theta * params->m_norRvAngles.at (cInd).at (ZOA_INDEX) + sqrt (1 - R_theta * R_theta) * m_normalRv->GetValue ();
+              double normalRv[4];
+              m_normalRv->GetValues (normalRv, 4);
+              params->m_norRvAngles.at (cInd).at (AOD_INDEX) = R_phi * params->m_norRvAngles.at (cInd).at (AOD_INDEX) + sqrt (1 - R_phi * R_phi) * normalRv[0];
+              params->m_norRvAngles.at (cInd).at (ZOD_INDEX) = R_theta * params->m_norRvAngles.at (cInd).at (ZOD_INDEX) + sqrt (1 - R_theta * R_theta) * normalRv[1];
+              params->m_norRvAngles.at (cInd).at (AOA_INDEX) = R_phi * params->m_norRvAngles.at (cInd).at (AOA_INDEX) + sqrt (1 - R_phi * R_phi) * normalRv[2];
+              params->m_norRvAngles.at (cInd).at (ZOA_INDEX) = R_theta * params->m_norRvAngles.at (cInd).at (ZOA_INDEX) + sqrt (1 - R_theta * R_theta) * normalRv[3];
 
               //The normal RV is transformed to uniform RV with the desired correlation.
               ranPhiAOD = (0.5 * erfc (-1 * params->m_norRvAngles.at (cInd).at (AOD_INDEX) / sqrt (2))) * 2 * M_PI - M_PI;
@@ -2052,16 +2087,42 @@ MmWaveVehicularSpectrumPropagationLossModel::UpdateChannel (Ptr<Params3gpp> para
           H_usn.at (uIndex).at (sIndex).resize (params->m_numCluster);
         }
     }
+  // the field pattern and the direction of the rays do not depend on the
+  // antenna elements, compute them once for all the pairs of elements
+  const std::vector<Vector>& rxLocations = rxAntenna->GetAntennaLocations ();
+  const std::vector<Vector>& txLocations = txAntenna->GetAntennaLocations ();
+  double2DVector_t rayPattern (params->m_numCluster, doubleVector_t (raysPerCluster));
+  std::vector< std::vector<Vector> > rxRayDirection (params->m_numCluster, std::vector<Vector> (raysPerCluster));
+  std::vector< std::vector<Vector> > txRayDirection (params->m_numCluster, std::vector<Vector> (raysPerCluster));
+  for (uint8_t nIndex = 0; nIndex < params->m_numCluster; nIndex++)
+    {
+      for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
+        {
+          rayPattern[nIndex][mIndex] = rxAntenna->GetRadiationPattern (rayZoa_radian[nIndex][mIndex],rayAoa_radian[nIndex][mIndex])
+            * txAntenna->GetRadiationPattern (rayZod_radian[nIndex][mIndex],rayAod_radian[nIndex][mIndex]);
+          rxRayDirection[nIndex][mIndex] = Vector (sin (rayZoa_radian[nIndex][mIndex]) * cos (rayAoa_radian[nIndex][mIndex]),
+                                                   sin (rayZoa_radian[nIndex][mIndex]) * sin (rayAoa_radian[nIndex][mIndex]),
+                                                   cos (rayZoa_radian[nIndex][mIndex]));
+          txRayDirection[nIndex][mIndex] = Vector (sin (rayZod_radian[nIndex][mIndex]) * cos (rayAod_radian[nIndex][mIndex]),
+                                                   sin (rayZod_radian[nIndex][mIndex]) * sin (rayAod_radian[nIndex][mIndex]),
+                                                   cos (rayZod_radian[nIndex][mIndex]));
+        }
+    }
+  double losPattern = rxAntenna->GetRadiationPattern (rxAngle.theta,rxAngle.phi)
+    * txAntenna->GetRadiationPattern (txAngle.theta,txAngle.phi);
+  Vector rxLosDirection (sin (rxAngle.theta) * cos (rxAngle.phi), sin (rxAngle.theta) * sin (rxAngle.phi), cos (rxAngle.theta));
+  Vector txLosDirection (sin (txAngle.theta) * cos (txAngle.phi), sin (txAngle.theta) * sin (txAngle.phi), cos (txAngle.theta));
+
   //double slotTime = Simulator::Now ().GetSeconds ();
   // The following for loops computes the channel coefficients
   for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
     {
-      Vector uLoc = rxAntenna->GetAntennaLocation (uIndex,rxAntennaNum);
+      const Vector& uLoc = rxLocations[uIndex];
 
       for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
         {
 
-          Vector sLoc = txAntenna->GetAntennaLocation (sIndex,txAntennaNum);
+          const Vector& sLoc = txLocations[sIndex];
 
           for (uint8_t nIndex = 0; nIndex < params->m_numCluster; nIndex++)
             {
@@ -2073,20 +2134,19 @@ MmWaveVehicularSpectrumPropagationLossModel::UpdateChannel (Ptr<Params3gpp> para
                     {
                       double initialPhase = clusterPhase.at (nIndex).at (mIndex);
                       //lambda_0 is accounted in the antenna spacing uLoc and sLoc.
-                      double rxPhaseDiff = 2 * M_PI * (sin (rayZoa_radian[nIndex][mIndex]) * cos (rayAoa_radian[nIndex][mIndex]) * uLoc.x
-                                                       + sin (rayZoa_radian[nIndex][mIndex]) * sin (rayAoa_radian[nIndex][mIndex]) * uLoc.y
-                                                       + cos (rayZoa_radian[nIndex][mIndex]) * uLoc.z);
+                      double rxPhaseDiff = 2 * M_PI * (rxRayDirection[nIndex][mIndex].x * uLoc.x
+                                                       + rxRayDirection[nIndex][mIndex].y * uLoc.y
+                                                       + rxRayDirection[nIndex][mIndex].z * uLoc.z);
 
-                      double txPhaseDiff = 2 * M_PI * (sin (rayZod_radian[nIndex][mIndex]) * cos (rayAod_radian[nIndex][mIndex]) * sLoc.x
-                                                       + sin (rayZod_radian[nIndex][mIndex]) * sin (rayAod_radian[nIndex][mIndex]) * sLoc.y
-                                                       + cos (rayZod_radian[nIndex][mIndex]) * sLoc.z);
+                      double txPhaseDiff = 2 * M_PI * (txRayDirection[nIndex][mIndex].x * sLoc.x
+                                                       + txRayDirection[nIndex][mIndex].y * sLoc.y
+                                                       + txRayDirection[nIndex][mIndex].z * sLoc.z);
                       //Doppler is computed in the CalBeamformingGain function and is simplified to only account for the center anngle of each cluster.
                       //double doppler = 2*M_PI*(sin(rayZoa_radian[nIndex][mIndex])*cos(rayAoa_radian[nIndex][mIndex])*relativeSpeed.x
                       //		+ sin(rayZoa_radian[nIndex][mIndex])*sin(rayAoa_radian[nIndex][mIndex])*relativeSpeed.y
                       //		+ cos(rayZoa_radian[nIndex][mIndex])*relativeSpeed.z)*slotTime*m_phyMacConfig->GetCenterFrequency ()/3e8;
                       rays += exp (std::complex<double> (0, initialPhase))
-                        * (rxAntenna->GetRadiationPattern (rayZoa_radian[nIndex][mIndex],rayAoa_radian[nIndex][mIndex])
-                           * txAntenna->GetRadiationPattern (rayZod_radian[nIndex][mIndex],rayAod_radian[nIndex][mIndex]))
+                        * rayPattern[nIndex][mIndex]
                         * exp (std::complex<double> (0, rxPhaseDiff))
                         * exp (std::complex<double> (0, txPhaseDiff));
                       //*exp(std::complex<double>(0, doppler));
@@ -2105,12 +2165,12 @@ MmWaveVehicularSpectrumPropagationLossModel::UpdateChannel (Ptr<Params3gpp> para
                   for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
                     {
                       double initialPhase = clusterPhase.at (nIndex).at (mIndex);
-                      double rxPhaseDiff = 2 * M_PI * (sin (rayZoa_radian[nIndex][mIndex]) * cos (rayAoa_radian[nIndex][mIndex]) * uLoc.x
-                                                       + sin (rayZoa_radian[nIndex][mIndex]) * sin (rayAoa_radian[nIndex][mIndex]) * uLoc.y
-                                                       + cos (rayZoa_radian[nIndex][mIndex]) * uLoc.z);
-                      double txPhaseDiff = 2 * M_PI * (sin (rayZod_radian[nIndex][mIndex]) * cos (rayAod_radian[nIndex][mIndex]) * sLoc.x
-                                                       + sin (rayZod_radian[nIndex][mIndex]) * sin (rayAod_radian[nIndex][mIndex]) * sLoc.y
-                                                       + cos (rayZod_radian[nIndex][mIndex]) * sLoc.z);
+                      double rxPhaseDiff = 2 * M_PI * (rxRayDirection[nIndex][mIndex].x * uLoc.x
+                                                       + rxRayDirection[nIndex][mIndex].y * uLoc.y
+                                                       + rxRayDirection[nIndex][mIndex].z * uLoc.z);
+                      double txPhaseDiff = 2 * M_PI * (txRayDirection[nIndex][mIndex].x * sLoc.x
+                                                       + txRayDirection[nIndex][mIndex].y * sLoc.y
+                                                       + txRayDirection[nIndex][mIndex].z * sLoc.z);
                       //double doppler = 2*M_PI*(sin(rayZoa_radian[nIndex][mIndex])*cos(rayAoa_radian[nIndex][mIndex])*relativeSpeed.x
                       //		+ sin(rayZoa_radian[nIndex][mIndex])*sin(rayAoa_radian[nIndex][mIndex])*relativeSpeed.y
                       //		+ cos(rayZoa_radian[nIndex][mIndex])*relativeSpeed.z)*slotTime*m_phyMacConfig->GetCenterFrequency ()/3e8;
@@ -2125,8 +2185,7 @@ MmWaveVehicularSpectrumPropagationLossModel::UpdateChannel (Ptr<Params3gpp> para
                         case 18:
                           //delaySpread= -2*M_PI*(clusterDelay.at(nIndex)+1.28*c_DS)*m_phyMacConfig->GetCenterFrequency ();
                           raysSub2 += exp (std::complex<double> (0, initialPhase))
-                            * (rxAntenna->GetRadiationPattern (rayZoa_radian[nIndex][mIndex],rayAoa_radian[nIndex][mIndex])
-                               * txAntenna->GetRadiationPattern (rayZod_radian[nIndex][mIndex],rayAod_radian[nIndex][mIndex]))
+                            * rayPattern[nIndex][mIndex]
                             * exp (std::complex<double> (0, rxPhaseDiff))
                             * exp (std::complex<double> (0, txPhaseDiff));
                           //*exp(std::complex<double>(0, doppler));
@@ -2138,8 +2197,7 @@ MmWaveVehicularSpectrumPropagationLossModel::UpdateChannel (Ptr<Params3gpp> para
                         case 16:
                           //delaySpread = -2*M_PI*(clusterDelay.at(nIndex)+2.56*c_DS)*m_phyMacConfig->GetCenterFrequency ();
                           raysSub3 += exp (std::complex<double> (0, initialPhase))
-                            * (rxAntenna->GetRadiationPattern (rayZoa_radian[nIndex][mIndex],rayAoa_radian[nIndex][mIndex])
-                               * txAntenna->GetRadiationPattern (rayZod_radian[nIndex][mIndex],rayAod_radian[nIndex][mIndex]))
+                            * rayPattern[nIndex][mIndex]
                             * exp (std::complex<double> (0, rxPhaseDiff))
                             * exp (std::complex<double> (0, txPhaseDiff));
                           //*exp(std::complex<double>(0, doppler));
@@ -2148,8 +2206,7 @@ MmWaveVehicularSpectrumPropagationLossModel::UpdateChannel (Ptr<Params3gpp> para
                         default:                        //case 1,2,3,4,5,6,7,8,19,20
                                                         //delaySpread = -2*M_PI*clusterDelay.at(nIndex)*m_phyMacConfig->GetCenterFrequency ();
                           raysSub1 += exp (std::complex<double> (0, initialPhase))
-                            * (rxAntenna->GetRadiationPattern (rayZoa_radian[nIndex][mIndex],rayAoa_radian[nIndex][mIndex])
-                               * txAntenna->GetRadiationPattern (rayZod_radian[nIndex][mIndex],rayAod_radian[nIndex][mIndex]))
+                            * rayPattern[nIndex][mIndex]
                             * exp (std::complex<double> (0, rxPhaseDiff))
                             * exp (std::complex<double> (0, txPhaseDiff));
                           //*exp(std::complex<double>(0, doppler));
@@ -2172,19 +2229,18 @@ MmWaveVehicularSpectrumPropagationLossModel::UpdateChannel (Ptr<Params3gpp> para
           if (params->m_condition == 'l')               //(7.5-29) && (7.5-30)
             {
               std::complex<double> ray (0,0);
-              double rxPhaseDiff = 2 * M_PI * (sin (rxAngle.theta) * cos (rxAngle.phi) * uLoc.x
-                                               + sin (rxAngle.theta) * sin (rxAngle.phi) * uLoc.y
-                                               + cos (rxAngle.theta) * uLoc.z);
-              double txPhaseDiff = 2 * M_PI * (sin (txAngle.theta) * cos (txAngle.phi) * sLoc.x
-                                               + sin (txAngle.theta) * sin (txAngle.phi) * sLoc.y
-                                               + cos (txAngle.theta) * sLoc.z);
+              double rxPhaseDiff = 2 * M_PI * (rxLosDirection.x * uLoc.x
+                                               + rxLosDirection.y * uLoc.y
+                                               + rxLosDirection.z * uLoc.z);
+              double txPhaseDiff = 2 * M_PI * (txLosDirection.x * sLoc.x
+                                               + txLosDirection.y * sLoc.y
+                                               + txLosDirection.z * sLoc.z);
               //double doppler = 2*M_PI*(sin(rxAngle.theta)*cos(rxAngle.phi)*relativeSpeed.x
               //		+ sin(rxAngle.theta)*sin(rxAngle.phi)*relativeSpeed.y
               //		+ cos(rxAngle.theta)*relativeSpeed.z)*slotTime*m_phyMacConfig->GetCenterFrequency ()/3e8;
 
               ray = exp (std::complex<double> (0, losPhase))
-                * (rxAntenna->GetRadiationPattern (rxAngle.theta,rxAngle.phi)
-                   * txAntenna->GetRadiationPattern (txAngle.theta,txAngle.phi))
+                * losPattern
                 * exp (std::complex<double> (0, rxPhaseDiff))
                 * exp (std::complex<double> (0, txPhaseDiff));
               //*exp(std::complex<double>(0, doppler));
@@ -22,7 +22,6 @@
 #ifndef RAIN_ATTENUATION_H_
 #define RAIN_ATTENUATION_H_
 
-#include "ns3/mmwave-vehicular-propagation-loss-model.h"
 #include "ns3/object.h"
 
 namespace ns3 {
@@ -20,14 +20,15 @@
  */
 
 #include "rain-snow-attenuation.h"
-#include <fstream>
 #include <math.h>
 #include <ns3/double.h>
 #include <ns3/log.h>
 #include <ns3/simulator.h>
 #include <ns3/uinteger.h>
-#include <stdio.h>
 #include <string>
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 
 NS_LOG_COMPONENT_DEFINE("RainSnowAttenuation");
@@ -38,6 +39,101 @@ namespace millicar {
 
 NS_OBJECT_ENSURE_REGISTERED(RainSnowAttenuation);
 
+/**
+ * Probability of each interval of 100 m of the rain height relative to the
+ * mean rain height, Table 1 of ITU-R P.530-15
+ */
+static const uint32_t kRainHeightIntervals = 49;
+static const double kRainHeightProb[kRainHeightIntervals] = {
+    0.000555, 0.000802, 0.001139, 0.001594, 0.002196, 0.002978, 0.003976,
+    0.005227, 0.006764, 0.008617, 0.010808, 0.013346, 0.016225, 0.019419,
+    0.022881, 0.026542, 0.030312, 0.034081, 0.037724, 0.041110, 0.044104,
+    0.046583, 0.048439, 0.049588, 0.049977, 0.049588, 0.048439, 0.046583,
+    0.044104, 0.041110, 0.037724, 0.034081, 0.030312, 0.026542, 0.022881,
+    0.019419, 0.016225, 0.013346, 0.010808, 0.008617, 0.006764, 0.005227,
+    0.003976, 0.002978, 0.002196, 0.001594, 0.001139, 0.000802, 0.000555};
+
+/**
+ * The multiplying factor depends only on the link height relative to the
+ * mean rain height, hence it is computed once, in steps of kSnowFactorStep
+ * meters between kSnowFactorMin, below which the link is not affected by
+ * the wet snow, and kSnowFactorMax, above which the factor is zero.
+ */
+static const double kSnowFactorStep = 1;
+static const double kSnowFactorMin = -3600;
+static const double kSnowFactorMax = 2500;
+
+/**
+ * Computes the multiplying factor for a link height relative to the rain
+ * height, Eq. (38) of ITU-R P.530-15
+ */
+static double AttenuationMultiplier(double deltaHeight) {
+  double attenMultiplier = 0;
+  if (deltaHeight > 0) {
+    attenMultiplier = 0;
+  } else if ((-1200 <= deltaHeight) && (deltaHeight <= 0)) {
+    double denom = 0;
+    double nom = 0;
+
+    denom = 1 + pow(1 - exp(-(pow(deltaHeight / 600, 2))), 2) *
+                    (4 * pow(1 - exp(deltaHeight / 70), 2) - 1);
+    nom = 4 * pow(1 - exp(deltaHeight / 70), 2);
+    attenMultiplier = nom / denom;
+  } else {
+    attenMultiplier = 1;
+  }
+  return attenMultiplier;
+}
+
+/**
+ * Computes the multiplying factor of a link whose height relative to the
+ * mean rain height is relativeHeight
+ */
+static double ComputeSnowAttenFactor(double relativeHeight) {
+  double multFactor = 0;
+
+  /**
+   * The table of the probabilities given in Table 1 of ITU-R P.530-15
+   * (see rainHeight_prob.txt) is embedded in kRainHeightProb.
+   * The rain height variability is modeled by taking 49
+   * intervals of 100 m relative to the mean rain height.
+   * The file based implementation read the last line of the table twice,
+   * thus an additional interval with the last probability is considered
+   * to keep the results unchanged.
+   *
+   */
+  for (uint32_t i = 0; i <= kRainHeightIntervals; i++) {
+    uint32_t probIdx = std::min(i, kRainHeightIntervals - 1);
+
+    // Calculate the link height relative to the rain height of the interval
+    double deltaHeight = relativeHeight + 2400 - 100 * i;
+
+    // Add the multiplying factor of the interval
+    multFactor += AttenuationMultiplier(deltaHeight) * kRainHeightProb[probIdx];
+  }
+
+  return multFactor;
+}
+
+/**
+ * Computes the multiplying factors of the relative link heights between
+ * kSnowFactorMin and kSnowFactorMax, together with their limits from
+ * below, since the multiplier of Eq. (38) jumps at -1200 m, i.e., the
+ * factor jumps at multiples of 100 m
+ */
+static std::vector<std::pair<double, double>> ComputeSnowAttenFactorTable(void) {
+  uint32_t size = (kSnowFactorMax - kSnowFactorMin) / kSnowFactorStep + 1;
+  std::vector<std::pair<double, double>> table;
+  table.reserve(size);
+  for (uint32_t i = 0; i < size; i++) {
+    double relativeHeight = kSnowFactorMin + i * kSnowFactorStep;
+    double below = relativeHeight - 1e-6; // a micrometer below
+    table.push_back(std::make_pair(ComputeSnowAttenFactor(relativeHeight),
+                                   ComputeSnowAttenFactor(below)));
+  }
+  return table;
+}
+
 TypeId RainSnowAttenuation::GetTypeId(void) {
   static TypeId tid =
       TypeId("ns3::RainSnowAttenuation")
@@ -53,7 +149,10 @@ TypeId RainSnowAttenuation::GetTypeId(void) {
               MakeDoubleChecker<double>());
   return tid;
 }
-RainSnowAttenuation::RainSnowAttenuation() { NS_LOG_FUNCTION(this); }
+RainSnowAttenuation::RainSnowAttenuation()
+    : m_rainAttenuation(CreateObject<RainAttenuation>()) {
+  NS_LOG_FUNCTION(this);
+}
 RainSnowAttenuation::~RainSnowAttenuation() { NS_LOG_FUNCTION(this); }
 
 /**
@@ -89,21 +188,7 @@ double RainSnowAttenuation::getRainHeight(double hTx, double hRx,
 }
 
 double RainSnowAttenuation::getAttenuationMultiplier(double deltaHeight) {
-  double attenMultiplier = 0;
-  if (deltaHeight > 0) {
-    attenMultiplier = 0;
-  } else if ((-1200 <= deltaHeight) && (deltaHeight <= 0)) {
-    double denom = 0;
-    double nom = 0;
-
-    denom = 1 + pow(1 - exp(-(pow(deltaHeight / 600, 2))), 2) *
-                    (4 * pow(1 - exp(deltaHeight / 70), 2) - 1);
-    nom = 4 * pow(1 - exp(deltaHeight / 70), 2);
-    attenMultiplier = nom / denom;
-  } else {
-    attenMultiplier = 1;
-  }
-  return attenMultiplier;
+  return AttenuationMultiplier(deltaHeight);
 }
 
 /**
@@ -118,51 +203,16 @@ double RainSnowAttenuation::getAttenuationMultiplier(double deltaHeight) {
 
 double RainSnowAttenuation::getSnowAttenFactor(double meanRainHeight,
                                                double linkHeight) {
-  double x, y;
-  int i;
-  double prob[49];
-  double multFactor = 0;
-
-  /**
-   * First, load the table of the propabilities given in
-   * Table 1 of ITU-R P.530-15.
-   * The rain height variability is modeled by taking 49
-   * intervals of 100 m relative to the mean rain height.
-   *
-   */
-
-  std::ifstream rainHeightProb;
-  rainHeightProb.open("src/millicar/model/rainHeight_prob.txt");
-  if (!rainHeightProb) {
-    printf("\n Unable to open the file");
-    exit(1);
+  // interpolate the tabulated factors, instead of integrating over the
+  // rain height intervals for each link
+  static const std::vector<std::pair<double, double>> table = ComputeSnowAttenFactorTable();
+  double position = (linkHeight - meanRainHeight - kSnowFactorMin) / kSnowFactorStep;
+  if (position < 0 || position >= table.size() - 1) {
+    return ComputeSnowAttenFactor(linkHeight - meanRainHeight);
   }
-  i = 0;
-  while (!rainHeightProb.eof()) {
-    rainHeightProb >> x >> y;
-    prob[i] = y;
-
-    // Do the following calculation for each interval
-    // Calculate the rain height -> rainHeight
-    double rainHeight = meanRainHeight - 2400 + 100 * i;
-
-    // Calculate the link height relative to the rain height
-    double deltaHeight = linkHeight - rainHeight;
-
-    // Calculate the addition to the multiplying factor
-    double attenuationMultiplyingFact = getAttenuationMultiplier(deltaHeight);
-
-    // Compute the multipying factor for each interval
-    double deltaF = attenuationMultiplyingFact * prob[i];
-
-    // Add the multiplying factor for each interval
-    multFactor = multFactor + deltaF;
-    i++;
-  }
-
-  rainHeightProb.close();
-
-  return multFactor;
+  uint32_t idx = floor(position);
+  double frac = position - idx;
+  return table[idx].first + frac * (table[idx + 1].second - table[idx].first);
 }
 /**
  * Computes the attenuation from combined rain and wet snow
@@ -183,14 +233,13 @@ double RainSnowAttenuation::getSnowAttenuation(double distance,
   double linkHeight = getRainHeight(hTx, hRx, distance);
   double meanRainHeight = getMeanAnnualRainHeight();
 
-  Ptr<RainAttenuation> rainAtten = CreateObject<RainAttenuation>();
-  double rainAttenuation = rainAtten->getRainAttenuation(distance, frequency);
+  double rainAttenuation = m_rainAttenuation->getRainAttenuation(distance, frequency);
 
   if (linkHeight <= (meanRainHeight - 3600)) {
-    printf("The location is not affected by the wet snow.");
+    NS_LOG_DEBUG("The location is not affected by the wet snow.");
     attenSnow = rainAttenuation;
   } else {
-    printf("The location it is affected by the wet snow.");
+    NS_LOG_DEBUG("The location is affected by the wet snow.");
     double attenFactor = getSnowAttenFactor(meanRainHeight, linkHeight);
     attenSnow = rainAttenuation * attenFactor;
   }
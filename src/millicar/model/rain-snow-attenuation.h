@@ -22,7 +22,6 @@
 #ifndef RAIN_SNOW_ATTENUATION_H_
 #define RAIN_SNOW_ATTENUATION_H_
 
-#include "ns3/mmwave-vehicular-propagation-loss-model.h"
 #include "ns3/object.h"
 #include "ns3/rain-attenuation.h"
 
@@ -48,7 +47,9 @@ public:
   double getRainHeight(double hTx, double hRx, double distance);
 
   /**
-   * Computes the attenuation factor
+   * Computes the attenuation factor, interpolating the factors which are
+   * tabulated at the first use, since they depend only on the link height
+   * relative to the mean rain height
    */
   double getSnowAttenFactor(double meanRainHeight, double linkHeight);
 
@@ -68,6 +69,7 @@ public:
 private:
   double m_altitude; // altitude in meters above the sea level 
   double m_h0;       // mean annual 0C isotherm height above mean sea level
+  Ptr<RainAttenuation> m_rainAttenuation; // rain attenuation of the link
 };
 
 } // namespace millicar
@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "ns3/mmwave-sidelink-mac.h"
+#include "ns3/log.h"
+#include "ns3/test.h"
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveSidelinkCqiHistoryTestSuite");
+
+using namespace ns3;
+using namespace millicar;
+
+/**
+ * This is a test to check the aggregation of the CQI history used by the
+ * MmWaveSidelinkMac for the link adaptation, and the expiry of the old
+ * reports
+ */
+class MmWaveSidelinkCqiHistoryTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  MmWaveSidelinkCqiHistoryTestCase ();
+
+  /**
+   * Destructor
+   */
+  virtual ~MmWaveSidelinkCqiHistoryTestCase ();
+
+private:
+  /**
+   * This method run the test
+   */
+  virtual void DoRun (void);
+};
+
+MmWaveSidelinkCqiHistoryTestCase::MmWaveSidelinkCqiHistoryTestCase ()
+  : TestCase ("Check the Last, Ewma and Min aggregations and the expiry of the CQI history")
+{
+}
+
+MmWaveSidelinkCqiHistoryTestCase::~MmWaveSidelinkCqiHistoryTestCase ()
+{
+}
+
+void
+MmWaveSidelinkCqiHistoryTestCase::DoRun (void)
+{
+  SlCqiHistory history (3);
+  NS_TEST_ASSERT_MSG_EQ (history.GetSize (), 0u, "The history is not empty");
+
+  history.Add (12, MilliSeconds (1));
+  history.Add (4, MilliSeconds (2));
+  history.Add (9, MilliSeconds (3));
+  NS_TEST_ASSERT_MSG_EQ (history.GetSize (), 3u, "Unexpected number of reports");
+  NS_TEST_ASSERT_MSG_EQ (history.GetLast (), 9, "Unexpected last CQI");
+  NS_TEST_ASSERT_MSG_EQ (history.GetMin (), 4, "Unexpected minimum CQI");
+  // 12, then 0.5 * 4 + 0.5 * 12 = 8, then 0.5 * 9 + 0.5 * 8 = 8.5
+  NS_TEST_ASSERT_MSG_EQ (history.GetEwma (0.5), 8, "Unexpected EWMA of the CQI");
+  NS_TEST_ASSERT_MSG_EQ (history.GetEwma (1.0), 9, "The EWMA with unit weight is not the last CQI");
+
+  // the newest report overwrites the oldest one
+  history.Add (15, MilliSeconds (4));
+  NS_TEST_ASSERT_MSG_EQ (history.GetSize (), 3u, "The history grew beyond its size");
+  NS_TEST_ASSERT_MSG_EQ (history.Get (0).cqi, 4, "The oldest report was not overwritten");
+  NS_TEST_ASSERT_MSG_EQ (history.GetLast (), 15, "Unexpected last CQI");
+  NS_TEST_ASSERT_MSG_EQ (history.GetMin (), 4, "Unexpected minimum CQI");
+  // 4, then 0.5 * 9 + 0.5 * 4 = 6.5, then 0.5 * 15 + 0.5 * 6.5 = 10.75
+  NS_TEST_ASSERT_MSG_EQ (history.GetEwma (0.5), 10, "Unexpected EWMA of the CQI");
+
+  // the MAC discards the reports older than CqiMaxAge before the aggregation
+  history.RemoveOlderThan (MilliSeconds (3));
+  NS_TEST_ASSERT_MSG_EQ (history.GetSize (), 2u, "The old reports were not discarded");
+  NS_TEST_ASSERT_MSG_EQ (history.Get (0).cqi, 9, "Unexpected oldest report");
+  NS_TEST_ASSERT_MSG_EQ (history.GetMin (), 9, "The minimum includes a discarded report");
+
+  history.RemoveOlderThan (MilliSeconds (5));
+  NS_TEST_ASSERT_MSG_EQ (history.GetSize (), 0u, "The expired reports were not discarded");
+
+  // the history is used again after the expiry of all the reports
+  history.Add (7, MilliSeconds (6));
+  NS_TEST_ASSERT_MSG_EQ (history.GetSize (), 1u, "Unexpected number of reports");
+  NS_TEST_ASSERT_MSG_EQ (history.GetLast (), 7, "Unexpected last CQI");
+  NS_TEST_ASSERT_MSG_EQ (history.GetMin (), 7, "Unexpected minimum CQI");
+  NS_TEST_ASSERT_MSG_EQ (history.GetEwma (0.5), 7, "Unexpected EWMA of the CQI");
+}
+
+/**
+ * Test suite for the CQI history of the MmWaveSidelinkMac
+ */
+class MmWaveSidelinkCqiHistoryTestSuite : public TestSuite
+{
+public:
+  MmWaveSidelinkCqiHistoryTestSuite ();
+};
+
+MmWaveSidelinkCqiHistoryTestSuite::MmWaveSidelinkCqiHistoryTestSuite ()
+  : TestSuite ("mmwave-sidelink-cqi-history", UNIT)
+{
+  AddTestCase (new MmWaveSidelinkCqiHistoryTestCase (), TestCase::QUICK);
+}
+
+static MmWaveSidelinkCqiHistoryTestSuite mmwaveSidelinkCqiHistoryTestSuite;
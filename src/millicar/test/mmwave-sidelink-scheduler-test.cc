@@ -0,0 +1,200 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "ns3/mmwave-sidelink-rr-scheduler.h"
+#include "ns3/mmwave-sidelink-pf-scheduler.h"
+#include "ns3/mmwave-sidelink-edf-scheduler.h"
+#include "ns3/mmwave-phy-mac-common.h"
+#include "ns3/mmwave-amc.h"
+#include "ns3/log.h"
+#include "ns3/test.h"
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveSidelinkSchedulerTestSuite");
+
+using namespace ns3;
+using namespace mmwave;
+using namespace millicar;
+
+/**
+ * This is a test to check the order in which the sidelink schedulers serve
+ * the logical channels, using synthetic scheduling requests
+ */
+class MmWaveSidelinkSchedulerTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  MmWaveSidelinkSchedulerTestCase ();
+
+  /**
+   * Destructor
+   */
+  virtual ~MmWaveSidelinkSchedulerTestCase ();
+
+private:
+  /**
+   * This method run the test
+   */
+  virtual void DoRun (void);
+
+  /**
+   * Create a scheduling request
+   * \param lcid the logical channel ID
+   * \param bufferSize the number of bytes waiting for transmission
+   * \param holDelay the head of line delay
+   * \param delayBudget the packet delay budget of the bearer
+   * \return the request
+   */
+  static SlSchedulingRequest CreateRequest (uint8_t lcid, uint32_t bufferSize, Time holDelay, Time delayBudget);
+
+  /**
+   * Get the LCIDs of the grants
+   * \param grants the grants
+   * \return the LCIDs, in the order of the grants
+   */
+  static std::vector<uint8_t> GetLcids (const std::vector<SlGrant>& grants);
+
+  /**
+   * Check the order of the grants
+   * \param grants the grants
+   * \param expected the expected LCIDs, in the order of the grants
+   * \param scheduler the name of the scheduler
+   */
+  void CheckOrder (const std::vector<SlGrant>& grants, const std::vector<uint8_t>& expected, std::string scheduler);
+};
+
+MmWaveSidelinkSchedulerTestCase::MmWaveSidelinkSchedulerTestCase ()
+  : TestCase ("Check the order of the grants of the RR, PF and EDF sidelink schedulers")
+{
+}
+
+MmWaveSidelinkSchedulerTestCase::~MmWaveSidelinkSchedulerTestCase ()
+{
+}
+
+SlSchedulingRequest
+MmWaveSidelinkSchedulerTestCase::CreateRequest (uint8_t lcid, uint32_t bufferSize, Time holDelay, Time delayBudget)
+{
+  SlSchedulingRequest request;
+  request.lcid = lcid;
+  request.rnti = lcid;
+  request.mcs = 20;
+  request.bufferSize = bufferSize;
+  request.holDelay = holDelay;
+  request.delayBudget = delayBudget;
+  return request;
+}
+
+std::vector<uint8_t>
+MmWaveSidelinkSchedulerTestCase::GetLcids (const std::vector<SlGrant>& grants)
+{
+  std::vector<uint8_t> lcids;
+  for (auto it = grants.begin (); it != grants.end (); it++)
+  {
+    lcids.push_back (it->lcid);
+  }
+  return lcids;
+}
+
+void
+MmWaveSidelinkSchedulerTestCase::CheckOrder (const std::vector<SlGrant>& grants, const std::vector<uint8_t>& expected, std::string scheduler)
+{
+  std::vector<uint8_t> lcids = GetLcids (grants);
+  NS_TEST_ASSERT_MSG_EQ (lcids.size (), expected.size (), "Unexpected number of grants of the " << scheduler << " scheduler");
+  for (uint32_t i = 0; i < expected.size (); i++)
+  {
+    NS_TEST_ASSERT_MSG_EQ (uint16_t (lcids [i]), uint16_t (expected [i]), "Unexpected grant " << i << " of the " << scheduler << " scheduler");
+  }
+}
+
+void
+MmWaveSidelinkSchedulerTestCase::DoRun (void)
+{
+  Ptr<MmWavePhyMacCommon> phyMacConfig = CreateObject<MmWavePhyMacCommon> ();
+  Ptr<MmWaveAmc> amc = CreateObject<MmWaveAmc> (phyMacConfig);
+  uint32_t availableSymbols = phyMacConfig->GetSymbPerSlot ();
+  NS_TEST_ASSERT_MSG_GT (amc->GetTbSizeFromMcsSymbols (20, 1), 0, "A TB does not fit in a symbol");
+
+  // RR: with a symbol per slot for two logical channels at most, each slot
+  // starts from the logical channel following the last served one
+  {
+    Ptr<MmWaveSidelinkRrScheduler> rr = CreateObject<MmWaveSidelinkRrScheduler> ();
+    rr->SetAmc (amc);
+    std::vector<SlSchedulingRequest> requests;
+    requests.push_back (CreateRequest (1, 100000, Seconds (0), MilliSeconds (50)));
+    requests.push_back (CreateRequest (2, 100000, Seconds (0), MilliSeconds (50)));
+    requests.push_back (CreateRequest (3, 100000, Seconds (0), MilliSeconds (50)));
+
+    CheckOrder (rr->ScheduleSlot (requests, 2), {1, 2}, "RR");
+    CheckOrder (rr->ScheduleSlot (requests, 2), {3, 1}, "RR");
+    CheckOrder (rr->ScheduleSlot (requests, 2), {2, 3}, "RR");
+  }
+
+  // PF: the new logical channels have the same metric and are served by
+  // LCID, then the ones with the lowest average throughput come first
+  {
+    Ptr<MmWaveSidelinkPfScheduler> pf = CreateObject<MmWaveSidelinkPfScheduler> ();
+    pf->SetAmc (amc);
+    std::vector<SlSchedulingRequest> requests;
+    requests.push_back (CreateRequest (1, 100, Seconds (0), MilliSeconds (50)));
+    requests.push_back (CreateRequest (2, 300, Seconds (0), MilliSeconds (50)));
+    requests.push_back (CreateRequest (3, 200, Seconds (0), MilliSeconds (50)));
+
+    CheckOrder (pf->ScheduleSlot (requests, availableSymbols), {1, 2, 3}, "PF");
+    CheckOrder (pf->ScheduleSlot (requests, availableSymbols), {1, 3, 2}, "PF");
+
+    // a removed logical channel is new again when its LCID is reused
+    pf->RemoveLogicalChannel (2);
+    CheckOrder (pf->ScheduleSlot (requests, availableSymbols), {2, 1, 3}, "PF");
+  }
+
+  // EDF: the logical channels are served by increasing time to the deadline,
+  // i.e., delay budget minus head of line delay, rather than by head of line
+  // delay, and the ties are broken by LCID
+  {
+    Ptr<MmWaveSidelinkEdfScheduler> edf = CreateObject<MmWaveSidelinkEdfScheduler> ();
+    edf->SetAmc (amc);
+    std::vector<SlSchedulingRequest> requests;
+    requests.push_back (CreateRequest (1, 100, MilliSeconds (10), MilliSeconds (50)));
+    requests.push_back (CreateRequest (2, 100, MilliSeconds (100), MilliSeconds (300)));
+    requests.push_back (CreateRequest (3, 100, MilliSeconds (30), MilliSeconds (100)));
+    requests.push_back (CreateRequest (4, 100, MilliSeconds (30), MilliSeconds (100)));
+
+    CheckOrder (edf->ScheduleSlot (requests, availableSymbols), {1, 3, 4, 2}, "EDF");
+
+    // the input order does not matter
+    std::vector<SlSchedulingRequest> reversed (requests.rbegin (), requests.rend ());
+    CheckOrder (edf->ScheduleSlot (reversed, availableSymbols), {1, 3, 4, 2}, "EDF");
+  }
+}
+
+/**
+ * Test suite for the sidelink schedulers
+ */
+class MmWaveSidelinkSchedulerTestSuite : public TestSuite
+{
+public:
+  MmWaveSidelinkSchedulerTestSuite ();
+};
+
+MmWaveSidelinkSchedulerTestSuite::MmWaveSidelinkSchedulerTestSuite ()
+  : TestSuite ("mmwave-sidelink-scheduler", UNIT)
+{
+  AddTestCase (new MmWaveSidelinkSchedulerTestCase (), TestCase::QUICK);
+}
+
+static MmWaveSidelinkSchedulerTestSuite mmwaveSidelinkSchedulerTestSuite;
@@ -0,0 +1,258 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "ns3/mmwave-sidelink-spectrum-channel.h"
+#include "ns3/antenna-model.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/spectrum-signal-parameters.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "ns3/test.h"
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveSidelinkSpectrumChannelTestSuite");
+
+using namespace ns3;
+using namespace millicar;
+
+/**
+ * A SpectrumPhy which records the context of the receptions
+ */
+class ContextRecordingSpectrumPhy : public SpectrumPhy
+{
+public:
+  ContextRecordingSpectrumPhy ();
+
+  // inherited from SpectrumPhy
+  virtual void SetDevice (Ptr<NetDevice> d);
+  virtual Ptr<NetDevice> GetDevice () const;
+  virtual void SetMobility (Ptr<MobilityModel> m);
+  virtual Ptr<MobilityModel> GetMobility ();
+  virtual void SetChannel (Ptr<SpectrumChannel> c);
+  virtual Ptr<const SpectrumModel> GetRxSpectrumModel () const;
+  virtual Ptr<AntennaModel> GetRxAntenna ();
+  virtual void StartRx (Ptr<SpectrumSignalParameters> params);
+
+  /**
+   * Records the context of an event scheduled by StartRx
+   */
+  void ScheduledByRx ();
+
+  uint32_t m_rxContext; //!< the context of the last reception
+  Time m_rxTime; //!< the time of the last reception
+  uint32_t m_scheduledContext; //!< the context of the last event scheduled by StartRx
+
+private:
+  Ptr<NetDevice> m_device; //!< the device
+  Ptr<MobilityModel> m_mobility; //!< the mobility model
+};
+
+ContextRecordingSpectrumPhy::ContextRecordingSpectrumPhy ()
+  : m_rxContext (Simulator::NO_CONTEXT),
+    m_scheduledContext (Simulator::NO_CONTEXT)
+{
+}
+
+void
+ContextRecordingSpectrumPhy::SetDevice (Ptr<NetDevice> d)
+{
+  m_device = d;
+}
+
+Ptr<NetDevice>
+ContextRecordingSpectrumPhy::GetDevice () const
+{
+  return m_device;
+}
+
+void
+ContextRecordingSpectrumPhy::SetMobility (Ptr<MobilityModel> m)
+{
+  m_mobility = m;
+}
+
+Ptr<MobilityModel>
+ContextRecordingSpectrumPhy::GetMobility ()
+{
+  return m_mobility;
+}
+
+void
+ContextRecordingSpectrumPhy::SetChannel (Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+ContextRecordingSpectrumPhy::GetRxSpectrumModel () const
+{
+  return 0;
+}
+
+Ptr<AntennaModel>
+ContextRecordingSpectrumPhy::GetRxAntenna ()
+{
+  return 0;
+}
+
+void
+ContextRecordingSpectrumPhy::StartRx (Ptr<SpectrumSignalParameters> params)
+{
+  m_rxContext = Simulator::GetContext ();
+  m_rxTime = Simulator::Now ();
+  Simulator::Schedule (NanoSeconds (1), &ContextRecordingSpectrumPhy::ScheduledByRx, this);
+}
+
+void
+ContextRecordingSpectrumPhy::ScheduledByRx ()
+{
+  m_scheduledContext = Simulator::GetContext ();
+}
+
+/**
+ * This is a test to check that the MmWaveSidelinkSpectrumChannel calls each
+ * receiver in the context of its node, and that a single event delivers a
+ * transmission to all the receivers of a node with the same propagation
+ * delay.
+ */
+class MmWaveSidelinkSpectrumChannelContextTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param delay true to use a propagation delay model
+   */
+  MmWaveSidelinkSpectrumChannelContextTestCase (bool delay);
+
+  /**
+   * Destructor
+   */
+  virtual ~MmWaveSidelinkSpectrumChannelContextTestCase ();
+
+private:
+  /**
+   * This method run the test
+   */
+  virtual void DoRun (void);
+
+  bool m_delay; //!< true to use a propagation delay model
+};
+
+MmWaveSidelinkSpectrumChannelContextTestCase::MmWaveSidelinkSpectrumChannelContextTestCase (bool delay)
+  : TestCase (std::string ("Check the context of the receivers ") + (delay ? "with" : "without") + " propagation delay"),
+    m_delay (delay)
+{
+}
+
+MmWaveSidelinkSpectrumChannelContextTestCase::~MmWaveSidelinkSpectrumChannelContextTestCase ()
+{
+}
+
+void
+MmWaveSidelinkSpectrumChannelContextTestCase::DoRun (void)
+{
+  // the transmitter is the first node, the second and the third nodes are at
+  // the same distance from it, and the second node has two receivers
+  double positions[] = { 0, 30, -30, 60 };
+  uint32_t numNodes = sizeof (positions) / sizeof (positions[0]);
+
+  Ptr<MmWaveSidelinkSpectrumChannel> channel = CreateObject<MmWaveSidelinkSpectrumChannel> ();
+  if (m_delay)
+    {
+      channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+    }
+
+  std::vector<Ptr<ContextRecordingSpectrumPhy> > phys;
+  for (uint32_t i = 0; i < numNodes; i++)
+    {
+      Ptr<Node> node = CreateObject<Node> ();
+      Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+      node->AddDevice (device);
+      Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (positions[i], 0.0, 0.0));
+      Ptr<ContextRecordingSpectrumPhy> phy = CreateObject<ContextRecordingSpectrumPhy> ();
+      phy->SetDevice (device);
+      phy->SetMobility (mobility);
+      channel->AddRx (phy);
+      phys.push_back (phy);
+    }
+  Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+  phys[1]->GetDevice ()->GetNode ()->AddDevice (device);
+  Ptr<ContextRecordingSpectrumPhy> phy = CreateObject<ContextRecordingSpectrumPhy> ();
+  phy->SetDevice (device);
+  phy->SetMobility (phys[1]->GetMobility ());
+  channel->AddRx (phy);
+  phys.push_back (phy);
+
+  std::vector<double> centerFreqs;
+  centerFreqs.push_back (60e9);
+  centerFreqs.push_back (60e9 + 1e6);
+  Ptr<SpectrumModel> model = Create<SpectrumModel> (centerFreqs);
+  Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters> ();
+  params->psd = Create<SpectrumValue> (model);
+  (*params->psd) = 1;
+  params->duration = MicroSeconds (10);
+  params->txPhy = phys[0];
+
+  // run the initialization of the nodes first
+  Simulator::Run ();
+  uint64_t initEvents = Simulator::GetEventCount ();
+
+  uint32_t txContext = phys[0]->GetDevice ()->GetNode ()->GetId ();
+  Simulator::ScheduleWithContext (txContext, MicroSeconds (1), &MmWaveSidelinkSpectrumChannel::StartTx, channel, params);
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (phys[0]->m_rxContext, Simulator::NO_CONTEXT, "The transmitter received its own signal");
+  for (uint32_t i = 1; i < phys.size (); i++)
+    {
+      uint32_t context = phys[i]->GetDevice ()->GetNode ()->GetId ();
+      NS_TEST_ASSERT_MSG_EQ (phys[i]->m_rxContext, context, "Receiver " << i << " not called in the context of its node");
+      NS_TEST_ASSERT_MSG_EQ (phys[i]->m_scheduledContext, context, "Event of receiver " << i << " not scheduled in the context of its node");
+    }
+  NS_TEST_ASSERT_MSG_EQ (phys[1]->m_rxTime, phys[2]->m_rxTime, "Receivers at the same distance not reached at the same time");
+  NS_TEST_ASSERT_MSG_EQ (phys[1]->m_rxTime, phys[numNodes]->m_rxTime, "Receivers of the same node not reached at the same time");
+  if (m_delay)
+    {
+      NS_TEST_ASSERT_MSG_GT (phys[3]->m_rxTime, phys[1]->m_rxTime, "The farthest receiver not reached last");
+    }
+
+  // the transmission, one reception per receiving node and one event
+  // scheduled by each receiver
+  uint64_t receivers = phys.size () - 1;
+  NS_TEST_ASSERT_MSG_EQ (Simulator::GetEventCount () - initEvents, 1 + (numNodes - 1) + receivers, "Unexpected number of events");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * Test suite for the class MmWaveSidelinkSpectrumChannel
+ */
+class MmWaveSidelinkSpectrumChannelTestSuite : public TestSuite
+{
+public:
+  MmWaveSidelinkSpectrumChannelTestSuite ();
+};
+
+MmWaveSidelinkSpectrumChannelTestSuite::MmWaveSidelinkSpectrumChannelTestSuite ()
+  : TestSuite ("mmwave-sidelink-spectrum-channel", UNIT)
+{
+  AddTestCase (new MmWaveSidelinkSpectrumChannelContextTestCase (false), TestCase::QUICK);
+  AddTestCase (new MmWaveSidelinkSpectrumChannelContextTestCase (true), TestCase::QUICK);
+}
+
+static MmWaveSidelinkSpectrumChannelTestSuite mmwaveSidelinkSpectrumChannelTestSuite;
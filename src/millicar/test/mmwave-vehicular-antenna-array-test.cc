@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering,
+*   SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "ns3/mmwave-vehicular-antenna-array-model.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/string.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/test.h"
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveVehicularAntennaArrayTestSuite");
+
+using namespace ns3;
+using namespace millicar;
+
+/**
+ * This is a test to check that the tabulated field pattern of the antenna
+ * elements is within the declared error of the exact one, for all the
+ * available element patterns and device types.
+ */
+class MmWaveVehicularAntennaPatternTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param pattern the antenna element pattern
+   * \param isUe the device type
+   */
+  MmWaveVehicularAntennaPatternTestCase (std::string pattern, bool isUe);
+
+  /**
+   * Destructor
+   */
+  virtual ~MmWaveVehicularAntennaPatternTestCase ();
+
+private:
+  /**
+   * This method run the test
+   */
+  virtual void DoRun (void);
+
+  std::string m_pattern; //!< the antenna element pattern
+  bool m_isUe; //!< the device type
+};
+
+MmWaveVehicularAntennaPatternTestCase::MmWaveVehicularAntennaPatternTestCase (std::string pattern, bool isUe)
+  : TestCase ("Check the tabulated field pattern of the " + pattern + " antenna element"),
+    m_pattern (pattern),
+    m_isUe (isUe)
+{
+}
+
+MmWaveVehicularAntennaPatternTestCase::~MmWaveVehicularAntennaPatternTestCase ()
+{
+}
+
+void
+MmWaveVehicularAntennaPatternTestCase::DoRun (void)
+{
+  Ptr<MmWaveVehicularAntennaArrayModel> antenna = CreateObject<MmWaveVehicularAntennaArrayModel> ();
+  antenna->SetAttribute ("IsotropicAntennaElements", BooleanValue (false));
+  antenna->SetAttribute ("AntennaElementPattern", StringValue (m_pattern));
+  antenna->SetDeviceType (m_isUe);
+
+  Ptr<UniformRandomVariable> vAngle = CreateObject<UniformRandomVariable> ();
+  vAngle->SetAttribute ("Min", DoubleValue (0));
+  vAngle->SetAttribute ("Max", DoubleValue (M_PI));
+  Ptr<UniformRandomVariable> hAngle = CreateObject<UniformRandomVariable> ();
+  hAngle->SetAttribute ("Min", DoubleValue (-M_PI));
+  hAngle->SetAttribute ("Max", DoubleValue (M_PI));
+
+  double maxError = MmWaveVehicularAntennaArrayModel::GetRadiationPatternMaxError ();
+  for (uint32_t i = 0; i < 10000; i++)
+    {
+      double v = vAngle->GetValue ();
+      double h = hAngle->GetValue ();
+      double exact = antenna->ComputeRadiationPattern (v, h);
+      double tabulated = antenna->GetRadiationPattern (v, h);
+      NS_TEST_ASSERT_MSG_EQ_TOL (tabulated, exact, exact * maxError,
+                                 "Tabulated field pattern out of tolerance for angles " << v << " " << h);
+    }
+
+  // the table is computed again when the element pattern changes: the
+  // back lobe is attenuated by the front-back ratio of the new pattern
+  std::string other = (m_pattern == "3GPP-V2V") ? "3GPP-MmWave" : "3GPP-V2V";
+  double frontBackRatio = (other == "3GPP-V2V") ? 25 : 30;
+  antenna->SetAttribute ("AntennaElementPattern", StringValue (other));
+  double front = antenna->GetRadiationPattern (M_PI / 2, 0);
+  double back = antenna->GetRadiationPattern (M_PI / 2, M_PI);
+  NS_TEST_ASSERT_MSG_EQ_TOL (back / front, std::pow (10, -frontBackRatio / 20), 1e-9,
+                             "Field pattern not updated with the element pattern");
+}
+
+/**
+ * This is a test to check the location of the elements of square and
+ * rectangular antenna arrays.
+ */
+class MmWaveVehicularAntennaLocationTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param elements the total number of antenna elements
+   * \param columns the number of elements in each row, 0 for a square array
+   * \param expectedColumns the expected number of columns
+   */
+  MmWaveVehicularAntennaLocationTestCase (uint64_t elements, uint16_t columns, uint16_t expectedColumns);
+
+  /**
+   * Destructor
+   */
+  virtual ~MmWaveVehicularAntennaLocationTestCase ();
+
+private:
+  /**
+   * This method run the test
+   */
+  virtual void DoRun (void);
+
+  uint64_t m_elements; //!< the total number of antenna elements
+  uint16_t m_columns; //!< the number of columns set as attribute
+  uint16_t m_expectedColumns; //!< the expected number of columns
+};
+
+MmWaveVehicularAntennaLocationTestCase::MmWaveVehicularAntennaLocationTestCase (uint64_t elements, uint16_t columns, uint16_t expectedColumns)
+  : TestCase ("Check the locations of an array of " + std::to_string (elements) + " elements in " + std::to_string (expectedColumns) + " columns"),
+    m_elements (elements),
+    m_columns (columns),
+    m_expectedColumns (expectedColumns)
+{
+}
+
+MmWaveVehicularAntennaLocationTestCase::~MmWaveVehicularAntennaLocationTestCase ()
+{
+}
+
+void
+MmWaveVehicularAntennaLocationTestCase::DoRun (void)
+{
+  double disH = 0.5;
+  double disV = 0.7;
+  Ptr<MmWaveVehicularAntennaArrayModel> antenna = CreateObject<MmWaveVehicularAntennaArrayModel> ();
+  antenna->SetAttribute ("AntennaElements", UintegerValue (m_elements));
+  antenna->SetAttribute ("AntennaColumns", UintegerValue (m_columns));
+  antenna->SetAttribute ("AntennaHorizontalSpacing", DoubleValue (disH));
+  antenna->SetAttribute ("AntennaVerticalSpacing", DoubleValue (disV));
+
+  uint16_t expectedRows = m_elements / m_expectedColumns;
+  NS_TEST_ASSERT_MSG_EQ (antenna->GetAntennaColumns (), m_expectedColumns, "Unexpected number of columns");
+  NS_TEST_ASSERT_MSG_EQ (antenna->GetAntennaRows (), expectedRows, "Unexpected number of rows");
+
+  const std::vector<Vector>& locations = antenna->GetAntennaLocations ();
+  NS_TEST_ASSERT_MSG_EQ (locations.size (), m_elements, "Unexpected number of locations");
+  for (uint64_t ind = 0; ind < m_elements; ind++)
+    {
+      // the elements are numbered row by row, starting from the bottom left corner
+      NS_TEST_ASSERT_MSG_EQ_TOL (locations[ind].x, 0.0, 1e-9, "Element " << ind << " is not on the y-z plane");
+      NS_TEST_ASSERT_MSG_EQ_TOL (locations[ind].y, disH * (ind % m_expectedColumns), 1e-9, "Wrong horizontal position of element " << ind);
+      NS_TEST_ASSERT_MSG_EQ_TOL (locations[ind].z, disV * (ind / m_expectedColumns), 1e-9, "Wrong vertical position of element " << ind);
+    }
+
+  // the locations are computed again when the geometry changes
+  antenna->SetAttribute ("AntennaHorizontalSpacing", DoubleValue (2 * disH));
+  const std::vector<Vector>& updated = antenna->GetAntennaLocations ();
+  NS_TEST_ASSERT_MSG_EQ_TOL (updated[m_expectedColumns - 1].y, 2 * disH * (m_expectedColumns - 1), 1e-9, "Locations not updated with the spacing");
+}
+
+class MmWaveVehicularAntennaArrayTestSuite : public TestSuite
+{
+public:
+  MmWaveVehicularAntennaArrayTestSuite ();
+};
+
+MmWaveVehicularAntennaArrayTestSuite::MmWaveVehicularAntennaArrayTestSuite ()
+  : TestSuite ("mmwave-vehicular-antenna-array", UNIT)
+{
+  AddTestCase (new MmWaveVehicularAntennaPatternTestCase ("3GPP-MmWave", true), TestCase::QUICK);
+  AddTestCase (new MmWaveVehicularAntennaPatternTestCase ("3GPP-MmWave", false), TestCase::QUICK);
+  AddTestCase (new MmWaveVehicularAntennaPatternTestCase ("3GPP-V2V", true), TestCase::QUICK);
+  AddTestCase (new MmWaveVehicularAntennaLocationTestCase (16, 0, 4), TestCase::QUICK);
+  AddTestCase (new MmWaveVehicularAntennaLocationTestCase (8, 4, 4), TestCase::QUICK);
+  AddTestCase (new MmWaveVehicularAntennaLocationTestCase (12, 2, 2), TestCase::QUICK);
+}
+
+static MmWaveVehicularAntennaArrayTestSuite mmwaveVehicularAntennaArrayTestSuite;
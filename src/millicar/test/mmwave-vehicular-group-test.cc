@@ -0,0 +1,208 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "ns3/mmwave-vehicular-net-device.h"
+#include "ns3/mmwave-vehicular-helper.h"
+#include "ns3/mobility-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/core-module.h"
+#include "ns3/test.h"
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveVehicularGroupTestSuite");
+
+using namespace ns3;
+using namespace mmwave;
+using namespace millicar;
+
+/**
+ * This is a test to check the lazy activation of the bearers among the
+ * devices of a group, the removal of a device from its group and the
+ * deactivation of the bearers, and that the packets are delivered only
+ * between the devices of a group
+ */
+class MmWaveVehicularGroupTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  MmWaveVehicularGroupTestCase ();
+
+  /**
+   * Destructor
+   */
+  virtual ~MmWaveVehicularGroupTestCase ();
+
+private:
+  /**
+   * This method run the test
+   */
+  virtual void DoRun (void);
+
+  /**
+   * Send a packet between two nodes
+   * \param from the sender
+   * \param to the receiver
+   * \param start the delay after which the packet is sent
+   */
+  void SendPacket (Ptr<Node> from, Ptr<Node> to, Time start);
+
+  /**
+   * Check the bearers between two devices
+   * \param a the first device
+   * \param b the second device
+   * \param active true if the bearers have to be active on both the devices
+   * \param msg the message in case of failure
+   */
+  void CheckBearers (Ptr<MmWaveVehicularNetDevice> a, Ptr<MmWaveVehicularNetDevice> b, bool active, std::string msg);
+};
+
+MmWaveVehicularGroupTestCase::MmWaveVehicularGroupTestCase ()
+  : TestCase ("Check the lazy bearer activation, the removal from a group and the bearer deactivation")
+{
+}
+
+MmWaveVehicularGroupTestCase::~MmWaveVehicularGroupTestCase ()
+{
+}
+
+void
+MmWaveVehicularGroupTestCase::SendPacket (Ptr<Node> from, Ptr<Node> to, Time start)
+{
+  UdpClientHelper client (to->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal (), 4000);
+  client.SetAttribute ("MaxPackets", UintegerValue (1));
+  client.SetAttribute ("PacketSize", UintegerValue (100));
+  ApplicationContainer apps = client.Install (from);
+  apps.Start (start);
+}
+
+void
+MmWaveVehicularGroupTestCase::CheckBearers (Ptr<MmWaveVehicularNetDevice> a, Ptr<MmWaveVehicularNetDevice> b, bool active, std::string msg)
+{
+  NS_TEST_ASSERT_MSG_EQ (a->HasBearer (b->GetMac ()->GetRnti ()), active, msg);
+  NS_TEST_ASSERT_MSG_EQ (b->HasBearer (a->GetMac ()->GetRnti ()), active, msg);
+}
+
+void
+MmWaveVehicularGroupTestCase::DoRun (void)
+{
+  NodeContainer n;
+  n.Create (3);
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (10.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (20.0, 0.0, 0.0));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (n);
+
+  Ptr<MmWaveVehicularHelper> helper = CreateObject<MmWaveVehicularHelper> ();
+  helper->SetNumerology (3);
+  helper->SetAttribute ("LazyBearerActivation", BooleanValue (true));
+  NetDeviceContainer devs = helper->InstallMmWaveVehicularNetDevices (n);
+
+  InternetStackHelper internet;
+  internet.Install (n);
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  ipv4.Assign (devs);
+
+  Ptr<MmWaveVehicularNetDevice> d0 = DynamicCast<MmWaveVehicularNetDevice> (devs.Get (0));
+  Ptr<MmWaveVehicularNetDevice> d1 = DynamicCast<MmWaveVehicularNetDevice> (devs.Get (1));
+  Ptr<MmWaveVehicularNetDevice> d2 = DynamicCast<MmWaveVehicularNetDevice> (devs.Get (2));
+
+  uint32_t groupId = helper->PairDevices (devs);
+  CheckBearers (d0, d1, false, "Bearer activated before the first packet");
+  CheckBearers (d0, d2, false, "Bearer activated before the first packet");
+  CheckBearers (d1, d2, false, "Bearer activated before the first packet");
+
+  UdpServerHelper server (4000);
+  ApplicationContainer servers = server.Install (n);
+  servers.Start (MilliSeconds (0));
+  Ptr<UdpServer> server0 = DynamicCast<UdpServer> (servers.Get (0));
+  Ptr<UdpServer> server1 = DynamicCast<UdpServer> (servers.Get (1));
+
+  // the first packet activates the bearers between its endpoints only
+  SendPacket (n.Get (0), n.Get (1), MilliSeconds (10));
+  Simulator::Stop (MilliSeconds (50));
+  Simulator::Run ();
+  CheckBearers (d0, d1, true, "Bearer not activated by the first packet");
+  CheckBearers (d0, d2, false, "Bearer activated without packets");
+  CheckBearers (d1, d2, false, "Bearer activated without packets");
+  NS_TEST_ASSERT_MSG_EQ (server1->GetReceived (), 1, "Packet not delivered after the lazy activation");
+
+  // the removal deactivates the bearers of the device, and the packets
+  // towards it are not delivered anymore
+  helper->RemoveDeviceFromGroup (d1);
+  CheckBearers (d0, d1, false, "Bearer active after the removal from the group");
+  SendPacket (n.Get (0), n.Get (1), MilliSeconds (10));
+  Simulator::Stop (MilliSeconds (50));
+  Simulator::Run ();
+  CheckBearers (d0, d1, false, "Bearer activated towards a removed device");
+  NS_TEST_ASSERT_MSG_EQ (server1->GetReceived (), 1, "Packet delivered after the removal from the group");
+
+  // a device removed from a group is not in any group, hence it can join
+  // the group again and its bearers are activated on demand as before
+  helper->AddDeviceToGroup (groupId, d1);
+  CheckBearers (d0, d1, false, "Bearer activated when joining the group");
+  SendPacket (n.Get (1), n.Get (0), MilliSeconds (10));
+  Simulator::Stop (MilliSeconds (50));
+  Simulator::Run ();
+  CheckBearers (d0, d1, true, "Bearer not activated after joining the group again");
+  NS_TEST_ASSERT_MSG_EQ (server0->GetReceived (), 1, "Packet not delivered after joining the group again");
+  NS_TEST_ASSERT_MSG_EQ (server1->GetReceived (), 1, "Packet of the previous membership delivered");
+
+  // the deactivation releases the bearer and its LCID on the device, and a
+  // new bearer can be activated with the same LCID
+  uint8_t lcid = 10;
+  Ipv4Address d2Addr = n.Get (2)->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal ();
+  d0->ActivateBearer (lcid, d2->GetMac ()->GetRnti (), d2Addr);
+  NS_TEST_ASSERT_MSG_EQ (d0->HasBearer (d2->GetMac ()->GetRnti ()), true, "Bearer not activated");
+  NS_TEST_ASSERT_MSG_EQ (d0->IsLcidAvailable (lcid), false, "LCID available with an active bearer");
+  d0->DeactivateBearer (d2->GetMac ()->GetRnti ());
+  NS_TEST_ASSERT_MSG_EQ (d0->HasBearer (d2->GetMac ()->GetRnti ()), false, "Bearer not deactivated");
+  NS_TEST_ASSERT_MSG_EQ (d0->IsLcidAvailable (lcid), true, "LCID not released by the deactivation");
+  NS_TEST_ASSERT_MSG_EQ (d0->HasBearer (d1->GetMac ()->GetRnti ()), true, "Deactivation of another bearer");
+  d0->ActivateBearer (lcid, d2->GetMac ()->GetRnti (), d2Addr);
+  NS_TEST_ASSERT_MSG_EQ (d0->HasBearer (d2->GetMac ()->GetRnti ()), true, "Bearer not activated again");
+
+  // the deactivation of a missing bearer has no effect
+  d0->DeactivateBearer (d2->GetMac ()->GetRnti ());
+  d0->DeactivateBearer (d2->GetMac ()->GetRnti ());
+  NS_TEST_ASSERT_MSG_EQ (d0->HasBearer (d1->GetMac ()->GetRnti ()), true, "Deactivation of another bearer");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * Test suite for the groups of devices of the MmWaveVehicularHelper
+ */
+class MmWaveVehicularGroupTestSuite : public TestSuite
+{
+public:
+  MmWaveVehicularGroupTestSuite ();
+};
+
+MmWaveVehicularGroupTestSuite::MmWaveVehicularGroupTestSuite ()
+  : TestSuite ("mmwave-vehicular-group", UNIT)
+{
+  AddTestCase (new MmWaveVehicularGroupTestCase (), TestCase::QUICK);
+}
+
+static MmWaveVehicularGroupTestSuite mmwaveVehicularGroupTestSuite;
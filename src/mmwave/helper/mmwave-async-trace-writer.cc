@@ -0,0 +1,214 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+*   Copyright (c) 2020 University of Padova, Dep. of Information Engineering, SIGNET lab.
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License version 2 as
+*   published by the Free Software Foundation;
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "mmwave-async-trace-writer.h"
+#include <ns3/core-config.h>
+#include <ns3/log.h>
+#include <ns3/boolean.h>
+#include <ns3/enum.h>
+#include <ns3/uinteger.h>
+#include <ns3/simulator.h>
+#ifdef HAVE_PTHREAD_H
+#include <ns3/system-thread.h>
+#endif
+#include <chrono>
+#include <set>
+#include <thread>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MmWaveAsyncTraceWriter");
+
+namespace mmwave {
+
+NS_OBJECT_ENSURE_REGISTERED (MmWaveAsyncTraceWriter);
+
+MmWaveAsyncTraceWriter::MmWaveAsyncTraceWriter ()
+  : m_async (false),
+    m_policy (BLOCK),
+    m_ringSize (0),
+    m_head (0),
+    m_tail (0),
+    m_stop (false),
+    m_dropped (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MmWaveAsyncTraceWriter::~MmWaveAsyncTraceWriter ()
+{
+  NS_LOG_FUNCTION (this);
+  Drain ();
+}
+
+TypeId
+MmWaveAsyncTraceWriter::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MmWaveAsyncTraceWriter")
+    .SetParent<Object> ()
+    .AddConstructor<MmWaveAsyncTraceWriter> ()
+    .AddAttribute ("Async",
+                   "If true, the trace records are formatted and written by a background thread",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MmWaveAsyncTraceWriter::m_async),
+                   MakeBooleanChecker ())
+    .AddAttribute ("BackPressure",
+                   "The policy applied when the ring of the records waiting to be written is full",
+                   EnumValue (BLOCK),
+                   MakeEnumAccessor (&MmWaveAsyncTraceWriter::m_policy),
+                   MakeEnumChecker (BLOCK, "Block",
+                                    DROP, "Drop"))
+    .AddAttribute ("RingSize",
+                   "The maximum number of records waiting to be written",
+                   UintegerValue (65536),
+                   MakeUintegerAccessor (&MmWaveAsyncTraceWriter::m_ringSize),
+                   MakeUintegerChecker<uint32_t> (1))
+  ;
+  return tid;
+}
+
+Ptr<MmWaveAsyncTraceWriter>
+MmWaveAsyncTraceWriter::Get ()
+{
+  static Ptr<MmWaveAsyncTraceWriter> writer = CreateObject<MmWaveAsyncTraceWriter> ();
+  return writer;
+}
+
+void
+MmWaveAsyncTraceWriter::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  Drain ();
+  Object::DoDispose ();
+}
+
+bool
+MmWaveAsyncTraceWriter::IsAsync () const
+{
+#ifdef HAVE_PTHREAD_H
+  return m_async;
+#else
+  return false;
+#endif
+}
+
+uint64_t
+MmWaveAsyncTraceWriter::GetDroppedRecords () const
+{
+  return m_dropped;
+}
+
+MmWaveAsyncTraceWriter::Slot*
+MmWaveAsyncTraceWriter::Reserve ()
+{
+#ifdef HAVE_PTHREAD_H
+  if (m_thread == 0)
+    {
+      NS_LOG_LOGIC ("Start the background thread");
+      if (m_ring.size () != m_ringSize)
+        {
+          m_ring.resize (m_ringSize);
+          m_head.store (0, std::memory_order_relaxed);
+          m_tail.store (0, std::memory_order_relaxed);
+        }
+      m_stop.store (false, std::memory_order_relaxed);
+      m_thread = Create<SystemThread> (MakeCallback (&MmWaveAsyncTraceWriter::Run, this));
+      m_thread->Start ();
+      // all the records must be written when the simulation ends
+      Simulator::ScheduleDestroy (&MmWaveAsyncTraceWriter::Drain, Ptr<MmWaveAsyncTraceWriter> (this));
+    }
+
+  uint64_t head = m_head.load (std::memory_order_relaxed);
+  while (head - m_tail.load (std::memory_order_acquire) >= m_ring.size ())
+    {
+      if (m_policy == DROP)
+        {
+          m_dropped++;
+          return 0;
+        }
+      std::this_thread::yield ();
+    }
+  return &m_ring[head % m_ring.size ()];
+#else
+  NS_FATAL_ERROR ("Asynchronous traces require thread support");
+  return 0;
+#endif
+}
+
+void
+MmWaveAsyncTraceWriter::Commit ()
+{
+  m_head.store (m_head.load (std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void
+MmWaveAsyncTraceWriter::Run ()
+{
+  std::set<std::ostream*> streams;
+  while (true)
+    {
+      uint64_t tail = m_tail.load (std::memory_order_relaxed);
+      if (tail == m_head.load (std::memory_order_acquire))
+        {
+          if (m_stop.load (std::memory_order_acquire))
+            {
+              // the records queued before the stop request are visible now
+              if (tail == m_head.load (std::memory_order_acquire))
+                {
+                  break;
+                }
+              continue;
+            }
+          std::this_thread::sleep_for (std::chrono::microseconds (100));
+          continue;
+        }
+
+      Slot& slot = m_ring[tail % m_ring.size ()];
+      slot.m_format (*slot.m_stream, slot.m_data);
+      streams.insert (slot.m_stream);
+      m_tail.store (tail + 1, std::memory_order_release);
+    }
+
+  for (std::set<std::ostream*>::iterator it = streams.begin (); it != streams.end (); ++it)
+    {
+      (*it)->flush ();
+    }
+}
+
+void
+MmWaveAsyncTraceWriter::Drain ()
+{
+#ifdef HAVE_PTHREAD_H
+  if (m_thread == 0)
+    {
+      return;
+    }
+  NS_LOG_FUNCTION (this);
+  m_stop.store (true, std::memory_order_release);
+  m_thread->Join ();
+  m_thread = 0;
+  if (m_dropped > 0)
+    {
+      NS_LOG_WARN (m_dropped << " trace records were dropped because the ring was full");
+    }
+#endif
+}
+
+} // namespace mmwave
+
+} // namespace ns3
@@ -31,6 +31,7 @@
 
 
 #include "mmwave-bearer-stats-calculator.h"
+#include "mmwave-async-trace-writer.h"
 #include "ns3/string.h"
 #include "ns3/nstime.h"
 #include <ns3/log.h>
@@ -45,6 +46,62 @@ namespace mmwave {
 
 NS_OBJECT_ENSURE_REGISTERED ( MmWaveBearerStatsCalculator);
 
+namespace {
+
+/// a line of the trace of the transmitted and received PDUs
+struct PduRecord
+{
+  bool m_rx; //!< true if the PDU was received, false if it was transmitted
+  double m_time; //!< the time in seconds
+  uint16_t m_cellId; //!< the cell ID
+  uint16_t m_rnti; //!< the RNTI
+  uint8_t m_lcid; //!< the LCID
+  uint32_t m_packetSize; //!< the size of the PDU
+  uint64_t m_delay; //!< the delay of the received PDU
+
+  /**
+   * Writes the line
+   * \param os the output stream
+   * \param record the record
+   */
+  static void Format (std::ostream& os, const PduRecord& record)
+  {
+    os << (record.m_rx ? "Rx " : "Tx ") << record.m_time << " " << record.m_cellId << " "
+       << record.m_rnti << " " << (uint32_t) record.m_lcid << " " << record.m_packetSize << " ";
+    if (record.m_rx)
+      {
+        os << record.m_delay;
+      }
+    os << "\n";
+  }
+};
+
+/**
+ * Writes a line of the trace of the transmitted and received PDUs
+ * \param os the output stream
+ * \param rx true if the PDU was received, false if it was transmitted
+ * \param cellId the cell ID
+ * \param rnti the RNTI
+ * \param lcid the LCID
+ * \param packetSize the size of the PDU
+ * \param delay the delay of the received PDU
+ */
+void
+WritePduRecord (std::ostream& os, bool rx, uint16_t cellId, uint16_t rnti, uint8_t lcid, uint32_t packetSize, uint64_t delay)
+{
+  PduRecord record;
+  record.m_rx = rx;
+  record.m_time = Simulator::Now ().GetNanoSeconds () / 1.0e9;
+  record.m_cellId = cellId;
+  record.m_rnti = rnti;
+  record.m_lcid = lcid;
+  record.m_packetSize = packetSize;
+  record.m_delay = delay;
+  MmWaveAsyncTraceWriter::Get ()->Write (os, record);
+}
+
+} // anonymous namespace
+
 MmWaveBearerStatsCalculator::MmWaveBearerStatsCalculator ()
   : m_firstWrite (true),
     m_pendingOutput (false),
@@ -64,6 +121,8 @@ MmWaveBearerStatsCalculator::MmWaveBearerStatsCalculator (std::string protocolTy
 MmWaveBearerStatsCalculator::~MmWaveBearerStatsCalculator ()
 {
   NS_LOG_FUNCTION (this);
+  // the output files are closed with this object
+  MmWaveAsyncTraceWriter::Get ()->Drain ();
 }
 
 TypeId
@@ -162,8 +221,7 @@ MmWaveBearerStatsCalculator::UlTxPdu (uint16_t cellId, uint64_t imsi, uint16_t r
   //    m_ulOutFile << "P ";
   // }
 
-  m_ulOutFile << "Tx " << Simulator::Now ().GetNanoSeconds () / 1.0e9 << " " << cellId << " "
-              << rnti << " " << (uint32_t) lcid << " " << packetSize << " " << std::endl;
+  WritePduRecord (m_ulOutFile, false, cellId, rnti, lcid, packetSize, 0);
 
   /*ImsiLcidPair_t p (imsi, lcid);
   if (Simulator::Now () >= m_startTime)
@@ -195,8 +253,7 @@ MmWaveBearerStatsCalculator::DlTxPdu (uint16_t cellId, uint64_t imsi, uint16_t r
   //    m_dlOutFile << "P ";
   // }
 
-  m_dlOutFile << "Tx " << Simulator::Now ().GetNanoSeconds () / 1.0e9 << " " << cellId << " "
-              << rnti << " " << (uint32_t) lcid << " " << packetSize << " " << std::endl;
+  WritePduRecord (m_dlOutFile, false, cellId, rnti, lcid, packetSize, 0);
 
 
   /*ImsiLcidPair_t p (imsi, lcid);
@@ -230,8 +287,7 @@ MmWaveBearerStatsCalculator::UlRxPdu (uint16_t cellId, uint64_t imsi, uint16_t r
   //    m_ulOutFile << "P ";
   // }
 
-  m_ulOutFile << "Rx " << Simulator::Now ().GetNanoSeconds () / 1.0e9 << " " << cellId << " "
-              << rnti << " " << (uint32_t) lcid << " " << packetSize << " " << delay << std::endl;
+  WritePduRecord (m_ulOutFile, true, cellId, rnti, lcid, packetSize, delay);
 
   /*ImsiLcidPair_t p (imsi, lcid);
   if (Simulator::Now () >= m_startTime)
@@ -272,8 +328,7 @@ MmWaveBearerStatsCalculator::DlRxPdu (uint16_t cellId, uint64_t imsi, uint16_t r
   //    m_dlOutFile << "P ";
   // }
 
-  m_dlOutFile << "Rx " << Simulator::Now ().GetNanoSeconds () / 1.0e9 << " " << cellId << " "
-              << rnti << " " << (uint32_t) lcid << " " << packetSize << " " << delay << std::endl;
+  WritePduRecord (m_dlOutFile, true, cellId, rnti, lcid, packetSize, delay);
 
   /* ImsiLcidPair_t p (imsi, lcid);
    if (Simulator::Now () >= m_startTime)
@@ -35,6 +35,7 @@
 
 #include <ns3/log.h>
 #include "mmwave-phy-trace.h"
+#include "mmwave-async-trace-writer.h"
 #include <ns3/simulator.h>
 #include <stdio.h>
 
@@ -46,6 +47,57 @@ namespace mmwave {
 
 NS_OBJECT_ENSURE_REGISTERED (MmWavePhyTrace);
 
+namespace {
+
+/// a line of the UL or DL PHY transmission trace
+struct PhyTransmissionRecord
+{
+  PhyTransmissionTraceParams m_params; //!< the traced transmission
+
+  /**
+   * Writes the line
+   * \param os the output stream
+   * \param record the record
+   */
+  static void Format (std::ostream& os, const PhyTransmissionRecord& record)
+  {
+    const PhyTransmissionTraceParams& param = record.m_params;
+    os << +param.m_frameNum << "\t" << +param.m_sfNum << "\t"
+       << +param.m_slotNum << "\t" << +param.m_rnti << "\t"
+       << +param.m_symStart << "\t" << +param.m_numSym << "\t"
+       << +param.m_ttiType << "\t" << +param.m_tddMode << "\t"
+       << +param.m_rv << "\t" << +param.m_ccId << "\n";
+  }
+};
+
+/// a line of the RX packet trace
+struct RxPacketRecord
+{
+  bool m_ul; //!< true if the packet was received by the eNB
+  double m_time; //!< the reception time in seconds
+  RxPacketTraceParams m_params; //!< the traced reception
+
+  /**
+   * Writes the line
+   * \param os the output stream
+   * \param record the record
+   */
+  static void Format (std::ostream& os, const RxPacketRecord& record)
+  {
+    const RxPacketTraceParams& params = record.m_params;
+    os << (record.m_ul ? "UL\t" : "DL\t") << record.m_time << "\t"
+       << params.m_frameNum << "\t" << +params.m_sfNum << "\t"
+       << +params.m_slotNum << "\t" << +params.m_symStart << "\t"
+       << +params.m_numSym << "\t" << params.m_cellId << "\t"
+       << params.m_rnti << "\t" << +params.m_ccId << "\t"
+       << params.m_tbSize << "\t" << +params.m_mcs << "\t"
+       << +params.m_rv << "\t" << 10 * std::log10 (params.m_sinr) << (record.m_ul ? " \t" : "\t")
+       << params.m_corrupt << "\t" << params.m_tbler << "\n";
+  }
+};
+
+} // anonymous namespace
+
 std::ofstream MmWavePhyTrace::m_rxPacketTraceFile;
 std::string MmWavePhyTrace::m_rxPacketTraceFilename;
 
@@ -61,6 +113,7 @@ MmWavePhyTrace::MmWavePhyTrace ()
 
 MmWavePhyTrace::~MmWavePhyTrace ()
 {
+  MmWaveAsyncTraceWriter::Get ()->Drain ();
   if (m_rxPacketTraceFile.is_open ())
     {
       m_rxPacketTraceFile.close ();
@@ -202,11 +255,9 @@ MmWavePhyTrace::ReportUlPhyTransmissionCallback (Ptr<MmWavePhyTrace> phyStats, P
     }
 
   // Trace the UL PHY transmission info
-  m_ulPhyTraceFile << +param.m_frameNum << "\t" << +param.m_sfNum << "\t"
-                   << +param.m_slotNum << "\t" << +param.m_rnti << "\t" 
-                   << +param.m_symStart << "\t" << +param.m_numSym << "\t" 
-                   << +param.m_ttiType << "\t" << +param.m_tddMode << "\t" 
-                   << +param.m_rv << "\t" << +param.m_ccId << std::endl;
+  PhyTransmissionRecord record;
+  record.m_params = param;
+  MmWaveAsyncTraceWriter::Get ()->Write (m_ulPhyTraceFile, record);
 }
 
 void 
@@ -223,11 +274,9 @@ MmWavePhyTrace::ReportDlPhyTransmissionCallback (Ptr<MmWavePhyTrace> phyStats, P
     }
 
   // Trace the DL PHY transmission info
-  m_dlPhyTraceFile << +param.m_frameNum << "\t" << +param.m_sfNum << "\t"
-                   << +param.m_slotNum << "\t" << +param.m_rnti << "\t" 
-                   << +param.m_symStart << "\t" << +param.m_numSym << "\t" 
-                   << +param.m_ttiType << "\t" << +param.m_tddMode << "\t" 
-                   << +param.m_rv << "\t" << +param.m_ccId << std::endl;
+  PhyTransmissionRecord record;
+  record.m_params = param;
+  MmWaveAsyncTraceWriter::Get ()->Write (m_dlPhyTraceFile, record);
 }
 
 void
@@ -242,14 +291,11 @@ MmWavePhyTrace::RxPacketTraceUeCallback (Ptr<MmWavePhyTrace> phyStats, std::stri
           NS_FATAL_ERROR ("Could not open tracefile");
         }
     }
-  m_rxPacketTraceFile << "DL\t" << Simulator::Now ().GetSeconds () << "\t" 
-                      << params.m_frameNum << "\t" << +params.m_sfNum << "\t" 
-                      << +params.m_slotNum << "\t" << +params.m_symStart << "\t" 
-                      << +params.m_numSym << "\t" << params.m_cellId << "\t" 
-                      << params.m_rnti << "\t" << +params.m_ccId << "\t" 
-                      << params.m_tbSize << "\t" << +params.m_mcs << "\t" 
-                      << +params.m_rv << "\t" << 10 * std::log10 (params.m_sinr) << "\t" 
-                      << params.m_corrupt << "\t" <<  params.m_tbler << std::endl;
+  RxPacketRecord record;
+  record.m_ul = false;
+  record.m_time = Simulator::Now ().GetSeconds ();
+  record.m_params = params;
+  MmWaveAsyncTraceWriter::Get ()->Write (m_rxPacketTraceFile, record);
 
   if (params.m_corrupt)
     {
@@ -274,14 +320,11 @@ MmWavePhyTrace::RxPacketTraceEnbCallback (Ptr<MmWavePhyTrace> phyStats, std::str
           NS_FATAL_ERROR ("Could not open tracefile");
         }
     }
-  m_rxPacketTraceFile << "UL\t" << Simulator::Now ().GetSeconds () << "\t" 
-                      << params.m_frameNum << "\t" << +params.m_sfNum << "\t" 
-                      << +params.m_slotNum << "\t" << +params.m_symStart << "\t" 
-                      << +params.m_numSym << "\t" << params.m_cellId << "\t" 
-                      << params.m_rnti << "\t" << +params.m_ccId << "\t" 
-                      << params.m_tbSize << "\t" << +params.m_mcs << "\t" 
-                      << +params.m_rv << "\t" << 10 * std::log10 (params.m_sinr) << " \t" 
-                      << params.m_corrupt << "\t" << params.m_tbler << std::endl;
+  RxPacketRecord record;
+  record.m_ul = true;
+  record.m_time = Simulator::Now ().GetSeconds ();
+  record.m_params = params;
+  MmWaveAsyncTraceWriter::Get ()->Write (m_rxPacketTraceFile, record);
 
   if (params.m_corrupt)
     {
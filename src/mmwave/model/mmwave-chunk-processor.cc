@@ -59,7 +59,11 @@ void
 mmWaveChunkProcessor::Start ()
 {
   NS_LOG_FUNCTION (this);
-  m_sumValues = 0;
+  if (m_sumValues)
+    {
+      // reuse the buffer of the previous reception
+      (*m_sumValues) = 0.0;
+    }
   m_totDuration = MicroSeconds (0);
 }
 
@@ -68,11 +72,17 @@ void
 mmWaveChunkProcessor::EvaluateChunk (const SpectrumValue& sinr, Time duration)
 {
   NS_LOG_FUNCTION (this << sinr << duration);
-  if (m_sumValues == 0)
+  if (m_sumValues == 0 || m_sumValues->GetSpectrumModel () != sinr.GetSpectrumModel ())
     {
       m_sumValues = Create<SpectrumValue> (sinr.GetSpectrumModel ());
     }
-  (*m_sumValues) += sinr * duration.GetSeconds ();
+  // accumulate sinr * duration in place, without temporary SpectrumValues
+  double seconds = duration.GetSeconds ();
+  Values::iterator sumIt = m_sumValues->ValuesBegin ();
+  for (Values::const_iterator it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); ++it, ++sumIt)
+    {
+      (*sumIt) += (*it) * seconds;
+    }
   m_totDuration += duration;
 }
 
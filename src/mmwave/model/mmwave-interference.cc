@@ -64,6 +64,8 @@ mmWaveInterference::DoDispose ()
   m_rxSignal = 0;
   m_allSignals = 0;
   m_noise = 0;
+  m_sinr = 0;
+  m_activeSignals = std::priority_queue<ActiveSignal, std::vector<ActiveSignal>, ActiveSignalCompare> ();
   Object::DoDispose ();
 }
 
@@ -82,10 +84,19 @@ void
 mmWaveInterference::StartRx (Ptr<const SpectrumValue> rxPsd)
 {
   NS_LOG_FUNCTION (this << *rxPsd);
+  RetireExpiredSignals ();
   if (m_receiving == false)
     {
       NS_LOG_LOGIC ("first signal");
-      m_rxSignal = rxPsd->Copy ();
+      if (m_rxSignal && m_rxSignal->GetSpectrumModel () == rxPsd->GetSpectrumModel ())
+        {
+          // reuse the buffer of the previous reception
+          *m_rxSignal = *rxPsd;
+        }
+      else
+        {
+          m_rxSignal = rxPsd->Copy ();
+        }
       m_lastChangeTime = Now ();
       m_receiving = true;
       for (std::list<Ptr<mmWaveChunkProcessor> >::const_iterator it = m_PowerChunkProcessorList.begin (); it != m_PowerChunkProcessorList.end (); ++it)
@@ -113,13 +124,14 @@ void
 mmWaveInterference::EndRx ()
 {
   NS_LOG_FUNCTION (this);
+  RetireExpiredSignals ();
   if (m_receiving != true)
     {
       NS_LOG_INFO ("EndRx was already evaluated or RX was aborted");
     }
   else
     {
-      ConditionallyEvaluateChunk ();
+      ConditionallyEvaluateChunk (Now ());
       m_receiving = false;
       for (std::list<Ptr<mmWaveChunkProcessor> >::const_iterator it = m_PowerChunkProcessorList.begin (); it != m_PowerChunkProcessorList.end (); ++it)
         {
@@ -137,6 +149,7 @@ void
 mmWaveInterference::AddSignal (Ptr<const SpectrumValue> spd, const Time duration)
 {
   NS_LOG_FUNCTION (this << *spd << duration);
+  RetireExpiredSignals ();
   DoAddSignal (spd);
   uint32_t signalId = ++m_lastSignalId;
   if (signalId == m_lastSignalIdBeforeReset)
@@ -148,7 +161,25 @@ mmWaveInterference::AddSignal (Ptr<const SpectrumValue> spd, const Time duration
       // boundary further.
       m_lastSignalIdBeforeReset += 0x10000000;
     }
-  Simulator::Schedule (duration, &mmWaveInterference::DoSubtractSignal, this, spd, signalId);
+  // the signal is subtracted when the interference is accessed after its
+  // end, instead of scheduling an event for each signal
+  ActiveSignal signal;
+  signal.m_endTime = Now () + duration;
+  signal.m_signalId = signalId;
+  signal.m_spd = spd;
+  m_activeSignals.push (signal);
+}
+
+void
+mmWaveInterference::RetireExpiredSignals ()
+{
+  Time now = Now ();
+  while (!m_activeSignals.empty () && m_activeSignals.top ().m_endTime <= now)
+    {
+      ActiveSignal signal = m_activeSignals.top ();
+      m_activeSignals.pop ();
+      DoSubtractSignal (signal.m_spd, signal.m_signalId, signal.m_endTime);
+    }
 }
 
 
@@ -156,15 +187,15 @@ void
 mmWaveInterference::DoAddSignal (Ptr<const SpectrumValue> spd)
 {
   NS_LOG_FUNCTION (this << *spd);
-  ConditionallyEvaluateChunk ();
+  ConditionallyEvaluateChunk (Now ());
   (*m_allSignals) += (*spd);
 }
 
 void
-mmWaveInterference::DoSubtractSignal  (Ptr<const SpectrumValue> spd, uint32_t signalId)
+mmWaveInterference::DoSubtractSignal  (Ptr<const SpectrumValue> spd, uint32_t signalId, Time endTime)
 {
-  NS_LOG_FUNCTION (this << *spd);
-  ConditionallyEvaluateChunk ();
+  NS_LOG_FUNCTION (this << *spd << endTime);
+  ConditionallyEvaluateChunk (endTime);
   int32_t deltaSignalId = signalId - m_lastSignalIdBeforeReset;
   if (deltaSignalId > 0)
     {
@@ -178,29 +209,28 @@ mmWaveInterference::DoSubtractSignal  (Ptr<const SpectrumValue> spd, uint32_t si
 
 
 void
-mmWaveInterference::ConditionallyEvaluateChunk ()
+mmWaveInterference::ConditionallyEvaluateChunk (Time now)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << now);
   if (m_receiving)
     {
       NS_LOG_DEBUG (this << " Receiving");
     }
-  NS_LOG_DEBUG (this << " now "  << Now () << " last " << m_lastChangeTime);
-  if (m_receiving && (Now () > m_lastChangeTime))
+  NS_LOG_DEBUG (this << " now "  << now << " last " << m_lastChangeTime);
+  if (m_receiving && (now > m_lastChangeTime))
     {
       NS_LOG_LOGIC (this << " signal = " << *m_rxSignal << " allSignals = " << *m_allSignals << " noise = " << *m_noise);
-      SpectrumValue interf =  (*m_allSignals) - (*m_rxSignal) + (*m_noise);
-      SpectrumValue sinr = (*m_rxSignal) / interf;
-      Time duration = Now () - m_lastChangeTime;
+      Sinr (*m_rxSignal, *m_allSignals, *m_noise, *m_sinr);
+      Time duration = now - m_lastChangeTime;
       for (std::list<Ptr<mmWaveChunkProcessor> >::const_iterator it = m_PowerChunkProcessorList.begin (); it != m_PowerChunkProcessorList.end (); ++it)
         {
           (*it)->EvaluateChunk (*m_rxSignal, duration);
         }
       for (std::list<Ptr<mmWaveChunkProcessor> >::const_iterator it = m_sinrChunkProcessorList.begin (); it != m_sinrChunkProcessorList.end (); ++it)
         {
-          (*it)->EvaluateChunk (sinr, duration);
+          (*it)->EvaluateChunk (*m_sinr, duration);
         }
-      m_lastChangeTime = Now ();
+      m_lastChangeTime = now;
     }
 }
 
@@ -208,9 +238,11 @@ void
 mmWaveInterference::SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd)
 {
   NS_LOG_FUNCTION (this << *noisePsd);
-  ConditionallyEvaluateChunk ();
+  RetireExpiredSignals ();
+  ConditionallyEvaluateChunk (Now ());
   m_noise = noisePsd;
   m_allSignals = Create<SpectrumValue> (noisePsd->GetSpectrumModel ());
+  m_sinr = Create<SpectrumValue> (noisePsd->GetSpectrumModel ());
   if (m_receiving == true)
     {
       // abort rx
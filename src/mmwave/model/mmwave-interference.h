@@ -35,6 +35,7 @@
 #include <ns3/nstime.h>
 #include <ns3/spectrum-value.h>
 #include <string.h>
+#include <queue>
 #include <ns3/mmwave-chunk-processor.h>
 
 
@@ -57,9 +58,36 @@ public:
   void AddSinrChunkProcessor (Ptr<mmWaveChunkProcessor> p);
 
 private:
-  void ConditionallyEvaluateChunk ();
+  /**
+   * A signal which contributes to m_allSignals until its end time
+   */
+  struct ActiveSignal
+  {
+    Time m_endTime; ///< the time at which the signal has to be subtracted
+    uint32_t m_signalId; ///< the signal ID
+    Ptr<const SpectrumValue> m_spd; ///< the power spectral density of the signal
+  };
+
+  /**
+   * Order the active signals by end time, and the signals ending at the same
+   * time by ID, i.e., in the order the subtraction events would be executed
+   */
+  struct ActiveSignalCompare
+  {
+    bool operator() (const ActiveSignal& a, const ActiveSignal& b) const
+    {
+      return (a.m_endTime > b.m_endTime) || (a.m_endTime == b.m_endTime && a.m_signalId > b.m_signalId);
+    }
+  };
+
+  /**
+   * Subtract the signals which ended before or at the current time,
+   * evaluating the chunks delimited by their end times
+   */
+  void RetireExpiredSignals ();
+  void ConditionallyEvaluateChunk (Time now);
   void DoAddSignal (Ptr<const SpectrumValue> spd);
-  void DoSubtractSignal  (Ptr<const SpectrumValue> spd, uint32_t signalId);
+  void DoSubtractSignal  (Ptr<const SpectrumValue> spd, uint32_t signalId, Time endTime);
   std::list<Ptr<mmWaveChunkProcessor> > m_PowerChunkProcessorList;
   std::list<Ptr<mmWaveChunkProcessor> > m_sinrChunkProcessorList;
 
@@ -69,11 +97,14 @@ private:
   Ptr<SpectrumValue> m_rxSignal;
   Ptr<SpectrumValue> m_allSignals;
   Ptr<const SpectrumValue> m_noise;
+  Ptr<SpectrumValue> m_sinr; ///< buffer reused for the SINR of each chunk
 
   Time m_lastChangeTime;
 
   uint32_t m_lastSignalId;
   uint32_t m_lastSignalIdBeforeReset;
+
+  std::priority_queue<ActiveSignal, std::vector<ActiveSignal>, ActiveSignalCompare> m_activeSignals; ///< the signals to be subtracted, ordered by end time
 };
 
 } // namespace mmwave
@@ -31,6 +31,7 @@
 #include "ns3/assert.h"
 #include "ns3/global-value.h"
 #include "ns3/boolean.h"
+#include "ns3/config.h"
 
 namespace ns3 {
 
@@ -138,6 +139,8 @@ Node::AddDevice (Ptr<NetDevice> device)
   Simulator::ScheduleWithContext (GetId (), Seconds (0.0), 
                                   &NetDevice::Initialize, device);
   NotifyDeviceAdded (device);
+  Config::NotifyNewObject ("/NodeList/" + std::to_string (GetId ()) +
+                           "/DeviceList/" + std::to_string (index), device);
   return index;
 }
 Ptr<NetDevice>
@@ -205,6 +208,13 @@ Node::DoDispose ()
   m_applications.clear ();
   Object::DoDispose ();
 }
+void
+Node::NotifyNewAggregate (void)
+{
+  NS_LOG_FUNCTION (this);
+  Config::NotifyNewObject ("/NodeList/" + std::to_string (GetId ()), this);
+  Object::NotifyNewAggregate ();
+}
 void 
 Node::DoInitialize (void)
 {
@@ -218,6 +218,11 @@ protected:
    */
   virtual void DoDispose (void);
   virtual void DoInitialize (void);
+  /**
+   * Notify the incremental Config connections of the objects aggregated
+   * to the node, e.g., the mobility model.
+   */
+  virtual void NotifyNewAggregate (void);
 private:
 
   /**
@@ -403,6 +403,34 @@ Integral (const SpectrumValue& arg)
   return i;
 }
 
+void
+Sinr (const SpectrumValue& signal, const SpectrumValue& allSignals,
+      const SpectrumValue& noise, SpectrumValue& sinr)
+{
+  NS_ASSERT (signal.m_spectrumModel == allSignals.m_spectrumModel);
+  NS_ASSERT (signal.m_spectrumModel == noise.m_spectrumModel);
+
+  size_t n = signal.m_values.size ();
+  if (sinr.m_spectrumModel != signal.m_spectrumModel)
+    {
+      sinr.m_spectrumModel = signal.m_spectrumModel;
+    }
+  if (sinr.m_values.size () != n)
+    {
+      sinr.m_values.resize (n);
+    }
+
+  // plain loop on contiguous arrays, so that the compiler can vectorize it
+  const double* s = signal.m_values.data ();
+  const double* a = allSignals.m_values.data ();
+  const double* w = noise.m_values.data ();
+  double* r = sinr.m_values.data ();
+  for (size_t i = 0; i < n; ++i)
+    {
+      r[i] = s[i] / ((a[i] - s[i]) + w[i]);
+    }
+}
+
 
 
 Ptr<SpectrumValue>
@@ -508,6 +508,20 @@ public:
    */
   friend double Integral (const SpectrumValue&  arg);
 
+  /**
+   * Compute the Signal to Interference plus Noise Ratio, i.e.,
+   * signal / (allSignals - signal + noise), component by component. The
+   * result is written in place in sinr, thus no memory is allocated if
+   * sinr already has the same number of values as the operands.
+   *
+   * @param signal the useful signal
+   * @param allSignals all the received signals, including the useful one
+   * @param noise the noise
+   * @param sinr the SpectrumValue where the result is stored
+   */
+  friend void Sinr (const SpectrumValue& signal, const SpectrumValue& allSignals,
+                    const SpectrumValue& noise, SpectrumValue& sinr);
+
   /**
    *
    * @return a Ptr to a copy of this instance
@@ -630,6 +644,8 @@ SpectrumValue Log10 (const SpectrumValue& arg);
 SpectrumValue Log2 (const SpectrumValue& arg);
 SpectrumValue Log (const SpectrumValue& arg);
 double Integral (const SpectrumValue& arg);
+void Sinr (const SpectrumValue& signal, const SpectrumValue& allSignals,
+           const SpectrumValue& noise, SpectrumValue& sinr);
 
 
 } // namespace ns3
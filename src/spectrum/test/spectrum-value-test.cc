@@ -242,6 +242,12 @@ SpectrumValueTestSuite::SpectrumValueTestSuite ()
   AddTestCase (new SpectrumValueTestCase (tv1rs3, v1rs3, "tv1rs3 = v1 >> 3"), TestCase::QUICK);
 
 
+  SpectrumValue vSinr (f), tvSinr (f);
+  vSinr = v1 / (v3 - v1 + v2);
+  Sinr (v1, v3, v2, tvSinr);
+  AddTestCase (new SpectrumValueTestCase (tvSinr, vSinr, "Sinr (v1, v3, v2, tvSinr)"), TestCase::QUICK);
+
+
 }
 
 
@@ -437,6 +437,8 @@ public:
         double getDistanceRoad(const std::string& edgeID1, double pos1, const std::string& edgeID2, double pos2, bool isDriving = false);
         libsumo::TraCIStage findRoute(const std::string& fromEdge, const std::string& toEdge, const std::string& vType = "", double pos = -1., int routingMode = 0) const;
         void writeMessage(const std::string msg);
+        void saveState(const std::string& fileName);
+        void loadState(const std::string& fileName);
     };
 
 
@@ -198,7 +198,7 @@ namespace ns3
       {
         int pos = m_sumoConfigPath.find_last_of("/\\");
         std::string sumoDir = m_sumoConfigPath.substr(0, pos);
-        m_sumoCommand += " --error-log " + sumoDir + "/SumoError.log";
+        m_sumoCommand += " --error-log " + SimulationFork::GetFileName(sumoDir + "/SumoError.log");
       }
 
     // sumo step log
@@ -217,6 +217,12 @@ namespace ns3
         m_sumoCommand += " --seed " + std::to_string(m_sumoSeed);
       }
 
+    // sumo saved state
+    if (m_sumoStateFile != "")
+      {
+        m_sumoCommand += " --load-state " + m_sumoStateFile;
+      }
+
     // sumo additional command line options
     m_sumoCommand += " " + m_sumoAddCmdOpt;
     m_sumoCommand += " --start --quit-on-end &";
@@ -233,6 +239,28 @@ namespace ns3
 
     m_includeNode = includeNode;
     m_excludeNode = excludeNode;
+
+    // start up sumo and connect to it
+    SumoStart();
+
+    // start sumo and simulate until the specified time
+    this->TraCIAPI::simulationStep(m_startTime.GetSeconds());
+
+    // synchronise sumo vehicles with ns3 nodes
+    SynchroniseVehicleNodeMap();
+
+    // get current positions from sumo and uptdate positions
+    UpdatePositions();
+
+    // schedule event to command sumo the next simulation step
+    Simulator::Schedule(m_synchInterval, &TraciClient::SumoSimulationStep, this);
+  }
+
+  void
+  TraciClient::SumoStart()
+  {
+    NS_LOG_FUNCTION(this);
+
     m_sumoCommand = GetSumoCmdString();
 
     // start up sumo
@@ -255,18 +283,39 @@ namespace ns3
       {
         NS_FATAL_ERROR("Can not connect to sumo via traci: " << e.what());
       }
+  }
 
-    // start sumo and simulate until the specified time
-    this->TraCIAPI::simulationStep(m_startTime.GetSeconds());
-
-    // synchronise sumo vehicles with ns3 nodes
-    SynchroniseVehicleNodeMap();
+  void
+  TraciClient::SumoSaveState(std::string stateFile)
+  {
+    NS_LOG_FUNCTION(this << stateFile);
 
-    // get current positions from sumo and uptdate positions
-    UpdatePositions();
+    try
+      {
+        this->TraCIAPI::simulation.saveState(stateFile);
+      }
+    catch (std::exception& e)
+      {
+        NS_FATAL_ERROR("Can not save the sumo state: " << e.what());
+      }
+  }
 
-    // schedule event to command sumo the next simulation step
-    Simulator::Schedule(m_synchInterval, &TraciClient::SumoSimulationStep, this);
+  void
+  TraciClient::SumoRestart(std::string stateFile, uint32_t portOffset)
+  {
+    NS_LOG_FUNCTION(this << stateFile << portOffset);
+
+    // the socket is shared with the parent process: close only the file
+    // descriptor of this process, without sending the close command which
+    // would quit the sumo instance of the parent
+    delete mySocket;
+    mySocket = nullptr;
+
+    // the new sumo instance starts at the time of the saved state, so that
+    // the next synchronisation step continues from there
+    m_sumoStateFile = stateFile;
+    m_sumoPort = GetFreePort(m_sumoPort + portOffset);
+    SumoStart();
   }
 
   void
@@ -55,6 +55,14 @@ public:
 
   void SumoStop();
 
+  // save the sumo simulation state to a file, e.g., before forking the simulation
+  void SumoSaveState(std::string stateFile);
+
+  // in a forked process: drop the connection inherited from the parent and
+  // connect to a new sumo instance, started from a saved state on a free port
+  // searched from the current port plus the offset
+  void SumoRestart(std::string stateFile, uint32_t portOffset);
+
   // get associated sumo vehicle for ns3 node
   std::string GetVehicleId(Ptr<Node> node);
 
@@ -79,6 +87,9 @@ private:
   // build command line string for sumo start up
   std::string GetSumoCmdString (void);
 
+  // start up sumo and connect to it via traci
+  void SumoStart (void);
+
   // map every sumo vehicle to a ns3 node
   //std::map< std::string, Ptr<Node> > m_vehicleNodeMap;
 
@@ -98,6 +109,7 @@ private:
   std::string m_sumoCommand;
   std::string m_sumoConfigPath;
   std::string m_sumoBinaryPath;
+  std::string m_sumoStateFile;
   uint16_t m_sumoPort;
   bool m_sumoGUI;
 
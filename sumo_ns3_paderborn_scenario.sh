@@ -25,13 +25,30 @@ altitude=122  # altitude in meters above the sea level of Paderborn
 h0=2000  # mean annual 0C isotherm height above mean sea level
 
 
-for intensity in ${rainIntensity[@]}
-do
+# Warm-up time in seconds shared by all the rain intensities: the simulation
+# runs once up to this time, then forks one process per rain intensity, each
+# with its own SUMO instance and output files (suffixed with -branchN).
+# Set to 0 to run the whole scenario once per rain intensity.
+forkTime=0
 
 simRun=1
 
+if [ "$forkTime" != "0" ]
+then
+
+  rainSweep=$(IFS=,; echo "${rainIntensity[*]}")
+
+  ./waf --run "sumo_ns3_paderborn  --simulationRun=$simRun --intensityOfRain=${rainIntensity[0]} --channel_condition=$environment --combined_rain_snow=$snowAttenuation --scenario=$commScenario --RngRun=$simRun --k=$k --alpha=$alpha --altitude=$altitude  --h0=$h0 --forkTime=$forkTime --rainSweep=$rainSweep"
+
+else
+
+for intensity in ${rainIntensity[@]}
+do
+
   ./waf --run "sumo_ns3_paderborn  --simulationRun=$simRun --intensityOfRain=$intensity --channel_condition=$environment --combined_rain_snow=$snowAttenuation --scenario=$commScenario --RngRun=$simRun --k=$k --alpha=$alpha --altitude=$altitude  --h0=$h0"
 
 done  
 
+fi
+
 
@@ -146,11 +146,27 @@ Bench::Cb (void)
 
 
 Ptr<RandomVariableStream>
-GetRandomStream (std::string filename)
+GetRandomStream (std::string filename, bool slot, double symbol)
 {
   Ptr<RandomVariableStream> stream = 0;
 
-  if (filename == "")
+  if (slot)
+    {
+      // the events of a slot-based PHY happen at the symbol boundaries:
+      // a fifth of the events are scheduled now, e.g., the receptions of a
+      // transmission, and the others one symbol, one slot (14 symbols) or
+      // a few slots later, so that many events share the same timestamp
+      LOGME ("using slot-periodic distribution, symbol " << symbol << " ns");
+      Ptr<EmpiricalRandomVariable> erv = CreateObject<EmpiricalRandomVariable> ();
+      erv->SetInterpolate (false);
+      erv->CDF (0, 0.2);
+      erv->CDF (symbol, 0.6);
+      erv->CDF (14 * symbol, 0.9);
+      erv->CDF (28 * symbol, 0.95);
+      erv->CDF (56 * symbol, 1.0);
+      stream = erv;
+    }
+  else if (filename == "")
     {
       LOGME ("using default exponential distribution");
       Ptr<ExponentialRandomVariable> erv = CreateObject<ExponentialRandomVariable> ();
@@ -200,6 +216,64 @@ GetRandomStream (std::string filename)
 
 
 
+/**
+ * Run the benchmark with a scheduler.
+ * \param bench the benchmark
+ * \param type the scheduler TypeId name
+ * \param pop the population
+ * \param total the total
+ * \param runs the number of runs
+ */
+void
+RunScheduler (Bench *bench, std::string type,
+              const uint32_t pop, const uint32_t total, const uint32_t runs)
+{
+  ObjectFactory factory (type);
+  Simulator::SetScheduler (factory);
+
+  LOGME ("scheduler: " << factory.GetTypeId ().GetName ());
+
+  // table header
+  LOG ("");
+  LOG (std::left << std::setw (g_fwidth) << "Run #" <<
+       std::left << std::setw (3 * g_fwidth) << "Inititialization:" <<
+       std::left << std::setw (3 * g_fwidth) << "Simulation:");
+  LOG (std::left << std::setw (g_fwidth) << "" <<
+       std::left << std::setw (g_fwidth) << "Time (s)" <<
+       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
+       std::left << std::setw (g_fwidth) << "Per (s/ev)" <<
+       std::left << std::setw (g_fwidth) << "Time (s)" <<
+       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
+       std::left << std::setw (g_fwidth) << "Per (s/ev)" );
+  LOG (std::setfill ('-') <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::setfill (' ')
+       );
+
+  // prime
+  DEB ("priming");
+  std::cout << std::left << std::setw (g_fwidth) << "(prime)";
+  bench->RunBench ();
+
+  bench->SetPopulation (pop);
+  bench->SetTotal (total);
+  for (uint32_t i = 0; i < runs; i++)
+    {
+      std::cout << std::setw (g_fwidth) << i;
+
+      bench->RunBench ();
+    }
+
+  LOG ("");
+  Simulator::Destroy ();
+}
+
 int main (int argc, char *argv[])
 {
 
@@ -207,100 +281,99 @@ int main (int argc, char *argv[])
   bool schedHeap = false;
   bool schedList = false;
   bool schedMap  = true;
+  bool schedPQ   = false;
+  bool schedLadder = false;
+  bool schedAll  = false;
 
   uint32_t pop   =  100000;
   uint32_t total = 1000000;
   uint32_t runs  =       1;
   std::string filename = "";
+  bool slot = false;
+  double symbol = 8928;
 
   CommandLine cmd;
   cmd.Usage ("Benchmark the simulator scheduler.\n"
              "\n"
              "Event intervals are taken from one of:\n"
              "  an exponential distribution, with mean 100 ns,\n"
+             "  a slot-periodic distribution, given by the --slot argument,\n"
              "  an ascii file, given by the --file=\"<filename>\" argument,\n"
              "  or standard input, by the argument --file=\"-\"\n"
              "In the case of either --file form, the input is expected\n"
-             "to be ascii, giving the relative event times in ns.");
+             "to be ascii, giving the relative event times in ns.\n"
+             "The slot-periodic distribution schedules the events at\n"
+             "multiples of the OFDM symbol of --symbol ns, with many\n"
+             "events sharing the same timestamp.");
   cmd.AddValue ("cal",   "use CalendarSheduler",          schedCal);
   cmd.AddValue ("heap",  "use HeapScheduler",             schedHeap);
   cmd.AddValue ("list",  "use ListSheduler",              schedList);
   cmd.AddValue ("map",   "use MapScheduler (default)",    schedMap);
+  cmd.AddValue ("pri",   "use PriorityQueueScheduler",    schedPQ);
+  cmd.AddValue ("ladder", "use LadderScheduler",          schedLadder);
+  cmd.AddValue ("all",   "run with all the schedulers",   schedAll);
   cmd.AddValue ("debug", "enable debugging output",       g_debug);
   cmd.AddValue ("pop",   "event population size (default 1E5)",         pop);
   cmd.AddValue ("total", "total number of events to run (default 1E6)", total);
   cmd.AddValue ("runs",  "number of runs (default 1)",    runs);
   cmd.AddValue ("file",  "file of relative event times",  filename);
+  cmd.AddValue ("slot",  "use the slot-periodic event times", slot);
+  cmd.AddValue ("symbol", "OFDM symbol duration in ns of the slot-periodic event times", symbol);
   cmd.AddValue ("prec",  "printed output precision",      g_fwidth);
   cmd.Parse (argc, argv);
   g_me = cmd.GetName () + ": ";
   g_fwidth += 6;  // 5 extra chars in '2.000002e+07 ': . e+0 _
 
-  ObjectFactory factory ("ns3::MapScheduler");
-  if (schedCal)
+  std::vector<std::string> schedulers;
+  if (schedAll)
     {
-      factory.SetTypeId ("ns3::CalendarScheduler");
+      schedulers.push_back ("ns3::MapScheduler");
+      schedulers.push_back ("ns3::CalendarScheduler");
+      schedulers.push_back ("ns3::HeapScheduler");
+      schedulers.push_back ("ns3::ListScheduler");
+      schedulers.push_back ("ns3::PriorityQueueScheduler");
+      schedulers.push_back ("ns3::LadderScheduler");
     }
-  if (schedHeap)
+  else if (schedCal)
     {
-      factory.SetTypeId ("ns3::HeapScheduler");
+      schedulers.push_back ("ns3::CalendarScheduler");
     }
-  if (schedList)
+  else if (schedHeap)
     {
-      factory.SetTypeId ("ns3::ListScheduler");
+      schedulers.push_back ("ns3::HeapScheduler");
+    }
+  else if (schedList)
+    {
+      schedulers.push_back ("ns3::ListScheduler");
+    }
+  else if (schedPQ)
+    {
+      schedulers.push_back ("ns3::PriorityQueueScheduler");
+    }
+  else if (schedLadder)
+    {
+      schedulers.push_back ("ns3::LadderScheduler");
+    }
+  else
+    {
+      schedulers.push_back ("ns3::MapScheduler");
     }
-  Simulator::SetScheduler (factory);
 
   LOGME (std::setprecision (g_fwidth - 6));
   DEB ("debugging is ON");
 
-  LOGME ("scheduler: " << factory.GetTypeId ().GetName ());
   LOGME ("population: " << pop);
   LOGME ("total events: " << total);
   LOGME ("runs: " << runs);
 
   Bench *bench = new Bench (pop, total);
-  bench->SetRandomStream (GetRandomStream (filename));
+  bench->SetRandomStream (GetRandomStream (filename, slot, symbol));
 
-  // table header
-  LOG ("");
-  LOG (std::left << std::setw (g_fwidth) << "Run #" <<
-       std::left << std::setw (3 * g_fwidth) << "Inititialization:" <<
-       std::left << std::setw (3 * g_fwidth) << "Simulation:");
-  LOG (std::left << std::setw (g_fwidth) << "" <<
-       std::left << std::setw (g_fwidth) << "Time (s)" <<
-       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
-       std::left << std::setw (g_fwidth) << "Per (s/ev)" <<
-       std::left << std::setw (g_fwidth) << "Time (s)" <<
-       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
-       std::left << std::setw (g_fwidth) << "Per (s/ev)" );
-  LOG (std::setfill ('-') <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::setfill (' ')
-       );
-
-  // prime
-  DEB ("priming");
-  std::cout << std::left << std::setw (g_fwidth) << "(prime)";
-  bench->RunBench ();
-
-  bench->SetPopulation (pop);
-  bench->SetTotal (total);
-  for (uint32_t i = 0; i < runs; i++)
+  for (std::vector<std::string>::const_iterator it = schedulers.begin (); it != schedulers.end (); ++it)
     {
-      std::cout << std::setw (g_fwidth) << i;
-
-      bench->RunBench ();
+      RunScheduler (bench, *it, pop, total, runs);
     }
 
-  LOG ("");
-  Simulator::Destroy ();
   delete bench;
   return 0;
 }